@@ -7,21 +7,35 @@ TEST_DIR=$(SRC_DIR)/sim
 # Simulator to use
 SIMULATOR=icarus
 #SIMULATOR=questasim
+#SIMULATOR=verilator
 # Directory where to store compiled hardware
 WORK_DIR=$(OBJ_DIR)/work
+# Directory where to store the Verilator model
+VERILATOR_DIR=$(OBJ_DIR)/verilator
 # Skip dependency check
 DEP_CHECK_DIS=0
 
 # RISC-V architecture
 ARCH=riscv32-unknown-elf
-# Linker script path
-LINKER_SCRIPT=$(SRC_DIR)/firmware/linker_script_sram.ld
+# Number of 2KB banks of the internal SRAM (RAM_BANKS parameter of chip_top, power of 2)
+RAM_BANKS=1
+# Size of the tightly-coupled instruction and data memories (ITCM_SIZE/DTCM_SIZE parameters of chip_top, bytes, 0 or power of 2)
+ITCM_SIZE=1024
+DTCM_SIZE=1024
+# Linker script path (scripts are generated in the build directory for the memory sizes set above)
+LINKER_SCRIPT=$(OBJ_DIR)/firmware/linker_script_sram.ld
+#LINKER_SCRIPT=$(OBJ_DIR)/firmware/linker_script_spi_boot_sram.ld
+#LINKER_SCRIPT=$(OBJ_DIR)/firmware/linker_script_spi_boot_ddr.ld
 # CRT0 file path
 CRT0=$(SRC_DIR)/firmware/crt0.s
 # Header files folder path
 HEADERS=$(SRC_DIR)/firmware/headers
+# Build firmware for the M extension (multiplication/division instructions), 0 for rv32i only
+RV32M=1
+# Build firmware for the C extension (compressed instructions), 0 for rv32i only
+RV32C=1
 # GCC compilation options
-OPTS=-march=rv32i -mabi=ilp32 -ffreestanding -Wl,--gc-sections -nostartfiles -I $(HEADERS) -T $(LINKER_SCRIPT)
+OPTS=-march=rv32i$(if $(filter 1,$(RV32M)),m)$(if $(filter 1,$(RV32C)),c)_zicsr -mabi=ilp32 -ffreestanding -Wl,--gc-sections -nostartfiles -I $(HEADERS) -T $(LINKER_SCRIPT)
 
 
 # Target to run when no target it specified
@@ -81,6 +95,22 @@ else ifeq ($(SIMULATOR), icarus)
 	else \
 		echo "GTKWave: OK"; \
 	fi
+else ifeq ($(SIMULATOR), verilator)
+# Check for verilator and gtkwave
+	@if ! which verilator > /dev/null 2>&1; then \
+		echo "Verilator: MISSING"; \
+		echo "Depencency check can be disabled setting "DEP_CHECK_DIS" in base.mk"; \
+		exit 1; \
+	else \
+		echo "Verilator: OK"; \
+	fi
+	@if ! which gtkwave > /dev/null 2>&1; then \
+		echo "GTKWave: MISSING"; \
+		echo "Depencency check can be disabled setting "DEP_CHECK_DIS" in base.mk"; \
+		exit 1; \
+	else \
+		echo "GTKWave: OK"; \
+	fi
 endif
 endif
 # Create obj directory
@@ -0,0 +1,35 @@
+# Common part of the benchmarks makefiles (src/bench/*)
+# Benchmarks use the targets of the tests (make batch, make gui, ...), the testbench writes
+#   the counters of the measured kernel in perf_report.json
+# run_bench.py runs all the benchmarks for each linker script
+
+# Include makefile to start testcase
+include $(TEST_DIR)/common.mk
+
+# Benchmarks are compiled with optimizations and use bench.h
+OPTS+=-O2 -I $(SRC_DIR)/bench/common
+
+# Data of the larger benchmarks does not fit in the default SRAM (MIN_RAM_BANKS is set by the benchmark)
+# run_bench.py builds the design, the linker scripts and the benchmark for BENCH_RAM_BANKS banks in
+#   a separate build directory (RAM_BANKS and OBJ_DIR set on the command line), base.mk is not changed
+BENCH_RAM_BANKS=$(shell if [ -n "$(MIN_RAM_BANKS)" ] && [ $(RAM_BANKS) -lt $(MIN_RAM_BANKS) ]; then echo $(MIN_RAM_BANKS); else echo $(RAM_BANKS); fi)
+
+.PHONY: ram_banks
+ram_banks :
+	@echo $(BENCH_RAM_BANKS)
+
+# Benchmarks built from sources outside of the repository set BENCH_SKIP (reason) when they
+#   are not available, run_bench.py reports them as skipped
+.PHONY: bench_skip
+bench_skip :
+	@echo "$(BENCH_SKIP)"
+
+.PHONY: .check_ram_banks
+.check_ram_banks :
+	@if [ $(RAM_BANKS) -lt $(BENCH_RAM_BANKS) ]; then \
+		echo "Error: $(TEST_NAME) needs at least $(BENCH_RAM_BANKS) SRAM banks, run it with run_bench.py" \
+		"or with make RAM_BANKS=$(BENCH_RAM_BANKS) OBJ_DIR=<build directory>" >&2; \
+		exit 1; \
+	fi
+
+$(OUTPUT_DIR)/$(TEST_NAME).elf : | .check_ram_banks
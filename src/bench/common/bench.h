@@ -0,0 +1,29 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+#include "perf_counters.h"
+
+// Measurement of the benchmarks kernels
+// The counters only run between BENCH_START and BENCH_STOP, the testbench reads them when the
+//   program ends and writes perf_report.json (cycles, instret, CPI, bytes/cycle, stall counters)
+
+// All the counters of mcountinhibit
+#define BENCH_INHIBIT_ALL_M (PERF_INHIBIT_CYCLE_M | PERF_INHIBIT_INSTRET_M | PERF_INHIBIT_INSTR_WAIT_M | \
+                             PERF_INHIBIT_DATA_WAIT_M | PERF_INHIBIT_LOAD_USE_M | PERF_INHIBIT_BRANCH_FLUSH_M | \
+                             PERF_INHIBIT_COPY_STALL_M | PERF_INHIBIT_MULDIV_STALL_M)
+
+// Clear the counters and start counting
+#define BENCH_START() do { \
+    PERF_INHIBIT(BENCH_INHIBIT_ALL_M); \
+    PERF_RESET(); \
+    PERF_INHIBIT(0); \
+} while (0)
+
+// Stop counting, bytes is the amount of data moved by the kernel (0 if not relevant)
+//   and is left in mscratch for the testbench
+#define BENCH_STOP(bytes) do { \
+    PERF_INHIBIT(BENCH_INHIBIT_ALL_M); \
+    CSR_WRITE(mscratch, (bytes)); \
+} while (0)
+
+#endif // BENCH_H
@@ -0,0 +1,57 @@
+#include "coremark.h"
+#include "core_portme.h"
+#include "bench.h"
+
+// Seeds of the run type (values of the CoreMark reference ports)
+#if VALIDATION_RUN
+volatile ee_s32 seed1_volatile = 0x3415;
+volatile ee_s32 seed2_volatile = 0x3415;
+volatile ee_s32 seed3_volatile = 0x66;
+#endif
+#if PERFORMANCE_RUN
+volatile ee_s32 seed1_volatile = 0x0;
+volatile ee_s32 seed2_volatile = 0x0;
+volatile ee_s32 seed3_volatile = 0x66;
+#endif
+#if PROFILE_RUN
+volatile ee_s32 seed1_volatile = 0x8;
+volatile ee_s32 seed2_volatile = 0x8;
+volatile ee_s32 seed3_volatile = 0x8;
+#endif
+volatile ee_s32 seed4_volatile = ITERATIONS;
+volatile ee_s32 seed5_volatile = 0;
+
+ee_u32 default_num_contexts = 1;
+
+// The counters only run during the timed iterations
+void start_time(void) {
+    BENCH_START();
+}
+
+void stop_time(void) {
+    BENCH_STOP(0);
+}
+
+CORE_TICKS get_time(void) {
+    return (CORE_TICKS)PERF_CYCLE();
+}
+
+secs_ret time_in_secs(CORE_TICKS ticks) {
+    return (secs_ret)(ticks / CLOCK_HZ);
+}
+
+void portable_init(core_portable *p, int *argc, char *argv[]) {
+    (void)argc;
+    (void)argv;
+    p->portable_id = 1;
+}
+
+void portable_fini(core_portable *p) {
+    p->portable_id = 0;
+}
+
+// Results are not printed (UART output would slow down the simulation)
+int ee_printf(const char *fmt, ...) {
+    (void)fmt;
+    return 0;
+}
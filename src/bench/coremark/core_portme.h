@@ -0,0 +1,81 @@
+#ifndef CORE_PORTME_H
+#define CORE_PORTME_H
+
+// CoreMark port (based on the barebones port of the CoreMark sources)
+// Nothing is printed, cycles and instructions of the timed iterations are written by the
+//   testbench in perf_report.json
+
+#include <stddef.h>
+
+// Clock of the SoC in simulation (10 ns period), only used to convert ticks to seconds
+#ifndef CLOCK_HZ
+#define CLOCK_HZ 100000000
+#endif
+
+// Features of the platform
+#define HAS_FLOAT      0
+#define HAS_TIME_H     0
+#define USE_CLOCK      0
+#define HAS_STDIO      0
+#define HAS_PRINTF     0
+#define MAIN_HAS_NOARGC   1
+#define MAIN_HAS_NORETURN 0
+
+// Compiler information (flags are passed by the makefile)
+#ifndef COMPILER_VERSION
+#define COMPILER_VERSION __VERSION__
+#endif
+#ifndef COMPILER_FLAGS
+#define COMPILER_FLAGS FLAGS_STR
+#endif
+#ifndef MEM_LOCATION
+#define MEM_LOCATION "STACK"
+#endif
+
+// Data types
+typedef signed short   ee_s16;
+typedef unsigned short ee_u16;
+typedef signed int     ee_s32;
+typedef double         ee_f32;
+typedef unsigned char  ee_u8;
+typedef unsigned int   ee_u32;
+typedef ee_u32         ee_ptr_int;
+typedef size_t         ee_size_t;
+
+// Align an address to 32 bits
+#define align_mem(x) (void *)(4 + (((ee_ptr_int)(x)-1) & ~3))
+
+// Ticks are clock cycles (mcycle)
+#define CORETIMETYPE ee_u32
+typedef ee_u32 CORE_TICKS;
+
+// Seeds are read from volatile variables, data is allocated on the stack, single thread
+#define SEED_METHOD SEED_VOLATILE
+#define MEM_METHOD  MEM_STACK
+#define MULTITHREAD 1
+#define USE_PTHREAD 0
+#define USE_FORK    0
+#define USE_SOCKET  0
+
+extern ee_u32 default_num_contexts;
+
+typedef struct CORE_PORTABLE_S {
+    ee_u8 portable_id;
+} core_portable;
+
+void portable_init(core_portable *p, int *argc, char *argv[]);
+void portable_fini(core_portable *p);
+
+#if !defined(PROFILE_RUN) && !defined(PERFORMANCE_RUN) && !defined(VALIDATION_RUN)
+#if (TOTAL_DATA_SIZE == 1200)
+#define PROFILE_RUN 1
+#elif (TOTAL_DATA_SIZE == 2000)
+#define PERFORMANCE_RUN 1
+#else
+#define VALIDATION_RUN 1
+#endif
+#endif
+
+int ee_printf(const char *fmt, ...);
+
+#endif // CORE_PORTME_H
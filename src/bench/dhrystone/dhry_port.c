@@ -0,0 +1,23 @@
+// Functions of the Dhrystone port (see dhry_port.h)
+
+static unsigned int time_calls = 0;
+
+// The first call starts the counters, the second one stops them
+long dhry_time() {
+    if (time_calls++ == 0) {
+        BENCH_START();
+    } else {
+        BENCH_STOP(0);
+    }
+    return time_calls;
+}
+
+// Two records are allocated by the program
+static long pool[64];
+static unsigned int pool_used = 0;
+
+char *dhry_malloc(unsigned int size) {
+    char *block = (char *)&pool[pool_used];
+    pool_used += (size + sizeof(long) - 1) / sizeof(long);
+    return block;
+}
@@ -0,0 +1,30 @@
+#ifndef DHRY_PORT_H
+#define DHRY_PORT_H
+
+// Dhrystone 2.1 port, included before each source file (the original sources are not modified)
+// Nothing is printed, cycles and instructions of the Number_Of_Runs loop are written by the
+//   testbench in perf_report.json (DMIPS/MHz = 1e6 / (1757 * cycles per run))
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bench.h"
+
+// Number of runs through the benchmark (read with scanf by the original program)
+#ifndef DHRY_RUNS
+#define DHRY_RUNS 100
+#endif
+
+// Output and input of the original program
+#define printf(...) 0
+#define scanf(fmt, n) (*(n) = DHRY_RUNS)
+
+// The measured loop is delimited by two calls to time() (TIME is defined by the makefile)
+#define time(t) dhry_time()
+long dhry_time();
+
+// Records are allocated from a static pool (there is no heap)
+#define malloc(size) dhry_malloc(size)
+char *dhry_malloc();
+
+#endif // DHRY_PORT_H
@@ -0,0 +1,47 @@
+#include "bench.h"
+
+// Copy bandwidth: a buffer is copied word by word REPEAT times
+// perf_report.json: bytes_per_cycle is the copy bandwidth (bytes read, also written)
+#ifndef BUF_SIZE
+#define BUF_SIZE 1024
+#endif
+#ifndef REPEAT
+#define REPEAT 8
+#endif
+#define WORDS (BUF_SIZE / 4)
+
+static unsigned int src[WORDS], dst[WORDS];
+
+// Loop unrolled 4 times, so that most of the instructions are loads and stores
+static void __attribute__((noinline)) copy_words(unsigned int *d, const unsigned int *s, unsigned int words) {
+    for (unsigned int i = 0; i < words; i += 4) {
+        unsigned int a = s[i];
+        unsigned int b = s[i+1];
+        unsigned int c = s[i+2];
+        unsigned int e = s[i+3];
+        d[i]   = a;
+        d[i+1] = b;
+        d[i+2] = c;
+        d[i+3] = e;
+    }
+}
+
+int main() {
+    int errors = 0;
+
+    for (unsigned int i = 0; i < WORDS; i++) {
+        src[i] = i * 0x01010101u;
+    }
+
+    BENCH_START();
+    for (int r = 0; r < REPEAT; r++) {
+        copy_words(dst, src, WORDS);
+    }
+    BENCH_STOP(REPEAT * BUF_SIZE);
+
+    // Return 0 if the copy is correct
+    for (unsigned int i = 0; i < WORDS; i++) {
+        errors += (dst[i] != src[i]);
+    }
+    return errors;
+}
@@ -0,0 +1,39 @@
+#include "bench.h"
+
+// Store bandwidth: a buffer is filled word by word REPEAT times
+// perf_report.json: bytes_per_cycle is the write bandwidth
+#ifndef BUF_SIZE
+#define BUF_SIZE 1024
+#endif
+#ifndef REPEAT
+#define REPEAT 8
+#endif
+#define WORDS (BUF_SIZE / 4)
+
+static unsigned int buf[WORDS];
+
+// Loop unrolled 4 times, so that most of the instructions are stores
+static void __attribute__((noinline)) set_words(unsigned int *d, unsigned int value, unsigned int words) {
+    for (unsigned int i = 0; i < words; i += 4) {
+        d[i]   = value;
+        d[i+1] = value;
+        d[i+2] = value;
+        d[i+3] = value;
+    }
+}
+
+int main() {
+    int errors = 0;
+
+    BENCH_START();
+    for (int r = 0; r < REPEAT; r++) {
+        set_words(buf, 0x5a5a0000u + r, WORDS);
+    }
+    BENCH_STOP(REPEAT * BUF_SIZE);
+
+    // Return 0 if the buffer holds the value of the last pass
+    for (unsigned int i = 0; i < WORDS; i++) {
+        errors += (buf[i] != 0x5a5a0000u + REPEAT - 1);
+    }
+    return errors;
+}
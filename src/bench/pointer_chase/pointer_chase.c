@@ -0,0 +1,56 @@
+#include "bench.h"
+
+// Load latency: each load reads the address of the next one, so loads cannot overlap
+// The nodes form a single random cycle over the buffer, so the accesses have no locality
+// perf_report.json: bytes/4 is the number of loads, cycles/(bytes/4) the average load-to-use latency
+#ifndef NODES
+#define NODES 256
+#endif
+#ifndef STEPS
+#define STEPS 2048
+#endif
+
+static void *nodes[NODES];
+
+// Pseudo-random numbers (linear congruential generator, same sequence on every run)
+static unsigned int seed = 12345;
+static unsigned int next_random(void) {
+    seed = seed * 1103515245u + 12345u;
+    return seed >> 8;
+}
+
+static void * __attribute__((noinline)) chase(void *p, unsigned int steps) {
+    for (unsigned int i = 0; i < steps; i += 4) {
+        p = *(void **)p;
+        p = *(void **)p;
+        p = *(void **)p;
+        p = *(void **)p;
+    }
+    return p;
+}
+
+int main() {
+    static unsigned int order[NODES];
+    void *end;
+
+    // Nodes in random order, each one points to the next in this order (single cycle)
+    for (unsigned int i = 0; i < NODES; i++) {
+        order[i] = i;
+    }
+    for (unsigned int i = NODES - 1; i > 0; i--) {
+        unsigned int j = next_random() % (i + 1);
+        unsigned int t = order[i];
+        order[i] = order[j];
+        order[j] = t;
+    }
+    for (unsigned int i = 0; i < NODES; i++) {
+        nodes[order[i]] = &nodes[order[(i + 1) % NODES]];
+    }
+
+    BENCH_START();
+    end = chase(&nodes[0], STEPS);
+    BENCH_STOP(STEPS * sizeof(void *));
+
+    // Return 0 if the walk has ended where expected (STEPS is a multiple of the cycle length)
+    return (STEPS % NODES == 0) ? (end != &nodes[0]) : 0;
+}
@@ -1,4 +1,7 @@
-module axi_2_hs(	
+module axi_2_hs #(
+	// Width of the transaction IDs
+	parameter ID_WIDTH=1
+	)(
 		input  clk_i,
 		input  rst_ni,
 	
@@ -7,28 +10,40 @@ module axi_2_hs(
 		input  arvalid_i,
 		output reg aready_o,
 		input  [31:0] araddr_i,
+		input  [7:0] arlen_i,
+		input  [2:0] arsize_i,
+		input  [1:0] arburst_i,
+		input  [ID_WIDTH-1:0] arid_i,
 
 		// Read Data (R) channel
 		output reg rvalid_o,
 		input  rready_i,
 		output [31:0] rdata_o,
 		output [1:0] rresp_o,
+		output rlast_o,
+		output [ID_WIDTH-1:0] rid_o,
 
 		// Write Address (AW) channel
 		input  awvalid_i,
 		output reg awready_o,
 		input  [31:0] awaddr_i,
+		input  [7:0] awlen_i,
+		input  [2:0] awsize_i,
+		input  [1:0] awburst_i,
+		input  [ID_WIDTH-1:0] awid_i,
 
 		// Write Data (W) channel
 		input  wvalid_i,
 		output reg wready_o,
 		input  [31:0] wdata_i,
 		input  [3:0] wstrb_i,
+		input  wlast_i,
 
 		// Write Response (B) channel
 		output reg bvalid_o,
 		input  bready_i,
 		output [1:0] bresp_o,
+		output [ID_WIDTH-1:0] bid_o,
 
 		// Handshake interface
 		output reg hs_read_o,
@@ -43,8 +58,41 @@ module axi_2_hs(
 // Registers to store address/data from axi interface
 reg [31:0] wdata_r, araddr_r, awaddr_r;
 reg [3:0] wstrb_r;
+reg wlast_r;
 reg wdata_reg_en_s, araddr_reg_en_s, awaddr_reg_en_s;
 
+// Registers to store burst information from axi interface
+reg [7:0] arlen_r, awlen_r;
+reg [2:0] arsize_r, awsize_r;
+reg [1:0] arburst_r, awburst_r;
+reg [ID_WIDTH-1:0] arid_r, awid_r;
+// Read beat counter
+reg [7:0] rbeat_cnt_r;
+// Move to next beat of the burst
+reg araddr_next_s, awaddr_next_s;
+
+// Address of the next beat of a burst
+function [31:0] burst_next_addr;
+	input [31:0] addr;
+	input [7:0] len;
+	input [2:0] size;
+	input [1:0] burst;
+	reg [31:0] incr_addr, wrap_mask;
+	begin
+		incr_addr = addr + (32'd1 << size);
+		// Wrapping bursts stay in a region as big as the whole burst (2, 4, 8 or 16 beats)
+		wrap_mask = ({24'd0, len} << size) | ((32'd1 << size) - 1);
+		case (burst)
+			// FIXED
+			2'b00   : burst_next_addr = addr;
+			// WRAP
+			2'b10   : burst_next_addr = (addr & ~wrap_mask) | (incr_addr & wrap_mask);
+			// INCR
+			default : burst_next_addr = incr_addr;
+		endcase
+	end
+endfunction
+
 // Register to store data from HS interface
 reg [31:0] rdata_r;
 reg rdata_reg_en_s;
@@ -104,14 +152,24 @@ always @(*) begin
 		R_TR : begin
 			if (rready_i) begin
 				// Master has sampled the data
-				next_state_s = IDLE;
+				if (rlast_o) begin
+					next_state_s = IDLE;
+				end else begin
+					// Read next beat of the burst
+					next_state_s = WAIT_SLV_R;
+				end
 			end
 		end
 
 		// Wait until slave writes data
 		WAIT_SLV_W : begin
 			if (hs_ready_i) begin
-				next_state_s = B_TR;
+				if (wlast_r) begin
+					next_state_s = B_TR;
+				end else begin
+					// Wait next beat of the burst
+					next_state_s = WAIT_W;
+				end
 			end
 		end
 
@@ -159,10 +217,15 @@ always @(*) begin
 	araddr_reg_en_s = 1'b1;
 	awaddr_reg_en_s = 1'b1;
 	rdata_reg_en_s  = 1'b0;
+	araddr_next_s   = 1'b0;
+	awaddr_next_s   = 1'b0;
 
 	case(current_state_r)
 		// Idle: wait for new request from hs interface
+		// Reads have priority, a write presented at the same time is not accepted
   		IDLE : begin
+			awready_o = !arvalid_i;
+			wready_o  = !arvalid_i;
 		end
 
 		// Wait until slave provvides data
@@ -185,6 +248,11 @@ always @(*) begin
 			awready_o = 1'b0;
 			wready_o  = 1'b0;
 			rvalid_o  = 1'b1;
+
+			wdata_reg_en_s  = 1'b0;
+			araddr_reg_en_s = 1'b0;
+			awaddr_reg_en_s = 1'b0;
+			araddr_next_s   = rready_i;
 		end
 
 		// Wait until slave writes data
@@ -198,6 +266,7 @@ always @(*) begin
 			wdata_reg_en_s  = 1'b0;
 			araddr_reg_en_s = 1'b0;
 			awaddr_reg_en_s = 1'b0;
+			awaddr_next_s   = hs_ready_i;
 		end
 
 		// Wait end of write address transfer
@@ -232,22 +301,47 @@ end
 // Registers to store data from axi interface
 always @(posedge clk_i) begin
 	if(rst_ni == 1'd0) begin
-		wdata_r  <= 32'd0;
-		wstrb_r  <= 4'd0;
-		araddr_r <= 32'd0;
-		awaddr_r <= 32'd0;
+		wdata_r   <= 32'd0;
+		wstrb_r   <= 4'd0;
+		wlast_r   <= 1'b0;
+		araddr_r  <= 32'd0;
+		arlen_r   <= 8'd0;
+		arsize_r  <= 3'd0;
+		arburst_r <= 2'd0;
+		arid_r    <= 'd0;
+		awaddr_r  <= 32'd0;
+		awlen_r   <= 8'd0;
+		awsize_r  <= 3'd0;
+		awburst_r <= 2'd0;
+		awid_r    <= 'd0;
+		rbeat_cnt_r <= 8'd0;
 	end else begin
 		if (wdata_reg_en_s == 1'b1) begin
 			wdata_r <= wdata_i;
 			wstrb_r <= wstrb_i;
+			wlast_r <= wlast_i;
 		end
 
 		if (araddr_reg_en_s == 1'b1) begin
-			araddr_r <= araddr_i;
-		end 
+			araddr_r    <= araddr_i;
+			arlen_r     <= arlen_i;
+			arsize_r    <= arsize_i;
+			arburst_r   <= arburst_i;
+			arid_r      <= arid_i;
+			rbeat_cnt_r <= 8'd0;
+		end else if (araddr_next_s == 1'b1) begin
+			araddr_r    <= burst_next_addr(araddr_r, arlen_r, arsize_r, arburst_r);
+			rbeat_cnt_r <= rbeat_cnt_r+1;
+		end
 		
 		if (awaddr_reg_en_s == 1'b1) begin
-			awaddr_r <= awaddr_i;
+			awaddr_r  <= awaddr_i;
+			awlen_r   <= awlen_i;
+			awsize_r  <= awsize_i;
+			awburst_r <= awburst_i;
+			awid_r    <= awid_i;
+		end else if (awaddr_next_s == 1'b1) begin
+			awaddr_r  <= burst_next_addr(awaddr_r, awlen_r, awsize_r, awburst_r);
 		end
 	end
 end
@@ -266,7 +360,11 @@ end
 //// Assign output values
 assign rdata_o = rdata_r;
 assign rresp_o = 2'd0;
+assign rlast_o = (rbeat_cnt_r == arlen_r) ? 1'b1 : 1'b0;
 assign bresp_o = 2'b0;
+// Responses carry the ID of the request
+assign rid_o = arid_r;
+assign bid_o = awid_r;
 assign hs_data_o = wdata_r;
 assign hs_addr_o = (hs_read_o) ? araddr_r : awaddr_r;
 assign byte_select_o = wstrb_r;
@@ -0,0 +1,99 @@
+module axi_arbiter #(
+	// Number of requesters
+	parameter N_REQ = 2,
+	// Arbitration policy
+	// 0: fixed priority (lower index wins), 1: round-robin, 2: weighted round-robin
+	parameter POLICY = 0,
+	// Weighted round-robin: consecutive grants of each requester before passing the turn (8 bits for each requester, at least 1)
+	parameter [(8*N_REQ)-1:0] WEIGHTS = {N_REQ{8'd1}},
+	// Width of the grant index (do not override)
+	parameter GNT_WIDTH = ($clog2(N_REQ) == 0) ? 1 : $clog2(N_REQ)
+	)(
+	input  clk_i,
+	input  rst_ni,
+
+	// Requests
+	input  [N_REQ-1:0] req_i,
+	// Granted request has been served
+	input  ack_i,
+
+	// Grant, kept stable until the request is served
+	output reg gnt_valid_o,
+	output reg [GNT_WIDTH-1:0] gnt_o
+);
+
+// Unpacked weights
+wire [7:0] WEIGHTS_UNPACKED [N_REQ-1:0];
+genvar w_idx;
+generate
+	for (w_idx = 0; w_idx < N_REQ; w_idx = w_idx + 1) begin : gen_weights
+		assign WEIGHTS_UNPACKED[w_idx] = WEIGHTS[(w_idx*8)+7:w_idx*8];
+	end
+endgenerate
+
+// Grant is locked until the request is served
+reg lock_r;
+reg [GNT_WIDTH-1:0] owner_r;
+// Last served requester and number of consecutive grants it has received
+reg [GNT_WIDTH-1:0] last_r;
+reg [7:0] served_r;
+// Requester with the highest priority
+reg [GNT_WIDTH-1:0] start_s;
+
+// Highest priority requester
+always @(*) begin
+	case (POLICY)
+		// Round-robin: the one after the last served
+		1 : start_s = (last_r == N_REQ-1) ? 'd0 : last_r+1;
+		// Weighted round-robin: the last served keeps the turn until its weight is consumed
+		2 : start_s = (served_r < WEIGHTS_UNPACKED[last_r]) ? last_r :
+		              (last_r == N_REQ-1) ? 'd0 : last_r+1;
+		// Fixed priority
+		default : start_s = 'd0;
+	endcase
+end
+
+// Grant of the first active request starting from the highest priority one
+always @(*) begin : a_gnt
+	integer i, idx;
+	gnt_o       = owner_r;
+	gnt_valid_o = lock_r;
+	if (!lock_r) begin
+		for (i = N_REQ-1; i >= 0; i = i - 1) begin
+			idx = start_s + i;
+			if (idx >= N_REQ) begin
+				idx = idx - N_REQ;
+			end
+			if (req_i[idx]) begin
+				gnt_o       = idx[GNT_WIDTH-1:0];
+				gnt_valid_o = 1'b1;
+			end
+		end
+	end
+end
+
+// Grant lock and turn update
+always @(posedge clk_i) begin
+	if (rst_ni == 1'b0) begin
+		lock_r   <= 1'b0;
+		owner_r  <= 'd0;
+		// First turn goes to requester 0
+		last_r   <= N_REQ-1;
+		served_r <= 8'hff;
+	end else begin
+		if (ack_i) begin
+			lock_r <= 1'b0;
+			last_r <= gnt_o;
+			if (gnt_o == last_r && served_r != 8'hff) begin
+				served_r <= served_r+1;
+			end else begin
+				served_r <= 8'd1;
+			end
+		end else if (gnt_valid_o) begin
+			lock_r  <= 1'b1;
+			owner_r <= gnt_o;
+		end
+	end
+end
+
+endmodule
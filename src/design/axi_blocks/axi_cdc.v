@@ -1,4 +1,7 @@
-module axi_cdc (	
+module axi_cdc #(
+		// Width of the transaction IDs
+		parameter ID_WIDTH=1
+		)(	
 		//// AXI master interface
 		input  m_clk_i,
 		input  m_rst_i,
@@ -6,23 +9,36 @@ module axi_cdc (
 		input  m_arvalid_i,
 		output m_aready_o,
 		input [31:0] m_araddr_i,
+		input [7:0] m_arlen_i,
+		input [2:0] m_arsize_i,
+		input [1:0] m_arburst_i,
+		input [ID_WIDTH-1:0] m_arid_i,
 		// Read Data (R) channel
 		output m_rvalid_o,
 		input  m_rready_i,
 		output [31:0] m_rdata_o,
 		output [1:0] m_rresp_o,
+		output m_rlast_o,
+		output [ID_WIDTH-1:0] m_rid_o,
 		// Write Address (AW) channel
 		input  m_awvalid_i,
 		output m_awready_o,
 		input  [31:0] m_awaddr_i,
+		input  [7:0] m_awlen_i,
+		input  [2:0] m_awsize_i,
+		input  [1:0] m_awburst_i,
+		input  [ID_WIDTH-1:0] m_awid_i,
 		// Write Data (W) channel
 		input  m_wvalid_i,
 		output m_wready_o,
 		input  [31:0] m_wdata_i,
+		input  [3:0] m_wstrb_i,
+		input  m_wlast_i,
 		// Write Response (B) channel
 		output m_bvalid_o,
 		input  m_bready_i,
 		output [1:0] m_bresp_o,
+		output [ID_WIDTH-1:0] m_bid_o,
 		
 		//// AXI slaves interface
 		input  s_clk_i,
@@ -31,214 +47,166 @@ module axi_cdc (
 		output s_arvalid_o,
 		input  s_aready_i,
 		output [31:0] s_araddr_o,
+		output [7:0] s_arlen_o,
+		output [2:0] s_arsize_o,
+		output [1:0] s_arburst_o,
+		output [ID_WIDTH-1:0] s_arid_o,
 		// Read Data (R) channel
 		input  s_rvalid_i,
 		output s_rready_o,
 		input  [31:0] s_rdata_i,
 		input  [1:0] s_rresp_i,
+		input  s_rlast_i,
+		input  [ID_WIDTH-1:0] s_rid_i,
 		// Write Address (AW) channel
 		output s_awvalid_o,
 		input  s_awready_i,
 		output [31:0] s_awaddr_o,
+		output [7:0] s_awlen_o,
+		output [2:0] s_awsize_o,
+		output [1:0] s_awburst_o,
+		output [ID_WIDTH-1:0] s_awid_o,
 		// Write Data (W) channel
 		output s_wvalid_o,
 		input  s_wready_i,
 		output [31:0] s_wdata_o,
+		output [3:0] s_wstrb_o,
+		output s_wlast_o,
 		// Write Response (B) channel
 		input  s_bvalid_i,
 		output s_bready_o,
-		input  [1:0] s_bresp_i
+		input  [1:0] s_bresp_i,
+		input  [ID_WIDTH-1:0] s_bid_i
 );
 
+// Every channel is a CDC fifo: a beat is written when valid and the fifo is not full,
+// so consecutive beats of a burst can be transferred without gaps
+
 //// Read Address (AR) channel CDC
-// m_arvalid_i and empty_wr_o rising edge detectors
-reg m_arvalid_r, fifo_ar_empty_wr_r;
-wire fifo_ar_wr_s, fifo_ar_empty_wr_s;
-always @(posedge m_clk_i) begin
-	if(m_rst_i == 1'd0) begin
-		m_arvalid_r  <= 1'b0;
-		fifo_ar_empty_wr_r <= 1'b0;
-	end else begin
-		m_arvalid_r  <= m_arvalid_i;
-		fifo_ar_empty_wr_r <= fifo_ar_empty_wr_s;
-	end
-end
-assign fifo_ar_wr_s = (m_arvalid_i && !m_arvalid_r);
-assign m_aready_o = (fifo_ar_empty_wr_s && !fifo_ar_empty_wr_r);
+wire fifo_ar_full_s;
+assign m_aready_o = !fifo_ar_full_s;
 // CDC fifo
 async_fifo  #(
 	.DEPTH(4),
-	.DATA_WIDTH(32)
+	.DATA_WIDTH(ID_WIDTH+32+8+3+2)
 	)
 	inst_async_fifo_ar (	
 	// Write port
 	.wr_clk_i(m_clk_i), 
 	.wr_rst_i(m_rst_i),
-	.wr_en_i(fifo_ar_wr_s),
-  	.wr_data_i(m_araddr_i),
-	.full_o(),
-	.empty_wr_o(fifo_ar_empty_wr_s),
+	.wr_en_i(m_arvalid_i),
+  	.wr_data_i({m_arid_i, m_arburst_i, m_arsize_i, m_arlen_i, m_araddr_i}),
+	.full_o(fifo_ar_full_s),
+	.empty_wr_o(),
 	// Read port
   	.rd_clk_i(s_clk_i), 
 	.rd_rst_i(s_rst_i),
   	.rd_en_i(s_aready_i),
-  	.rd_data_o(s_araddr_o),
+  	.rd_data_o({s_arid_o, s_arburst_o, s_arsize_o, s_arlen_o, s_araddr_o}),
   	.empty_o(),
 	.not_empty_o(s_arvalid_o)
 );
 
 
 //// Read Data (R) channel
-// s_rvalid_i and empty_wr_o edge detectors
-reg s_rvalid_r, fifo_r_empty_wr_r;
-wire fifo_r_wr_s, fifo_r_empty_wr_s;
-always @(posedge s_clk_i) begin
-	if(s_rst_i == 1'd0) begin
-		s_rvalid_r  <= 1'b0;
-		fifo_r_empty_wr_r <= 1'b0;
-	end else begin
-		s_rvalid_r  <= s_rvalid_i;
-		fifo_r_empty_wr_r <= fifo_r_empty_wr_s;
-	end
-end
-assign fifo_r_wr_s = (s_rvalid_i && !s_rvalid_r);
-assign s_rready_o = (fifo_r_empty_wr_s && !fifo_r_empty_wr_r);
-// Unpacking of rd_data
-wire [(32+2)-1:0] fifo_r_data_s;
-assign m_rresp_o = fifo_r_data_s[33:32];
-assign m_rdata_o = fifo_r_data_s[31:0];
+wire fifo_r_full_s;
+assign s_rready_o = !fifo_r_full_s;
 // CDC fifo
 async_fifo  #(
 	.DEPTH(4),
-	.DATA_WIDTH(32+2)
+	.DATA_WIDTH(ID_WIDTH+32+2+1)
 	)
 	inst_async_fifo_r (	
 	// Write port
 	.wr_clk_i(s_clk_i), 
 	.wr_rst_i(s_rst_i),
-	.wr_en_i(fifo_r_wr_s),
-  	.wr_data_i({s_rresp_i,s_rdata_i}),
-	.full_o(),
-	.empty_wr_o(fifo_r_empty_wr_s),
+	.wr_en_i(s_rvalid_i),
+  	.wr_data_i({s_rid_i, s_rlast_i, s_rresp_i, s_rdata_i}),
+	.full_o(fifo_r_full_s),
+	.empty_wr_o(),
 	// Read port
   	.rd_clk_i(m_clk_i), 
 	.rd_rst_i(m_rst_i),
   	.rd_en_i(m_rready_i),
-  	.rd_data_o(fifo_r_data_s),
+  	.rd_data_o({m_rid_o, m_rlast_o, m_rresp_o, m_rdata_o}),
   	.empty_o(),
 	.not_empty_o(m_rvalid_o)
 );
 
 
 //// Write Address (AW) channel CDC
-// m_awvalid_i and empty_wr_o rising edge detectors
-reg m_awvalid_r, fifo_aw_empty_wr_r;
-wire fifo_aw_wr_s, fifo_aw_empty_wr_s;
-always @(posedge m_clk_i) begin
-	if(m_rst_i == 1'd0) begin
-		m_awvalid_r  <= 1'b0;
-		fifo_aw_empty_wr_r <= 1'b0;
-	end else begin
-		m_awvalid_r  <= m_awvalid_i;
-		fifo_aw_empty_wr_r <= fifo_aw_empty_wr_s;
-	end
-end
-assign fifo_aw_wr_s = (m_awvalid_i && !m_awvalid_r);
-assign m_awready_o = (fifo_aw_empty_wr_s && !fifo_aw_empty_wr_r);
+wire fifo_aw_full_s;
+assign m_awready_o = !fifo_aw_full_s;
 // CDC fifo
 async_fifo  #(
 	.DEPTH(4),
-	.DATA_WIDTH(32)
+	.DATA_WIDTH(ID_WIDTH+32+8+3+2)
 	)
 	inst_async_fifo_aw (	
 	// Write port
 	.wr_clk_i(m_clk_i), 
 	.wr_rst_i(m_rst_i),
-	.wr_en_i(fifo_aw_wr_s),
-  	.wr_data_i(m_awaddr_i),
-	.full_o(),
-	.empty_wr_o(fifo_aw_empty_wr_s),
+	.wr_en_i(m_awvalid_i),
+  	.wr_data_i({m_awid_i, m_awburst_i, m_awsize_i, m_awlen_i, m_awaddr_i}),
+	.full_o(fifo_aw_full_s),
+	.empty_wr_o(),
 	// Read port
   	.rd_clk_i(s_clk_i), 
 	.rd_rst_i(s_rst_i),
   	.rd_en_i(s_awready_i),
-  	.rd_data_o(s_awaddr_o),
+  	.rd_data_o({s_awid_o, s_awburst_o, s_awsize_o, s_awlen_o, s_awaddr_o}),
   	.empty_o(),
 	.not_empty_o(s_awvalid_o)
 );
 
 
 //// Write Data (W) channel CDC
-// m_wvalid_i and empty_wr_o rising edge detectors
-reg m_wvalid_r, fifo_w_empty_wr_r;
-wire fifo_w_wr_s, fifo_w_empty_wr_s;
-always @(posedge m_clk_i) begin
-	if(m_rst_i == 1'd0) begin
-		m_wvalid_r  <= 1'b0;
-		fifo_w_empty_wr_r <= 1'b0;
-	end else begin
-		m_wvalid_r  <= m_wvalid_i;
-		fifo_w_empty_wr_r <= fifo_w_empty_wr_s;
-	end
-end
-assign fifo_w_wr_s = (m_wvalid_i && !m_wvalid_r);
-assign m_wready_o = (fifo_w_empty_wr_s && !fifo_w_empty_wr_r);
+wire fifo_w_full_s;
+assign m_wready_o = !fifo_w_full_s;
 // CDC fifo
 async_fifo  #(
 	.DEPTH(4),
-	.DATA_WIDTH(32)
+	.DATA_WIDTH(32+4+1)
 	)
 	inst_async_fifo_w (	
 	// Write port
 	.wr_clk_i(m_clk_i), 
 	.wr_rst_i(m_rst_i),
-	.wr_en_i(fifo_w_wr_s),
-  	.wr_data_i(m_wdata_i),
-	.full_o(),
-	.empty_wr_o(fifo_w_empty_wr_s),
+	.wr_en_i(m_wvalid_i),
+  	.wr_data_i({m_wlast_i, m_wstrb_i, m_wdata_i}),
+	.full_o(fifo_w_full_s),
+	.empty_wr_o(),
 	// Read port
   	.rd_clk_i(s_clk_i), 
 	.rd_rst_i(s_rst_i),
   	.rd_en_i(s_wready_i),
-  	.rd_data_o(s_wdata_o),
+  	.rd_data_o({s_wlast_o, s_wstrb_o, s_wdata_o}),
   	.empty_o(),
 	.not_empty_o(s_wvalid_o)
 );
 
 
 //// Write Response (B) channel
-// s_bvalid_i and empty_wr_o edge detectors
-reg s_bvalid_r, fifo_b_empty_wr_r;
-wire fifo_b_wr_s, fifo_b_empty_wr_s;
-always @(posedge s_clk_i) begin
-	if(s_rst_i == 1'd0) begin
-		s_bvalid_r  <= 1'b0;
-		fifo_b_empty_wr_r <= 1'b0;
-	end else begin
-		s_bvalid_r  <= s_bvalid_i;
-		fifo_b_empty_wr_r <= fifo_b_empty_wr_s;
-	end
-end
-assign fifo_b_wr_s = (s_bvalid_i && !s_bvalid_r);
-assign s_bready_o = (fifo_b_empty_wr_s && !fifo_b_empty_wr_r);
+wire fifo_b_full_s;
+assign s_bready_o = !fifo_b_full_s;
 // CDC fifo
 async_fifo  #(
 	.DEPTH(4),
-	.DATA_WIDTH(2)
+	.DATA_WIDTH(ID_WIDTH+2)
 	)
 	inst_async_fifo_b (	
 	// Write port
 	.wr_clk_i(s_clk_i), 
 	.wr_rst_i(s_rst_i),
-	.wr_en_i(fifo_b_wr_s),
-  	.wr_data_i(s_bresp_i),
-	.full_o(),
-	.empty_wr_o(fifo_b_empty_wr_s),
+	.wr_en_i(s_bvalid_i),
+  	.wr_data_i({s_bid_i, s_bresp_i}),
+	.full_o(fifo_b_full_s),
+	.empty_wr_o(),
 	// Read port
   	.rd_clk_i(m_clk_i), 
 	.rd_rst_i(m_rst_i),
   	.rd_en_i(m_bready_i),
-  	.rd_data_o(m_bresp_o),
+  	.rd_data_o({m_bid_o, m_bresp_o}),
   	.empty_o(),
 	.not_empty_o(m_bvalid_o)
 );
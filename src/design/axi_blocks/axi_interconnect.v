@@ -2,7 +2,24 @@ module axi_interconnect #(
 		parameter N_MST = 1,
 		parameter N_SLV = 4,
   		parameter [(32*N_SLV)-1:0] SLV_BASE_ADDRESSES = 'd0,
-		parameter [(32*N_SLV)-1:0] SLV_TOP_ADDRESSES  = 'd0
+		parameter [(32*N_SLV)-1:0] SLV_TOP_ADDRESSES  = 'd0,
+		// Slaves supporting only AXI-Lite (one bit for each slave)
+		// Bursts towards these slaves are split in single transfers
+		parameter [N_SLV-1:0] SLV_AXI_LITE = 'd0,
+		// Width of the transaction IDs of the master interfaces
+		parameter ID_WIDTH = 1,
+		// Width of the transaction IDs of the slave interfaces
+		// (index of the master is added on top of the master ID, do not override)
+		parameter SLV_ID_WIDTH = ID_WIDTH + (($clog2(N_MST) == 0) ? 1 : $clog2(N_MST)),
+		// Maximum number of outstanding reads and of outstanding writes of each master (8 bits for each master)
+		parameter [(8*N_MST)-1:0] MST_MAX_OUTSTANDING = {N_MST{8'd4}},
+		// Number of writes accepted by a slave and waiting for their data (power of 2, at least 2)
+		parameter W_ORDER_DEPTH = 4,
+		// Arbitration policy of the slaves address channels
+		// 0: fixed priority (lower master index wins), 1: round-robin, 2: weighted round-robin
+		parameter ARB_POLICY = 0,
+		// Weighted round-robin: consecutive grants of each master (8 bits for each master, at least 1)
+		parameter [(8*N_MST)-1:0] MST_WEIGHTS = {N_MST{8'd1}}
 		) (	
 		input  clk_i,
 		input  rst_ni,
@@ -12,352 +29,614 @@ module axi_interconnect #(
 		input  [N_MST-1:0] m_arvalid_i,
 		output reg [N_MST-1:0] m_aready_o,
 		input  [(32*N_MST)-1:0] m_araddr_i,
+		input  [(8*N_MST)-1:0] m_arlen_i,
+		input  [(3*N_MST)-1:0] m_arsize_i,
+		input  [(2*N_MST)-1:0] m_arburst_i,
+		input  [(ID_WIDTH*N_MST)-1:0] m_arid_i,
 
 		// Read Data (R) channel
 		output reg [N_MST-1:0] m_rvalid_o,
 		input  [N_MST-1:0] m_rready_i,
 		output [(32*N_MST)-1:0] m_rdata_o,
 		output [(2*N_MST)-1:0] m_rresp_o,
+		output reg [N_MST-1:0] m_rlast_o,
+		output [(ID_WIDTH*N_MST)-1:0] m_rid_o,
 
 		// Write Address (AW) channel
 		input  [N_MST-1:0] m_awvalid_i,
 		output reg [N_MST-1:0] m_awready_o,
 		input  [(32*N_MST)-1:0] m_awaddr_i,
+		input  [(8*N_MST)-1:0] m_awlen_i,
+		input  [(3*N_MST)-1:0] m_awsize_i,
+		input  [(2*N_MST)-1:0] m_awburst_i,
+		input  [(ID_WIDTH*N_MST)-1:0] m_awid_i,
 
 		// Write Data (W) channel
 		input  [N_MST-1:0] m_wvalid_i,
 		output reg [N_MST-1:0] m_wready_o,
 		input  [(32*N_MST)-1:0] m_wdata_i,
 		input  [(4*N_MST)-1:0] m_wstrb_i,
+		input  [N_MST-1:0] m_wlast_i,
 
 		// Write Response (B) channel
 		output reg [N_MST-1:0] m_bvalid_o,
 		input  [N_MST-1:0] m_bready_i,
 		output [(2*N_MST)-1:0] m_bresp_o,
+		output [(ID_WIDTH*N_MST)-1:0] m_bid_o,
 		
 		
 		//// AXI slaves interfaces
 		// Read Address (AR) channel
-		output reg [N_SLV-1:0] s_arvalid_o,
+		output [N_SLV-1:0] s_arvalid_o,
 		input  [N_SLV-1:0] s_aready_i,
 		output [(32*N_SLV)-1:0] s_araddr_o,
+		output [(8*N_SLV)-1:0] s_arlen_o,
+		output [(3*N_SLV)-1:0] s_arsize_o,
+		output [(2*N_SLV)-1:0] s_arburst_o,
+		output [(SLV_ID_WIDTH*N_SLV)-1:0] s_arid_o,
 
 		// Read Data (R) channel
 		input  [N_SLV-1:0] s_rvalid_i,
-		output reg [N_SLV-1:0] s_rready_o,
+		output [N_SLV-1:0] s_rready_o,
 		input  [(32*N_SLV)-1:0] s_rdata_i,
 		input  [(2*N_SLV)-1:0] s_rresp_i,
+		input  [N_SLV-1:0] s_rlast_i,
+		input  [(SLV_ID_WIDTH*N_SLV)-1:0] s_rid_i,
 
 		// Write Address (AW) channel
-		output reg [N_SLV-1:0] s_awvalid_o,
+		output [N_SLV-1:0] s_awvalid_o,
 		input  [N_SLV-1:0] s_awready_i,
 		output [(32*N_SLV)-1:0] s_awaddr_o,
+		output [(8*N_SLV)-1:0] s_awlen_o,
+		output [(3*N_SLV)-1:0] s_awsize_o,
+		output [(2*N_SLV)-1:0] s_awburst_o,
+		output [(SLV_ID_WIDTH*N_SLV)-1:0] s_awid_o,
 
 		// Write Data (W) channel
-		output reg [N_SLV-1:0] s_wvalid_o,
+		output [N_SLV-1:0] s_wvalid_o,
 		input  [N_SLV-1:0] s_wready_i,
 		output [(32*N_SLV)-1:0] s_wdata_o,
 		output [(4*N_SLV)-1:0] s_wstrb_o,
+		output [N_SLV-1:0] s_wlast_o,
 
 		// Write Response (B) channel
 		input  [N_SLV-1:0] s_bvalid_i,
-		output reg [N_SLV-1:0] s_bready_o,
-		input  [(2*N_SLV)-1:0] s_bresp_i
+		output [N_SLV-1:0] s_bready_o,
+		input  [(2*N_SLV)-1:0] s_bresp_i,
+		input  [(SLV_ID_WIDTH*N_SLV)-1:0] s_bid_i,
+
+		//// QoS statistics of the masters (32 bits for each master)
+		input  stat_clr_i,
+		// Completed transactions (reads and writes)
+		output [(32*N_MST)-1:0] m_stat_tr_cnt_o,
+		// Sum of the latencies of the completed and pending transactions,
+		// from address valid to last response (clock cycles)
+		output [(32*N_MST)-1:0] m_stat_lat_cnt_o,
+		// Maximum number of clock cycles an address has waited to be accepted
+		output [(32*N_MST)-1:0] m_stat_max_wait_o
 );
 
+localparam WIDTH_SLV = ($clog2(N_SLV) == 0) ? 1 : $clog2(N_SLV);
+localparam WIDTH_MST = ($clog2(N_MST) == 0) ? 1 : $clog2(N_MST);
+
 // Unpcked addresses for the slave interfaces
 wire [31:0] SLV_BASE_ADDRESSES_UNPACKED [N_SLV-1:0];
 wire [31:0] SLV_TOP_ADDRESSES_UNPACKED  [N_SLV-1:0];
+// Unpacked outstanding transactions limits
+wire [7:0]  MST_MAX_OUTSTANDING_UNPACKED [N_MST-1:0];
 
 // Unpacked arrays of master interfaces
-wire [31:0] m_araddr_i_unpacked [N_MST-1:0];
-reg  [31:0] m_rdata_o_unpacked  [N_MST-1:0];
-reg  [1:0]  m_rresp_o_unpacked  [N_MST-1:0];
-wire [31:0] m_awaddr_i_unpacked [N_MST-1:0];
-wire [31:0] m_wdata_i_unpacked  [N_MST-1:0];
-wire [3:0]  m_wstrb_i_unpacked  [N_MST-1:0];
-reg  [1:0]  m_bresp_o_unpacked  [N_MST-1:0];
-
-// Unpacked arrays of slave interfaces
-reg  [31:0] s_araddr_o_unpacked [N_SLV-1:0];
-wire [31:0] s_rdata_i_unpacked  [N_SLV-1:0];
-wire [1:0]  s_rresp_i_unpacked  [N_SLV-1:0];
-reg  [31:0] s_awaddr_o_unpacked [N_SLV-1:0];
-reg  [31:0] s_wdata_o_unpacked  [N_SLV-1:0];
-reg  [3:0]  s_wstrb_o_unpacked  [N_SLV-1:0];
-wire [1:0]  s_bresp_i_unpacked  [N_SLV-1:0];
+wire [31:0] m_araddr_i_unpacked  [N_MST-1:0];
+wire [7:0]  m_arlen_i_unpacked   [N_MST-1:0];
+wire [2:0]  m_arsize_i_unpacked  [N_MST-1:0];
+wire [1:0]  m_arburst_i_unpacked [N_MST-1:0];
+wire [ID_WIDTH-1:0] m_arid_i_unpacked [N_MST-1:0];
+reg  [31:0] m_rdata_o_unpacked   [N_MST-1:0];
+reg  [1:0]  m_rresp_o_unpacked   [N_MST-1:0];
+reg  [ID_WIDTH-1:0] m_rid_o_unpacked [N_MST-1:0];
+wire [31:0] m_awaddr_i_unpacked  [N_MST-1:0];
+wire [7:0]  m_awlen_i_unpacked   [N_MST-1:0];
+wire [2:0]  m_awsize_i_unpacked  [N_MST-1:0];
+wire [1:0]  m_awburst_i_unpacked [N_MST-1:0];
+wire [ID_WIDTH-1:0] m_awid_i_unpacked [N_MST-1:0];
+wire [31:0] m_wdata_i_unpacked   [N_MST-1:0];
+wire [3:0]  m_wstrb_i_unpacked   [N_MST-1:0];
+reg  [1:0]  m_bresp_o_unpacked   [N_MST-1:0];
+reg  [ID_WIDTH-1:0] m_bid_o_unpacked [N_MST-1:0];
+// QoS statistics of master interfaces
+reg  [31:0] stat_tr_cnt_r   [N_MST-1:0];
+reg  [31:0] stat_lat_cnt_r  [N_MST-1:0];
+reg  [31:0] stat_max_wait_r [N_MST-1:0];
+// Cycles the current read/write address of each master has been waiting
+reg  [31:0] stat_ar_wait_r  [N_MST-1:0];
+reg  [31:0] stat_aw_wait_r  [N_MST-1:0];
+
+// Slave side of the interconnect, before AXI-Lite adapters
+reg  [N_SLV-1:0] slv_arvalid_s;
+wire [N_SLV-1:0] slv_aready_s;
+reg  [31:0] slv_araddr_s  [N_SLV-1:0];
+reg  [7:0]  slv_arlen_s   [N_SLV-1:0];
+reg  [2:0]  slv_arsize_s  [N_SLV-1:0];
+reg  [1:0]  slv_arburst_s [N_SLV-1:0];
+reg  [SLV_ID_WIDTH-1:0] slv_arid_s [N_SLV-1:0];
+wire [N_SLV-1:0] slv_rvalid_s;
+reg  [N_SLV-1:0] slv_rready_s;
+wire [31:0] slv_rdata_s   [N_SLV-1:0];
+wire [1:0]  slv_rresp_s   [N_SLV-1:0];
+wire [N_SLV-1:0] slv_rlast_s;
+wire [SLV_ID_WIDTH-1:0] slv_rid_s [N_SLV-1:0];
+reg  [N_SLV-1:0] slv_awvalid_s;
+wire [N_SLV-1:0] slv_awready_s;
+reg  [31:0] slv_awaddr_s  [N_SLV-1:0];
+reg  [7:0]  slv_awlen_s   [N_SLV-1:0];
+reg  [2:0]  slv_awsize_s  [N_SLV-1:0];
+reg  [1:0]  slv_awburst_s [N_SLV-1:0];
+reg  [SLV_ID_WIDTH-1:0] slv_awid_s [N_SLV-1:0];
+reg  [N_SLV-1:0] slv_wvalid_s;
+wire [N_SLV-1:0] slv_wready_s;
+reg  [31:0] slv_wdata_s   [N_SLV-1:0];
+reg  [3:0]  slv_wstrb_s   [N_SLV-1:0];
+reg  [N_SLV-1:0] slv_wlast_s;
+wire [N_SLV-1:0] slv_bvalid_s;
+reg  [N_SLV-1:0] slv_bready_s;
+wire [1:0]  slv_bresp_s   [N_SLV-1:0];
+wire [SLV_ID_WIDTH-1:0] slv_bid_s [N_SLV-1:0];
 
 // Packing/Unpacking of master interfaces
 genvar mst_pck;
 generate
 	for (mst_pck = 0; mst_pck < N_MST; mst_pck = mst_pck + 1) begin : gen_mst_pack
+		// Unpacking of parameters
+		assign MST_MAX_OUTSTANDING_UNPACKED[mst_pck] = MST_MAX_OUTSTANDING[(mst_pck*8)+7:mst_pck*8];
 		// Unpacking of inputs
-		assign m_araddr_i_unpacked[mst_pck] = m_araddr_i[(mst_pck*32)+31:mst_pck*32];
-		assign m_awaddr_i_unpacked[mst_pck] = m_awaddr_i[(mst_pck*32)+31:mst_pck*32];
-		assign m_wdata_i_unpacked[mst_pck]  = m_wdata_i[(mst_pck*32)+31:mst_pck*32];
-		assign m_wstrb_i_unpacked[mst_pck]  = m_wstrb_i[(mst_pck*4)+3:mst_pck*4];
+		assign m_araddr_i_unpacked[mst_pck]  = m_araddr_i[(mst_pck*32)+31:mst_pck*32];
+		assign m_arlen_i_unpacked[mst_pck]   = m_arlen_i[(mst_pck*8)+7:mst_pck*8];
+		assign m_arsize_i_unpacked[mst_pck]  = m_arsize_i[(mst_pck*3)+2:mst_pck*3];
+		assign m_arburst_i_unpacked[mst_pck] = m_arburst_i[(mst_pck*2)+1:mst_pck*2];
+		assign m_arid_i_unpacked[mst_pck]    = m_arid_i[(mst_pck*ID_WIDTH)+ID_WIDTH-1:mst_pck*ID_WIDTH];
+		assign m_awaddr_i_unpacked[mst_pck]  = m_awaddr_i[(mst_pck*32)+31:mst_pck*32];
+		assign m_awlen_i_unpacked[mst_pck]   = m_awlen_i[(mst_pck*8)+7:mst_pck*8];
+		assign m_awsize_i_unpacked[mst_pck]  = m_awsize_i[(mst_pck*3)+2:mst_pck*3];
+		assign m_awburst_i_unpacked[mst_pck] = m_awburst_i[(mst_pck*2)+1:mst_pck*2];
+		assign m_awid_i_unpacked[mst_pck]    = m_awid_i[(mst_pck*ID_WIDTH)+ID_WIDTH-1:mst_pck*ID_WIDTH];
+		assign m_wdata_i_unpacked[mst_pck]   = m_wdata_i[(mst_pck*32)+31:mst_pck*32];
+		assign m_wstrb_i_unpacked[mst_pck]   = m_wstrb_i[(mst_pck*4)+3:mst_pck*4];
 		// Packing of outputs
 		assign m_rdata_o[(mst_pck*32)+31:mst_pck*32] = m_rdata_o_unpacked[mst_pck];
 		assign m_rresp_o[(mst_pck*2)+1:mst_pck*2]    = m_rresp_o_unpacked[mst_pck];
+		assign m_rid_o[(mst_pck*ID_WIDTH)+ID_WIDTH-1:mst_pck*ID_WIDTH] = m_rid_o_unpacked[mst_pck];
 		assign m_bresp_o[(mst_pck*2)+1:mst_pck*2]    = m_bresp_o_unpacked[mst_pck];
+		assign m_bid_o[(mst_pck*ID_WIDTH)+ID_WIDTH-1:mst_pck*ID_WIDTH] = m_bid_o_unpacked[mst_pck];
+		assign m_stat_tr_cnt_o[(mst_pck*32)+31:mst_pck*32]   = stat_tr_cnt_r[mst_pck];
+		assign m_stat_lat_cnt_o[(mst_pck*32)+31:mst_pck*32]  = stat_lat_cnt_r[mst_pck];
+		assign m_stat_max_wait_o[(mst_pck*32)+31:mst_pck*32] = stat_max_wait_r[mst_pck];
 	end
 endgenerate
 
 // Packing/Unpacking of slave interfaces
+// AXI-Lite slaves are connected through an adapter, other slaves directly
 genvar slv_pck;
 generate
 	for (slv_pck = 0; slv_pck < N_SLV; slv_pck = slv_pck + 1) begin : gen_slv_pack
 		// Unpacking of addresses
 		assign SLV_BASE_ADDRESSES_UNPACKED[slv_pck] = SLV_BASE_ADDRESSES[(slv_pck*32)+31:slv_pck*32];
 		assign SLV_TOP_ADDRESSES_UNPACKED[slv_pck]  = SLV_TOP_ADDRESSES[(slv_pck*32)+31:slv_pck*32];
-		// Unpacking of inputs
-		assign s_rdata_i_unpacked[slv_pck] = s_rdata_i[(slv_pck*32)+31:slv_pck*32];
-		assign s_rresp_i_unpacked[slv_pck] = s_rresp_i[(slv_pck*2)+1:slv_pck*2];
-		assign s_bresp_i_unpacked[slv_pck] = s_bresp_i[(slv_pck*2)+1:slv_pck*2];
-		// Packing of outputs
-		assign s_araddr_o[(slv_pck*32)+31:slv_pck*32] = s_araddr_o_unpacked[slv_pck];
-		assign s_awaddr_o[(slv_pck*32)+31:slv_pck*32] = s_awaddr_o_unpacked[slv_pck];
-		assign s_wdata_o[(slv_pck*32)+31:slv_pck*32]  = s_wdata_o_unpacked[slv_pck];
-		assign s_wstrb_o[(slv_pck*4)+3:slv_pck*4]     = s_wstrb_o_unpacked[slv_pck];
-	end
-endgenerate
-
 
-// Signals and encoding for FSM status
-reg [3:0] current_state_r [N_MST-1:0];
-reg [3:0] next_state_s [N_MST-1:0];
-localparam IDLE    = 4'd0;
-localparam AR_TR   = 4'd1;
-localparam R_TR    = 4'd2;
-localparam W_TR    = 4'd3;
-localparam WAIT_AW = 4'd4;
-localparam WAIT_W  = 4'd5;
-localparam B_TR    = 4'd6;
-
-// Signals to indicate if a slave is busy
-reg [N_MST-1:0] slv_sel_s [N_SLV-1:0];
-reg [N_MST-1:0] slv_clr_s [N_SLV-1:0];
-reg [N_SLV-1:0] slv_busy_r;
-
-// Register to store the slave selected by each master
-localparam WIDTH_SLV = ($clog2(N_SLV) == 0) ? 1 : $clog2(N_SLV);
-reg [WIDTH_SLV-1:0] selected_slv_r [N_MST-1:0];
-
-// Register to store wich master has selected a slave
-localparam WIDTH_MST = ($clog2(N_MST) == 0) ? 1 : $clog2(N_MST);
-reg [WIDTH_MST-1:0] selecting_mst_r [N_SLV-1:0];
-
-// Other registers
-always @(posedge clk_i) begin : a_regs
-	integer i, j;
-	if(rst_ni == 1'd0) begin
-		slv_busy_r <= 'b0;
-		for (i = 0; i < N_MST; i = i + 1) begin
-			selected_slv_r[i] <= 'b0;
-		end
-		for (i = 0; i < N_SLV; i = i + 1) begin
-			selecting_mst_r[i] <= 'b0;
-		end
-	end else begin
-		// Update slaves busy/selected flags 
-		for (i = 0; i < N_SLV; i = i + 1) begin
-			for (j = 0; j < N_MST; j = j + 1) begin
-				if (slv_sel_s[i][j]) begin
-					slv_busy_r[i] <= 'b1;
-					selected_slv_r[j] <= i[WIDTH_SLV-1:0];
-					selecting_mst_r[i] <= j[WIDTH_MST-1:0];
-				end else if (slv_clr_s[i][j]) begin
-					slv_busy_r[i] <= 'b0;
-					selected_slv_r[j] <= 'b0;
-					selecting_mst_r[i] <= 'b0;
-				end
-			end
+		if (SLV_AXI_LITE[slv_pck]) begin : gen_lite
+			axi_lite_adapter #(
+				.ID_WIDTH(SLV_ID_WIDTH)
+				)
+				inst_axi_lite_adapter (
+				.clk_i(clk_i),
+				.rst_ni(rst_ni),
+				//// AXI4 slave interface
+				// Read Address (AR) channel
+				.s_arvalid_i(slv_arvalid_s[slv_pck]),
+				.s_aready_o(slv_aready_s[slv_pck]),
+				.s_araddr_i(slv_araddr_s[slv_pck]),
+				.s_arlen_i(slv_arlen_s[slv_pck]),
+				.s_arsize_i(slv_arsize_s[slv_pck]),
+				.s_arburst_i(slv_arburst_s[slv_pck]),
+				.s_arid_i(slv_arid_s[slv_pck]),
+				// Read Data (R) channel
+				.s_rvalid_o(slv_rvalid_s[slv_pck]),
+				.s_rready_i(slv_rready_s[slv_pck]),
+				.s_rdata_o(slv_rdata_s[slv_pck]),
+				.s_rresp_o(slv_rresp_s[slv_pck]),
+				.s_rlast_o(slv_rlast_s[slv_pck]),
+				.s_rid_o(slv_rid_s[slv_pck]),
+				// Write Address (AW) channel
+				.s_awvalid_i(slv_awvalid_s[slv_pck]),
+				.s_awready_o(slv_awready_s[slv_pck]),
+				.s_awaddr_i(slv_awaddr_s[slv_pck]),
+				.s_awlen_i(slv_awlen_s[slv_pck]),
+				.s_awsize_i(slv_awsize_s[slv_pck]),
+				.s_awburst_i(slv_awburst_s[slv_pck]),
+				.s_awid_i(slv_awid_s[slv_pck]),
+				// Write Data (W) channel
+				.s_wvalid_i(slv_wvalid_s[slv_pck]),
+				.s_wready_o(slv_wready_s[slv_pck]),
+				.s_wdata_i(slv_wdata_s[slv_pck]),
+				.s_wstrb_i(slv_wstrb_s[slv_pck]),
+				.s_wlast_i(slv_wlast_s[slv_pck]),
+				// Write Response (B) channel
+				.s_bvalid_o(slv_bvalid_s[slv_pck]),
+				.s_bready_i(slv_bready_s[slv_pck]),
+				.s_bresp_o(slv_bresp_s[slv_pck]),
+				.s_bid_o(slv_bid_s[slv_pck]),
+				//// AXI-Lite master interface
+				// Read Address (AR) channel
+				.m_arvalid_o(s_arvalid_o[slv_pck]),
+				.m_aready_i(s_aready_i[slv_pck]),
+				.m_araddr_o(s_araddr_o[(slv_pck*32)+31:slv_pck*32]),
+				// Read Data (R) channel
+				.m_rvalid_i(s_rvalid_i[slv_pck]),
+				.m_rready_o(s_rready_o[slv_pck]),
+				.m_rdata_i(s_rdata_i[(slv_pck*32)+31:slv_pck*32]),
+				.m_rresp_i(s_rresp_i[(slv_pck*2)+1:slv_pck*2]),
+				// Write Address (AW) channel
+				.m_awvalid_o(s_awvalid_o[slv_pck]),
+				.m_awready_i(s_awready_i[slv_pck]),
+				.m_awaddr_o(s_awaddr_o[(slv_pck*32)+31:slv_pck*32]),
+				// Write Data (W) channel
+				.m_wvalid_o(s_wvalid_o[slv_pck]),
+				.m_wready_i(s_wready_i[slv_pck]),
+				.m_wdata_o(s_wdata_o[(slv_pck*32)+31:slv_pck*32]),
+				.m_wstrb_o(s_wstrb_o[(slv_pck*4)+3:slv_pck*4]),
+				// Write Response (B) channel
+				.m_bvalid_i(s_bvalid_i[slv_pck]),
+				.m_bready_o(s_bready_o[slv_pck]),
+				.m_bresp_i(s_bresp_i[(slv_pck*2)+1:slv_pck*2])
+			);
+			// Single transfers only, IDs are handled by the adapter
+			assign s_arid_o[(slv_pck*SLV_ID_WIDTH)+SLV_ID_WIDTH-1:slv_pck*SLV_ID_WIDTH] = 'd0;
+			assign s_awid_o[(slv_pck*SLV_ID_WIDTH)+SLV_ID_WIDTH-1:slv_pck*SLV_ID_WIDTH] = 'd0;
+			assign s_arlen_o[(slv_pck*8)+7:slv_pck*8]   = 8'd0;
+			assign s_arsize_o[(slv_pck*3)+2:slv_pck*3]  = 3'd2;
+			assign s_arburst_o[(slv_pck*2)+1:slv_pck*2] = 2'b01;
+			assign s_awlen_o[(slv_pck*8)+7:slv_pck*8]   = 8'd0;
+			assign s_awsize_o[(slv_pck*3)+2:slv_pck*3]  = 3'd2;
+			assign s_awburst_o[(slv_pck*2)+1:slv_pck*2] = 2'b01;
+			assign s_wlast_o[slv_pck] = 1'b1;
+		end else begin : gen_full
+			// Unpacking of inputs
+			assign slv_aready_s[slv_pck]  = s_aready_i[slv_pck];
+			assign slv_rvalid_s[slv_pck]  = s_rvalid_i[slv_pck];
+			assign slv_rdata_s[slv_pck]   = s_rdata_i[(slv_pck*32)+31:slv_pck*32];
+			assign slv_rresp_s[slv_pck]   = s_rresp_i[(slv_pck*2)+1:slv_pck*2];
+			assign slv_rlast_s[slv_pck]   = s_rlast_i[slv_pck];
+			assign slv_rid_s[slv_pck]     = s_rid_i[(slv_pck*SLV_ID_WIDTH)+SLV_ID_WIDTH-1:slv_pck*SLV_ID_WIDTH];
+			assign slv_awready_s[slv_pck] = s_awready_i[slv_pck];
+			assign slv_wready_s[slv_pck]  = s_wready_i[slv_pck];
+			assign slv_bvalid_s[slv_pck]  = s_bvalid_i[slv_pck];
+			assign slv_bresp_s[slv_pck]   = s_bresp_i[(slv_pck*2)+1:slv_pck*2];
+			assign slv_bid_s[slv_pck]     = s_bid_i[(slv_pck*SLV_ID_WIDTH)+SLV_ID_WIDTH-1:slv_pck*SLV_ID_WIDTH];
+			// Packing of outputs
+			assign s_arvalid_o[slv_pck] = slv_arvalid_s[slv_pck];
+			assign s_araddr_o[(slv_pck*32)+31:slv_pck*32] = slv_araddr_s[slv_pck];
+			assign s_arlen_o[(slv_pck*8)+7:slv_pck*8]     = slv_arlen_s[slv_pck];
+			assign s_arsize_o[(slv_pck*3)+2:slv_pck*3]    = slv_arsize_s[slv_pck];
+			assign s_arburst_o[(slv_pck*2)+1:slv_pck*2]   = slv_arburst_s[slv_pck];
+			assign s_arid_o[(slv_pck*SLV_ID_WIDTH)+SLV_ID_WIDTH-1:slv_pck*SLV_ID_WIDTH] = slv_arid_s[slv_pck];
+			assign s_rready_o[slv_pck]  = slv_rready_s[slv_pck];
+			assign s_awvalid_o[slv_pck] = slv_awvalid_s[slv_pck];
+			assign s_awaddr_o[(slv_pck*32)+31:slv_pck*32] = slv_awaddr_s[slv_pck];
+			assign s_awlen_o[(slv_pck*8)+7:slv_pck*8]     = slv_awlen_s[slv_pck];
+			assign s_awsize_o[(slv_pck*3)+2:slv_pck*3]    = slv_awsize_s[slv_pck];
+			assign s_awburst_o[(slv_pck*2)+1:slv_pck*2]   = slv_awburst_s[slv_pck];
+			assign s_awid_o[(slv_pck*SLV_ID_WIDTH)+SLV_ID_WIDTH-1:slv_pck*SLV_ID_WIDTH] = slv_awid_s[slv_pck];
+			assign s_wvalid_o[slv_pck]  = slv_wvalid_s[slv_pck];
+			assign s_wdata_o[(slv_pck*32)+31:slv_pck*32]  = slv_wdata_s[slv_pck];
+			assign s_wstrb_o[(slv_pck*4)+3:slv_pck*4]     = slv_wstrb_s[slv_pck];
+			assign s_wlast_o[slv_pck]   = slv_wlast_s[slv_pck];
+			assign s_bready_o[slv_pck]  = slv_bready_s[slv_pck];
 		end
 	end
-end
+endgenerate
 
-// Generation of FSMs towards master interfaces
-genvar mst_fsm;
+/* ---------------------------------------------------
+* Outstanding transactions tracking
+* Read and write channels are independent. The outstanding transactions of
+*   a master on each direction must target the same slave, so its responses
+*   always come from a single slave and in order
+* --------------------------------------------------*/
+// Slave decoded from the addresses of each master
+reg [WIDTH_SLV-1:0] ar_dec_s [N_MST-1:0];
+reg [WIDTH_SLV-1:0] aw_dec_s [N_MST-1:0];
+reg [N_MST-1:0] ar_hit_s, aw_hit_s;
+// Number of outstanding transactions of each master, and slave they are directed to
+reg [7:0] rd_cnt_r [N_MST-1:0];
+reg [7:0] wr_cnt_r [N_MST-1:0];
+reg [WIDTH_SLV-1:0] rd_slv_r [N_MST-1:0];
+reg [WIDTH_SLV-1:0] wr_slv_r [N_MST-1:0];
+// A new transaction of the master can be forwarded to the decoded slave
+reg [N_MST-1:0] ar_allowed_s, aw_allowed_s;
+
+// Address channels arbitration of each slave
+reg [N_MST-1:0] ar_req_s [N_SLV-1:0];
+reg [N_MST-1:0] aw_req_s [N_SLV-1:0];
+wire [WIDTH_MST-1:0] ar_gnt_s [N_SLV-1:0];
+wire [WIDTH_MST-1:0] aw_gnt_s [N_SLV-1:0];
+wire [N_SLV-1:0] ar_gnt_valid_s, aw_gnt_valid_s;
+// Masters owning the write data channel of each slave (in write address order)
+wire [N_SLV-1:0] w_order_full_s, w_order_not_empty_s;
+wire [WIDTH_MST-1:0] w_owner_s [N_SLV-1:0];
+// Masters the responses of each slave are directed to (MSBs of the ID)
+wire [WIDTH_MST-1:0] r_dst_s [N_SLV-1:0];
+wire [WIDTH_MST-1:0] b_dst_s [N_SLV-1:0];
+
+// Logic towards master interfaces
+genvar mst_idx;
 generate
-	for (mst_fsm = 0; mst_fsm < N_MST; mst_fsm = mst_fsm + 1) begin : gen_mst_fsm
+	for (mst_idx = 0; mst_idx < N_MST; mst_idx = mst_idx + 1) begin : gen_mst
 
-		// Calculating if another master with higher priority (lowest index) has selected a slave
-		reg [N_SLV-1:0] master_prio_s;
-		always @(*) begin : a_master_prio
+		// Slave address decoding
+		always @(*) begin : a_mst_dec
 			integer i;
+			ar_hit_s[mst_idx] = 1'b0;
+			ar_dec_s[mst_idx] = 'd0;
+			aw_hit_s[mst_idx] = 1'b0;
+			aw_dec_s[mst_idx] = 'd0;
 			for (i = 0; i < N_SLV; i = i + 1) begin
-				master_prio_s[i] = ((slv_sel_s[i] & ((1<<mst_fsm)-1)) == 'd0) ? 1'b0 : 1'b1;
+				if (m_araddr_i_unpacked[mst_idx] >= SLV_BASE_ADDRESSES_UNPACKED[i] && m_araddr_i_unpacked[mst_idx] <= SLV_TOP_ADDRESSES_UNPACKED[i]) begin
+					ar_hit_s[mst_idx] = 1'b1;
+					ar_dec_s[mst_idx] = i[WIDTH_SLV-1:0];
+				end
+				if (m_awaddr_i_unpacked[mst_idx] >= SLV_BASE_ADDRESSES_UNPACKED[i] && m_awaddr_i_unpacked[mst_idx] <= SLV_TOP_ADDRESSES_UNPACKED[i]) begin
+					aw_hit_s[mst_idx] = 1'b1;
+					aw_dec_s[mst_idx] = i[WIDTH_SLV-1:0];
+				end
 			end
 		end
 
-		// FSM present state update
+		// New transactions are accepted while below the outstanding limit and towards the same slave
+		// Write transactions also need space in the write data order queue of the slave
+		always @(*) begin
+			ar_allowed_s[mst_idx] = ar_hit_s[mst_idx] &&
+			                        (rd_cnt_r[mst_idx] == 'd0 || (rd_slv_r[mst_idx] == ar_dec_s[mst_idx] && rd_cnt_r[mst_idx] < MST_MAX_OUTSTANDING_UNPACKED[mst_idx]));
+			aw_allowed_s[mst_idx] = aw_hit_s[mst_idx] && !w_order_full_s[aw_dec_s[mst_idx]] &&
+			                        (wr_cnt_r[mst_idx] == 'd0 || (wr_slv_r[mst_idx] == aw_dec_s[mst_idx] && wr_cnt_r[mst_idx] < MST_MAX_OUTSTANDING_UNPACKED[mst_idx]));
+		end
+
+		// Outstanding transactions counters
+		// A transaction starts with the address transfer and ends with the last read beat / write response
 		always @(posedge clk_i) begin
 			if(rst_ni == 1'd0) begin
-				current_state_r[mst_fsm] <= IDLE;
+				rd_cnt_r[mst_idx] <= 'd0;
+				rd_slv_r[mst_idx] <= 'd0;
+				wr_cnt_r[mst_idx] <= 'd0;
+				wr_slv_r[mst_idx] <= 'd0;
 			end else begin
-				current_state_r[mst_fsm] <= next_state_s[mst_fsm];
-			end
-		end
-
-		// FSM next state calculation
-		always @(*) begin : a_mst_fsm
-			integer i;
-			// Default next state
-			next_state_s[mst_fsm] = current_state_r[mst_fsm];
-			// Do not select/clear any slave by default
-			for (i = 0; i < N_SLV; i = i + 1) begin
-				slv_sel_s[i][mst_fsm] = 1'b0;
-				slv_clr_s[i][mst_fsm] = 1'b0;
-			end
-
-			case(current_state_r[mst_fsm])
-				// Idle: wait for new request from master interface
-				IDLE : begin
-					if (m_arvalid_i[mst_fsm]) begin
-						// Master requesting read transaction
-						// Decode slave address
-						for (i = 0; i < N_SLV; i = i + 1) begin
-							if (m_araddr_i_unpacked[mst_fsm] >= SLV_BASE_ADDRESSES_UNPACKED[i] && m_araddr_i_unpacked[mst_fsm] <= SLV_TOP_ADDRESSES_UNPACKED[i]) begin
-								// Check if slave is not busy and not selected by higher priority master
-								if (slv_busy_r[i] == 1'b0 && master_prio_s[i] == 1'b0) begin
-									// Mark slave as busy
-									slv_sel_s[i][mst_fsm] = 1'b1;
-									// Start read transaction
-									next_state_s[mst_fsm] = AR_TR;
-								end // if (slv_busy_r[i] == 1'b0 && ...
-							end // if (m_araddr_i_unpacked[mst_fsm][...
-						end // for (i = 0; i < N_SLV; i = i + 1)
-					end else if (m_awvalid_i[mst_fsm]) begin
-						// Master requesting write transaction
-						for (i = 0; i < N_SLV; i = i + 1) begin
-							if (m_awaddr_i_unpacked[mst_fsm] >= SLV_BASE_ADDRESSES_UNPACKED[i] && m_awaddr_i_unpacked[mst_fsm] <= SLV_TOP_ADDRESSES_UNPACKED[i]) begin
-								// Check if slave is not busy and not selected by higher priority master
-								if (slv_busy_r[i] == 1'b0 && master_prio_s[i] == 1'b0) begin
-									// Mark slave as busy
-									slv_sel_s[i][mst_fsm] = 1'b1;
-									// Start write transaction
-									next_state_s[mst_fsm] = W_TR;	
-								end // if (slv_busy_r[i] == 1'b0 && ...
-							end // if (m_awaddr_i_unpacked[mst_fsm][...
-						end // for (i = 0; i < N_SLV; i = i + 1)
-					end // if (m_arvalid_i[mst_fsm])
-				end // IDLE
-				
-				// Read address transfer
-				AR_TR : begin
-					if (s_aready_i[selected_slv_r[mst_fsm]] && m_arvalid_i[mst_fsm]) begin
-						next_state_s[mst_fsm] = R_TR;
-					end
+				if (m_arvalid_i[mst_idx] && m_aready_o[mst_idx]) begin
+					rd_slv_r[mst_idx] <= ar_dec_s[mst_idx];
 				end
-
-				// Read data transfer
-				R_TR : begin
-					if (s_rvalid_i[selected_slv_r[mst_fsm]] && m_rready_i[mst_fsm]) begin
-						next_state_s[mst_fsm] = IDLE;
-						// Clear slave busy flag
-						slv_clr_s[selected_slv_r[mst_fsm]][mst_fsm] = 1'b1;
-					end
+				if ((m_arvalid_i[mst_idx] && m_aready_o[mst_idx]) && !(m_rvalid_o[mst_idx] && m_rready_i[mst_idx] && m_rlast_o[mst_idx])) begin
+					rd_cnt_r[mst_idx] <= rd_cnt_r[mst_idx]+1;
+				end else if (!(m_arvalid_i[mst_idx] && m_aready_o[mst_idx]) && (m_rvalid_o[mst_idx] && m_rready_i[mst_idx] && m_rlast_o[mst_idx])) begin
+					rd_cnt_r[mst_idx] <= rd_cnt_r[mst_idx]-1;
 				end
 
-				// Write address/data transfer
-				W_TR : begin
-					// Check if one or both transfers have ended
-					if (s_awready_i[selected_slv_r[mst_fsm]] && m_awvalid_i[mst_fsm] &&
-					    	s_wready_i[selected_slv_r[mst_fsm]] && m_wvalid_i[mst_fsm]) begin
-						next_state_s[mst_fsm] = B_TR;
-					end else if (s_awready_i[selected_slv_r[mst_fsm]] && m_awvalid_i[mst_fsm]) begin
-						next_state_s[mst_fsm] = WAIT_W;
-					end else if (s_wready_i[selected_slv_r[mst_fsm]] && m_wvalid_i[mst_fsm]) begin
-						next_state_s[mst_fsm] = WAIT_AW;
-					end
+				if (m_awvalid_i[mst_idx] && m_awready_o[mst_idx]) begin
+					wr_slv_r[mst_idx] <= aw_dec_s[mst_idx];
 				end
-				
-				// Wait end of write address transfer
-				WAIT_AW : begin
-					if (s_awready_i[selected_slv_r[mst_fsm]] && m_awvalid_i[mst_fsm]) begin
-						next_state_s[mst_fsm] = B_TR;
-					end
+				if ((m_awvalid_i[mst_idx] && m_awready_o[mst_idx]) && !(m_bvalid_o[mst_idx] && m_bready_i[mst_idx])) begin
+					wr_cnt_r[mst_idx] <= wr_cnt_r[mst_idx]+1;
+				end else if (!(m_awvalid_i[mst_idx] && m_awready_o[mst_idx]) && (m_bvalid_o[mst_idx] && m_bready_i[mst_idx])) begin
+					wr_cnt_r[mst_idx] <= wr_cnt_r[mst_idx]-1;
 				end
+			end
+		end
 
-				// Wait end of write data transfer
-				WAIT_W : begin
-					if (s_wready_i[selected_slv_r[mst_fsm]] && m_wvalid_i[mst_fsm]) begin
-						next_state_s[mst_fsm] = B_TR;
-					end
-				end
+		// QoS statistics
+		// Each cycle the latency counter is increased by the number of transactions in flight
+		// (address waiting or outstanding), so it is the sum of the latencies of all transactions
+		always @(posedge clk_i) begin
+			if(rst_ni == 1'd0 || stat_clr_i == 1'b1) begin
+				stat_tr_cnt_r[mst_idx]   <= 'd0;
+				stat_lat_cnt_r[mst_idx]  <= 'd0;
+				stat_max_wait_r[mst_idx] <= 'd0;
+				stat_ar_wait_r[mst_idx]  <= 'd0;
+				stat_aw_wait_r[mst_idx]  <= 'd0;
+			end else begin
+				stat_lat_cnt_r[mst_idx] <= stat_lat_cnt_r[mst_idx] + m_arvalid_i[mst_idx] + m_awvalid_i[mst_idx] + rd_cnt_r[mst_idx] + wr_cnt_r[mst_idx];
 
-				// Write response transfer
-				B_TR : begin
-					if (s_bvalid_i[selected_slv_r[mst_fsm]] && m_bvalid_o[mst_fsm]) begin
-						next_state_s[mst_fsm] = IDLE;
-						// Clear slave busy flag
-						slv_clr_s[selected_slv_r[mst_fsm]][mst_fsm] = 1'b1;
-					end
+				if ((m_rvalid_o[mst_idx] && m_rready_i[mst_idx] && m_rlast_o[mst_idx]) && (m_bvalid_o[mst_idx] && m_bready_i[mst_idx])) begin
+					stat_tr_cnt_r[mst_idx] <= stat_tr_cnt_r[mst_idx]+2;
+				end else if ((m_rvalid_o[mst_idx] && m_rready_i[mst_idx] && m_rlast_o[mst_idx]) || (m_bvalid_o[mst_idx] && m_bready_i[mst_idx])) begin
+					stat_tr_cnt_r[mst_idx] <= stat_tr_cnt_r[mst_idx]+1;
 				end
 
-				default : next_state_s[mst_fsm] = IDLE;
-			endcase
+				// Waiting time of addresses
+				if (m_arvalid_i[mst_idx] && !m_aready_o[mst_idx]) begin
+					stat_ar_wait_r[mst_idx] <= stat_ar_wait_r[mst_idx]+1;
+				end else begin
+					stat_ar_wait_r[mst_idx] <= 'd0;
+				end
+				if (m_awvalid_i[mst_idx] && !m_awready_o[mst_idx]) begin
+					stat_aw_wait_r[mst_idx] <= stat_aw_wait_r[mst_idx]+1;
+				end else begin
+					stat_aw_wait_r[mst_idx] <= 'd0;
+				end
+				if (stat_ar_wait_r[mst_idx] > stat_max_wait_r[mst_idx] && stat_ar_wait_r[mst_idx] >= stat_aw_wait_r[mst_idx]) begin
+					stat_max_wait_r[mst_idx] <= stat_ar_wait_r[mst_idx];
+				end else if (stat_aw_wait_r[mst_idx] > stat_max_wait_r[mst_idx]) begin
+					stat_max_wait_r[mst_idx] <= stat_aw_wait_r[mst_idx];
+				end
+			end
 		end
 
-
-		// FSM output calculation
-		// Routing of signals from selected slave to master
+		// Routing of signals from slaves to master
 		always @(*) begin
 			// Default values
-			m_aready_o[mst_fsm] = 'd0;
-			m_rvalid_o[mst_fsm] = 'd0;
-			m_rdata_o_unpacked[mst_fsm] = 'd0;
-			m_rresp_o_unpacked[mst_fsm] = 'd0;
-			m_awready_o[mst_fsm] = 'd0;
-			m_wready_o[mst_fsm] = 'd0;
-			m_bvalid_o[mst_fsm] = 'd0;
-			m_bresp_o_unpacked[mst_fsm] = 'd0;
-
-			// Connect signals only when not in idle state
-			if (current_state_r[mst_fsm] != IDLE) begin
-				m_aready_o[mst_fsm] = s_aready_i[selected_slv_r[mst_fsm]];
-				m_rvalid_o[mst_fsm] = s_rvalid_i[selected_slv_r[mst_fsm]];
-				m_rdata_o_unpacked[mst_fsm] = s_rdata_i_unpacked[selected_slv_r[mst_fsm]];
-				m_rresp_o_unpacked[mst_fsm] = s_rresp_i_unpacked[selected_slv_r[mst_fsm]];
-				m_awready_o[mst_fsm] = s_awready_i[selected_slv_r[mst_fsm]];
-				m_wready_o[mst_fsm] = s_wready_i[selected_slv_r[mst_fsm]];
-				m_bvalid_o[mst_fsm] = s_bvalid_i[selected_slv_r[mst_fsm]];
-				m_bresp_o_unpacked[mst_fsm] = s_bresp_i_unpacked[selected_slv_r[mst_fsm]];
+			m_aready_o[mst_idx] = 'd0;
+			m_rvalid_o[mst_idx] = 'd0;
+			m_rdata_o_unpacked[mst_idx] = 'd0;
+			m_rresp_o_unpacked[mst_idx] = 'd0;
+			m_rlast_o[mst_idx] = 'd0;
+			m_rid_o_unpacked[mst_idx] = 'd0;
+			m_awready_o[mst_idx] = 'd0;
+			m_wready_o[mst_idx] = 'd0;
+			m_bvalid_o[mst_idx] = 'd0;
+			m_bresp_o_unpacked[mst_idx] = 'd0;
+			m_bid_o_unpacked[mst_idx] = 'd0;
+
+			// Address channels: from the decoded slave, when granted
+			if (ar_hit_s[mst_idx] && ar_gnt_valid_s[ar_dec_s[mst_idx]] && ar_gnt_s[ar_dec_s[mst_idx]] == mst_idx) begin
+				m_aready_o[mst_idx] = slv_aready_s[ar_dec_s[mst_idx]];
+			end
+			if (aw_hit_s[mst_idx] && aw_gnt_valid_s[aw_dec_s[mst_idx]] && aw_gnt_s[aw_dec_s[mst_idx]] == mst_idx) begin
+				m_awready_o[mst_idx] = slv_awready_s[aw_dec_s[mst_idx]];
+			end
+
+			// Read data channel: from the slave of the outstanding reads, when the response is for this master
+			if (rd_cnt_r[mst_idx] != 'd0 && r_dst_s[rd_slv_r[mst_idx]] == mst_idx) begin
+				m_rvalid_o[mst_idx] = slv_rvalid_s[rd_slv_r[mst_idx]];
+				m_rdata_o_unpacked[mst_idx] = slv_rdata_s[rd_slv_r[mst_idx]];
+				m_rresp_o_unpacked[mst_idx] = slv_rresp_s[rd_slv_r[mst_idx]];
+				m_rlast_o[mst_idx] = slv_rlast_s[rd_slv_r[mst_idx]];
+				m_rid_o_unpacked[mst_idx] = slv_rid_s[rd_slv_r[mst_idx]][ID_WIDTH-1:0];
+			end
+
+			// Write data channel: towards the slave of the outstanding writes, when this master owns its data channel
+			if (wr_cnt_r[mst_idx] != 'd0 && w_order_not_empty_s[wr_slv_r[mst_idx]] && w_owner_s[wr_slv_r[mst_idx]] == mst_idx) begin
+				m_wready_o[mst_idx] = slv_wready_s[wr_slv_r[mst_idx]];
+			end
+
+			// Write response channel: from the slave of the outstanding writes, when the response is for this master
+			if (wr_cnt_r[mst_idx] != 'd0 && b_dst_s[wr_slv_r[mst_idx]] == mst_idx) begin
+				m_bvalid_o[mst_idx] = slv_bvalid_s[wr_slv_r[mst_idx]];
+				m_bresp_o_unpacked[mst_idx] = slv_bresp_s[wr_slv_r[mst_idx]];
+				m_bid_o_unpacked[mst_idx] = slv_bid_s[wr_slv_r[mst_idx]][ID_WIDTH-1:0];
 			end
 		end
 
-	end // for (mst_fsm = 0; mst_fsm < N_MST ...
+	end // for (mst_idx = 0; mst_idx < N_MST ...
 endgenerate
 
-// Routing of signals from master to slave
+// Logic towards slave interfaces
 genvar slv_idx;
 generate
-	for (slv_idx = 0; slv_idx < N_SLV; slv_idx = slv_idx + 1) begin : gen_slv_mux
+	for (slv_idx = 0; slv_idx < N_SLV; slv_idx = slv_idx + 1) begin : gen_slv
+
+		// Masters requesting the slave
+		always @(*) begin : a_slv_req
+			integer i;
+			for (i = 0; i < N_MST; i = i + 1) begin
+				ar_req_s[slv_idx][i] = m_arvalid_i[i] && ar_allowed_s[i] && (ar_dec_s[i] == slv_idx);
+				aw_req_s[slv_idx][i] = m_awvalid_i[i] && aw_allowed_s[i] && (aw_dec_s[i] == slv_idx);
+			end
+		end
+
+		// Address channels arbitration
+		// Grant is kept until the address has been accepted by the slave
+		axi_arbiter #(
+			.N_REQ(N_MST),
+			.POLICY(ARB_POLICY),
+			.WEIGHTS(MST_WEIGHTS)
+			)
+			inst_ar_arbiter (
+			.clk_i(clk_i),
+			.rst_ni(rst_ni),
+			.req_i(ar_req_s[slv_idx]),
+			.ack_i(slv_arvalid_s[slv_idx] & slv_aready_s[slv_idx]),
+			.gnt_valid_o(ar_gnt_valid_s[slv_idx]),
+			.gnt_o(ar_gnt_s[slv_idx])
+		);
+
+		axi_arbiter #(
+			.N_REQ(N_MST),
+			.POLICY(ARB_POLICY),
+			.WEIGHTS(MST_WEIGHTS)
+			)
+			inst_aw_arbiter (
+			.clk_i(clk_i),
+			.rst_ni(rst_ni),
+			.req_i(aw_req_s[slv_idx]),
+			.ack_i(slv_awvalid_s[slv_idx] & slv_awready_s[slv_idx]),
+			.gnt_valid_o(aw_gnt_valid_s[slv_idx]),
+			.gnt_o(aw_gnt_s[slv_idx])
+		);
+
+		// Write data is forwarded in the same order of the accepted write addresses
+		sync_fifo  #(
+			.DEPTH(W_ORDER_DEPTH),
+			.DATA_WIDTH(WIDTH_MST)
+			)
+			inst_w_order (
+			// Write port
+			.clk_i(clk_i),
+			.rst_ni(rst_ni),
+			.wr_en_i(slv_awvalid_s[slv_idx] & slv_awready_s[slv_idx]),
+			.wr_data_i(aw_gnt_s[slv_idx]),
+			.full_o(w_order_full_s[slv_idx]),
+			// Read port
+			.rd_en_i(slv_wvalid_s[slv_idx] & slv_wready_s[slv_idx] & slv_wlast_s[slv_idx]),
+			.rd_data_o(w_owner_s[slv_idx]),
+			.empty_o(),
+			.not_empty_o(w_order_not_empty_s[slv_idx])
+		);
+
+		// Responses are routed with the master index stored in the ID
+		assign r_dst_s[slv_idx] = slv_rid_s[slv_idx][SLV_ID_WIDTH-1:ID_WIDTH];
+		assign b_dst_s[slv_idx] = slv_bid_s[slv_idx][SLV_ID_WIDTH-1:ID_WIDTH];
+
+		// Routing of signals from masters to slave
 		always @(*) begin
 			// Default values
-			s_arvalid_o[slv_idx] = 'd0;
-			s_araddr_o_unpacked[slv_idx] = 'd0;
-			s_rready_o[slv_idx] = 'd0;
-			s_awvalid_o[slv_idx] = 'd0;
-			s_awaddr_o_unpacked[slv_idx] = 'd0;
-			s_wvalid_o[slv_idx] = 'd0;
-			s_wdata_o_unpacked[slv_idx] = 'd0;
-			s_wstrb_o_unpacked[slv_idx] = 'd0;
-			s_bready_o[slv_idx] = 'd0;
-
-			// Connect signals only when not in idle
-			if (slv_busy_r[slv_idx]) begin
-				s_arvalid_o[slv_idx] = m_arvalid_i[selecting_mst_r[slv_idx]];
-				s_araddr_o_unpacked[slv_idx] = m_araddr_i_unpacked[selecting_mst_r[slv_idx]];
-				s_rready_o[slv_idx] = m_rready_i[selecting_mst_r[slv_idx]];
-				s_awvalid_o[slv_idx] = m_awvalid_i[selecting_mst_r[slv_idx]];
-				s_awaddr_o_unpacked[slv_idx] = m_awaddr_i_unpacked[selecting_mst_r[slv_idx]];
-				s_wvalid_o[slv_idx] = m_wvalid_i[selecting_mst_r[slv_idx]];
-				s_wdata_o_unpacked[slv_idx] = m_wdata_i_unpacked[selecting_mst_r[slv_idx]];
-				s_wstrb_o_unpacked[slv_idx] = m_wstrb_i_unpacked[selecting_mst_r[slv_idx]];
-				s_bready_o[slv_idx] = m_bready_i[selecting_mst_r[slv_idx]];
+			slv_arvalid_s[slv_idx] = 'd0;
+			slv_araddr_s[slv_idx] = 'd0;
+			slv_arlen_s[slv_idx] = 'd0;
+			slv_arsize_s[slv_idx] = 'd0;
+			slv_arburst_s[slv_idx] = 'd0;
+			slv_arid_s[slv_idx] = 'd0;
+			slv_rready_s[slv_idx] = 'd0;
+			slv_awvalid_s[slv_idx] = 'd0;
+			slv_awaddr_s[slv_idx] = 'd0;
+			slv_awlen_s[slv_idx] = 'd0;
+			slv_awsize_s[slv_idx] = 'd0;
+			slv_awburst_s[slv_idx] = 'd0;
+			slv_awid_s[slv_idx] = 'd0;
+			slv_wvalid_s[slv_idx] = 'd0;
+			slv_wdata_s[slv_idx] = 'd0;
+			slv_wstrb_s[slv_idx] = 'd0;
+			slv_wlast_s[slv_idx] = 'd0;
+			slv_bready_s[slv_idx] = 'd0;
+
+			// Address channels from the granted master, master index is added to the ID
+			if (ar_gnt_valid_s[slv_idx]) begin
+				slv_arvalid_s[slv_idx] = m_arvalid_i[ar_gnt_s[slv_idx]];
+				slv_araddr_s[slv_idx] = m_araddr_i_unpacked[ar_gnt_s[slv_idx]];
+				slv_arlen_s[slv_idx] = m_arlen_i_unpacked[ar_gnt_s[slv_idx]];
+				slv_arsize_s[slv_idx] = m_arsize_i_unpacked[ar_gnt_s[slv_idx]];
+				slv_arburst_s[slv_idx] = m_arburst_i_unpacked[ar_gnt_s[slv_idx]];
+				slv_arid_s[slv_idx] = {ar_gnt_s[slv_idx], m_arid_i_unpacked[ar_gnt_s[slv_idx]]};
+			end
+			if (aw_gnt_valid_s[slv_idx]) begin
+				slv_awvalid_s[slv_idx] = m_awvalid_i[aw_gnt_s[slv_idx]];
+				slv_awaddr_s[slv_idx] = m_awaddr_i_unpacked[aw_gnt_s[slv_idx]];
+				slv_awlen_s[slv_idx] = m_awlen_i_unpacked[aw_gnt_s[slv_idx]];
+				slv_awsize_s[slv_idx] = m_awsize_i_unpacked[aw_gnt_s[slv_idx]];
+				slv_awburst_s[slv_idx] = m_awburst_i_unpacked[aw_gnt_s[slv_idx]];
+				slv_awid_s[slv_idx] = {aw_gnt_s[slv_idx], m_awid_i_unpacked[aw_gnt_s[slv_idx]]};
+			end
+
+			// Write data channel from the master of the oldest accepted write address
+			if (w_order_not_empty_s[slv_idx]) begin
+				slv_wvalid_s[slv_idx] = m_wvalid_i[w_owner_s[slv_idx]];
+				slv_wdata_s[slv_idx] = m_wdata_i_unpacked[w_owner_s[slv_idx]];
+				slv_wstrb_s[slv_idx] = m_wstrb_i_unpacked[w_owner_s[slv_idx]];
+				slv_wlast_s[slv_idx] = m_wlast_i[w_owner_s[slv_idx]];
+			end
+
+			// Response channels ready from the master the response is directed to
+			if (r_dst_s[slv_idx] < N_MST && rd_cnt_r[r_dst_s[slv_idx]] != 'd0 && rd_slv_r[r_dst_s[slv_idx]] == slv_idx) begin
+				slv_rready_s[slv_idx] = m_rready_i[r_dst_s[slv_idx]];
+			end
+			if (b_dst_s[slv_idx] < N_MST && wr_cnt_r[b_dst_s[slv_idx]] != 'd0 && wr_slv_r[b_dst_s[slv_idx]] == slv_idx) begin
+				slv_bready_s[slv_idx] = m_bready_i[b_dst_s[slv_idx]];
 			end
 		end
+
 	end // for (slv_idx = 0; slv_idx < N_SLV ...
 endgenerate
 
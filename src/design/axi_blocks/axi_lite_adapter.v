@@ -0,0 +1,180 @@
+module axi_lite_adapter #(
+	// Width of the transaction IDs
+	parameter ID_WIDTH=1
+	)(
+		input  clk_i,
+		input  rst_ni,
+
+		//// AXI4 slave interface (bursts)
+		// Read Address (AR) channel
+		input  s_arvalid_i,
+		output s_aready_o,
+		input  [31:0] s_araddr_i,
+		input  [7:0] s_arlen_i,
+		input  [2:0] s_arsize_i,
+		input  [1:0] s_arburst_i,
+		input  [ID_WIDTH-1:0] s_arid_i,
+
+		// Read Data (R) channel
+		output s_rvalid_o,
+		input  s_rready_i,
+		output [31:0] s_rdata_o,
+		output [1:0] s_rresp_o,
+		output s_rlast_o,
+		output [ID_WIDTH-1:0] s_rid_o,
+
+		// Write Address (AW) channel
+		input  s_awvalid_i,
+		output s_awready_o,
+		input  [31:0] s_awaddr_i,
+		input  [7:0] s_awlen_i,
+		input  [2:0] s_awsize_i,
+		input  [1:0] s_awburst_i,
+		input  [ID_WIDTH-1:0] s_awid_i,
+
+		// Write Data (W) channel
+		input  s_wvalid_i,
+		output s_wready_o,
+		input  [31:0] s_wdata_i,
+		input  [3:0] s_wstrb_i,
+		input  s_wlast_i,
+
+		// Write Response (B) channel
+		output s_bvalid_o,
+		input  s_bready_i,
+		output [1:0] s_bresp_o,
+		output [ID_WIDTH-1:0] s_bid_o,
+
+		//// AXI-Lite master interface (single transfers)
+		// Read Address (AR) channel
+		output m_arvalid_o,
+		input  m_aready_i,
+		output [31:0] m_araddr_o,
+
+		// Read Data (R) channel
+		input  m_rvalid_i,
+		output m_rready_o,
+		input  [31:0] m_rdata_i,
+		input  [1:0] m_rresp_i,
+
+		// Write Address (AW) channel
+		output m_awvalid_o,
+		input  m_awready_i,
+		output [31:0] m_awaddr_o,
+
+		// Write Data (W) channel
+		output m_wvalid_o,
+		input  m_wready_i,
+		output [31:0] m_wdata_o,
+		output [3:0] m_wstrb_o,
+
+		// Write Response (B) channel
+		input  m_bvalid_i,
+		output m_bready_o,
+		input  [1:0] m_bresp_i
+);
+
+// Every beat of a burst is converted into a single AXI-Lite transaction
+wire hs_read_s, hs_write_s, hs_ready_s;
+wire [31:0] hs_addr_s, hs_wdata_s, hs_rdata_s;
+wire [3:0] hs_byte_select_s;
+
+// Burst side
+axi_2_hs #(
+	.ID_WIDTH(ID_WIDTH)
+	)
+	inst_axi_slave (
+	.clk_i(clk_i),
+	.rst_ni(rst_ni),
+	//// AXI interface
+	// Read Address (AR) channel
+	.arvalid_i(s_arvalid_i),
+	.aready_o(s_aready_o),
+	.araddr_i(s_araddr_i),
+	.arlen_i(s_arlen_i),
+	.arsize_i(s_arsize_i),
+	.arburst_i(s_arburst_i),
+	.arid_i(s_arid_i),
+	// Read Data (R) channel
+	.rvalid_o(s_rvalid_o),
+	.rready_i(s_rready_i),
+	.rdata_o(s_rdata_o),
+	.rresp_o(s_rresp_o),
+	.rlast_o(s_rlast_o),
+	.rid_o(s_rid_o),
+	// Write Address (AW) channel
+	.awvalid_i(s_awvalid_i),
+	.awready_o(s_awready_o),
+	.awaddr_i(s_awaddr_i),
+	.awlen_i(s_awlen_i),
+	.awsize_i(s_awsize_i),
+	.awburst_i(s_awburst_i),
+	.awid_i(s_awid_i),
+	// Write Data (W) channel
+	.wvalid_i(s_wvalid_i),
+	.wready_o(s_wready_o),
+	.wdata_i(s_wdata_i),
+	.wstrb_i(s_wstrb_i),
+	.wlast_i(s_wlast_i),
+	// Write Response (B) channel
+	.bvalid_o(s_bvalid_o),
+	.bready_i(s_bready_i),
+	.bresp_o(s_bresp_o),
+	.bid_o(s_bid_o),
+	// Handshake interface
+	.hs_read_o(hs_read_s),
+	.hs_write_o(hs_write_s),
+	.hs_addr_o(hs_addr_s),
+	.hs_data_o(hs_wdata_s),
+	.hs_ready_i(hs_ready_s),
+	.hs_data_i(hs_rdata_s),
+	.byte_select_o(hs_byte_select_s)
+);
+
+// Single transfer side
+hs_2_axi inst_axi_master (
+	.clk_i(clk_i),
+	.rst_ni(rst_ni),
+	// Handshake interface
+	.hs_read_i(hs_read_s),
+	.hs_write_i(hs_write_s),
+	.hs_addr_i(hs_addr_s),
+	.hs_data_i(hs_wdata_s),
+	.hs_len_i(8'd0),
+	.hs_ready_o(hs_ready_s),
+	.hs_data_o(hs_rdata_s),
+	.byte_select_i(hs_byte_select_s),
+	//// AXI interface
+	// Read Address (AR) channel
+	.arvalid_o(m_arvalid_o),
+	.aready_i(m_aready_i),
+	.araddr_o(m_araddr_o),
+	.arlen_o(),
+	.arsize_o(),
+	.arburst_o(),
+	// Read Data (R) channel
+	.rvalid_i(m_rvalid_i),
+	.rready_o(m_rready_o),
+	.rdata_i(m_rdata_i),
+	.rresp_i(m_rresp_i),
+	.rlast_i(1'b1),
+	// Write Address (AW) channel
+	.awvalid_o(m_awvalid_o),
+	.awready_i(m_awready_i),
+	.awaddr_o(m_awaddr_o),
+	.awlen_o(),
+	.awsize_o(),
+	.awburst_o(),
+	// Write Data (W) channel
+	.wvalid_o(m_wvalid_o),
+	.wready_i(m_wready_i),
+	.wdata_o(m_wdata_o),
+	.wstrb_o(m_wstrb_o),
+	.wlast_o(),
+	// Write Response (B) channel
+	.bvalid_i(m_bvalid_i),
+	.bready_o(m_bready_o),
+	.bresp_i(m_bresp_i)
+);
+
+endmodule
@@ -1,4 +1,9 @@
-module axi_ram_wrapper(	
+module axi_ram_wrapper #(
+	// Width of the transaction IDs
+	parameter ID_WIDTH=1,
+	// Number of 2KB SRAM macros (power of 2), consecutive words are stored in different banks
+	parameter N_BANKS=1
+	)(
 	input clk_i,
 	input rst_ni,
 
@@ -7,36 +12,70 @@ module axi_ram_wrapper(
 	input  arvalid_i,
 	output aready_o,
 	input  [31:0] araddr_i,
+	input  [7:0] arlen_i,
+	input  [2:0] arsize_i,
+	input  [1:0] arburst_i,
+	input  [ID_WIDTH-1:0] arid_i,
 
 	// Read Data (R) channel
 	output rvalid_o,
 	input  rready_i,
 	output [31:0] rdata_o,
 	output [1:0] rresp_o,
+	output rlast_o,
+	output [ID_WIDTH-1:0] rid_o,
 
 	// Write Address (AW) channel
 	input  awvalid_i,
 	output awready_o,
 	input  [31:0] awaddr_i,
+	input  [7:0] awlen_i,
+	input  [2:0] awsize_i,
+	input  [1:0] awburst_i,
+	input  [ID_WIDTH-1:0] awid_i,
 
 	// Write Data (W) channel
 	input  wvalid_i,
 	output wready_o,
 	input  [31:0] wdata_i,
 	input  [3:0] wstrb_i,
+	input  wlast_i,
 
 	// Write Response (B) channel
 	output bvalid_o,
 	input  bready_i,
-	output [1:0] bresp_o
+	output [1:0] bresp_o,
+	output [ID_WIDTH-1:0] bid_o
 );
 
-reg  ram_ready_r;
+localparam BANK_LOG   = $clog2(N_BANKS);
+localparam BANK_WIDTH = (N_BANKS > 1) ? BANK_LOG : 1;
+
+// Name of the file loaded in each bank (FPGA only)
+// A single bank uses the whole image, otherwise the image is split by binary_conversion.py
+function [8*14-1:0] bank_file_name;
+	input integer bank;
+	begin
+		if (N_BANKS == 1) begin
+			bank_file_name = "software.txt";
+		end else begin
+			bank_file_name = {"software_", (bank < 10) ? 8'd48+bank[7:0] : 8'd87+bank[7:0], ".txt"};
+		end
+	end
+endfunction
+
+/* ---------------------------------------------------
+* AXI slaves, reads and writes are served by independent handshake ports
+* --------------------------------------------------*/
 wire ram_rd_en_s, ram_wr_en_s;
-wire [31:0] ram_addr_s, ram_data_o_s, ram_data_i_s;
+wire [31:0] ram_rd_addr_s, ram_wr_addr_s, ram_data_o_s, ram_data_i_s;
 wire [3:0] ram_byte_select_s;
+reg  ram_rd_ready_r, ram_wr_ready_r;
 
-axi_2_hs inst_axi_slave (
+axi_2_hs #(
+	.ID_WIDTH(ID_WIDTH)
+	)
+	inst_axi_slave_rd (
 	.clk_i(clk_i),
 	.rst_ni(rst_ni),
 	//// AXI interface
@@ -44,57 +83,167 @@ axi_2_hs inst_axi_slave (
 	.arvalid_i(arvalid_i),
 	.aready_o(aready_o),
 	.araddr_i(araddr_i),
+	.arlen_i(arlen_i),
+	.arsize_i(arsize_i),
+	.arburst_i(arburst_i),
+	.arid_i(arid_i),
 	// Read Data (R) channel
 	.rvalid_o(rvalid_o),
 	.rready_i(rready_i),
 	.rdata_o(rdata_o),
 	.rresp_o(rresp_o),
+	.rlast_o(rlast_o),
+	.rid_o(rid_o),
+	// Write Address (AW) channel
+	.awvalid_i(1'b0),
+	.awready_o(),
+	.awaddr_i(32'd0),
+	.awlen_i(8'd0),
+	.awsize_i(3'd0),
+	.awburst_i(2'd0),
+	.awid_i({ID_WIDTH{1'b0}}),
+	// Write Data (W) channel
+	.wvalid_i(1'b0),
+	.wready_o(),
+	.wdata_i(32'd0),
+	.wstrb_i(4'd0),
+	.wlast_i(1'b0),
+	// Write Response (B) channel
+	.bvalid_o(),
+	.bready_i(1'b0),
+	.bresp_o(),
+	.bid_o(),
+	// Handshake interface
+	.hs_read_o(ram_rd_en_s),
+	.hs_write_o(),
+	.hs_addr_o(ram_rd_addr_s),
+	.hs_data_o(),
+	.hs_ready_i(ram_rd_ready_r),
+	.hs_data_i(ram_data_o_s),
+	.byte_select_o()
+);
+
+axi_2_hs #(
+	.ID_WIDTH(ID_WIDTH)
+	)
+	inst_axi_slave_wr (
+	.clk_i(clk_i),
+	.rst_ni(rst_ni),
+	//// AXI interface
+	// Read Address (AR) channel
+	.arvalid_i(1'b0),
+	.aready_o(),
+	.araddr_i(32'd0),
+	.arlen_i(8'd0),
+	.arsize_i(3'd0),
+	.arburst_i(2'd0),
+	.arid_i({ID_WIDTH{1'b0}}),
+	// Read Data (R) channel
+	.rvalid_o(),
+	.rready_i(1'b0),
+	.rdata_o(),
+	.rresp_o(),
+	.rlast_o(),
+	.rid_o(),
 	// Write Address (AW) channel
 	.awvalid_i(awvalid_i),
 	.awready_o(awready_o),
 	.awaddr_i(awaddr_i),
+	.awlen_i(awlen_i),
+	.awsize_i(awsize_i),
+	.awburst_i(awburst_i),
+	.awid_i(awid_i),
 	// Write Data (W) channel
 	.wvalid_i(wvalid_i),
 	.wready_o(wready_o),
 	.wdata_i(wdata_i),
 	.wstrb_i(wstrb_i),
+	.wlast_i(wlast_i),
 	// Write Response (B) channel
 	.bvalid_o(bvalid_o),
 	.bready_i(bready_i),
 	.bresp_o(bresp_o),
+	.bid_o(bid_o),
 	// Handshake interface
-	.hs_read_o(ram_rd_en_s),
+	.hs_read_o(),
 	.hs_write_o(ram_wr_en_s),
-	.hs_addr_o(ram_addr_s),
+	.hs_addr_o(ram_wr_addr_s),
 	.hs_data_o(ram_data_i_s),
-	.hs_ready_i(ram_ready_r),
-	.hs_data_i(ram_data_o_s),
+	.hs_ready_i(ram_wr_ready_r),
+	.hs_data_i(32'd0),
 	.byte_select_o(ram_byte_select_s)
 );
 
-// Ready signal considering ram delay
+/* ---------------------------------------------------
+* Bank arbitration
+* A read and a write to different banks are served in the same cycle,
+*   on a conflict the port that lost the previous conflict wins
+* --------------------------------------------------*/
+// Bank (word address LSBs) and row inside the bank of each port
+wire [BANK_WIDTH-1:0] rd_bank_s, wr_bank_s;
+wire [9:0] rd_row_s, wr_row_s;
+assign rd_bank_s = (N_BANKS > 1) ? ram_rd_addr_s[BANK_WIDTH+1:2] : 'd0;
+assign wr_bank_s = (N_BANKS > 1) ? ram_wr_addr_s[BANK_WIDTH+1:2] : 'd0;
+assign rd_row_s  = ram_rd_addr_s[31:2] >> BANK_LOG;
+assign wr_row_s  = ram_wr_addr_s[31:2] >> BANK_LOG;
+
+// A port requests its bank for one cycle, the data is ready in the following one
+wire rd_req_s, wr_req_s, conflict_s, rd_gnt_s, wr_gnt_s;
+reg  wr_prio_r;
+assign rd_req_s   = ram_rd_en_s & ~ram_rd_ready_r;
+assign wr_req_s   = ram_wr_en_s & ~ram_wr_ready_r;
+assign conflict_s = rd_req_s & wr_req_s & (rd_bank_s == wr_bank_s);
+assign rd_gnt_s   = rd_req_s & ~(conflict_s & wr_prio_r);
+assign wr_gnt_s   = wr_req_s & ~(conflict_s & ~wr_prio_r);
+
+// Ready signals considering ram delay
 always @(posedge clk_i) begin
 	if(rst_ni == 1'd0) begin
-		ram_ready_r <= 1'd0;
+		ram_rd_ready_r <= 1'd0;
+		ram_wr_ready_r <= 1'd0;
+		wr_prio_r      <= 1'd0;
 	end else begin
-		ram_ready_r <= (ram_rd_en_s || ram_wr_en_s);
+		ram_rd_ready_r <= rd_gnt_s;
+		ram_wr_ready_r <= wr_gnt_s;
+		if (conflict_s) begin
+			wr_prio_r <= ~wr_prio_r;
+		end
 	end
 end
 
+/* ---------------------------------------------------
+* SRAM banks
+* --------------------------------------------------*/
 // Data extension for spare ram column
-wire [32:0] extended_ram_data_i_s, extended_ram_data_o_s;
+wire [32:0] extended_ram_data_i_s;
+wire [32:0] extended_ram_data_o_s [0:N_BANKS-1];
 assign extended_ram_data_i_s = {1'b0, ram_data_i_s};
-assign ram_data_o_s = extended_ram_data_o_s[31:0];
-
-sky130_sram_2kbyte_1rw_32x512_8 inst_ram (
-	.clk0(clk_i), 
-	.csb0(~(ram_rd_en_s | ram_wr_en_s)), 
-	.web0(~ram_wr_en_s), 
-	.addr0(ram_addr_s[11:2]), 
-	.din0(extended_ram_data_i_s), 
-	.dout0(extended_ram_data_o_s),
-	.wmask0(ram_byte_select_s),
-	.spare_wen0(1'b0)
-);
-endmodule
+// Read data from the bank of the read port (address is held until ready)
+assign ram_data_o_s = extended_ram_data_o_s[rd_bank_s][31:0];
 
+genvar bank_idx;
+generate
+	for (bank_idx = 0; bank_idx < N_BANKS; bank_idx = bank_idx + 1) begin : gen_bank
+		wire rd_sel_s, wr_sel_s;
+		assign rd_sel_s = rd_gnt_s & (rd_bank_s == bank_idx);
+		assign wr_sel_s = wr_gnt_s & (wr_bank_s == bank_idx);
+
+		sky130_sram_2kbyte_1rw_32x512_8
+`ifdef FPGA
+			#(
+			.FILE_NAME(bank_file_name(bank_idx))
+			)
+`endif
+			inst_ram (
+			.clk0(clk_i), 
+			.csb0(~(rd_sel_s | wr_sel_s)), 
+			.web0(~wr_sel_s), 
+			.addr0((wr_sel_s) ? wr_row_s : rd_row_s), 
+			.din0(extended_ram_data_i_s), 
+			.dout0(extended_ram_data_o_s[bank_idx]),
+			.wmask0(ram_byte_select_s),
+			.spare_wen0(1'b0)
+		);
+	end
+endgenerate
+endmodule
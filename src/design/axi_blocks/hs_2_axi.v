@@ -1,38 +1,50 @@
-module hs_2_axi(	
+module hs_2_axi(
 		input  clk_i,
 		input  rst_ni,
 
 		// Handshake interface
+		// For bursts (hs_len_i>0) hs_ready_o is asserted once per beat,
+		// on writes the last one is asserted after the write response
 		input  hs_read_i,
 		input  hs_write_i,
 		input  [31:0] hs_addr_i,
 		input  [31:0] hs_data_i,
+		// Number of beats of the transaction minus one
+		input  [7:0] hs_len_i,
 		output reg hs_ready_o,
 		output reg [31:0] hs_data_o,
 		input [3:0] byte_select_i,
-		
+
 		//// AXI interface
 		// Read Address (AR) channel
 		output reg arvalid_o,
 		input  aready_i,
 		output reg [31:0] araddr_o,
+		output reg [7:0] arlen_o,
+		output [2:0] arsize_o,
+		output [1:0] arburst_o,
 
 		// Read Data (R) channel
 		input  rvalid_i,
 		output reg rready_o,
 		input  [31:0] rdata_i,
 		input  [1:0] rresp_i,
+		input  rlast_i,
 
 		// Write Address (AW) channel
 		output reg awvalid_o,
 		input  awready_i,
 		output reg [31:0] awaddr_o,
+		output reg [7:0] awlen_o,
+		output [2:0] awsize_o,
+		output [1:0] awburst_o,
 
 		// Write Data (W) channel
 		output reg wvalid_o,
 		input  wready_i,
 		output reg [31:0] wdata_o,
 		output reg [3:0] wstrb_o,
+		output reg wlast_o,
 
 		// Write Response (B) channel
 		input  bvalid_i,
@@ -43,6 +55,15 @@ module hs_2_axi(
 // Signal to store data form axi interface
 reg rdata_reg_en_s;
 
+// Transaction information sampled at the start of the transaction
+reg [31:0] addr_r;
+reg [7:0] len_r;
+reg [7:0] beat_cnt_r;
+reg beat_cnt_en_s;
+// Write address transfer has been done
+reg aw_done_r;
+wire aw_done_s;
+
 // Signals and encoding for FSM status
 reg [3:0] current_state_r, next_state_s;
 localparam IDLE    = 4'd0;
@@ -50,9 +71,10 @@ localparam AR_TR   = 4'd1;
 localparam R_TR    = 4'd2;
 localparam W_TR    = 4'd3;
 localparam WAIT_AW = 4'd4;
-localparam WAIT_W  = 4'd5;
+localparam R_ACK   = 4'd5;
 localparam B_TR    = 4'd6;
 localparam HS_ACK  = 4'd7;
+localparam W_ACK   = 4'd8;
 
 // FSM present state update
 always @(posedge clk_i) begin
@@ -63,6 +85,9 @@ always @(posedge clk_i) begin
 	end
 end
 
+// Write address transfer concluded (now or in a previous beat)
+assign aw_done_s = aw_done_r | (awvalid_o & awready_i);
+
 // FSM next state calculation
 always @(*) begin
 	// Default next state
@@ -90,22 +115,39 @@ always @(*) begin
 		// Read data transfer
 		R_TR : begin
 			if (rvalid_i) begin
-				next_state_s = HS_ACK;
+				if (rlast_i) begin
+					next_state_s = HS_ACK;
+				end else begin
+					next_state_s = R_ACK;
+				end
 			end
 		end
 
+		// Send acknowledge of a read beat to hs interface
+		R_ACK : begin
+			next_state_s = R_TR;
+		end
+
 		// Write address/data transfer
 		W_TR : begin
 			// Check if one or both transfers have ended
-			if (awready_i && wready_i) begin
-			     next_state_s = B_TR;
-			end else if (awready_i) begin
-				next_state_s = WAIT_W;
-			end else if (wready_i) begin
-				next_state_s = WAIT_AW;
+			if (wready_i) begin
+				if (!wlast_o) begin
+					// Get next beat from hs interface
+					next_state_s = W_ACK;
+				end else if (aw_done_s) begin
+					next_state_s = B_TR;
+				end else begin
+					next_state_s = WAIT_AW;
+				end
 			end
 		end
-		
+
+		// Send acknowledge of a write beat to hs interface
+		W_ACK : begin
+			next_state_s = W_TR;
+		end
+
 		// Wait end of write address transfer
 		WAIT_AW : begin
 			if (awready_i) begin
@@ -113,13 +155,6 @@ always @(*) begin
 			end
 		end
 
-		// Wait end of write data transfer
-		WAIT_W : begin
-			if (wready_i) begin
-				next_state_s = B_TR;
-			end
-		end
-
 		// Write response transfer
 		B_TR : begin
 			if (bvalid_i) begin
@@ -131,7 +166,7 @@ always @(*) begin
 		HS_ACK : begin
 			next_state_s = IDLE;
 		end
-        
+
         default : next_state_s = IDLE;
 	endcase
 end
@@ -140,17 +175,20 @@ end
 always @(*) begin
 	// Default output values
 	arvalid_o  = 'b0;
-	arvalid_o  = 'b0;
 	araddr_o   = 'b0;
+	arlen_o    = 'b0;
 	rready_o   = 'b0;
 	awvalid_o  = 'b0;
 	awaddr_o   = 'b0;
+	awlen_o    = 'b0;
 	wvalid_o   = 'b0;
 	wdata_o    = 'b0;
 	wstrb_o    = 'b0;
+	wlast_o    = 'b0;
 	bready_o   = 'b0;
 
 	rdata_reg_en_s = 'b0;
+	beat_cnt_en_s  = 'b0;
 	hs_ready_o = 'b0;
 
 	case(current_state_r)
@@ -161,7 +199,8 @@ always @(*) begin
 		// Read address transfer
 		AR_TR : begin
 			arvalid_o = 'b1;
-			araddr_o  = hs_addr_i;
+			araddr_o  = addr_r;
+			arlen_o   = len_r;
 		end
 
 		// Read data transfer
@@ -170,34 +209,46 @@ always @(*) begin
 			rdata_reg_en_s = 'b1;
 		end
 
+		// Send acknowledge of a read beat to hs interface
+		R_ACK : begin
+			hs_ready_o = 'b1;
+		end
+
 		// Write address/data transfer
+		// Write address is kept valid until accepted
 		W_TR : begin
-			awvalid_o = 'b1;
-			awaddr_o  = hs_addr_i;
-			
+			awvalid_o = !aw_done_r;
+			awaddr_o  = addr_r;
+			awlen_o   = len_r;
+
 			wvalid_o = 'b1;
 			wdata_o  = hs_data_i;
 			wstrb_o  = byte_select_i;
+			wlast_o  = (beat_cnt_r == len_r) ? 1'b1 : 1'b0;
+		end
+
+		// Send acknowledge of a write beat to hs interface
+		W_ACK : begin
+			awvalid_o = !aw_done_r;
+			awaddr_o  = addr_r;
+			awlen_o   = len_r;
+
+			hs_ready_o    = 'b1;
+			beat_cnt_en_s = 'b1;
 		end
 
 		// Wait end of write address transfer
 		WAIT_AW : begin
 			awvalid_o = 'b1;
-			awaddr_o  = hs_addr_i;
-		end
-		
-		// Wait end of write data transfer
-		WAIT_W : begin
-			wvalid_o = 'b1;
-			wdata_o  = hs_data_i;
-			wstrb_o  = byte_select_i;
+			awaddr_o  = addr_r;
+			awlen_o   = len_r;
 		end
 
 		// Write response transfer
 		B_TR : begin
 			bready_o = 'b1;
 		end
-        
+
 		// Send acknowledge to hs interface
 		HS_ACK : begin
 			hs_ready_o = 'b1;
@@ -207,6 +258,11 @@ always @(*) begin
 		end
 	endcase
 end
+// Only full word incrementing bursts are generated
+assign arsize_o  = 3'd2;
+assign arburst_o = 2'b01;
+assign awsize_o  = 3'd2;
+assign awburst_o = 2'b01;
 
 // Register to store data from axi interface
 always @(posedge clk_i) begin
@@ -219,4 +275,29 @@ always @(posedge clk_i) begin
 	end
 end
 
+// Registers to store transaction information
+always @(posedge clk_i) begin
+	if(rst_ni == 1'd0) begin
+		addr_r     <= 'b0;
+		len_r      <= 'b0;
+		beat_cnt_r <= 'b0;
+		aw_done_r  <= 'b0;
+	end else begin
+		if (current_state_r == IDLE) begin
+			// Sample request from hs interface
+			addr_r     <= hs_addr_i;
+			len_r      <= hs_len_i;
+			beat_cnt_r <= 'b0;
+			aw_done_r  <= 'b0;
+		end else begin
+			if (beat_cnt_en_s) begin
+				beat_cnt_r <= beat_cnt_r+1;
+			end
+			if (aw_done_s) begin
+				aw_done_r <= 1'b1;
+			end
+		end
+	end
+end
+
 endmodule
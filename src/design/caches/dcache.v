@@ -0,0 +1,405 @@
+module dcache #(
+	// Number of ways (1: direct mapped, 2: 2-way set associative)
+	parameter WAYS=2,
+	// Number of sets (power of 2, at least 2)
+	parameter SETS=8,
+	// Number of 32-bit words in a line (power of 2, at least 2)
+	parameter LINE_WORDS=4,
+	// Address ranges that are not cached (MMIO)
+	parameter N_UNCACHED=1,
+	parameter [(32*N_UNCACHED)-1:0] UNCACHED_BASE_ADDRESSES = 32'h00010000,
+	parameter [(32*N_UNCACHED)-1:0] UNCACHED_TOP_ADDRESSES  = 32'h0001ffff
+	)(
+	input  clk_i,
+	input  rst_ni,
+
+	// Write back all dirty lines
+	input  clean_i,
+	// Write back all dirty lines and invalidate all lines
+	input  flush_i,
+	// Clean/flush in progress
+	output busy_o,
+	// Clear hit/miss/writeback counters
+	input  cnt_clr_i,
+	// CPU has consumed the data (used only for statistics)
+	input  cpu_ack_i,
+
+	// Handshake interface from CPU
+	input  cpu_rd_i,
+	input  cpu_wr_i,
+	input  [31:0] cpu_addr_i,
+	input  [31:0] cpu_data_i,
+	input  [3:0] cpu_byte_select_i,
+	output cpu_ready_o,
+	output [31:0] cpu_data_o,
+
+	// Handshake interface towards memory (line fills, write backs and uncached accesses)
+	input  mem_ready_i,
+	input  [31:0] mem_data_i,
+	output reg mem_rd_o,
+	output reg mem_wr_o,
+	output reg [31:0] mem_addr_o,
+	output reg [31:0] mem_data_o,
+	output reg [3:0] mem_byte_select_o,
+	// Number of words of the transfer minus one (lines are transferred as bursts)
+	output reg [7:0] mem_len_o,
+
+	// Statistics
+	output reg [31:0] hit_cnt_o,
+	output reg [31:0] miss_cnt_o,
+	output reg [31:0] writeback_cnt_o
+);
+
+localparam OFFSET_WIDTH = $clog2(LINE_WORDS);
+localparam INDEX_WIDTH  = $clog2(SETS);
+localparam TAG_WIDTH    = 32-2-OFFSET_WIDTH-INDEX_WIDTH;
+localparam LINES        = WAYS*SETS;
+localparam LINE_WIDTH   = $clog2(LINES);
+
+// Fields of the address from CPU
+wire [TAG_WIDTH-1:0]    tag_s;
+wire [INDEX_WIDTH-1:0]  index_s;
+wire [OFFSET_WIDTH-1:0] offset_s;
+assign tag_s    = cpu_addr_i[31:2+OFFSET_WIDTH+INDEX_WIDTH];
+assign index_s  = cpu_addr_i[2+OFFSET_WIDTH+INDEX_WIDTH-1:2+OFFSET_WIDTH];
+assign offset_s = cpu_addr_i[2+OFFSET_WIDTH-1:2];
+
+// Cache storage
+// Line l=(way*SETS+set) is stored in words [l*LINE_WORDS, (l+1)*LINE_WORDS-1]
+reg [31:0] data_r [0:LINES*LINE_WORDS-1];
+reg [TAG_WIDTH-1:0] tag_r [0:LINES-1];
+reg [LINES-1:0] valid_r, dirty_r;
+// Way to be replaced on next miss, for each set
+reg [SETS-1:0] lru_r;
+
+/* ---------------------------------------------------
+* Lookup
+* --------------------------------------------------*/
+// Check if the address is in a non cacheable region
+reg uncached_s;
+integer r;
+always @(*) begin
+	uncached_s = 1'b0;
+	for (r=0; r<N_UNCACHED; r=r+1) begin
+		if (cpu_addr_i >= UNCACHED_BASE_ADDRESSES[(r*32)+:32] && cpu_addr_i <= UNCACHED_TOP_ADDRESSES[(r*32)+:32]) begin
+			uncached_s = 1'b1;
+		end
+	end
+end
+
+reg hit_s;
+reg hit_way_s;
+integer w;
+always @(*) begin
+	hit_s     = 1'b0;
+	hit_way_s = 1'b0;
+	for (w=0; w<WAYS; w=w+1) begin
+		if (valid_r[w*SETS+index_s] && tag_r[w*SETS+index_s]==tag_s) begin
+			hit_s     = 1'b1;
+			hit_way_s = w;
+		end
+	end
+end
+
+// Way where a missing line is allocated: first invalid way, otherwise the least recently used
+wire victim_way_s;
+assign victim_way_s = (WAYS==1) ? 1'b0 :
+                      (!valid_r[index_s])      ? 1'b0 :
+                      (!valid_r[SETS+index_s]) ? 1'b1 : lru_r[index_s];
+
+/* ---------------------------------------------------
+* Cache control FSM
+* --------------------------------------------------*/
+// Word counter for line transfers
+reg [OFFSET_WIDTH-1:0] cnt_r;
+// Line being written back
+reg [LINE_WIDTH-1:0]  wb_line_r;
+reg [TAG_WIDTH-1:0]   wb_tag_r;
+// Write back started by clean/flush (otherwise by a miss, followed by the fill)
+reg wb_flush_r;
+// Line being filled
+reg fill_way_r;
+reg [TAG_WIDTH-1:0]   fill_tag_r;
+reg [INDEX_WIDTH-1:0] fill_index_r;
+// Line being checked by clean/flush
+reg [LINE_WIDTH-1:0]  flush_line_r;
+// Pending clean/flush requests, flush also invalidates
+reg clean_pending_r, flush_pending_r, flush_inv_r;
+// Last access has been served by a line fill (do not count it as a hit)
+reg refill_r;
+
+// Signals and encoding for FSM status
+reg [2:0] current_state_r, next_state_s;
+localparam IDLE      = 3'd0;
+localparam BYPASS    = 3'd1;
+localparam WRITEBACK = 3'd2;
+localparam FILL      = 3'd3;
+localparam FLUSH     = 3'd4;
+
+// CPU access towards cached/uncached regions
+wire cpu_req_s;
+assign cpu_req_s = cpu_rd_i | cpu_wr_i;
+
+// FSM present state update
+always @(posedge clk_i) begin
+	if(rst_ni == 1'd0) begin
+		current_state_r <= IDLE;
+	end else begin
+		current_state_r <= next_state_s;
+	end
+end
+
+// FSM next state calculation
+always @(*) begin
+	// Default next state
+	next_state_s = current_state_r;
+
+ 	case(current_state_r)
+		// Serve hits, wait for misses, uncached accesses and clean/flush requests
+		IDLE : begin
+			if (clean_pending_r || flush_pending_r) begin
+				next_state_s = FLUSH;
+			end else if (cpu_req_s && uncached_s) begin
+				next_state_s = BYPASS;
+			end else if (cpu_req_s && !hit_s) begin
+				if (valid_r[victim_way_s*SETS+index_s] && dirty_r[victim_way_s*SETS+index_s]) begin
+					// Victim line has been modified, write it back before the fill
+					next_state_s = WRITEBACK;
+				end else begin
+					next_state_s = FILL;
+				end
+			end
+		end
+
+		// Forward uncached access to memory
+		BYPASS : begin
+			if (mem_ready_i) begin
+				next_state_s = IDLE;
+			end
+		end
+
+		// Write one word at a time to memory until the whole line is written
+		WRITEBACK : begin
+			if (mem_ready_i && cnt_r==LINE_WORDS-1) begin
+				if (wb_flush_r) begin
+					// Continue clean/flush
+					next_state_s = FLUSH;
+				end else begin
+					// Fill line that caused the miss
+					next_state_s = FILL;
+				end
+			end
+		end
+
+		// Read one word at a time from memory until the line is complete
+		FILL : begin
+			if (mem_ready_i && cnt_r==LINE_WORDS-1) begin
+				next_state_s = IDLE;
+			end
+		end
+
+		// Check one line at a time, write back the ones that have been modified
+		FLUSH : begin
+			if (valid_r[flush_line_r] && dirty_r[flush_line_r]) begin
+				next_state_s = WRITEBACK;
+			end else if (flush_line_r == LINES-1) begin
+				next_state_s = IDLE;
+			end
+		end
+
+        default : next_state_s = IDLE;
+	endcase
+end
+
+// FSM output calculation
+always @(*) begin
+	// Default output values
+	mem_rd_o          = 1'b0;
+	mem_wr_o          = 1'b0;
+	mem_addr_o        = 32'd0;
+	mem_data_o        = 32'd0;
+	mem_byte_select_o = 4'hf;
+	mem_len_o         = 8'd0;
+
+	case(current_state_r)
+		// Forward uncached access to memory
+		BYPASS : begin
+			mem_rd_o          = cpu_rd_i;
+			mem_wr_o          = cpu_wr_i;
+			mem_addr_o        = cpu_addr_i;
+			mem_data_o        = cpu_data_i;
+			mem_byte_select_o = cpu_byte_select_i;
+		end
+
+		// Write line to memory
+		WRITEBACK : begin
+			mem_wr_o   = 1'b1;
+			mem_addr_o = {wb_tag_r, wb_line_r[INDEX_WIDTH-1:0], cnt_r, 2'b00};
+			mem_data_o = data_r[wb_line_r*LINE_WORDS+cnt_r];
+			mem_len_o  = LINE_WORDS-1;
+		end
+
+		// Read line from memory
+		FILL : begin
+			mem_rd_o   = 1'b1;
+			mem_addr_o = {fill_tag_r, fill_index_r, cnt_r, 2'b00};
+			mem_len_o  = LINE_WORDS-1;
+		end
+
+		default : begin
+		end
+	endcase
+end
+
+// Hits are served in the same cycle, uncached accesses when memory is ready
+assign cpu_ready_o = (current_state_r==IDLE) ? (cpu_req_s && !uncached_s && hit_s && !clean_pending_r && !flush_pending_r) :
+                     (current_state_r==BYPASS) ? mem_ready_i : 1'b0;
+assign cpu_data_o  = (current_state_r==BYPASS) ? mem_data_i : data_r[(hit_way_s*SETS+index_s)*LINE_WORDS+offset_s];
+assign busy_o      = clean_pending_r | flush_pending_r;
+
+// Storage update
+integer i, b;
+always @(posedge clk_i) begin
+	if (rst_ni == 1'b0) begin
+		valid_r <= 'b0;
+		dirty_r <= 'b0;
+		lru_r   <= 'b0;
+		for (i=0; i<LINES; i=i+1) begin
+			tag_r[i] <= 'b0;
+		end
+		cnt_r        <= 'b0;
+		wb_line_r    <= 'b0;
+		wb_tag_r     <= 'b0;
+		wb_flush_r   <= 1'b0;
+		fill_way_r   <= 1'b0;
+		fill_tag_r   <= 'b0;
+		fill_index_r <= 'b0;
+		flush_line_r <= 'b0;
+		clean_pending_r <= 1'b0;
+		flush_pending_r <= 1'b0;
+		flush_inv_r     <= 1'b0;
+	end else begin
+		case(current_state_r)
+			IDLE : begin
+				cnt_r <= 'b0;
+				if (next_state_s == FLUSH) begin
+					// Start checking from first line
+					flush_line_r <= 'b0;
+					flush_inv_r  <= flush_pending_r;
+				end else if (next_state_s == WRITEBACK || next_state_s == FILL) begin
+					// Save line to be filled, victim is not valid anymore
+					fill_way_r   <= victim_way_s;
+					fill_tag_r   <= tag_s;
+					fill_index_r <= index_s;
+					wb_line_r    <= victim_way_s*SETS+index_s;
+					wb_tag_r     <= tag_r[victim_way_s*SETS+index_s];
+					wb_flush_r   <= 1'b0;
+					valid_r[victim_way_s*SETS+index_s] <= 1'b0;
+				end else if (cpu_ready_o) begin
+					// Write hit: update selected bytes, line must be written back on eviction
+					if (cpu_wr_i) begin
+						for (b=0; b<4; b=b+1) begin
+							if (cpu_byte_select_i[b]) begin
+								data_r[(hit_way_s*SETS+index_s)*LINE_WORDS+offset_s][(b*8)+:8] <= cpu_data_i[(b*8)+:8];
+							end
+						end
+						dirty_r[hit_way_s*SETS+index_s] <= 1'b1;
+					end
+					// The other way becomes the replacement candidate
+					if (cpu_ack_i && WAYS>1) begin
+						lru_r[index_s] <= ~hit_way_s;
+					end
+				end
+			end
+
+			WRITEBACK : begin
+				if (mem_ready_i) begin
+					cnt_r <= cnt_r+1;
+					if (cnt_r == LINE_WORDS-1) begin
+						dirty_r[wb_line_r] <= 1'b0;
+					end
+				end
+			end
+
+			FILL : begin
+				if (mem_ready_i) begin
+					data_r[(fill_way_r*SETS+fill_index_r)*LINE_WORDS+cnt_r] <= mem_data_i;
+					cnt_r <= cnt_r+1;
+					if (cnt_r == LINE_WORDS-1) begin
+						tag_r[fill_way_r*SETS+fill_index_r]   <= fill_tag_r;
+						valid_r[fill_way_r*SETS+fill_index_r] <= 1'b1;
+						dirty_r[fill_way_r*SETS+fill_index_r] <= 1'b0;
+						if (WAYS>1) begin
+							lru_r[fill_index_r] <= ~fill_way_r;
+						end
+					end
+				end
+			end
+
+			FLUSH : begin
+				cnt_r <= 'b0;
+				if (valid_r[flush_line_r] && dirty_r[flush_line_r]) begin
+					// Write back modified line
+					wb_line_r <= flush_line_r;
+					wb_tag_r  <= tag_r[flush_line_r];
+					wb_flush_r <= 1'b1;
+				end else begin
+					// Line is clean, invalidate it if flushing
+					if (flush_inv_r) begin
+						valid_r[flush_line_r] <= 1'b0;
+					end
+					flush_line_r <= flush_line_r+1;
+					// All lines checked, a flush requested during a clean starts again to invalidate all lines
+					if (flush_line_r == LINES-1) begin
+						clean_pending_r <= 1'b0;
+						if (flush_inv_r) begin
+							flush_pending_r <= 1'b0;
+						end
+					end
+				end
+			end
+
+			default : begin
+			end
+		endcase
+		// Save clean/flush requests until they can be served
+		if (clean_i) begin
+			clean_pending_r <= 1'b1;
+		end
+		if (flush_i) begin
+			flush_pending_r <= 1'b1;
+		end
+	end
+end
+
+/* ---------------------------------------------------
+* Statistics
+* --------------------------------------------------*/
+always @(posedge clk_i) begin
+	if (rst_ni == 1'b0 || cnt_clr_i == 1'b1) begin
+		hit_cnt_o       <= 'b0;
+		miss_cnt_o      <= 'b0;
+		writeback_cnt_o <= 'b0;
+		refill_r        <= 1'b0;
+	end else begin
+		// Every line fill is a miss
+		if (current_state_r==IDLE && (next_state_s==FILL || next_state_s==WRITEBACK)) begin
+			miss_cnt_o <= miss_cnt_o+1;
+		end
+		// Every line written to memory
+		if (current_state_r==WRITEBACK && next_state_s!=WRITEBACK) begin
+			writeback_cnt_o <= writeback_cnt_o+1;
+		end
+		// The access that caused the miss completes after the fill
+		if (current_state_r==FILL && next_state_s==IDLE) begin
+			refill_r <= 1'b1;
+		end else if (current_state_r==IDLE && cpu_ready_o && cpu_ack_i) begin
+			refill_r <= 1'b0;
+			if (!refill_r) begin
+				hit_cnt_o <= hit_cnt_o+1;
+			end
+		end
+	end
+end
+
+endmodule
@@ -0,0 +1,225 @@
+module icache #(
+	// Number of ways (1: direct mapped, 2: 2-way set associative)
+	parameter WAYS=2,
+	// Number of sets (power of 2, at least 2)
+	parameter SETS=8,
+	// Number of 32-bit words in a line (power of 2, at least 2)
+	parameter LINE_WORDS=4
+	)(
+	input  clk_i,
+	input  rst_ni,
+
+	// Invalidate all lines
+	input  invalidate_i,
+	// Clear hit/miss counters
+	input  cnt_clr_i,
+	// CPU has consumed the instruction (used only for statistics)
+	input  cpu_ack_i,
+
+	// Handshake interface from CPU
+	input  cpu_rd_i,
+	input  [31:0] cpu_addr_i,
+	output cpu_ready_o,
+	output [31:0] cpu_data_o,
+
+	// Handshake interface towards memory (line fills)
+	input  mem_ready_i,
+	input  [31:0] mem_data_i,
+	output reg mem_rd_o,
+	output [31:0] mem_addr_o,
+	// Number of words of the transfer minus one (lines are read as bursts)
+	output [7:0] mem_len_o,
+
+	// Statistics
+	output reg [31:0] hit_cnt_o,
+	output reg [31:0] miss_cnt_o
+);
+
+localparam OFFSET_WIDTH = $clog2(LINE_WORDS);
+localparam INDEX_WIDTH  = $clog2(SETS);
+localparam TAG_WIDTH    = 32-2-OFFSET_WIDTH-INDEX_WIDTH;
+localparam LINES        = WAYS*SETS;
+
+// Fields of the address from CPU
+wire [TAG_WIDTH-1:0]    tag_s;
+wire [INDEX_WIDTH-1:0]  index_s;
+wire [OFFSET_WIDTH-1:0] offset_s;
+assign tag_s    = cpu_addr_i[31:2+OFFSET_WIDTH+INDEX_WIDTH];
+assign index_s  = cpu_addr_i[2+OFFSET_WIDTH+INDEX_WIDTH-1:2+OFFSET_WIDTH];
+assign offset_s = cpu_addr_i[2+OFFSET_WIDTH-1:2];
+
+// Cache storage
+// Line l=(way*SETS+set) is stored in words [l*LINE_WORDS, (l+1)*LINE_WORDS-1]
+reg [31:0] data_r [0:LINES*LINE_WORDS-1];
+reg [TAG_WIDTH-1:0] tag_r [0:LINES-1];
+reg [LINES-1:0] valid_r;
+// Way to be replaced on next miss, for each set
+reg [SETS-1:0] lru_r;
+
+/* ---------------------------------------------------
+* Lookup
+* --------------------------------------------------*/
+reg hit_s;
+reg hit_way_s;
+integer w;
+always @(*) begin
+	hit_s     = 1'b0;
+	hit_way_s = 1'b0;
+	for (w=0; w<WAYS; w=w+1) begin
+		if (valid_r[w*SETS+index_s] && tag_r[w*SETS+index_s]==tag_s) begin
+			hit_s     = 1'b1;
+			hit_way_s = w;
+		end
+	end
+end
+assign cpu_ready_o = cpu_rd_i & hit_s;
+assign cpu_data_o  = data_r[(hit_way_s*SETS+index_s)*LINE_WORDS+offset_s];
+
+// Way where a missing line is allocated: first invalid way, otherwise the least recently used
+wire victim_way_s;
+assign victim_way_s = (WAYS==1) ? 1'b0 :
+                      (!valid_r[index_s])      ? 1'b0 :
+                      (!valid_r[SETS+index_s]) ? 1'b1 : lru_r[index_s];
+
+/* ---------------------------------------------------
+* Line fill FSM
+* --------------------------------------------------*/
+// Line being filled
+reg fill_way_r;
+reg [TAG_WIDTH-1:0]    fill_tag_r;
+reg [INDEX_WIDTH-1:0]  fill_index_r;
+reg [OFFSET_WIDTH-1:0] fill_cnt_r;
+// Invalidate received while filling, line must not be validated
+reg fill_discard_r;
+// Last access has been served by a line fill (do not count it as a hit)
+reg refill_r;
+
+// Signals and encoding for FSM status
+reg current_state_r, next_state_s;
+localparam IDLE = 1'd0;
+localparam FILL = 1'd1;
+
+// FSM present state update
+always @(posedge clk_i) begin
+	if(rst_ni == 1'd0) begin
+		current_state_r <= IDLE;
+	end else begin
+		current_state_r <= next_state_s;
+	end
+end
+
+// FSM next state calculation
+always @(*) begin
+	// Default next state
+	next_state_s = current_state_r;
+
+ 	case(current_state_r)
+		// Wait for a miss
+		IDLE : begin
+			if (cpu_rd_i && !hit_s && !invalidate_i) begin
+				next_state_s = FILL;
+			end
+		end
+
+		// Read one word at a time from memory until the line is complete
+		FILL : begin
+			if (mem_ready_i && fill_cnt_r==LINE_WORDS-1) begin
+				next_state_s = IDLE;
+			end
+		end
+
+        default : next_state_s = IDLE;
+	endcase
+end
+
+// FSM output calculation
+always @(*) begin
+	mem_rd_o = (current_state_r==FILL) ? 1'b1 : 1'b0;
+end
+assign mem_addr_o = {fill_tag_r, fill_index_r, fill_cnt_r, 2'b00};
+assign mem_len_o  = LINE_WORDS-1;
+
+// Storage update
+integer i;
+always @(posedge clk_i) begin
+	if (rst_ni == 1'b0) begin
+		valid_r <= 'b0;
+		lru_r   <= 'b0;
+		for (i=0; i<LINES; i=i+1) begin
+			tag_r[i] <= 'b0;
+		end
+		fill_way_r     <= 1'b0;
+		fill_tag_r     <= 'b0;
+		fill_index_r   <= 'b0;
+		fill_cnt_r     <= 'b0;
+		fill_discard_r <= 1'b0;
+	end else begin
+		case(current_state_r)
+			IDLE : begin
+				if (next_state_s == FILL) begin
+					// Save line to be filled, and invalidate it until the fill is complete
+					fill_way_r     <= victim_way_s;
+					fill_tag_r     <= tag_s;
+					fill_index_r   <= index_s;
+					fill_cnt_r     <= 'b0;
+					fill_discard_r <= 1'b0;
+					valid_r[victim_way_s*SETS+index_s] <= 1'b0;
+				end else if (cpu_ready_o && cpu_ack_i && WAYS>1) begin
+					// Hit: the other way becomes the replacement candidate
+					lru_r[index_s] <= ~hit_way_s;
+				end
+			end
+
+			FILL : begin
+				if (mem_ready_i) begin
+					data_r[(fill_way_r*SETS+fill_index_r)*LINE_WORDS+fill_cnt_r] <= mem_data_i;
+					fill_cnt_r <= fill_cnt_r+1;
+					if (fill_cnt_r == LINE_WORDS-1) begin
+						tag_r[fill_way_r*SETS+fill_index_r]   <= fill_tag_r;
+						valid_r[fill_way_r*SETS+fill_index_r] <= !(fill_discard_r || invalidate_i);
+						if (WAYS>1) begin
+							lru_r[fill_index_r] <= ~fill_way_r;
+						end
+					end
+				end
+				if (invalidate_i) begin
+					fill_discard_r <= 1'b1;
+				end
+			end
+
+			default : begin
+			end
+		endcase
+		// Invalidation of all lines
+		if (invalidate_i) begin
+			valid_r <= 'b0;
+		end
+	end
+end
+
+/* ---------------------------------------------------
+* Statistics
+* --------------------------------------------------*/
+always @(posedge clk_i) begin
+	if (rst_ni == 1'b0 || cnt_clr_i == 1'b1) begin
+		hit_cnt_o  <= 'b0;
+		miss_cnt_o <= 'b0;
+		refill_r   <= 1'b0;
+	end else begin
+		// Every line fill is a miss
+		if (current_state_r==IDLE && next_state_s==FILL) begin
+			miss_cnt_o <= miss_cnt_o+1;
+		end
+		// The access that caused the miss completes after the fill
+		if (current_state_r==FILL && next_state_s==IDLE) begin
+			refill_r <= 1'b1;
+		end else if (cpu_ready_o && cpu_ack_i) begin
+			refill_r <= 1'b0;
+			if (!refill_r) begin
+				hit_cnt_o <= hit_cnt_o+1;
+			end
+		end
+	end
+end
+
+endmodule
@@ -1,4 +1,13 @@
-module chip_top (
+module chip_top #(
+	// Depth of the UART and SPI fifos (bytes, power of 2, at least 4)
+	parameter UART_FIFO_DEPTH=16,
+	parameter SPI_FIFO_DEPTH=16,
+	// Number of 2KB SRAM banks (power of 2), the internal SRAM is RAM_BANKS*2KB
+	parameter RAM_BANKS=1,
+	// Size of the tightly-coupled instruction and data memories (bytes, power of 2, 0 for no memory)
+	parameter ITCM_SIZE=0,
+	parameter DTCM_SIZE=0
+	)(
 	input  clk_i,
 	input  rst_ni,
 	// Boot source strapping pins
@@ -8,12 +17,10 @@ module chip_top (
 	output tx_o,
 	input  rx_i,
 	// SPI
+	// IO0:MOSI, IO1:MISO, IO2:WP#, IO3:HOLD#
 	output spi_sck_o,
 	output spi_cs_no,
-	output spi_mosi_o,
-	input  spi_miso_i,
-	output wp_no,
-	output hold_no
+	inout  [3:0] spi_io
 `ifdef DDR
 	,
 	// DDR
@@ -37,28 +44,46 @@ module chip_top (
 
 //// Signals between cpu and memory interfaces controller
 // Intruction memory interface
-wire mem_ready_s, cpu_instr_mem_rd_s;
+wire cpu_instr_mem_ready_s, cpu_instr_mem_rd_s;
 wire [31:0] cpu_instr_mem_addr_s, cpu_instr_mem_data_s;
 // Data memory interface
-wire cpu_data_mem_rd_s, cpu_data_mem_wr_s;
+wire cpu_data_mem_ready_s, cpu_data_mem_rd_s, cpu_data_mem_wr_s, cpu_data_mem_fence_s;
 wire [31:0] cpu_data_mem_addr_s, cpu_data_mem_data_o_s, cpu_data_mem_data_i_s;
 wire [3:0]  cpu_data_mem_byte_select_s;
+// Direct interface to the tightly-coupled memories
+wire [31:0] itcm_cpu_addr_s, itcm_cpu_data_s;
+wire dtcm_cpu_wr_s;
+wire [31:0] dtcm_cpu_addr_s, dtcm_cpu_data_o_s, dtcm_cpu_data_i_s;
+wire [3:0]  dtcm_cpu_byte_select_s;
+// Code copy in progress (for CPU performance counters)
+wire copy_busy_s;
+// Branch predictor statistics
+wire bp_cnt_clr_s;
+wire [31:0] bp_hit_cnt_s, bp_miss_cnt_s;
 
 //// INSTRUCTION MEMORY AXI SIGNALS
 // Read Address (AR) channel
 wire instr_arvalid_s, instr_aready_s;
 wire [31:0] instr_araddr_s;
+wire [7:0] instr_arlen_s;
+wire [2:0] instr_arsize_s;
+wire [1:0] instr_arburst_s;
 // Read Data (R) channel
 wire instr_rvalid_s, instr_rready_s;
 wire [31:0] instr_rdata_s;
 wire [1:0] instr_rresp_s;
+wire instr_rlast_s;
 // Write Address (AW) channel
 wire instr_awvalid_s, instr_awready_s;
 wire [31:0] instr_awaddr_s;
+wire [7:0] instr_awlen_s;
+wire [2:0] instr_awsize_s;
+wire [1:0] instr_awburst_s;
 // Write Data (W) channel
 wire instr_wvalid_s, instr_wready_s;
 wire [31:0] instr_wdata_s;
 wire [3:0] instr_wstrb_s;
+wire instr_wlast_s;
 // Write Response (B) channel
 wire instr_bvalid_s, instr_bready_s;
 wire [1:0] instr_bresp_s;
@@ -67,21 +92,56 @@ wire [1:0] instr_bresp_s;
 // Read Address (AR) channel
 wire data_arvalid_s, data_aready_s;
 wire [31:0] data_araddr_s;
+wire [7:0] data_arlen_s;
+wire [2:0] data_arsize_s;
+wire [1:0] data_arburst_s;
 // Read Data (R) channel
 wire data_rvalid_s, data_rready_s;
 wire [31:0] data_rdata_s;
 wire [1:0] data_rresp_s;
+wire data_rlast_s;
 // Write Address (AW) channel
 wire data_awvalid_s, data_awready_s;
 wire [31:0] data_awaddr_s;
+wire [7:0] data_awlen_s;
+wire [2:0] data_awsize_s;
+wire [1:0] data_awburst_s;
 // Write Data (W) channel
 wire data_wvalid_s, data_wready_s;
 wire [31:0] data_wdata_s;
 wire [3:0] data_wstrb_s;
+wire data_wlast_s;
 // Write Response (B) channel
 wire data_bvalid_s, data_bready_s;
 wire [1:0] data_bresp_s;
 
+//// DMA MASTER AXI SIGNALS
+// Read Address (AR) channel
+wire dma_mst_arvalid_s, dma_mst_aready_s;
+wire [31:0] dma_mst_araddr_s;
+wire [7:0] dma_mst_arlen_s;
+wire [2:0] dma_mst_arsize_s;
+wire [1:0] dma_mst_arburst_s;
+// Read Data (R) channel
+wire dma_mst_rvalid_s, dma_mst_rready_s;
+wire [31:0] dma_mst_rdata_s;
+wire [1:0] dma_mst_rresp_s;
+wire dma_mst_rlast_s;
+// Write Address (AW) channel
+wire dma_mst_awvalid_s, dma_mst_awready_s;
+wire [31:0] dma_mst_awaddr_s;
+wire [7:0] dma_mst_awlen_s;
+wire [2:0] dma_mst_awsize_s;
+wire [1:0] dma_mst_awburst_s;
+// Write Data (W) channel
+wire dma_mst_wvalid_s, dma_mst_wready_s;
+wire [31:0] dma_mst_wdata_s;
+wire [3:0] dma_mst_wstrb_s;
+wire dma_mst_wlast_s;
+// Write Response (B) channel
+wire dma_mst_bvalid_s, dma_mst_bready_s;
+wire [1:0] dma_mst_bresp_s;
+
 //// UART AXI SIGNALS
 // Read Address (AR) channel
 wire uart_arvalid_s, uart_aready_s;
@@ -100,22 +160,83 @@ wire [3:0] uart_wstrb_s;
 // Write Response (B) channel
 wire uart_bvalid_s, uart_bready_s;
 wire [1:0] uart_bresp_s;
+// DMA requests
+wire uart_dma_rx_req_s, uart_dma_tx_req_s;
+// Interrupt request
+wire uart_irq_s;
+
+//// DMA AXI SIGNALS
+// Read Address (AR) channel
+wire dma_arvalid_s, dma_aready_s;
+wire [31:0] dma_araddr_s;
+// Read Data (R) channel
+wire dma_rvalid_s, dma_rready_s;
+wire [31:0] dma_rdata_s;
+wire [1:0] dma_rresp_s;
+// Write Address (AW) channel
+wire dma_awvalid_s, dma_awready_s;
+wire [31:0] dma_awaddr_s;
+// Write Data (W) channel
+wire dma_wvalid_s, dma_wready_s;
+wire [31:0] dma_wdata_s;
+wire [3:0] dma_wstrb_s;
+// Write Response (B) channel
+wire dma_bvalid_s, dma_bready_s;
+wire [1:0] dma_bresp_s;
+// Peripheral requests (0: memory, 1: UART, 2: SPI)
+localparam DMA_N_REQ = 4;
+wire [DMA_N_REQ-1:0] dma_rd_req_s, dma_wr_req_s;
+// Completed channels
+localparam DMA_N_CH = 4;
+wire [DMA_N_CH-1:0] dma_done_s;
+
+//// INTERRUPT CONTROLLER AXI SIGNALS
+// Read Address (AR) channel
+wire irq_arvalid_s, irq_aready_s;
+wire [31:0] irq_araddr_s;
+// Read Data (R) channel
+wire irq_rvalid_s, irq_rready_s;
+wire [31:0] irq_rdata_s;
+wire [1:0] irq_rresp_s;
+// Write Address (AW) channel
+wire irq_awvalid_s, irq_awready_s;
+wire [31:0] irq_awaddr_s;
+// Write Data (W) channel
+wire irq_wvalid_s, irq_wready_s;
+wire [31:0] irq_wdata_s;
+wire [3:0] irq_wstrb_s;
+// Write Response (B) channel
+wire irq_bvalid_s, irq_bready_s;
+wire [1:0] irq_bresp_s;
+// Interrupt sources (0: reserved, 1: UART, 2: SPI, 3: DMA)
+localparam IRQ_N_SRC = 8;
+wire [IRQ_N_SRC-1:0] irq_src_s;
+// Interrupt requests towards the CPU
+wire irq_meip_s, irq_msip_s, irq_mtip_s;
 
 //// DDR AXI SIGNALS (system clock domain)
 // Read Address (AR) channel
 wire ddr_arvalid_s, ddr_aready_s;
 wire [31:0] ddr_araddr_s;
+wire [7:0] ddr_arlen_s;
+wire [2:0] ddr_arsize_s;
+wire [1:0] ddr_arburst_s;
 // Read Data (R) channel
 wire ddr_rvalid_s, ddr_rready_s;
 wire [31:0] ddr_rdata_s;
 wire [1:0] ddr_rresp_s;
+wire ddr_rlast_s;
 // Write Address (AW) channel
 wire ddr_awvalid_s, ddr_awready_s;
 wire [31:0] ddr_awaddr_s;
+wire [7:0] ddr_awlen_s;
+wire [2:0] ddr_awsize_s;
+wire [1:0] ddr_awburst_s;
 // Write Data (W) channel
 wire ddr_wvalid_s, ddr_wready_s;
 wire [31:0] ddr_wdata_s;
 wire [3:0] ddr_wstrb_s;
+wire ddr_wlast_s;
 // Write Response (B) channel
 wire ddr_bvalid_s, ddr_bready_s;
 wire [1:0] ddr_bresp_s;
@@ -125,16 +246,25 @@ wire [1:0] ddr_bresp_s;
 // Read Address (AR) channel
 wire ddr_ref_arvalid_s, ddr_ref_aready_s;
 wire [31:0] ddr_ref_araddr_s;
+wire [7:0] ddr_ref_arlen_s;
+wire [2:0] ddr_ref_arsize_s;
+wire [1:0] ddr_ref_arburst_s;
 // Read Data (R) channel
 wire ddr_ref_rvalid_s, ddr_ref_rready_s;
 wire [31:0] ddr_ref_rdata_s;
 wire [1:0] ddr_ref_rresp_s;
+wire ddr_ref_rlast_s;
 // Write Address (AW) channel
 wire ddr_ref_awvalid_s, ddr_ref_awready_s;
 wire [31:0] ddr_ref_awaddr_s;
+wire [7:0] ddr_ref_awlen_s;
+wire [2:0] ddr_ref_awsize_s;
+wire [1:0] ddr_ref_awburst_s;
 // Write Data (W) channel
 wire ddr_ref_wvalid_s, ddr_ref_wready_s;
 wire [31:0] ddr_ref_wdata_s;
+wire [3:0] ddr_ref_wstrb_s;
+wire ddr_ref_wlast_s;
 // Write Response (B) channel
 wire ddr_ref_bvalid_s, ddr_ref_bready_s;
 wire [1:0] ddr_ref_bresp_s;
@@ -158,22 +288,129 @@ wire [3:0] spi_wstrb_s;
 // Write Response (B) channel
 wire spi_bvalid_s, spi_bready_s;
 wire [1:0] spi_bresp_s;
+// Direct interface for flash execute in place
+wire spi_xip_en_s, spi_xip_cs_hold_s, spi_xip_tx_wr_s, spi_xip_rx_rd_s;
+wire spi_xip_rx_not_empty_s, spi_xip_rx_flush_s, spi_xip_busy_s;
+wire [1:0] spi_xip_lanes_s;
+wire [7:0] spi_xip_tx_data_s, spi_xip_rx_data_s;
+// SPI data lanes
+wire [3:0] spi_sio_o_s, spi_sio_oe_s;
+// DMA requests
+wire spi_dma_rx_req_s, spi_dma_tx_req_s;
+// Interrupt request
+wire spi_irq_s;
+
+//// SPI FLASH WINDOW AXI SIGNALS
+// Read Address (AR) channel
+wire flash_arvalid_s, flash_aready_s;
+wire [31:0] flash_araddr_s;
+wire [7:0] flash_arlen_s;
+wire [2:0] flash_arsize_s;
+wire [1:0] flash_arburst_s;
+// Read Data (R) channel
+wire flash_rvalid_s, flash_rready_s;
+wire [31:0] flash_rdata_s;
+wire [1:0] flash_rresp_s;
+wire flash_rlast_s;
+// Write Address (AW) channel
+wire flash_awvalid_s, flash_awready_s;
+wire [31:0] flash_awaddr_s;
+wire [7:0] flash_awlen_s;
+wire [2:0] flash_awsize_s;
+wire [1:0] flash_awburst_s;
+// Write Data (W) channel
+wire flash_wvalid_s, flash_wready_s;
+wire [31:0] flash_wdata_s;
+wire [3:0] flash_wstrb_s;
+wire flash_wlast_s;
+// Write Response (B) channel
+wire flash_bvalid_s, flash_bready_s;
+wire [1:0] flash_bresp_s;
+// Flash readers sharing the SPI controller (0: boot controller, 1: flash window)
+wire [1:0] xip_req_s, xip_grant_s, xip_release_s;
+wire [1:0] xip_en_s, xip_cs_hold_s, xip_tx_wr_s, xip_rx_rd_s, xip_rx_not_empty_s, xip_rx_flush_s;
+wire [3:0] xip_lanes_s;
+wire [15:0] xip_tx_data_s;
+wire [7:0] xip_rx_data_s;
+wire xip_busy_s;
+
+//// ITCM AXI SIGNALS
+// Read Address (AR) channel
+wire itcm_arvalid_s, itcm_aready_s;
+wire [31:0] itcm_araddr_s;
+wire [7:0] itcm_arlen_s;
+wire [2:0] itcm_arsize_s;
+wire [1:0] itcm_arburst_s;
+// Read Data (R) channel
+wire itcm_rvalid_s, itcm_rready_s;
+wire [31:0] itcm_rdata_s;
+wire [1:0] itcm_rresp_s;
+wire itcm_rlast_s;
+// Write Address (AW) channel
+wire itcm_awvalid_s, itcm_awready_s;
+wire [31:0] itcm_awaddr_s;
+wire [7:0] itcm_awlen_s;
+wire [2:0] itcm_awsize_s;
+wire [1:0] itcm_awburst_s;
+// Write Data (W) channel
+wire itcm_wvalid_s, itcm_wready_s;
+wire [31:0] itcm_wdata_s;
+wire [3:0] itcm_wstrb_s;
+wire itcm_wlast_s;
+// Write Response (B) channel
+wire itcm_bvalid_s, itcm_bready_s;
+wire [1:0] itcm_bresp_s;
+
+//// DTCM AXI SIGNALS
+// Read Address (AR) channel
+wire dtcm_arvalid_s, dtcm_aready_s;
+wire [31:0] dtcm_araddr_s;
+wire [7:0] dtcm_arlen_s;
+wire [2:0] dtcm_arsize_s;
+wire [1:0] dtcm_arburst_s;
+// Read Data (R) channel
+wire dtcm_rvalid_s, dtcm_rready_s;
+wire [31:0] dtcm_rdata_s;
+wire [1:0] dtcm_rresp_s;
+wire dtcm_rlast_s;
+// Write Address (AW) channel
+wire dtcm_awvalid_s, dtcm_awready_s;
+wire [31:0] dtcm_awaddr_s;
+wire [7:0] dtcm_awlen_s;
+wire [2:0] dtcm_awsize_s;
+wire [1:0] dtcm_awburst_s;
+// Write Data (W) channel
+wire dtcm_wvalid_s, dtcm_wready_s;
+wire [31:0] dtcm_wdata_s;
+wire [3:0] dtcm_wstrb_s;
+wire dtcm_wlast_s;
+// Write Response (B) channel
+wire dtcm_bvalid_s, dtcm_bready_s;
+wire [1:0] dtcm_bresp_s;
 
 //// RAM AXI SIGNALS
 // Read Address (AR) channel
 wire ram_arvalid_s, ram_aready_s;
 wire [31:0] ram_araddr_s;
+wire [7:0] ram_arlen_s;
+wire [2:0] ram_arsize_s;
+wire [1:0] ram_arburst_s;
 // Read Data (R) channel
 wire ram_rvalid_s, ram_rready_s;
 wire [31:0] ram_rdata_s;
 wire [1:0] ram_rresp_s;
+wire ram_rlast_s;
 // Write Address (AW) channel
 wire ram_awvalid_s, ram_awready_s;
 wire [31:0] ram_awaddr_s;
+wire [7:0] ram_awlen_s;
+wire [2:0] ram_awsize_s;
+wire [1:0] ram_awburst_s;
 // Write Data (W) channel
 wire ram_wvalid_s, ram_wready_s;
 wire [31:0] ram_wdata_s;
 wire [3:0] ram_wstrb_s;
+wire ram_wlast_s;
 // Write Response (B) channel
 wire ram_bvalid_s, ram_bready_s;
 wire [1:0] ram_bresp_s;
@@ -198,59 +435,99 @@ wire boot_ctrl_bvalid_s, boot_ctrl_bready_s;
 wire [1:0] boot_ctrl_bresp_s;
 
 //// Packed AXI master interfaces
-localparam N_MST = 2;
+localparam N_MST = 3;
+// Width of the transaction IDs of masters and slaves
+// (the interconnect adds the index of the master on top of the master ID)
+localparam MST_ID_WIDTH = 1;
+localparam SLV_ID_WIDTH = MST_ID_WIDTH+$clog2(N_MST);
+// Arbitration policy of the slaves (0: fixed priority, 1: round-robin, 2: weighted round-robin)
+localparam ARB_POLICY = 1;
+// QoS statistics of the masters
+wire bus_stat_clr_s;
+wire [(32*N_MST)-1:0] bus_stat_tr_cnt_s, bus_stat_lat_cnt_s, bus_stat_max_wait_s;
 // Read Address (AR) channel
 wire [N_MST-1:0] mst_arvalid_s, mst_aready_s;
 wire [(32*N_MST)-1:0] mst_araddr_s;
+wire [(8*N_MST)-1:0] mst_arlen_s;
+wire [(3*N_MST)-1:0] mst_arsize_s;
+wire [(2*N_MST)-1:0] mst_arburst_s;
+wire [(MST_ID_WIDTH*N_MST)-1:0] mst_arid_s;
 // Read Data (R) channel
 wire [N_MST-1:0] mst_rvalid_s, mst_rready_s;
 wire [(32*N_MST)-1:0] mst_rdata_s;
 wire [(2*N_MST)-1:0] mst_rresp_s;
+wire [N_MST-1:0] mst_rlast_s;
 // Write Address (AW) channel
 wire [N_MST-1:0] mst_awvalid_s, mst_awready_s;
 wire [(32*N_MST)-1:0] mst_awaddr_s;
+wire [(8*N_MST)-1:0] mst_awlen_s;
+wire [(3*N_MST)-1:0] mst_awsize_s;
+wire [(2*N_MST)-1:0] mst_awburst_s;
+wire [(MST_ID_WIDTH*N_MST)-1:0] mst_awid_s;
 // Write Data (W) channel
 wire [N_MST-1:0] mst_wvalid_s, mst_wready_s;
 wire [(32*N_MST)-1:0] mst_wdata_s;
 wire [(4*N_MST)-1:0] mst_wstrb_s;
+wire [N_MST-1:0] mst_wlast_s;
 // Write Response (B) channel
 wire [N_MST-1:0] mst_bvalid_s, mst_bready_s;
 wire [(2*N_MST)-1:0] mst_bresp_s;
 
 //// Packing/Unpacking of master interfaces
 // Read Address (AR) channel
-assign mst_arvalid_s  = {data_arvalid_s, instr_arvalid_s};
+assign mst_arvalid_s  = {dma_mst_arvalid_s, data_arvalid_s, instr_arvalid_s};
 assign instr_aready_s = mst_aready_s[0];
 assign data_aready_s  = mst_aready_s[1];
-assign mst_araddr_s   = {data_araddr_s, instr_araddr_s};
+assign dma_mst_aready_s = mst_aready_s[2];
+assign mst_araddr_s   = {dma_mst_araddr_s, data_araddr_s, instr_araddr_s};
+assign mst_arlen_s    = {dma_mst_arlen_s, data_arlen_s, instr_arlen_s};
+assign mst_arsize_s   = {dma_mst_arsize_s, data_arsize_s, instr_arsize_s};
+assign mst_arburst_s  = {dma_mst_arburst_s, data_arburst_s, instr_arburst_s};
+// CPU interfaces issue one transaction at a time, always with the same ID
+assign mst_arid_s     = 'd0;
 // Read Data (R) channel
 assign instr_rvalid_s = mst_rvalid_s[0];
 assign data_rvalid_s  = mst_rvalid_s[1];
-assign mst_rready_s   = {data_rready_s ,instr_rready_s};
+assign dma_mst_rvalid_s = mst_rvalid_s[2];
+assign mst_rready_s   = {dma_mst_rready_s, data_rready_s ,instr_rready_s};
 assign instr_rdata_s  = mst_rdata_s[(0*32)+31:0*32];
 assign data_rdata_s   = mst_rdata_s[(1*32)+31:1*32];
+assign dma_mst_rdata_s = mst_rdata_s[(2*32)+31:2*32];
 assign instr_rresp_s  = mst_rresp_s[(0*2)+1:0*2];
 assign data_rresp_s   = mst_rresp_s[(1*2)+1:1*2];
+assign dma_mst_rresp_s = mst_rresp_s[(2*2)+1:2*2];
+assign instr_rlast_s  = mst_rlast_s[0];
+assign data_rlast_s   = mst_rlast_s[1];
+assign dma_mst_rlast_s = mst_rlast_s[2];
 // Write Address (AW) channel
-assign mst_awvalid_s   = {data_awvalid_s, instr_awvalid_s};
+assign mst_awvalid_s   = {dma_mst_awvalid_s, data_awvalid_s, instr_awvalid_s};
 assign instr_awready_s = mst_awready_s[0];
 assign data_awready_s  = mst_awready_s[1];
-assign mst_awaddr_s    = {data_awaddr_s, instr_awaddr_s};
+assign dma_mst_awready_s = mst_awready_s[2];
+assign mst_awaddr_s    = {dma_mst_awaddr_s, data_awaddr_s, instr_awaddr_s};
+assign mst_awlen_s     = {dma_mst_awlen_s, data_awlen_s, instr_awlen_s};
+assign mst_awsize_s    = {dma_mst_awsize_s, data_awsize_s, instr_awsize_s};
+assign mst_awburst_s   = {dma_mst_awburst_s, data_awburst_s, instr_awburst_s};
+assign mst_awid_s      = 'd0;
 // Write Data (W) channel
-assign mst_wvalid_s   = {data_wvalid_s, instr_wvalid_s};
+assign mst_wvalid_s   = {dma_mst_wvalid_s, data_wvalid_s, instr_wvalid_s};
 assign instr_wready_s = mst_wready_s[0];
 assign data_wready_s  = mst_wready_s[1];
-assign mst_wdata_s    = {data_wdata_s, instr_wdata_s};
-assign mst_wstrb_s    = {data_wstrb_s, instr_wstrb_s};
+assign dma_mst_wready_s = mst_wready_s[2];
+assign mst_wdata_s    = {dma_mst_wdata_s, data_wdata_s, instr_wdata_s};
+assign mst_wstrb_s    = {dma_mst_wstrb_s, data_wstrb_s, instr_wstrb_s};
+assign mst_wlast_s    = {dma_mst_wlast_s, data_wlast_s, instr_wlast_s};
 // Write Response (B) channel
 assign instr_bvalid_s = mst_bvalid_s[0];
 assign data_bvalid_s  = mst_bvalid_s[1];
-assign mst_bready_s   = {data_bready_s, instr_bready_s};
+assign dma_mst_bvalid_s = mst_bvalid_s[2];
+assign mst_bready_s   = {dma_mst_bready_s, data_bready_s, instr_bready_s};
 assign instr_bresp_s  = mst_bresp_s[(0*2)+1:0*2];
 assign data_bresp_s   = mst_bresp_s[(1*2)+1:1*2];
+assign dma_mst_bresp_s = mst_bresp_s[(2*2)+1:2*2];
 
 //// Packed AXI slave interfaces
-localparam N_SLV = 5;
+localparam N_SLV = 10;
 localparam UART_SLV_IDX       = 0;
 localparam UART_BASE_ADDRESS  = 32'h10100;
 localparam UART_ADDRESS_SPACE = 32'hff;
@@ -262,27 +539,63 @@ localparam DDR_BASE_ADDRESS   = 32'hf0000000;
 localparam DDR_ADDRESS_SPACE  = 32'h0fffffff;
 localparam RAM_SLV_IDX        = 3;
 localparam RAM_BASE_ADDRESS   = 32'h0;
-localparam RAM_ADDRESS_SPACE  = 32'h7ff;
+localparam RAM_ADDRESS_SPACE  = (32'h800*RAM_BANKS)-1;
 localparam BOOT_CTRL_SLV_IDX       = 4;
 localparam BOOT_CTRL_BASE_ADDRESS  = 32'h10000;
 localparam BOOT_CTRL_ADDRESS_SPACE = 32'hff;
+localparam DMA_SLV_IDX        = 5;
+localparam DMA_BASE_ADDRESS   = 32'h10300;
+localparam DMA_ADDRESS_SPACE  = 32'hff;
+localparam IRQ_SLV_IDX        = 6;
+localparam IRQ_BASE_ADDRESS   = 32'h10400;
+localparam IRQ_ADDRESS_SPACE  = 32'hff;
+localparam FLASH_SLV_IDX       = 7;
+localparam FLASH_BASE_ADDRESS  = 32'h20000000;
+localparam FLASH_ADDRESS_SPACE = 32'h00ffffff;
+localparam ITCM_SLV_IDX       = 8;
+localparam ITCM_BASE_ADDRESS  = 32'h00100000;
+localparam ITCM_ADDRESS_SPACE = ITCM_SIZE-1;
+localparam DTCM_SLV_IDX       = 9;
+localparam DTCM_BASE_ADDRESS  = 32'h00200000;
+localparam DTCM_ADDRESS_SPACE = DTCM_SIZE-1;
+// Register slaves only support single transfers (AXI-Lite)
+// Bursts are used only towards memories (RAM, DDR and flash window)
+localparam [N_SLV-1:0] SLV_AXI_LITE = (1<<UART_SLV_IDX) | (1<<SPI_SLV_IDX) | (1<<BOOT_CTRL_SLV_IDX) | (1<<DMA_SLV_IDX) | (1<<IRQ_SLV_IDX);
 // Read Address (AR) channel
 wire [N_SLV-1:0] slv_arvalid_s, slv_aready_s;
 wire [(32*N_SLV)-1:0] slv_araddr_s;
+wire [(8*N_SLV)-1:0] slv_arlen_s;
+wire [(3*N_SLV)-1:0] slv_arsize_s;
+wire [(2*N_SLV)-1:0] slv_arburst_s;
+wire [(SLV_ID_WIDTH*N_SLV)-1:0] slv_arid_s;
 // Read Data (R) channel
 wire [N_SLV-1:0] slv_rvalid_s, slv_rready_s;
 wire [(32*N_SLV)-1:0] slv_rdata_s;
 wire [(2*N_SLV)-1:0] slv_rresp_s;
+wire [N_SLV-1:0] slv_rlast_s;
+wire [(SLV_ID_WIDTH*N_SLV)-1:0] slv_rid_s;
 // Write Address (AW) channel
 wire [N_SLV-1:0] slv_awvalid_s, slv_awready_s;
 wire [(32*N_SLV)-1:0] slv_awaddr_s;
+wire [(8*N_SLV)-1:0] slv_awlen_s;
+wire [(3*N_SLV)-1:0] slv_awsize_s;
+wire [(2*N_SLV)-1:0] slv_awburst_s;
+wire [(SLV_ID_WIDTH*N_SLV)-1:0] slv_awid_s;
 // Write Data (W) channel
 wire [N_SLV-1:0] slv_wvalid_s, slv_wready_s;
 wire [(32*N_SLV)-1:0] slv_wdata_s;
 wire [(4*N_SLV)-1:0] slv_wstrb_s;
+wire [N_SLV-1:0] slv_wlast_s;
 // Write Response (B) channel
 wire [N_SLV-1:0] slv_bvalid_s, slv_bready_s;
 wire [(2*N_SLV)-1:0] slv_bresp_s;
+wire [(SLV_ID_WIDTH*N_SLV)-1:0] slv_bid_s;
+// Transaction IDs of the slaves with AXI4 interface
+wire [SLV_ID_WIDTH-1:0] ddr_arid_s, ddr_rid_s, ddr_awid_s, ddr_bid_s;
+wire [SLV_ID_WIDTH-1:0] ram_arid_s, ram_rid_s, ram_awid_s, ram_bid_s;
+wire [SLV_ID_WIDTH-1:0] flash_arid_s, flash_rid_s, flash_awid_s, flash_bid_s;
+wire [SLV_ID_WIDTH-1:0] itcm_arid_s, itcm_rid_s, itcm_awid_s, itcm_bid_s;
+wire [SLV_ID_WIDTH-1:0] dtcm_arid_s, dtcm_rid_s, dtcm_awid_s, dtcm_bid_s;
 
 //// Packing/Unpacking of slave interfaces
 // Read Address (AR) channel
@@ -291,78 +604,192 @@ assign spi_arvalid_s  = slv_arvalid_s[SPI_SLV_IDX];
 assign ddr_arvalid_s  = slv_arvalid_s[DDR_SLV_IDX];
 assign ram_arvalid_s  = slv_arvalid_s[RAM_SLV_IDX];
 assign boot_ctrl_arvalid_s = slv_arvalid_s[BOOT_CTRL_SLV_IDX];
-assign slv_aready_s   = {boot_ctrl_aready_s, ram_aready_s, ddr_aready_s, spi_aready_s, uart_aready_s};
+assign dma_arvalid_s  = slv_arvalid_s[DMA_SLV_IDX];
+assign irq_arvalid_s  = slv_arvalid_s[IRQ_SLV_IDX];
+assign flash_arvalid_s  = slv_arvalid_s[FLASH_SLV_IDX];
+assign itcm_arvalid_s  = slv_arvalid_s[ITCM_SLV_IDX];
+assign dtcm_arvalid_s  = slv_arvalid_s[DTCM_SLV_IDX];
+assign slv_aready_s   = {dtcm_aready_s, itcm_aready_s, flash_aready_s, irq_aready_s, dma_aready_s, boot_ctrl_aready_s, ram_aready_s, ddr_aready_s, spi_aready_s, uart_aready_s};
 assign uart_araddr_s  = slv_araddr_s[(UART_SLV_IDX*32)+31:UART_SLV_IDX*32];
 assign spi_araddr_s   = slv_araddr_s[(SPI_SLV_IDX*32)+31:SPI_SLV_IDX*32];
 assign ddr_araddr_s   = slv_araddr_s[(DDR_SLV_IDX*32)+31:DDR_SLV_IDX*32];
 assign ram_araddr_s   = slv_araddr_s[(RAM_SLV_IDX*32)+31:RAM_SLV_IDX*32];
 assign boot_ctrl_araddr_s = slv_araddr_s[(BOOT_CTRL_SLV_IDX*32)+31:BOOT_CTRL_SLV_IDX*32];
+assign dma_araddr_s  = slv_araddr_s[(DMA_SLV_IDX*32)+31:DMA_SLV_IDX*32];
+assign irq_araddr_s  = slv_araddr_s[(IRQ_SLV_IDX*32)+31:IRQ_SLV_IDX*32];
+assign flash_araddr_s   = slv_araddr_s[(FLASH_SLV_IDX*32)+31:FLASH_SLV_IDX*32];
+assign itcm_araddr_s   = slv_araddr_s[(ITCM_SLV_IDX*32)+31:ITCM_SLV_IDX*32];
+assign dtcm_araddr_s   = slv_araddr_s[(DTCM_SLV_IDX*32)+31:DTCM_SLV_IDX*32];
+assign ddr_arlen_s    = slv_arlen_s[(DDR_SLV_IDX*8)+7:DDR_SLV_IDX*8];
+assign ram_arlen_s    = slv_arlen_s[(RAM_SLV_IDX*8)+7:RAM_SLV_IDX*8];
+assign flash_arlen_s    = slv_arlen_s[(FLASH_SLV_IDX*8)+7:FLASH_SLV_IDX*8];
+assign itcm_arlen_s    = slv_arlen_s[(ITCM_SLV_IDX*8)+7:ITCM_SLV_IDX*8];
+assign dtcm_arlen_s    = slv_arlen_s[(DTCM_SLV_IDX*8)+7:DTCM_SLV_IDX*8];
+assign ddr_arsize_s   = slv_arsize_s[(DDR_SLV_IDX*3)+2:DDR_SLV_IDX*3];
+assign ram_arsize_s   = slv_arsize_s[(RAM_SLV_IDX*3)+2:RAM_SLV_IDX*3];
+assign flash_arsize_s   = slv_arsize_s[(FLASH_SLV_IDX*3)+2:FLASH_SLV_IDX*3];
+assign itcm_arsize_s   = slv_arsize_s[(ITCM_SLV_IDX*3)+2:ITCM_SLV_IDX*3];
+assign dtcm_arsize_s   = slv_arsize_s[(DTCM_SLV_IDX*3)+2:DTCM_SLV_IDX*3];
+assign ddr_arburst_s  = slv_arburst_s[(DDR_SLV_IDX*2)+1:DDR_SLV_IDX*2];
+assign ram_arburst_s  = slv_arburst_s[(RAM_SLV_IDX*2)+1:RAM_SLV_IDX*2];
+assign flash_arburst_s  = slv_arburst_s[(FLASH_SLV_IDX*2)+1:FLASH_SLV_IDX*2];
+assign itcm_arburst_s  = slv_arburst_s[(ITCM_SLV_IDX*2)+1:ITCM_SLV_IDX*2];
+assign dtcm_arburst_s  = slv_arburst_s[(DTCM_SLV_IDX*2)+1:DTCM_SLV_IDX*2];
+assign ddr_arid_s     = slv_arid_s[(DDR_SLV_IDX*SLV_ID_WIDTH)+SLV_ID_WIDTH-1:DDR_SLV_IDX*SLV_ID_WIDTH];
+assign ram_arid_s     = slv_arid_s[(RAM_SLV_IDX*SLV_ID_WIDTH)+SLV_ID_WIDTH-1:RAM_SLV_IDX*SLV_ID_WIDTH];
+assign flash_arid_s     = slv_arid_s[(FLASH_SLV_IDX*SLV_ID_WIDTH)+SLV_ID_WIDTH-1:FLASH_SLV_IDX*SLV_ID_WIDTH];
+assign itcm_arid_s     = slv_arid_s[(ITCM_SLV_IDX*SLV_ID_WIDTH)+SLV_ID_WIDTH-1:ITCM_SLV_IDX*SLV_ID_WIDTH];
+assign dtcm_arid_s     = slv_arid_s[(DTCM_SLV_IDX*SLV_ID_WIDTH)+SLV_ID_WIDTH-1:DTCM_SLV_IDX*SLV_ID_WIDTH];
 // Read Data (R) channel
-assign slv_rvalid_s  = {boot_ctrl_rvalid_s, ram_rvalid_s, ddr_rvalid_s, spi_rvalid_s, uart_rvalid_s};
+assign slv_rvalid_s  = {dtcm_rvalid_s, itcm_rvalid_s, flash_rvalid_s, irq_rvalid_s, dma_rvalid_s, boot_ctrl_rvalid_s, ram_rvalid_s, ddr_rvalid_s, spi_rvalid_s, uart_rvalid_s};
 assign uart_rready_s = slv_rready_s[UART_SLV_IDX];
 assign spi_rready_s  = slv_rready_s[SPI_SLV_IDX];
 assign ddr_rready_s  = slv_rready_s[DDR_SLV_IDX];
 assign ram_rready_s  = slv_rready_s[RAM_SLV_IDX];
 assign boot_ctrl_rready_s = slv_rready_s[BOOT_CTRL_SLV_IDX];
-assign slv_rdata_s   = {boot_ctrl_rdata_s, ram_rdata_s, ddr_rdata_s, spi_rdata_s, uart_rdata_s};
-assign slv_rresp_s   = {boot_ctrl_rresp_s, ram_rresp_s, ddr_rresp_s, spi_rresp_s, uart_rresp_s};
+assign dma_rready_s  = slv_rready_s[DMA_SLV_IDX];
+assign irq_rready_s  = slv_rready_s[IRQ_SLV_IDX];
+assign flash_rready_s  = slv_rready_s[FLASH_SLV_IDX];
+assign itcm_rready_s  = slv_rready_s[ITCM_SLV_IDX];
+assign dtcm_rready_s  = slv_rready_s[DTCM_SLV_IDX];
+assign slv_rdata_s   = {dtcm_rdata_s, itcm_rdata_s, flash_rdata_s, irq_rdata_s, dma_rdata_s, boot_ctrl_rdata_s, ram_rdata_s, ddr_rdata_s, spi_rdata_s, uart_rdata_s};
+assign slv_rresp_s   = {dtcm_rresp_s, itcm_rresp_s, flash_rresp_s, irq_rresp_s, dma_rresp_s, boot_ctrl_rresp_s, ram_rresp_s, ddr_rresp_s, spi_rresp_s, uart_rresp_s};
+// Not used for AXI-Lite slaves
+assign slv_rlast_s   = {dtcm_rlast_s, itcm_rlast_s, flash_rlast_s, 1'b1, 1'b1, 1'b1, ram_rlast_s, ddr_rlast_s, 1'b1, 1'b1};
+assign slv_rid_s     = {dtcm_rid_s, itcm_rid_s, flash_rid_s, {SLV_ID_WIDTH{1'b0}}, {SLV_ID_WIDTH{1'b0}}, {SLV_ID_WIDTH{1'b0}}, ram_rid_s, ddr_rid_s, {SLV_ID_WIDTH{1'b0}}, {SLV_ID_WIDTH{1'b0}}};
 // Write Address (AW) channel
 assign uart_awvalid_s = slv_awvalid_s[UART_SLV_IDX];
 assign spi_awvalid_s  = slv_awvalid_s[SPI_SLV_IDX];
 assign ddr_awvalid_s  = slv_awvalid_s[DDR_SLV_IDX];
 assign ram_awvalid_s  = slv_awvalid_s[RAM_SLV_IDX];
 assign boot_ctrl_awvalid_s = slv_awvalid_s[BOOT_CTRL_SLV_IDX];
-assign slv_awready_s  = {boot_ctrl_awready_s, ram_awready_s, ddr_awready_s, spi_awready_s, uart_awready_s};
+assign dma_awvalid_s  = slv_awvalid_s[DMA_SLV_IDX];
+assign irq_awvalid_s  = slv_awvalid_s[IRQ_SLV_IDX];
+assign flash_awvalid_s  = slv_awvalid_s[FLASH_SLV_IDX];
+assign itcm_awvalid_s  = slv_awvalid_s[ITCM_SLV_IDX];
+assign dtcm_awvalid_s  = slv_awvalid_s[DTCM_SLV_IDX];
+assign slv_awready_s  = {dtcm_awready_s, itcm_awready_s, flash_awready_s, irq_awready_s, dma_awready_s, boot_ctrl_awready_s, ram_awready_s, ddr_awready_s, spi_awready_s, uart_awready_s};
 assign uart_awaddr_s  = slv_awaddr_s[(UART_SLV_IDX*32)+31:UART_SLV_IDX*32];
 assign spi_awaddr_s   = slv_awaddr_s[(SPI_SLV_IDX*32)+31:SPI_SLV_IDX*32];
 assign ddr_awaddr_s   = slv_awaddr_s[(DDR_SLV_IDX*32)+31:DDR_SLV_IDX*32];
 assign ram_awaddr_s   = slv_awaddr_s[(RAM_SLV_IDX*32)+31:RAM_SLV_IDX*32];
 assign boot_ctrl_awaddr_s = slv_awaddr_s[(BOOT_CTRL_SLV_IDX*32)+31:BOOT_CTRL_SLV_IDX*32];
+assign dma_awaddr_s  = slv_awaddr_s[(DMA_SLV_IDX*32)+31:DMA_SLV_IDX*32];
+assign irq_awaddr_s  = slv_awaddr_s[(IRQ_SLV_IDX*32)+31:IRQ_SLV_IDX*32];
+assign flash_awaddr_s   = slv_awaddr_s[(FLASH_SLV_IDX*32)+31:FLASH_SLV_IDX*32];
+assign itcm_awaddr_s   = slv_awaddr_s[(ITCM_SLV_IDX*32)+31:ITCM_SLV_IDX*32];
+assign dtcm_awaddr_s   = slv_awaddr_s[(DTCM_SLV_IDX*32)+31:DTCM_SLV_IDX*32];
+assign ddr_awlen_s    = slv_awlen_s[(DDR_SLV_IDX*8)+7:DDR_SLV_IDX*8];
+assign ram_awlen_s    = slv_awlen_s[(RAM_SLV_IDX*8)+7:RAM_SLV_IDX*8];
+assign flash_awlen_s    = slv_awlen_s[(FLASH_SLV_IDX*8)+7:FLASH_SLV_IDX*8];
+assign itcm_awlen_s    = slv_awlen_s[(ITCM_SLV_IDX*8)+7:ITCM_SLV_IDX*8];
+assign dtcm_awlen_s    = slv_awlen_s[(DTCM_SLV_IDX*8)+7:DTCM_SLV_IDX*8];
+assign ddr_awsize_s   = slv_awsize_s[(DDR_SLV_IDX*3)+2:DDR_SLV_IDX*3];
+assign ram_awsize_s   = slv_awsize_s[(RAM_SLV_IDX*3)+2:RAM_SLV_IDX*3];
+assign flash_awsize_s   = slv_awsize_s[(FLASH_SLV_IDX*3)+2:FLASH_SLV_IDX*3];
+assign itcm_awsize_s   = slv_awsize_s[(ITCM_SLV_IDX*3)+2:ITCM_SLV_IDX*3];
+assign dtcm_awsize_s   = slv_awsize_s[(DTCM_SLV_IDX*3)+2:DTCM_SLV_IDX*3];
+assign ddr_awburst_s  = slv_awburst_s[(DDR_SLV_IDX*2)+1:DDR_SLV_IDX*2];
+assign ram_awburst_s  = slv_awburst_s[(RAM_SLV_IDX*2)+1:RAM_SLV_IDX*2];
+assign flash_awburst_s  = slv_awburst_s[(FLASH_SLV_IDX*2)+1:FLASH_SLV_IDX*2];
+assign itcm_awburst_s  = slv_awburst_s[(ITCM_SLV_IDX*2)+1:ITCM_SLV_IDX*2];
+assign dtcm_awburst_s  = slv_awburst_s[(DTCM_SLV_IDX*2)+1:DTCM_SLV_IDX*2];
+assign ddr_awid_s     = slv_awid_s[(DDR_SLV_IDX*SLV_ID_WIDTH)+SLV_ID_WIDTH-1:DDR_SLV_IDX*SLV_ID_WIDTH];
+assign ram_awid_s     = slv_awid_s[(RAM_SLV_IDX*SLV_ID_WIDTH)+SLV_ID_WIDTH-1:RAM_SLV_IDX*SLV_ID_WIDTH];
+assign flash_awid_s     = slv_awid_s[(FLASH_SLV_IDX*SLV_ID_WIDTH)+SLV_ID_WIDTH-1:FLASH_SLV_IDX*SLV_ID_WIDTH];
+assign itcm_awid_s     = slv_awid_s[(ITCM_SLV_IDX*SLV_ID_WIDTH)+SLV_ID_WIDTH-1:ITCM_SLV_IDX*SLV_ID_WIDTH];
+assign dtcm_awid_s     = slv_awid_s[(DTCM_SLV_IDX*SLV_ID_WIDTH)+SLV_ID_WIDTH-1:DTCM_SLV_IDX*SLV_ID_WIDTH];
 // Write Data (W) channel
 assign uart_wvalid_s = slv_wvalid_s[UART_SLV_IDX];
 assign spi_wvalid_s  = slv_wvalid_s[SPI_SLV_IDX];
 assign ddr_wvalid_s  = slv_wvalid_s[DDR_SLV_IDX];
 assign ram_wvalid_s  = slv_wvalid_s[RAM_SLV_IDX];
 assign boot_ctrl_wvalid_s = slv_wvalid_s[BOOT_CTRL_SLV_IDX];
-assign slv_wready_s  = {boot_ctrl_wready_s, ram_wready_s, ddr_wready_s, spi_wready_s, uart_wready_s};
+assign dma_wvalid_s  = slv_wvalid_s[DMA_SLV_IDX];
+assign irq_wvalid_s  = slv_wvalid_s[IRQ_SLV_IDX];
+assign flash_wvalid_s  = slv_wvalid_s[FLASH_SLV_IDX];
+assign itcm_wvalid_s  = slv_wvalid_s[ITCM_SLV_IDX];
+assign dtcm_wvalid_s  = slv_wvalid_s[DTCM_SLV_IDX];
+assign slv_wready_s  = {dtcm_wready_s, itcm_wready_s, flash_wready_s, irq_wready_s, dma_wready_s, boot_ctrl_wready_s, ram_wready_s, ddr_wready_s, spi_wready_s, uart_wready_s};
 assign uart_wdata_s  = slv_wdata_s[(UART_SLV_IDX*32)+31:UART_SLV_IDX*32];
 assign spi_wdata_s   = slv_wdata_s[(SPI_SLV_IDX*32)+31:SPI_SLV_IDX*32];
 assign ddr_wdata_s   = slv_wdata_s[(DDR_SLV_IDX*32)+31:DDR_SLV_IDX*32];
 assign ram_wdata_s   = slv_wdata_s[(RAM_SLV_IDX*32)+31:RAM_SLV_IDX*32];
 assign boot_ctrl_wdata_s = slv_wdata_s[(BOOT_CTRL_SLV_IDX*32)+31:BOOT_CTRL_SLV_IDX*32];
+assign dma_wdata_s  = slv_wdata_s[(DMA_SLV_IDX*32)+31:DMA_SLV_IDX*32];
+assign irq_wdata_s  = slv_wdata_s[(IRQ_SLV_IDX*32)+31:IRQ_SLV_IDX*32];
+assign flash_wdata_s   = slv_wdata_s[(FLASH_SLV_IDX*32)+31:FLASH_SLV_IDX*32];
+assign itcm_wdata_s   = slv_wdata_s[(ITCM_SLV_IDX*32)+31:ITCM_SLV_IDX*32];
+assign dtcm_wdata_s   = slv_wdata_s[(DTCM_SLV_IDX*32)+31:DTCM_SLV_IDX*32];
 assign uart_wstrb_s  = slv_wstrb_s[(UART_SLV_IDX*4)+3:UART_SLV_IDX*4];
 assign spi_wstrb_s   = slv_wstrb_s[(SPI_SLV_IDX*4)+3:SPI_SLV_IDX*4];
 assign ddr_wstrb_s   = slv_wstrb_s[(DDR_SLV_IDX*4)+3:DDR_SLV_IDX*4];
 assign ram_wstrb_s   = slv_wstrb_s[(RAM_SLV_IDX*4)+3:RAM_SLV_IDX*4];
 assign boot_ctrl_wstrb_s = slv_wstrb_s[(BOOT_CTRL_SLV_IDX*4)+3:BOOT_CTRL_SLV_IDX*4];
+assign dma_wstrb_s  = slv_wstrb_s[(DMA_SLV_IDX*4)+3:DMA_SLV_IDX*4];
+assign irq_wstrb_s  = slv_wstrb_s[(IRQ_SLV_IDX*4)+3:IRQ_SLV_IDX*4];
+assign flash_wstrb_s   = slv_wstrb_s[(FLASH_SLV_IDX*4)+3:FLASH_SLV_IDX*4];
+assign itcm_wstrb_s   = slv_wstrb_s[(ITCM_SLV_IDX*4)+3:ITCM_SLV_IDX*4];
+assign dtcm_wstrb_s   = slv_wstrb_s[(DTCM_SLV_IDX*4)+3:DTCM_SLV_IDX*4];
+assign ddr_wlast_s   = slv_wlast_s[DDR_SLV_IDX];
+assign ram_wlast_s   = slv_wlast_s[RAM_SLV_IDX];
+assign flash_wlast_s   = slv_wlast_s[FLASH_SLV_IDX];
+assign itcm_wlast_s   = slv_wlast_s[ITCM_SLV_IDX];
+assign dtcm_wlast_s   = slv_wlast_s[DTCM_SLV_IDX];
 // Write Response (B) channel
-assign slv_bvalid_s  = {boot_ctrl_bvalid_s, ram_bvalid_s, ddr_bvalid_s, spi_bvalid_s, uart_bvalid_s};
+assign slv_bvalid_s  = {dtcm_bvalid_s, itcm_bvalid_s, flash_bvalid_s, irq_bvalid_s, dma_bvalid_s, boot_ctrl_bvalid_s, ram_bvalid_s, ddr_bvalid_s, spi_bvalid_s, uart_bvalid_s};
 assign uart_bready_s = slv_bready_s[UART_SLV_IDX];
 assign spi_bready_s  = slv_bready_s[SPI_SLV_IDX];
 assign ddr_bready_s  = slv_bready_s[DDR_SLV_IDX];
 assign ram_bready_s  = slv_bready_s[RAM_SLV_IDX];
 assign boot_ctrl_bready_s = slv_bready_s[BOOT_CTRL_SLV_IDX];
-assign slv_bresp_s   = {boot_ctrl_bresp_s, ram_bresp_s, ddr_bresp_s, spi_bresp_s, uart_bresp_s};
+assign dma_bready_s  = slv_bready_s[DMA_SLV_IDX];
+assign irq_bready_s  = slv_bready_s[IRQ_SLV_IDX];
+assign flash_bready_s  = slv_bready_s[FLASH_SLV_IDX];
+assign itcm_bready_s  = slv_bready_s[ITCM_SLV_IDX];
+assign dtcm_bready_s  = slv_bready_s[DTCM_SLV_IDX];
+assign slv_bresp_s   = {dtcm_bresp_s, itcm_bresp_s, flash_bresp_s, irq_bresp_s, dma_bresp_s, boot_ctrl_bresp_s, ram_bresp_s, ddr_bresp_s, spi_bresp_s, uart_bresp_s};
+// Not used for AXI-Lite slaves
+assign slv_bid_s     = {dtcm_bid_s, itcm_bid_s, flash_bid_s, {SLV_ID_WIDTH{1'b0}}, {SLV_ID_WIDTH{1'b0}}, {SLV_ID_WIDTH{1'b0}}, ram_bid_s, ddr_bid_s, {SLV_ID_WIDTH{1'b0}}, {SLV_ID_WIDTH{1'b0}}};
 
 cpu inst_cpu(
 	.clk_i(clk_i),
     .rst_ni(rst_ni),
-	.mem_ready_i(mem_ready_s),
 	.trap_o(),
+	// Interrupt requests
+	.irq_external_i(irq_meip_s),
+	.irq_timer_i(irq_mtip_s),
+	.irq_software_i(irq_msip_s),
+	.copy_busy_i(copy_busy_s),
+	// Branch predictor statistics
+	.bp_cnt_clr_i(bp_cnt_clr_s),
+	.bp_hit_cnt_o(bp_hit_cnt_s),
+	.bp_miss_cnt_o(bp_miss_cnt_s),
 	// Instruction memory IOs
+	.instr_mem_ready_i(cpu_instr_mem_ready_s),
 	.instr_mem_data_i(cpu_instr_mem_data_s),
 	.instr_mem_addr_o(cpu_instr_mem_addr_s),
 	.instr_mem_rd_o(cpu_instr_mem_rd_s),
 	// Data memory IOs
+	.data_mem_ready_i(cpu_data_mem_ready_s),
 	.data_mem_data_i(cpu_data_mem_data_i_s),
 	.data_mem_addr_o(cpu_data_mem_addr_s),
 	.data_mem_data_o(cpu_data_mem_data_o_s),
 	.data_mem_rd_o(cpu_data_mem_rd_s),
 	.data_mem_wr_o(cpu_data_mem_wr_s),
+	.data_mem_fence_o(cpu_data_mem_fence_s),
 	.byte_select_o(cpu_data_mem_byte_select_s)
 );
 
-axi_cpu_interface_ctrl inst_axi_cpu_interface_ctrl(	
+axi_cpu_interface_ctrl #(
+	.BUS_N_MST(N_MST),
+	.ITCM_BASE_ADDRESS(ITCM_BASE_ADDRESS),
+	.ITCM_SIZE(ITCM_SIZE),
+	.DTCM_BASE_ADDRESS(DTCM_BASE_ADDRESS),
+	.DTCM_SIZE(DTCM_SIZE),
+	.SPI_FIFO_DEPTH(SPI_FIFO_DEPTH)
+	)
+	inst_axi_cpu_interface_ctrl(	
 	.clk_i(clk_i),
 	.rst_ni(rst_ni),
 	// Boot source strapping pins
@@ -391,38 +818,55 @@ axi_cpu_interface_ctrl inst_axi_cpu_interface_ctrl(
 	.boot_ctrl_bvalid_o(boot_ctrl_bvalid_s),
 	.boot_ctrl_bready_i(boot_ctrl_bready_s),
 	.boot_ctrl_bresp_o(boot_ctrl_bresp_s),
-	// CPU stall signal
-	.mem_ready_o(mem_ready_s),
 	// Instruction memory IOs towards CPU
+	.cpu_instr_mem_ready_o(cpu_instr_mem_ready_s),
 	.cpu_instr_mem_rd_i(cpu_instr_mem_rd_s),
 	.cpu_instr_mem_addr_i(cpu_instr_mem_addr_s),
 	.cpu_instr_mem_data_o(cpu_instr_mem_data_s),
 	// Data memory IOs towards CPU
+	.cpu_data_mem_ready_o(cpu_data_mem_ready_s),
 	.cpu_data_mem_rd_i(cpu_data_mem_rd_s),
 	.cpu_data_mem_wr_i(cpu_data_mem_wr_s),
+	.cpu_data_mem_fence_i(cpu_data_mem_fence_s),
 	.cpu_data_mem_addr_i(cpu_data_mem_addr_s),
 	.cpu_data_mem_data_i(cpu_data_mem_data_o_s),
 	.cpu_data_mem_data_o(cpu_data_mem_data_i_s),
 	.cpu_byte_select_i(cpu_data_mem_byte_select_s),
+	//// Direct interface to the tightly-coupled memories
+	.itcm_addr_o(itcm_cpu_addr_s),
+	.itcm_data_i(itcm_cpu_data_s),
+	.dtcm_wr_o(dtcm_cpu_wr_s),
+	.dtcm_addr_o(dtcm_cpu_addr_s),
+	.dtcm_data_o(dtcm_cpu_data_o_s),
+	.dtcm_byte_select_o(dtcm_cpu_byte_select_s),
+	.dtcm_data_i(dtcm_cpu_data_i_s),
 	//// Instruction memory AXI interface
 	// Read Address (AR) channel
 	.instr_arvalid_o(instr_arvalid_s),
 	.instr_aready_i(instr_aready_s),
 	.instr_araddr_o(instr_araddr_s),
+	.instr_arlen_o(instr_arlen_s),
+	.instr_arsize_o(instr_arsize_s),
+	.instr_arburst_o(instr_arburst_s),
 	// Read Data (R) channel
 	.instr_rvalid_i(instr_rvalid_s),
 	.instr_rready_o(instr_rready_s),
 	.instr_rdata_i(instr_rdata_s),
 	.instr_rresp_i(instr_rresp_s),
+	.instr_rlast_i(instr_rlast_s),
 	// Write Address (AW) channel
 	.instr_awvalid_o(instr_awvalid_s),
 	.instr_awready_i(instr_awready_s),
 	.instr_awaddr_o(instr_awaddr_s),
+	.instr_awlen_o(instr_awlen_s),
+	.instr_awsize_o(instr_awsize_s),
+	.instr_awburst_o(instr_awburst_s),
 	// Write Data (W) channel
 	.instr_wvalid_o(instr_wvalid_s),
 	.instr_wready_i(instr_wready_s),
 	.instr_wdata_o(instr_wdata_s),
 	.instr_wstrb_o(instr_wstrb_s),
+	.instr_wlast_o(instr_wlast_s),
 	// Write Response (B) channel
 	.instr_bvalid_i(instr_bvalid_s),
 	.instr_bready_o(instr_bready_s),
@@ -432,39 +876,84 @@ axi_cpu_interface_ctrl inst_axi_cpu_interface_ctrl(
 	.data_arvalid_o(data_arvalid_s),
 	.data_aready_i(data_aready_s),
 	.data_araddr_o(data_araddr_s),
+	.data_arlen_o(data_arlen_s),
+	.data_arsize_o(data_arsize_s),
+	.data_arburst_o(data_arburst_s),
 	// Read Data (R) channel
 	.data_rvalid_i(data_rvalid_s),
 	.data_rready_o(data_rready_s),
 	.data_rdata_i(data_rdata_s),
 	.data_rresp_i(data_rresp_s),
+	.data_rlast_i(data_rlast_s),
 	// Write Address (AW) channel
 	.data_awvalid_o(data_awvalid_s),
 	.data_awready_i(data_awready_s),
 	.data_awaddr_o(data_awaddr_s),
+	.data_awlen_o(data_awlen_s),
+	.data_awsize_o(data_awsize_s),
+	.data_awburst_o(data_awburst_s),
 	// Write Data (W) channel
 	.data_wvalid_o(data_wvalid_s),
 	.data_wready_i(data_wready_s),
 	.data_wdata_o(data_wdata_s),
 	.data_wstrb_o(data_wstrb_s),
+	.data_wlast_o(data_wlast_s),
 	// Write Response (B) channel
 	.data_bvalid_i(data_bvalid_s),
 	.data_bready_o(data_bready_s),
-	.data_bresp_i(data_bresp_s)
+	.data_bresp_i(data_bresp_s),
+	//// Direct interface to SPI controller (flash execute in place)
+	.spi_xip_en_o(xip_en_s[0]),
+	.spi_xip_cs_hold_o(xip_cs_hold_s[0]),
+	.spi_xip_lanes_o(xip_lanes_s[1:0]),
+	.spi_xip_tx_wr_o(xip_tx_wr_s[0]),
+	.spi_xip_tx_data_o(xip_tx_data_s[7:0]),
+	.spi_xip_rx_rd_o(xip_rx_rd_s[0]),
+	.spi_xip_rx_data_i(xip_rx_data_s),
+	.spi_xip_rx_not_empty_i(xip_rx_not_empty_s[0]),
+	.spi_xip_rx_flush_o(xip_rx_flush_s[0]),
+	.spi_xip_busy_i(xip_busy_s),
+	.spi_xip_req_o(xip_req_s[0]),
+	.spi_xip_grant_i(xip_grant_s[0]),
+	.spi_xip_release_i(xip_release_s[0]),
+	.copy_busy_o(copy_busy_s),
+	//// CPU branch predictor statistics
+	.bp_cnt_clr_o(bp_cnt_clr_s),
+	.bp_hit_cnt_i(bp_hit_cnt_s),
+	.bp_miss_cnt_i(bp_miss_cnt_s),
+	//// BUS QoS statistics
+	.bus_stat_clr_o(bus_stat_clr_s),
+	.bus_stat_tr_cnt_i(bus_stat_tr_cnt_s),
+	.bus_stat_lat_cnt_i(bus_stat_lat_cnt_s),
+	.bus_stat_max_wait_i(bus_stat_max_wait_s)
 );
 
 axi_interconnect  #(
 	.N_MST(N_MST),
 	.N_SLV(N_SLV),
-	.SLV_BASE_ADDRESSES({BOOT_CTRL_BASE_ADDRESS,
+	.SLV_BASE_ADDRESSES({DTCM_BASE_ADDRESS,
+						ITCM_BASE_ADDRESS,
+						FLASH_BASE_ADDRESS,
+						IRQ_BASE_ADDRESS,
+						DMA_BASE_ADDRESS,
+						BOOT_CTRL_BASE_ADDRESS,
 						RAM_BASE_ADDRESS, 
 						DDR_BASE_ADDRESS, 
 						SPI_BASE_ADDRESS, 
 						UART_BASE_ADDRESS}),
-	.SLV_TOP_ADDRESSES( {BOOT_CTRL_BASE_ADDRESS+BOOT_CTRL_ADDRESS_SPACE, 
+	.SLV_TOP_ADDRESSES( {DTCM_BASE_ADDRESS+DTCM_ADDRESS_SPACE,
+						ITCM_BASE_ADDRESS+ITCM_ADDRESS_SPACE,
+						FLASH_BASE_ADDRESS+FLASH_ADDRESS_SPACE,
+						IRQ_BASE_ADDRESS+IRQ_ADDRESS_SPACE, 
+						DMA_BASE_ADDRESS+DMA_ADDRESS_SPACE, 
+						BOOT_CTRL_BASE_ADDRESS+BOOT_CTRL_ADDRESS_SPACE, 
 						RAM_BASE_ADDRESS+RAM_ADDRESS_SPACE, 
 						DDR_BASE_ADDRESS+DDR_ADDRESS_SPACE, 
 						SPI_BASE_ADDRESS+SPI_ADDRESS_SPACE, 
-						UART_BASE_ADDRESS+UART_ADDRESS_SPACE})
+						UART_BASE_ADDRESS+UART_ADDRESS_SPACE}),
+	.SLV_AXI_LITE(SLV_AXI_LITE),
+	.ID_WIDTH(MST_ID_WIDTH),
+	.ARB_POLICY(ARB_POLICY)
 	)
 	inst_axi_interconnect (	
 	.clk_i(clk_i),
@@ -474,50 +963,82 @@ axi_interconnect  #(
 	.m_arvalid_i(mst_arvalid_s),
 	.m_aready_o(mst_aready_s),
 	.m_araddr_i(mst_araddr_s),
+	.m_arlen_i(mst_arlen_s),
+	.m_arsize_i(mst_arsize_s),
+	.m_arburst_i(mst_arburst_s),
+	.m_arid_i(mst_arid_s),
 	// Read Data (R) channel
 	.m_rvalid_o(mst_rvalid_s),
 	.m_rready_i(mst_rready_s),
 	.m_rdata_o(mst_rdata_s),
 	.m_rresp_o(mst_rresp_s),
+	.m_rlast_o(mst_rlast_s),
+	.m_rid_o(),
 	// Write Address (AW) channel
 	.m_awvalid_i(mst_awvalid_s),
 	.m_awready_o(mst_awready_s),
 	.m_awaddr_i(mst_awaddr_s),
+	.m_awlen_i(mst_awlen_s),
+	.m_awsize_i(mst_awsize_s),
+	.m_awburst_i(mst_awburst_s),
+	.m_awid_i(mst_awid_s),
 	// Write Data (W) channel
 	.m_wvalid_i(mst_wvalid_s),
 	.m_wready_o(mst_wready_s),
 	.m_wdata_i(mst_wdata_s),
 	.m_wstrb_i(mst_wstrb_s),
+	.m_wlast_i(mst_wlast_s),
 	// Write Response (B) channel
 	.m_bvalid_o(mst_bvalid_s),
 	.m_bready_i(mst_bready_s),
 	.m_bresp_o(mst_bresp_s),
+	.m_bid_o(),
 	//// AXI slaves interfaces
 	// Read Address (AR) channel
 	.s_arvalid_o(slv_arvalid_s),
 	.s_aready_i(slv_aready_s),
 	.s_araddr_o(slv_araddr_s),
+	.s_arlen_o(slv_arlen_s),
+	.s_arsize_o(slv_arsize_s),
+	.s_arburst_o(slv_arburst_s),
+	.s_arid_o(slv_arid_s),
 	// Read Data (R) channel
 	.s_rvalid_i(slv_rvalid_s),
 	.s_rready_o(slv_rready_s),
 	.s_rdata_i(slv_rdata_s),
 	.s_rresp_i(slv_rresp_s),
+	.s_rlast_i(slv_rlast_s),
+	.s_rid_i(slv_rid_s),
 	// Write Address (AW) channel
 	.s_awvalid_o(slv_awvalid_s),
 	.s_awready_i(slv_awready_s),
 	.s_awaddr_o(slv_awaddr_s),
+	.s_awlen_o(slv_awlen_s),
+	.s_awsize_o(slv_awsize_s),
+	.s_awburst_o(slv_awburst_s),
+	.s_awid_o(slv_awid_s),
 	// Write Data (W) channel
 	.s_wvalid_o(slv_wvalid_s),
 	.s_wready_i(slv_wready_s),
 	.s_wdata_o(slv_wdata_s),
 	.s_wstrb_o(slv_wstrb_s),
+	.s_wlast_o(slv_wlast_s),
 	// Write Response (B) channel
 	.s_bvalid_i(slv_bvalid_s),
 	.s_bready_o(slv_bready_s),
-	.s_bresp_i(slv_bresp_s)
+	.s_bresp_i(slv_bresp_s),
+	.s_bid_i(slv_bid_s),
+	//// QoS statistics
+	.stat_clr_i(bus_stat_clr_s),
+	.m_stat_tr_cnt_o(bus_stat_tr_cnt_s),
+	.m_stat_lat_cnt_o(bus_stat_lat_cnt_s),
+	.m_stat_max_wait_o(bus_stat_max_wait_s)
 );
 
-axi_uart_ctrl inst_uart (
+axi_uart_ctrl #(
+	.FIFO_DEPTH(UART_FIFO_DEPTH)
+	)
+	inst_uart (
 	.clk_i(clk_i),
 	.rst_ni(rst_ni),
 	//// AXI interface
@@ -543,11 +1064,127 @@ axi_uart_ctrl inst_uart (
 	.bvalid_o(uart_bvalid_s),
 	.bready_i(uart_bready_s),
 	.bresp_o(uart_bresp_s),
+	// DMA requests
+	.dma_rx_req_o(uart_dma_rx_req_s),
+	.dma_tx_req_o(uart_dma_tx_req_s),
+	// Interrupt request
+	.irq_o(uart_irq_s),
 	//// UART interface
 	.rx_i(rx_i),
 	.tx_o(tx_o)
 );
 
+// Request line 0 is used for memory and is always active
+assign dma_rd_req_s = {1'b0, spi_dma_rx_req_s, uart_dma_rx_req_s, 1'b1};
+assign dma_wr_req_s = {1'b0, spi_dma_tx_req_s, uart_dma_tx_req_s, 1'b1};
+
+axi_dma_ctrl #(
+	.N_CH(DMA_N_CH),
+	.BURST_LEN(8),
+	.N_REQ(DMA_N_REQ)
+	)
+	inst_dma (
+	.clk_i(clk_i),
+	.rst_ni(rst_ni),
+	//// Registers AXI interface
+	// Read Address (AR) channel
+	.arvalid_i(dma_arvalid_s),
+	.aready_o(dma_aready_s),
+	.araddr_i(dma_araddr_s),
+	// Read Data (R) channel
+	.rvalid_o(dma_rvalid_s),
+	.rready_i(dma_rready_s),
+	.rdata_o(dma_rdata_s),
+	.rresp_o(dma_rresp_s),
+	// Write Address (AW) channel
+	.awvalid_i(dma_awvalid_s),
+	.awready_o(dma_awready_s),
+	.awaddr_i(dma_awaddr_s),
+	// Write Data (W) channel
+	.wvalid_i(dma_wvalid_s),
+	.wready_o(dma_wready_s),
+	.wdata_i(dma_wdata_s),
+	.wstrb_i(dma_wstrb_s),
+	// Write Response (B) channel
+	.bvalid_o(dma_bvalid_s),
+	.bready_i(dma_bready_s),
+	.bresp_o(dma_bresp_s),
+	//// Transfers AXI interface
+	// Read Address (AR) channel
+	.mst_arvalid_o(dma_mst_arvalid_s),
+	.mst_aready_i(dma_mst_aready_s),
+	.mst_araddr_o(dma_mst_araddr_s),
+	.mst_arlen_o(dma_mst_arlen_s),
+	.mst_arsize_o(dma_mst_arsize_s),
+	.mst_arburst_o(dma_mst_arburst_s),
+	// Read Data (R) channel
+	.mst_rvalid_i(dma_mst_rvalid_s),
+	.mst_rready_o(dma_mst_rready_s),
+	.mst_rdata_i(dma_mst_rdata_s),
+	.mst_rresp_i(dma_mst_rresp_s),
+	.mst_rlast_i(dma_mst_rlast_s),
+	// Write Address (AW) channel
+	.mst_awvalid_o(dma_mst_awvalid_s),
+	.mst_awready_i(dma_mst_awready_s),
+	.mst_awaddr_o(dma_mst_awaddr_s),
+	.mst_awlen_o(dma_mst_awlen_s),
+	.mst_awsize_o(dma_mst_awsize_s),
+	.mst_awburst_o(dma_mst_awburst_s),
+	// Write Data (W) channel
+	.mst_wvalid_o(dma_mst_wvalid_s),
+	.mst_wready_i(dma_mst_wready_s),
+	.mst_wdata_o(dma_mst_wdata_s),
+	.mst_wstrb_o(dma_mst_wstrb_s),
+	.mst_wlast_o(dma_mst_wlast_s),
+	// Write Response (B) channel
+	.mst_bvalid_i(dma_mst_bvalid_s),
+	.mst_bready_o(dma_mst_bready_s),
+	.mst_bresp_i(dma_mst_bresp_s),
+	//// Peripheral flow control
+	.rd_req_i(dma_rd_req_s),
+	.wr_req_i(dma_wr_req_s),
+	.done_o(dma_done_s)
+);
+
+// Source 0 is reserved (no interrupt)
+assign irq_src_s = {4'd0, |dma_done_s, spi_irq_s, uart_irq_s, 1'b0};
+
+axi_irq_ctrl #(
+	.N_SRC(IRQ_N_SRC)
+	)
+	inst_irq_ctrl (
+	.clk_i(clk_i),
+	.rst_ni(rst_ni),
+	//// AXI interface
+	// Read Address (AR) channel
+	.arvalid_i(irq_arvalid_s),
+	.aready_o(irq_aready_s),
+	.araddr_i(irq_araddr_s),
+	// Read Data (R) channel
+	.rvalid_o(irq_rvalid_s),
+	.rready_i(irq_rready_s),
+	.rdata_o(irq_rdata_s),
+	.rresp_o(irq_rresp_s),
+	// Write Address (AW) channel
+	.awvalid_i(irq_awvalid_s),
+	.awready_o(irq_awready_s),
+	.awaddr_i(irq_awaddr_s),
+	// Write Data (W) channel
+	.wvalid_i(irq_wvalid_s),
+	.wready_o(irq_wready_s),
+	.wdata_i(irq_wdata_s),
+	.wstrb_i(irq_wstrb_s),
+	// Write Response (B) channel
+	.bvalid_o(irq_bvalid_s),
+	.bready_i(irq_bready_s),
+	.bresp_o(irq_bresp_s),
+	//// Interrupts
+	.src_i(irq_src_s),
+	.meip_o(irq_meip_s),
+	.msip_o(irq_msip_s),
+	.mtip_o(irq_mtip_s)
+);
+
 `ifdef FPGA
 STARTUPE2 #(
 	.PROG_USR("FALSE"),  // Activate program event security feature. Requires encrypted bitstreams.
@@ -572,7 +1209,10 @@ STARTUPE2_inst (
 );
 `endif
 
-axi_spi_mst inst_spi_mst (
+axi_spi_mst #(
+	.FIFO_DEPTH(SPI_FIFO_DEPTH)
+	)
+	inst_spi_mst (
 	.clk_i(clk_i),
 	.rst_ni(rst_ni),
 	//// AXI interface
@@ -598,16 +1238,131 @@ axi_spi_mst inst_spi_mst (
 	.bvalid_o(spi_bvalid_s),
 	.bready_i(spi_bready_s),
 	.bresp_o(spi_bresp_s),
+	// Direct interface for flash execute in place
+	.xip_en_i(spi_xip_en_s),
+	.xip_cs_hold_i(spi_xip_cs_hold_s),
+	.xip_lanes_i(spi_xip_lanes_s),
+	.xip_tx_wr_i(spi_xip_tx_wr_s),
+	.xip_tx_data_i(spi_xip_tx_data_s),
+	.xip_rx_rd_i(spi_xip_rx_rd_s),
+	.xip_rx_data_o(spi_xip_rx_data_s),
+	.xip_rx_not_empty_o(spi_xip_rx_not_empty_s),
+	.xip_rx_flush_i(spi_xip_rx_flush_s),
+	.xip_busy_o(spi_xip_busy_s),
+	// DMA requests
+	.dma_rx_req_o(spi_dma_rx_req_s),
+	.dma_tx_req_o(spi_dma_tx_req_s),
+	// Interrupt request
+	.irq_o(spi_irq_s),
 	// SPI interface
 	.sck_o(spi_sck_o),
 	.cs_no(spi_cs_no),
-	.mosi_o(spi_mosi_o),
-	.miso_i(spi_miso_i)
+	.sio_o(spi_sio_o_s),
+	.sio_oe_o(spi_sio_oe_s),
+	.sio_i(spi_io)
 );
-assign wp_no = 1'b1;
-assign hold_no = 1'b1;
+// SPI data lanes are released when used as inputs
+assign spi_io[0] = (spi_sio_oe_s[0]) ? spi_sio_o_s[0] : 1'bz;
+assign spi_io[1] = (spi_sio_oe_s[1]) ? spi_sio_o_s[1] : 1'bz;
+assign spi_io[2] = (spi_sio_oe_s[2]) ? spi_sio_o_s[2] : 1'bz;
+assign spi_io[3] = (spi_sio_oe_s[3]) ? spi_sio_o_s[3] : 1'bz;
 
-axi_ram_wrapper inst_ram_wrapper(	
+// Read-only memory mapped window on the flash
+axi_spi_flash #(
+	.ID_WIDTH(SLV_ID_WIDTH),
+	.SPI_FIFO_DEPTH(SPI_FIFO_DEPTH)
+	)
+	inst_spi_flash (
+	.clk_i(clk_i),
+	.rst_ni(rst_ni),
+	//// AXI interface
+	// Read Address (AR) channel
+	.arvalid_i(flash_arvalid_s),
+	.aready_o(flash_aready_s),
+	.araddr_i(flash_araddr_s),
+	.arlen_i(flash_arlen_s),
+	.arsize_i(flash_arsize_s),
+	.arburst_i(flash_arburst_s),
+	.arid_i(flash_arid_s),
+	// Read Data (R) channel
+	.rvalid_o(flash_rvalid_s),
+	.rready_i(flash_rready_s),
+	.rdata_o(flash_rdata_s),
+	.rresp_o(flash_rresp_s),
+	.rlast_o(flash_rlast_s),
+	.rid_o(flash_rid_s),
+	// Write Address (AW) channel
+	.awvalid_i(flash_awvalid_s),
+	.awready_o(flash_awready_s),
+	.awaddr_i(flash_awaddr_s),
+	.awlen_i(flash_awlen_s),
+	.awsize_i(flash_awsize_s),
+	.awburst_i(flash_awburst_s),
+	.awid_i(flash_awid_s),
+	// Write Data (W) channel
+	.wvalid_i(flash_wvalid_s),
+	.wready_o(flash_wready_s),
+	.wdata_i(flash_wdata_s),
+	.wstrb_i(flash_wstrb_s),
+	.wlast_i(flash_wlast_s),
+	// Write Response (B) channel
+	.bvalid_o(flash_bvalid_s),
+	.bready_i(flash_bready_s),
+	.bresp_o(flash_bresp_s),
+	.bid_o(flash_bid_s),
+	// Arbitration of the SPI controller
+	.spi_xip_req_o(xip_req_s[1]),
+	.spi_xip_grant_i(xip_grant_s[1]),
+	.spi_xip_release_i(xip_release_s[1]),
+	// Direct interface to SPI controller
+	.spi_xip_en_o(xip_en_s[1]),
+	.spi_xip_cs_hold_o(xip_cs_hold_s[1]),
+	.spi_xip_lanes_o(xip_lanes_s[3:2]),
+	.spi_xip_tx_wr_o(xip_tx_wr_s[1]),
+	.spi_xip_tx_data_o(xip_tx_data_s[15:8]),
+	.spi_xip_rx_rd_o(xip_rx_rd_s[1]),
+	.spi_xip_rx_data_i(xip_rx_data_s),
+	.spi_xip_rx_not_empty_i(xip_rx_not_empty_s[1]),
+	.spi_xip_rx_flush_o(xip_rx_flush_s[1]),
+	.spi_xip_busy_i(xip_busy_s)
+);
+
+// The boot controller and the flash window share the direct interface of the SPI controller
+spi_xip_arb inst_spi_xip_arb (
+	.clk_i(clk_i),
+	.rst_ni(rst_ni),
+	// Flash readers
+	.req_i(xip_req_s),
+	.grant_o(xip_grant_s),
+	.release_o(xip_release_s),
+	.xip_en_i(xip_en_s),
+	.xip_cs_hold_i(xip_cs_hold_s),
+	.xip_lanes_i(xip_lanes_s),
+	.xip_tx_wr_i(xip_tx_wr_s),
+	.xip_tx_data_i(xip_tx_data_s),
+	.xip_rx_rd_i(xip_rx_rd_s),
+	.xip_rx_data_o(xip_rx_data_s),
+	.xip_rx_not_empty_o(xip_rx_not_empty_s),
+	.xip_rx_flush_i(xip_rx_flush_s),
+	.xip_busy_o(xip_busy_s),
+	// Direct interface towards SPI controller
+	.spi_xip_en_o(spi_xip_en_s),
+	.spi_xip_cs_hold_o(spi_xip_cs_hold_s),
+	.spi_xip_lanes_o(spi_xip_lanes_s),
+	.spi_xip_tx_wr_o(spi_xip_tx_wr_s),
+	.spi_xip_tx_data_o(spi_xip_tx_data_s),
+	.spi_xip_rx_rd_o(spi_xip_rx_rd_s),
+	.spi_xip_rx_data_i(spi_xip_rx_data_s),
+	.spi_xip_rx_not_empty_i(spi_xip_rx_not_empty_s),
+	.spi_xip_rx_flush_o(spi_xip_rx_flush_s),
+	.spi_xip_busy_i(spi_xip_busy_s)
+);
+
+axi_ram_wrapper #(
+	.ID_WIDTH(SLV_ID_WIDTH),
+	.N_BANKS(RAM_BANKS)
+	)
+	inst_ram_wrapper(	
 	.clk_i(clk_i),
 	.rst_ni(rst_ni),
 	//// AXI interface
@@ -615,24 +1370,138 @@ axi_ram_wrapper inst_ram_wrapper(
 	.arvalid_i(ram_arvalid_s),
 	.aready_o(ram_aready_s),
 	.araddr_i(ram_araddr_s),
+	.arlen_i(ram_arlen_s),
+	.arsize_i(ram_arsize_s),
+	.arburst_i(ram_arburst_s),
+	.arid_i(ram_arid_s),
 	// Read Data (R) channel
 	.rvalid_o(ram_rvalid_s),
 	.rready_i(ram_rready_s),
 	.rdata_o(ram_rdata_s),
 	.rresp_o(ram_rresp_s),
+	.rlast_o(ram_rlast_s),
+	.rid_o(ram_rid_s),
 	// Write Address (AW) channel
 	.awvalid_i(ram_awvalid_s),
 	.awready_o(ram_awready_s),
 	.awaddr_i(ram_awaddr_s),
+	.awlen_i(ram_awlen_s),
+	.awsize_i(ram_awsize_s),
+	.awburst_i(ram_awburst_s),
+	.awid_i(ram_awid_s),
 	// Write Data (W) channel
 	.wvalid_i(ram_wvalid_s),
 	.wready_o(ram_wready_s),
 	.wdata_i(ram_wdata_s),
 	.wstrb_i(ram_wstrb_s),
+	.wlast_i(ram_wlast_s),
 	// Write Response (B) channel
 	.bvalid_o(ram_bvalid_s),
 	.bready_i(ram_bready_s),
-	.bresp_o(ram_bresp_s)
+	.bresp_o(ram_bresp_s),
+	.bid_o(ram_bid_s)
+);
+
+// Tightly-coupled instruction memory (CPU reads, bus fills it)
+axi_tcm #(
+	.ID_WIDTH(SLV_ID_WIDTH),
+	.SIZE(ITCM_SIZE)
+	)
+	inst_itcm (
+	.clk_i(clk_i),
+	.rst_ni(rst_ni),
+	//// AXI interface
+	// Read Address (AR) channel
+	.arvalid_i(itcm_arvalid_s),
+	.aready_o(itcm_aready_s),
+	.araddr_i(itcm_araddr_s),
+	.arlen_i(itcm_arlen_s),
+	.arsize_i(itcm_arsize_s),
+	.arburst_i(itcm_arburst_s),
+	.arid_i(itcm_arid_s),
+	// Read Data (R) channel
+	.rvalid_o(itcm_rvalid_s),
+	.rready_i(itcm_rready_s),
+	.rdata_o(itcm_rdata_s),
+	.rresp_o(itcm_rresp_s),
+	.rlast_o(itcm_rlast_s),
+	.rid_o(itcm_rid_s),
+	// Write Address (AW) channel
+	.awvalid_i(itcm_awvalid_s),
+	.awready_o(itcm_awready_s),
+	.awaddr_i(itcm_awaddr_s),
+	.awlen_i(itcm_awlen_s),
+	.awsize_i(itcm_awsize_s),
+	.awburst_i(itcm_awburst_s),
+	.awid_i(itcm_awid_s),
+	// Write Data (W) channel
+	.wvalid_i(itcm_wvalid_s),
+	.wready_o(itcm_wready_s),
+	.wdata_i(itcm_wdata_s),
+	.wstrb_i(itcm_wstrb_s),
+	.wlast_i(itcm_wlast_s),
+	// Write Response (B) channel
+	.bvalid_o(itcm_bvalid_s),
+	.bready_i(itcm_bready_s),
+	.bresp_o(itcm_bresp_s),
+	.bid_o(itcm_bid_s),
+	// CPU port
+	.cpu_wr_i(1'b0),
+	.cpu_addr_i(itcm_cpu_addr_s),
+	.cpu_data_i(32'd0),
+	.cpu_byte_select_i(4'd0),
+	.cpu_data_o(itcm_cpu_data_s)
+);
+
+// Tightly-coupled data memory
+axi_tcm #(
+	.ID_WIDTH(SLV_ID_WIDTH),
+	.SIZE(DTCM_SIZE)
+	)
+	inst_dtcm (
+	.clk_i(clk_i),
+	.rst_ni(rst_ni),
+	//// AXI interface
+	// Read Address (AR) channel
+	.arvalid_i(dtcm_arvalid_s),
+	.aready_o(dtcm_aready_s),
+	.araddr_i(dtcm_araddr_s),
+	.arlen_i(dtcm_arlen_s),
+	.arsize_i(dtcm_arsize_s),
+	.arburst_i(dtcm_arburst_s),
+	.arid_i(dtcm_arid_s),
+	// Read Data (R) channel
+	.rvalid_o(dtcm_rvalid_s),
+	.rready_i(dtcm_rready_s),
+	.rdata_o(dtcm_rdata_s),
+	.rresp_o(dtcm_rresp_s),
+	.rlast_o(dtcm_rlast_s),
+	.rid_o(dtcm_rid_s),
+	// Write Address (AW) channel
+	.awvalid_i(dtcm_awvalid_s),
+	.awready_o(dtcm_awready_s),
+	.awaddr_i(dtcm_awaddr_s),
+	.awlen_i(dtcm_awlen_s),
+	.awsize_i(dtcm_awsize_s),
+	.awburst_i(dtcm_awburst_s),
+	.awid_i(dtcm_awid_s),
+	// Write Data (W) channel
+	.wvalid_i(dtcm_wvalid_s),
+	.wready_o(dtcm_wready_s),
+	.wdata_i(dtcm_wdata_s),
+	.wstrb_i(dtcm_wstrb_s),
+	.wlast_i(dtcm_wlast_s),
+	// Write Response (B) channel
+	.bvalid_o(dtcm_bvalid_s),
+	.bready_i(dtcm_bready_s),
+	.bresp_o(dtcm_bresp_s),
+	.bid_o(dtcm_bid_s),
+	// CPU port
+	.cpu_wr_i(dtcm_cpu_wr_s),
+	.cpu_addr_i(dtcm_cpu_addr_s),
+	.cpu_data_i(dtcm_cpu_data_o_s),
+	.cpu_byte_select_i(dtcm_cpu_byte_select_s),
+	.cpu_data_o(dtcm_cpu_data_i_s)
 );
 
 `ifdef DDR
@@ -649,7 +1518,11 @@ clk_wiz_0 inst_clock_mul (
 );
 
 wire ui_clk_s, init_calib_complete_s;
-axi_cdc inst_axi_cdc (
+wire [SLV_ID_WIDTH-1:0] ddr_ref_arid_s, ddr_ref_rid_s, ddr_ref_awid_s, ddr_ref_bid_s;
+axi_cdc #(
+	.ID_WIDTH(SLV_ID_WIDTH)
+	)
+	inst_axi_cdc (
 	//// AXI master interface
 	.m_clk_i(clk_i),
 	.m_rst_i(rst_ni),
@@ -657,23 +1530,36 @@ axi_cdc inst_axi_cdc (
 	.m_arvalid_i(ddr_arvalid_s),
 	.m_aready_o(ddr_aready_s),
 	.m_araddr_i(ddr_araddr_s),
+	.m_arlen_i(ddr_arlen_s),
+	.m_arsize_i(ddr_arsize_s),
+	.m_arburst_i(ddr_arburst_s),
+	.m_arid_i(ddr_arid_s),
 	// Read Data (R) channel
 	.m_rvalid_o(ddr_rvalid_s),
 	.m_rready_i(ddr_rready_s),
 	.m_rdata_o(ddr_rdata_s),
 	.m_rresp_o(ddr_rresp_s),
+	.m_rlast_o(ddr_rlast_s),
+	.m_rid_o(ddr_rid_s),
 	// Write Address (AW) channel
 	.m_awvalid_i(ddr_awvalid_s),
 	.m_awready_o(ddr_awready_s),
 	.m_awaddr_i(ddr_awaddr_s),
+	.m_awlen_i(ddr_awlen_s),
+	.m_awsize_i(ddr_awsize_s),
+	.m_awburst_i(ddr_awburst_s),
+	.m_awid_i(ddr_awid_s),
 	// Write Data (W) channel
 	.m_wvalid_i(ddr_wvalid_s),
 	.m_wready_o(ddr_wready_s),
 	.m_wdata_i(ddr_wdata_s),
+	.m_wstrb_i(ddr_wstrb_s),
+	.m_wlast_i(ddr_wlast_s),
 	// Write Response (B) channel
 	.m_bvalid_o(ddr_bvalid_s),
 	.m_bready_i(ddr_bready_s),
 	.m_bresp_o(ddr_bresp_s),
+	.m_bid_o(ddr_bid_s),
 	//// AXI slave interface
 	.s_clk_i(ui_clk_s),
 	.s_rst_i(init_calib_complete_s),
@@ -681,23 +1567,36 @@ axi_cdc inst_axi_cdc (
 	.s_arvalid_o(ddr_ref_arvalid_s),
 	.s_aready_i(ddr_ref_aready_s),
 	.s_araddr_o(ddr_ref_araddr_s),
+	.s_arlen_o(ddr_ref_arlen_s),
+	.s_arsize_o(ddr_ref_arsize_s),
+	.s_arburst_o(ddr_ref_arburst_s),
+	.s_arid_o(ddr_ref_arid_s),
 	// Read Data (R) channel
 	.s_rvalid_i(ddr_ref_rvalid_s),
 	.s_rready_o(ddr_ref_rready_s),
 	.s_rdata_i(ddr_ref_rdata_s),
 	.s_rresp_i(ddr_ref_rresp_s),
+	.s_rlast_i(ddr_ref_rlast_s),
+	.s_rid_i(ddr_ref_rid_s),
 	// Write Address (AW) channel
 	.s_awvalid_o(ddr_ref_awvalid_s),
 	.s_awready_i(ddr_ref_awready_s),
 	.s_awaddr_o(ddr_ref_awaddr_s),
+	.s_awlen_o(ddr_ref_awlen_s),
+	.s_awsize_o(ddr_ref_awsize_s),
+	.s_awburst_o(ddr_ref_awburst_s),
+	.s_awid_o(ddr_ref_awid_s),
 	// Write Data (W) channel
 	.s_wvalid_o(ddr_ref_wvalid_s),
 	.s_wready_i(ddr_ref_wready_s),
 	.s_wdata_o(ddr_ref_wdata_s),
+	.s_wstrb_o(ddr_ref_wstrb_s),
+	.s_wlast_o(ddr_ref_wlast_s),
 	// Write Response (B) channel
 	.s_bvalid_i(ddr_ref_bvalid_s),
 	.s_bready_o(ddr_ref_bready_s),
-	.s_bresp_i(ddr_ref_bresp_s)
+	.s_bresp_i(ddr_ref_bresp_s),
+	.s_bid_i(ddr_ref_bid_s)
 );
 
 mig_7series_0 inst_ddr_ctrl (
@@ -730,11 +1629,11 @@ mig_7series_0 inst_ddr_ctrl (
     .app_ref_ack                    (),  // output			app_ref_ack
     .app_zq_ack                     (),  // output			app_zq_ack
     // Slave Interface Write Address Ports
-    .s_axi_awid                     (1'd0),  // input [0:0]			s_axi_awid
+    .s_axi_awid                     (ddr_ref_awid_s),  // input [2:0]			s_axi_awid
     .s_axi_awaddr                   (ddr_ref_awaddr_s[27:0]),  // input [27:0]			s_axi_awaddr
-    .s_axi_awlen                    (8'd0),  // input [7:0]			s_axi_awlen
-    .s_axi_awsize                   (3'd2),  // input [2:0]			s_axi_awsize
-    .s_axi_awburst                  (2'd1),  // input [1:0]			s_axi_awburst
+    .s_axi_awlen                    (ddr_ref_awlen_s),  // input [7:0]			s_axi_awlen
+    .s_axi_awsize                   (ddr_ref_awsize_s),  // input [2:0]			s_axi_awsize
+    .s_axi_awburst                  (ddr_ref_awburst_s),  // input [1:0]			s_axi_awburst
     .s_axi_awlock                   (1'd0),  // input [0:0]			s_axi_awlock
     .s_axi_awcache                  (4'd0),  // input [3:0]			s_axi_awcache
     .s_axi_awprot                   (3'd0),  // input [2:0]			s_axi_awprot
@@ -743,21 +1642,21 @@ mig_7series_0 inst_ddr_ctrl (
     .s_axi_awready                  (ddr_ref_awready_s),  // output			s_axi_awready
     // Slave Interface Write Data Ports
     .s_axi_wdata                    (ddr_ref_wdata_s),  // input [31:0]			s_axi_wdata
-    .s_axi_wstrb                    ({4{ddr_ref_wvalid_s}}),  // input [3:0]			s_axi_wstrb
-    .s_axi_wlast                    (1'd1),  // input			s_axi_wlast
+    .s_axi_wstrb                    (ddr_ref_wstrb_s),  // input [3:0]			s_axi_wstrb
+    .s_axi_wlast                    (ddr_ref_wlast_s),  // input			s_axi_wlast
     .s_axi_wvalid                   (ddr_ref_wvalid_s),  // input			s_axi_wvalid
     .s_axi_wready                   (ddr_ref_wready_s),  // output			s_axi_wready
     // Slave Interface Write Response Ports
-    .s_axi_bid                      (),  // output [0:0]			s_axi_bid
+    .s_axi_bid                      (ddr_ref_bid_s),  // output [2:0]			s_axi_bid
     .s_axi_bresp                    (ddr_ref_bresp_s),  // output [1:0]			s_axi_bresp
     .s_axi_bvalid                   (ddr_ref_bvalid_s),  // output			s_axi_bvalid
     .s_axi_bready                   (ddr_ref_bready_s),  // input			s_axi_bready
     // Slave Interface Read Address Ports
-    .s_axi_arid                     (1'd0),  // input [0:0]			s_axi_arid
+    .s_axi_arid                     (ddr_ref_arid_s),  // input [2:0]			s_axi_arid
     .s_axi_araddr                   (ddr_ref_araddr_s[27:0]),  // input [27:0]			s_axi_araddr
-    .s_axi_arlen                    (8'd0),  // input [7:0]			s_axi_arlen
-    .s_axi_arsize                   (3'd2),  // input [2:0]			s_axi_arsize
-    .s_axi_arburst                  (2'd1),  // input [1:0]			s_axi_arburst
+    .s_axi_arlen                    (ddr_ref_arlen_s),  // input [7:0]			s_axi_arlen
+    .s_axi_arsize                   (ddr_ref_arsize_s),  // input [2:0]			s_axi_arsize
+    .s_axi_arburst                  (ddr_ref_arburst_s),  // input [1:0]			s_axi_arburst
     .s_axi_arlock                   (1'd0),  // input [0:0]			s_axi_arlock
     .s_axi_arcache                  (4'd0),  // input [3:0]			s_axi_arcache
     .s_axi_arprot                   (3'd0),  // input [2:0]			s_axi_arprot
@@ -765,10 +1664,10 @@ mig_7series_0 inst_ddr_ctrl (
     .s_axi_arvalid                  (ddr_ref_arvalid_s),  // input			s_axi_arvalid
     .s_axi_arready                  (ddr_ref_aready_s),  // output			s_axi_arready
     // Slave Interface Read Data Ports
-    .s_axi_rid                      (),  // output [0:0]			s_axi_rid
+    .s_axi_rid                      (ddr_ref_rid_s),  // output [2:0]			s_axi_rid
     .s_axi_rdata                    (ddr_ref_rdata_s),  // output [31:0]			s_axi_rdata
     .s_axi_rresp                    (ddr_ref_rresp_s),  // output [1:0]			s_axi_rresp
-    .s_axi_rlast                    (),  // output			s_axi_rlast
+    .s_axi_rlast                    (ddr_ref_rlast_s),  // output			s_axi_rlast
     .s_axi_rvalid                   (ddr_ref_rvalid_s),  // output			s_axi_rvalid
     .s_axi_rready                   (ddr_ref_rready_s),  // input			s_axi_rready
     // System Clock Ports
@@ -785,10 +1684,13 @@ assign ddr_aready_s = 'd0;
 assign ddr_rvalid_s = 'd0;
 assign ddr_rdata_s = 'd0;
 assign ddr_rresp_s = 'd0;
+assign ddr_rlast_s = 'd0;
+assign ddr_rid_s = 'd0;
 assign ddr_awready_s = 'd0;
 assign ddr_wready_s = 'd0;
 assign ddr_bvalid_s = 'd0;
 assign ddr_bresp_s = 'd0;
+assign ddr_bid_s = 'd0;
 `endif
 
 endmodule
\ No newline at end of file
@@ -2,6 +2,8 @@ module alu (
 	input signed [31:0] op1_i,
     input signed [31:0] op2_i, 
 	input [4:0] alu_ctrl_i, 
+	// Compressed instruction (return address of jumps is the address of the instruction + 2)
+	input compressed_i,
 	
 	output reg [31:0] data_o,
 	output reg Zero_o
@@ -29,7 +31,7 @@ always @(*) begin
 
         // jal, jalr
         5'd5 : begin 
-            data_o = op1_i + 32'd4;
+            data_o = (compressed_i == 1'b1) ? op1_i + 32'd2 : op1_i + 32'd4;
             Zero_o = 1'b1;
 		end
 
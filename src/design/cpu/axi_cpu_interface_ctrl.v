@@ -1,4 +1,14 @@
-module axi_cpu_interface_ctrl(	
+module axi_cpu_interface_ctrl #(
+	// Number of BUS masters with QoS statistics (at most 4)
+	parameter BUS_N_MST=2,
+	// Tightly-coupled instruction and data memories (size in bytes, 0 for no memory)
+	parameter ITCM_BASE_ADDRESS=32'h00100000,
+	parameter ITCM_SIZE=0,
+	parameter DTCM_BASE_ADDRESS=32'h00200000,
+	parameter DTCM_SIZE=0,
+	// Depth of the fifos of the SPI controller (bytes)
+	parameter SPI_FIFO_DEPTH=16
+	)(	
 	input  clk_i,
 	input  rst_ni,
 
@@ -30,41 +40,60 @@ module axi_cpu_interface_ctrl(
 	input  boot_ctrl_bready_i,
 	output [1:0] boot_ctrl_bresp_o,
 
-	// CPU stall signal
-	output mem_ready_o,
-
 	// Instruction memory IOs towards CPU
+	output cpu_instr_mem_ready_o,
 	input  cpu_instr_mem_rd_i,
 	input  [31:0] cpu_instr_mem_addr_i,
 	output [31:0] cpu_instr_mem_data_o,
 
 	// Data memory IOs towards CPU
+	output cpu_data_mem_ready_o,
 	input  cpu_data_mem_rd_i,
 	input  cpu_data_mem_wr_i,
+	input  cpu_data_mem_fence_i,
 	input  [31:0] cpu_data_mem_addr_i,
 	input  [31:0] cpu_data_mem_data_i,
 	output [31:0] cpu_data_mem_data_o,
 	input  [3:0] cpu_byte_select_i,
 
+	//// Direct interface to the tightly-coupled memories
+	// ITCM (instruction reads)
+	output [31:0] itcm_addr_o,
+	input  [31:0] itcm_data_i,
+	// DTCM (data reads and writes)
+	output dtcm_wr_o,
+	output [31:0] dtcm_addr_o,
+	output [31:0] dtcm_data_o,
+	output [3:0] dtcm_byte_select_o,
+	input  [31:0] dtcm_data_i,
+
 	//// Instruction memory AXI interface
 	// Read Address (AR) channel
 	output instr_arvalid_o,
 	input  instr_aready_i,
 	output [31:0] instr_araddr_o,
+	output [7:0] instr_arlen_o,
+	output [2:0] instr_arsize_o,
+	output [1:0] instr_arburst_o,
 	// Read Data (R) channel
 	input  instr_rvalid_i,
 	output instr_rready_o,
 	input [31:0] instr_rdata_i,
 	input [1:0] instr_rresp_i,
+	input instr_rlast_i,
 	// Write Address (AW) channel
 	output instr_awvalid_o,
 	input instr_awready_i,
 	output [31:0] instr_awaddr_o,
+	output [7:0] instr_awlen_o,
+	output [2:0] instr_awsize_o,
+	output [1:0] instr_awburst_o,
 	// Write Data (W) channel
 	output instr_wvalid_o,
 	input instr_wready_i,
 	output [31:0] instr_wdata_o,
 	output [3:0] instr_wstrb_o,
+	output instr_wlast_o,
 	// Write Response (B) channel
 	input instr_bvalid_i,
 	output instr_bready_o,
@@ -75,36 +104,84 @@ module axi_cpu_interface_ctrl(
 	output data_arvalid_o,
 	input  data_aready_i,
 	output [31:0] data_araddr_o,
+	output [7:0] data_arlen_o,
+	output [2:0] data_arsize_o,
+	output [1:0] data_arburst_o,
 	// Read Data (R) channel
 	input  data_rvalid_i,
 	output data_rready_o,
 	input [31:0] data_rdata_i,
 	input [1:0] data_rresp_i,
+	input data_rlast_i,
 	// Write Address (AW) channel
 	output data_awvalid_o,
 	input data_awready_i,
 	output [31:0] data_awaddr_o,
+	output [7:0] data_awlen_o,
+	output [2:0] data_awsize_o,
+	output [1:0] data_awburst_o,
 	// Write Data (W) channel
 	output data_wvalid_o,
 	input data_wready_i,
 	output [31:0] data_wdata_o,
 	output [3:0] data_wstrb_o,
+	output data_wlast_o,
 	// Write Response (B) channel
 	input data_bvalid_i,
 	output data_bready_o,
-	input [1:0] data_bresp_i
+	input [1:0] data_bresp_i,
+
+	//// Direct interface to SPI controller (flash execute in place)
+	output spi_xip_en_o,
+	output spi_xip_cs_hold_o,
+	output [1:0] spi_xip_lanes_o,
+	output spi_xip_tx_wr_o,
+	output [7:0] spi_xip_tx_data_o,
+	output spi_xip_rx_rd_o,
+	input  [7:0] spi_xip_rx_data_i,
+	input  spi_xip_rx_not_empty_i,
+	output spi_xip_rx_flush_o,
+	input  spi_xip_busy_i,
+	// Arbitration of the SPI controller with the other flash readers
+	output spi_xip_req_o,
+	input  spi_xip_grant_i,
+	input  spi_xip_release_i,
+
+	// Code copy in progress, CPU memory interfaces are blocked
+	output copy_busy_o,
+
+	//// CPU branch predictor statistics
+	output bp_cnt_clr_o,
+	input  [31:0] bp_hit_cnt_i,
+	input  [31:0] bp_miss_cnt_i,
+
+	//// BUS QoS statistics (32 bits for each master)
+	output bus_stat_clr_o,
+	input  [(32*BUS_N_MST)-1:0] bus_stat_tr_cnt_i,
+	input  [(32*BUS_N_MST)-1:0] bus_stat_lat_cnt_i,
+	input  [(32*BUS_N_MST)-1:0] bus_stat_max_wait_i
 );
 
 //// Hand-shake to AXI conversion signals
 // Intruction memory interface
 wire instr_mem_ready_s, instr_mem_rd_s, instr_mem_wr_s;
 wire [31:0] instr_mem_data_i_s, instr_mem_data_o_s, instr_mem_addr_s;
+wire [7:0] instr_mem_len_s;
 // Data memory interface
 wire data_mem_ready_s, data_mem_rd_s, data_mem_wr_s;
 wire [31:0] data_mem_data_i_s, data_mem_addr_s, data_mem_data_o_s;
 wire [3:0] data_mem_byte_select_s;
+wire [7:0] data_mem_len_s;
 
-cpu_interface_ctrl inst_cpu_interface_ctrl(	
+cpu_interface_ctrl #(
+	.BUS_N_MST(BUS_N_MST),
+	.ITCM_BASE_ADDRESS(ITCM_BASE_ADDRESS),
+	.ITCM_SIZE(ITCM_SIZE),
+	.DTCM_BASE_ADDRESS(DTCM_BASE_ADDRESS),
+	.DTCM_SIZE(DTCM_SIZE),
+	.SPI_FIFO_DEPTH(SPI_FIFO_DEPTH)
+	)
+	inst_cpu_interface_ctrl(	
 	.clk_i(clk_i),
 	.rst_ni(rst_ni),
 	// Boot source strapping pins
@@ -133,10 +210,9 @@ cpu_interface_ctrl inst_cpu_interface_ctrl(
 	.bvalid_o(boot_ctrl_bvalid_o),
 	.bready_i(boot_ctrl_bready_i),
 	.bresp_o(boot_ctrl_bresp_o),
-	// CPU stall signal
-	.mem_ready_o(mem_ready_o),
 	//// Instruction memory IOs
 	// Towards CPU
+	.cpu_instr_mem_ready_o(cpu_instr_mem_ready_o),
 	.cpu_instr_mem_rd_i(cpu_instr_mem_rd_i),
 	.cpu_instr_mem_addr_i(cpu_instr_mem_addr_i),
 	.cpu_instr_mem_data_o(cpu_instr_mem_data_o),
@@ -147,10 +223,30 @@ cpu_interface_ctrl inst_cpu_interface_ctrl(
 	.bus_instr_mem_addr_o(instr_mem_addr_s),
 	.bus_instr_mem_data_i(instr_mem_data_i_s),
 	.bus_instr_mem_data_o(instr_mem_data_o_s),
+	.bus_instr_mem_len_o(instr_mem_len_s),
+	// Towards ITCM
+	.itcm_addr_o(itcm_addr_o),
+	.itcm_data_i(itcm_data_i),
+	// Towards SPI controller (flash execute in place)
+	.spi_xip_en_o(spi_xip_en_o),
+	.spi_xip_cs_hold_o(spi_xip_cs_hold_o),
+	.spi_xip_lanes_o(spi_xip_lanes_o),
+	.spi_xip_tx_wr_o(spi_xip_tx_wr_o),
+	.spi_xip_tx_data_o(spi_xip_tx_data_o),
+	.spi_xip_rx_rd_o(spi_xip_rx_rd_o),
+	.spi_xip_rx_data_i(spi_xip_rx_data_i),
+	.spi_xip_rx_not_empty_i(spi_xip_rx_not_empty_i),
+	.spi_xip_rx_flush_o(spi_xip_rx_flush_o),
+	.spi_xip_busy_i(spi_xip_busy_i),
+	.spi_xip_req_o(spi_xip_req_o),
+	.spi_xip_grant_i(spi_xip_grant_i),
+	.spi_xip_release_i(spi_xip_release_i),
 	// Data memory IOs
 	// Towards CPU
+	.cpu_data_mem_ready_o(cpu_data_mem_ready_o),
 	.cpu_data_mem_rd_i(cpu_data_mem_rd_i),
 	.cpu_data_mem_wr_i(cpu_data_mem_wr_i),
+	.cpu_data_mem_fence_i(cpu_data_mem_fence_i),
 	.cpu_data_mem_addr_i(cpu_data_mem_addr_i),
 	.cpu_data_mem_data_i(cpu_data_mem_data_i),
 	.cpu_data_mem_data_o(cpu_data_mem_data_o),
@@ -162,7 +258,23 @@ cpu_interface_ctrl inst_cpu_interface_ctrl(
 	.bus_data_mem_addr_o(data_mem_addr_s),
 	.bus_data_mem_data_i(data_mem_data_i_s),
 	.bus_data_mem_data_o(data_mem_data_o_s),
-	.bus_byte_select_o(data_mem_byte_select_s)
+	.bus_byte_select_o(data_mem_byte_select_s),
+	.bus_data_mem_len_o(data_mem_len_s),
+	// Towards DTCM
+	.dtcm_wr_o(dtcm_wr_o),
+	.dtcm_addr_o(dtcm_addr_o),
+	.dtcm_data_o(dtcm_data_o),
+	.dtcm_byte_select_o(dtcm_byte_select_o),
+	.dtcm_data_i(dtcm_data_i),
+	// BUS QoS statistics
+	.copy_busy_o(copy_busy_o),
+	.bp_cnt_clr_o(bp_cnt_clr_o),
+	.bp_hit_cnt_i(bp_hit_cnt_i),
+	.bp_miss_cnt_i(bp_miss_cnt_i),
+	.bus_stat_clr_o(bus_stat_clr_o),
+	.bus_stat_tr_cnt_i(bus_stat_tr_cnt_i),
+	.bus_stat_lat_cnt_i(bus_stat_lat_cnt_i),
+	.bus_stat_max_wait_i(bus_stat_max_wait_i)
 );
 
 hs_2_axi inst_instr_mem_axi_master(	
@@ -173,6 +285,7 @@ hs_2_axi inst_instr_mem_axi_master(
 	.hs_write_i(instr_mem_wr_s),
 	.hs_addr_i(instr_mem_addr_s),
 	.hs_data_i(instr_mem_data_o_s),
+	.hs_len_i(instr_mem_len_s),
 	.hs_ready_o(instr_mem_ready_s),
 	.hs_data_o(instr_mem_data_i_s),
 	.byte_select_i(4'd1),
@@ -181,20 +294,28 @@ hs_2_axi inst_instr_mem_axi_master(
 	.arvalid_o(instr_arvalid_o),
 	.aready_i(instr_aready_i),
 	.araddr_o(instr_araddr_o),
+	.arlen_o(instr_arlen_o),
+	.arsize_o(instr_arsize_o),
+	.arburst_o(instr_arburst_o),
 	// Read Data (R) channel
 	.rvalid_i(instr_rvalid_i),
 	.rready_o(instr_rready_o),
 	.rdata_i(instr_rdata_i),
 	.rresp_i(instr_rresp_i),
+	.rlast_i(instr_rlast_i),
 	// Write Address (AW) channel
 	.awvalid_o(instr_awvalid_o),
 	.awready_i(instr_awready_i),
 	.awaddr_o(instr_awaddr_o),
+	.awlen_o(instr_awlen_o),
+	.awsize_o(instr_awsize_o),
+	.awburst_o(instr_awburst_o),
 	// Write Data (W) channel
 	.wvalid_o(instr_wvalid_o),
 	.wready_i(instr_wready_i),
 	.wdata_o(instr_wdata_o),
 	.wstrb_o(instr_wstrb_o),
+	.wlast_o(instr_wlast_o),
 	// Write Response (B) czannel
 	.bvalid_i(instr_bvalid_i),
 	.bready_o(instr_bready_o),
@@ -209,6 +330,7 @@ hs_2_axi inst_data_mem_axi_master(
 	.hs_write_i(data_mem_wr_s),
 	.hs_addr_i(data_mem_addr_s),
 	.hs_data_i(data_mem_data_o_s),
+	.hs_len_i(data_mem_len_s),
 	.hs_ready_o(data_mem_ready_s),
 	.hs_data_o(data_mem_data_i_s),
 	.byte_select_i(data_mem_byte_select_s),
@@ -217,20 +339,28 @@ hs_2_axi inst_data_mem_axi_master(
 	.arvalid_o(data_arvalid_o),
 	.aready_i(data_aready_i),
 	.araddr_o(data_araddr_o),
+	.arlen_o(data_arlen_o),
+	.arsize_o(data_arsize_o),
+	.arburst_o(data_arburst_o),
 	// Read Data (R) channel
 	.rvalid_i(data_rvalid_i),
 	.rready_o(data_rready_o),
 	.rdata_i(data_rdata_i),
 	.rresp_i(data_rresp_i),
+	.rlast_i(data_rlast_i),
 	// Write Address (AW) channel
 	.awvalid_o(data_awvalid_o),
 	.awready_i(data_awready_i),
 	.awaddr_o(data_awaddr_o),
+	.awlen_o(data_awlen_o),
+	.awsize_o(data_awsize_o),
+	.awburst_o(data_awburst_o),
 	// Write Data (W) channel
 	.wvalid_o(data_wvalid_o),
 	.wready_i(data_wready_i),
 	.wdata_o(data_wdata_o),
 	.wstrb_o(data_wstrb_o),
+	.wlast_o(data_wlast_o),
 	// Write Response (B) channel
 	.bvalid_i(data_bvalid_i),
 	.bready_o(data_bready_o),
@@ -0,0 +1,197 @@
+module branch_predictor #(
+	// Direction predictor (0: none, always predict not taken, 1: bimodal, 2: gshare)
+	parameter MODE=1,
+	// Number of entries of the branch target buffer (power of 2, at least 2)
+	parameter BTB_ENTRIES=16,
+	// Number of 2-bit counters of the pattern history table (power of 2, at least 2)
+	parameter PHT_ENTRIES=64,
+	// Number of entries of the return address stack (power of 2, at least 2)
+	parameter RAS_DEPTH=4,
+	// Instructions aligned to 16 bits (compressed instructions supported)
+	parameter COMPRESSED=1,
+	// Width of the pattern history table index (do not override)
+	parameter PHT_WIDTH=$clog2(PHT_ENTRIES)
+	)(
+	input  clk_i,
+	input  rst_ni,
+
+	// Prediction of the instruction being fetched
+	// fetch_i is high when the instruction is accepted
+	input  fetch_i,
+	input  [31:0] fetch_addr_i,
+	// Instruction being fetched is compressed
+	input  fetch_rvc_i,
+	output pred_taken_o,
+	output [31:0] pred_target_o,
+	// Index of the counter used for the prediction, to be returned on resolution
+	output [PHT_WIDTH-1:0] pred_idx_o,
+
+	// Resolution of a control transfer instruction
+	input  resolve_i,
+	// Type of the instruction (conditional branch, call, return, other jumps otherwise)
+	input  resolve_branch_i,
+	input  resolve_call_i,
+	input  resolve_return_i,
+	input  resolve_taken_i,
+	input  [31:0] resolve_addr_i,
+	input  resolve_rvc_i,
+	input  [31:0] resolve_target_i,
+	input  [PHT_WIDTH-1:0] resolve_idx_i,
+	// Instruction was mispredicted, the pipeline is flushed
+	input  mispredict_i,
+	// Pipeline is flushed by an interrupt or a trap return (instructions in flight are not resolved)
+	input  flush_i,
+
+	// Statistics
+	input  cnt_clr_i,
+	output reg [31:0] hit_cnt_o,
+	output reg [31:0] miss_cnt_o
+);
+
+// Lowest bit of the instruction addresses used for the tables index
+localparam ADDR_LSB  = (COMPRESSED != 0) ? 1 : 2;
+localparam BTB_WIDTH = $clog2(BTB_ENTRIES);
+localparam TAG_WIDTH = 32-ADDR_LSB-BTB_WIDTH;
+localparam RAS_WIDTH = $clog2(RAS_DEPTH);
+// Type of the instructions stored in the branch target buffer
+localparam TYPE_BRANCH = 2'd0;
+localparam TYPE_JUMP   = 2'd1;
+localparam TYPE_CALL   = 2'd2;
+localparam TYPE_RETURN = 2'd3;
+
+// Branch target buffer
+reg [BTB_ENTRIES-1:0] btb_valid_r;
+reg [TAG_WIDTH-1:0] btb_tag_r [0:BTB_ENTRIES-1];
+reg [31:0] btb_target_r [0:BTB_ENTRIES-1];
+reg [1:0]  btb_type_r [0:BTB_ENTRIES-1];
+// Pattern history table (2-bit saturating counters) and global history
+reg [1:0] pht_r [0:PHT_ENTRIES-1];
+reg [PHT_WIDTH-1:0] ghr_r;
+// Return address stack
+//   the speculative pointer is updated on fetch, the committed one on resolution
+reg [31:0] ras_r [0:RAS_DEPTH-1];
+reg [RAS_WIDTH-1:0] ras_ptr_r, ras_commit_ptr_r;
+wire [RAS_WIDTH-1:0] ras_top_s;
+assign ras_top_s = ras_ptr_r-1;
+
+/* ---------------------------------------------------
+* Prediction
+* --------------------------------------------------*/
+wire [BTB_WIDTH-1:0] fetch_btb_idx_s;
+wire [TAG_WIDTH-1:0] fetch_tag_s;
+wire btb_hit_s;
+wire [1:0] btb_type_s;
+assign fetch_btb_idx_s = fetch_addr_i[BTB_WIDTH+ADDR_LSB-1:ADDR_LSB];
+assign fetch_tag_s     = fetch_addr_i[31:BTB_WIDTH+ADDR_LSB];
+assign btb_hit_s       = btb_valid_r[fetch_btb_idx_s] && btb_tag_r[fetch_btb_idx_s]==fetch_tag_s;
+assign btb_type_s      = btb_type_r[fetch_btb_idx_s];
+
+// Counter selected by the address (bimodal) or by the address hashed with the global history (gshare)
+assign pred_idx_o = (MODE==2) ? (fetch_addr_i[PHT_WIDTH+ADDR_LSB-1:ADDR_LSB] ^ ghr_r) : fetch_addr_i[PHT_WIDTH+ADDR_LSB-1:ADDR_LSB];
+
+// Jumps are always taken, conditional branches follow the counter
+assign pred_taken_o  = (MODE!=0) && btb_hit_s && (btb_type_s!=TYPE_BRANCH || pht_r[pred_idx_o][1]);
+// Returns take the target from the return address stack
+assign pred_target_o = (btb_type_s==TYPE_RETURN) ? ras_r[ras_top_s] : btb_target_r[fetch_btb_idx_s];
+
+/* ---------------------------------------------------
+* Update
+* --------------------------------------------------*/
+wire [BTB_WIDTH-1:0] resolve_btb_idx_s;
+reg [1:0] resolve_type_s;
+reg [RAS_WIDTH-1:0] ras_commit_ptr_s;
+assign resolve_btb_idx_s = resolve_addr_i[BTB_WIDTH+ADDR_LSB-1:ADDR_LSB];
+
+always @(*) begin
+	resolve_type_s   = TYPE_JUMP;
+	ras_commit_ptr_s = ras_commit_ptr_r;
+	if (resolve_branch_i) begin
+		resolve_type_s = TYPE_BRANCH;
+	end else if (resolve_call_i) begin
+		resolve_type_s   = TYPE_CALL;
+		ras_commit_ptr_s = ras_commit_ptr_r+1;
+	end else if (resolve_return_i) begin
+		resolve_type_s   = TYPE_RETURN;
+		ras_commit_ptr_s = ras_commit_ptr_r-1;
+	end
+end
+
+integer i;
+always @(posedge clk_i) begin
+	if (rst_ni == 1'b0) begin
+		btb_valid_r      <= 'b0;
+		ghr_r            <= 'b0;
+		ras_ptr_r        <= 'b0;
+		ras_commit_ptr_r <= 'b0;
+		for (i=0; i<BTB_ENTRIES; i=i+1) begin
+			btb_tag_r[i]    <= 'b0;
+			btb_target_r[i] <= 32'd0;
+			btb_type_r[i]   <= TYPE_BRANCH;
+		end
+		// Counters start from weakly not taken
+		for (i=0; i<PHT_ENTRIES; i=i+1) begin
+			pht_r[i] <= 2'b01;
+		end
+		for (i=0; i<RAS_DEPTH; i=i+1) begin
+			ras_r[i] <= 32'd0;
+		end
+	end else begin
+		// Speculative update of the return address stack on fetch
+		if (fetch_i && pred_taken_o) begin
+			if (btb_type_s == TYPE_CALL) begin
+				ras_r[ras_ptr_r] <= (fetch_rvc_i) ? fetch_addr_i+2 : fetch_addr_i+4;
+				ras_ptr_r        <= ras_ptr_r+1;
+			end else if (btb_type_s == TYPE_RETURN) begin
+				ras_ptr_r <= ras_ptr_r-1;
+			end
+		end
+
+		if (resolve_i) begin
+			// Allocate taken instructions in the branch target buffer
+			if (resolve_taken_i) begin
+				btb_valid_r[resolve_btb_idx_s]  <= 1'b1;
+				btb_tag_r[resolve_btb_idx_s]    <= resolve_addr_i[31:BTB_WIDTH+ADDR_LSB];
+				btb_target_r[resolve_btb_idx_s] <= resolve_target_i;
+				btb_type_r[resolve_btb_idx_s]   <= resolve_type_s;
+			end
+			// Train counter and global history with the outcome of conditional branches
+			if (resolve_branch_i) begin
+				if (resolve_taken_i && pht_r[resolve_idx_i]!=2'b11) begin
+					pht_r[resolve_idx_i] <= pht_r[resolve_idx_i]+1;
+				end else if (!resolve_taken_i && pht_r[resolve_idx_i]!=2'b00) begin
+					pht_r[resolve_idx_i] <= pht_r[resolve_idx_i]-1;
+				end
+				ghr_r <= {ghr_r[PHT_WIDTH-2:0], resolve_taken_i};
+			end
+			ras_commit_ptr_r <= ras_commit_ptr_s;
+			// Instructions fetched after a misprediction are discarded, restore the stack pointer
+			if (mispredict_i) begin
+				ras_ptr_r <= ras_commit_ptr_s;
+				// Return address of a call that was not predicted has not been pushed
+				if (resolve_call_i) begin
+					ras_r[ras_commit_ptr_r] <= (resolve_rvc_i) ? resolve_addr_i+2 : resolve_addr_i+4;
+				end
+			end
+		end else if (mispredict_i || flush_i) begin
+			ras_ptr_r <= ras_commit_ptr_r;
+		end
+	end
+end
+
+/* ---------------------------------------------------
+* Statistics
+* --------------------------------------------------*/
+always @(posedge clk_i) begin
+	if (rst_ni == 1'b0 || cnt_clr_i == 1'b1) begin
+		hit_cnt_o  <= 'b0;
+		miss_cnt_o <= 'b0;
+	end else begin
+		if (mispredict_i) begin
+			miss_cnt_o <= miss_cnt_o+1;
+		end else if (resolve_i) begin
+			hit_cnt_o <= hit_cnt_o+1;
+		end
+	end
+end
+
+endmodule
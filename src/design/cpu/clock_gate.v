@@ -0,0 +1,27 @@
+module clock_gate (
+	input  clk_i,
+	// Clock is enabled from the next rising edge
+	input  en_i,
+	output clk_o
+);
+
+`ifdef FPGA
+// Global buffer with clock enable
+BUFGCE inst_bufgce (
+	.I(clk_i),
+	.CE(en_i),
+	.O(clk_o)
+);
+`else
+// Latch based clock gate, the enable is sampled while the clock is low so the gated clock has no glitches
+reg en_latch_r;
+always @(*) begin
+	if (clk_i == 1'b0) begin
+		en_latch_r = en_i;
+	end
+end
+
+assign clk_o = clk_i & en_latch_r;
+`endif
+
+endmodule
@@ -1,10 +1,14 @@
 module control_unit (
     input [6:0] op_i,
+    input [2:0] funct_3_i,
+    input [6:0] funct_7_i,
+    // rs2 field, with funct_7 it forms the funct12 field of the system instructions
+    input [4:0] rs2_addr_i,
     
     output reg [2:0] alu_op_o,
     output reg [2:0] imm_select_o,
     output reg alu_src_o, alu_pc_o, add_sum_reg_o, reg_write_o,
-    output reg mem_rd_o, mem_wr_o, mem_to_reg_o, branch_o, trap_o
+    output reg mem_rd_o, mem_wr_o, mem_to_reg_o, branch_o, trap_o, fence_o, csr_o, muldiv_o, mret_o, wfi_o
 );
 
 always @(*) begin
@@ -20,6 +24,11 @@ always @(*) begin
     branch_o      = 1'b0;
     imm_select_o  = 3'b000;
     trap_o        = 1'b0;
+    fence_o       = 1'b0;
+    csr_o         = 1'b0;
+    muldiv_o      = 1'b0;
+    mret_o        = 1'b0;
+    wfi_o         = 1'b0;
 
     case(op_i)
         // nop
@@ -27,8 +36,12 @@ always @(*) begin
         end
 
         // add, sub, xor, or, and, sll, srl, sra, slt, sltu
+        // mul, mulh, mulhsu, mulhu, div, divu, rem, remu
         7'b0110011 : begin
             reg_write_o = 1'b1;
+            if (funct_7_i == 7'b0000001) begin
+                muldiv_o = 1'b1;
+            end
         end
 
         // addi, xori, ori, andi, slli, srli, srai, slti, sltiu
@@ -97,9 +110,27 @@ always @(*) begin
             imm_select_o = 3'b011; 	// "U" immediate format
         end
 
-        // ecall, ebreak
+        // fence, fence.i
+        7'b0001111 : begin
+            fence_o = 1'b1;
+        end
+
+        // ecall, ebreak, mret, wfi, csrrw, csrrs, csrrc, csrrwi, csrrsi, csrrci
         7'b1110011 : begin
-            trap_o = 1'b1;
+            if (funct_3_i == 3'b000) begin
+                // ecall and ebreak stop the execution, mret returns from a trap, wfi waits for an interrupt
+                // (the whole funct12 field is decoded, sret has the same funct7 of wfi)
+                if ({funct_7_i, rs2_addr_i} == 12'h000 || {funct_7_i, rs2_addr_i} == 12'h001) begin
+                    trap_o = 1'b1;
+                end else if ({funct_7_i, rs2_addr_i} == 12'h302) begin
+                    mret_o = 1'b1;
+                end else if ({funct_7_i, rs2_addr_i} == 12'h105) begin
+                    wfi_o = 1'b1;
+                end
+            end else begin
+                reg_write_o = 1'b1;
+                csr_o       = 1'b1;
+            end
         end
 
         default : begin
@@ -1,20 +1,51 @@
-module cpu (
+module cpu #(
+	// Number of fetched instructions waiting to be decoded (power of 2, at least 2)
+	parameter FETCH_QUEUE_DEPTH=4,
+	// Branch predictor (0: none, always predict not taken, 1: bimodal, 2: gshare)
+	parameter BP_MODE=1,
+	// Branch predictor tables sizes (power of 2, at least 2)
+	parameter BP_BTB_ENTRIES=16,
+	parameter BP_PHT_ENTRIES=64,
+	parameter BP_RAS_DEPTH=4,
+	// Multiplier implementation (0: single cycle, 1: two stages)
+	parameter MUL_PIPELINE=1,
+	// Compressed instructions (RV32C) support
+	parameter RV32C=1,
+	// Clock of the pipeline stopped while waiting for an interrupt (wfi)
+	parameter CLOCK_GATING=1
+	)(
 	input  clk_i,
 	input  rst_ni,
-	input  mem_ready_i,
 	output trap_o,
+	// Interrupt requests (levels)
+	input  irq_external_i,
+	input  irq_timer_i,
+	input  irq_software_i,
+	// Code copy in progress (used only by the performance counters)
+	input  copy_busy_i,
+
+	// Branch predictor statistics
+	input  bp_cnt_clr_i,
+	output [31:0] bp_hit_cnt_o,
+	output [31:0] bp_miss_cnt_o,
 
 	// Instruction memory IOs
+	// Instruction is provided in the same cycle of instr_mem_ready_i
+	input  instr_mem_ready_i,
 	input  [31:0] instr_mem_data_i,
 	output [31:0] instr_mem_addr_o,
 	output instr_mem_rd_o,
 
 	// Data memory IOs
+	// Access is completed (and read data provided) in the same cycle of data_mem_ready_i
+	input  data_mem_ready_i,
 	input  [31:0] data_mem_data_i,
 	output [31:0] data_mem_addr_o,
 	output [31:0] data_mem_data_o,
 	output data_mem_rd_o,
 	output data_mem_wr_o,
+	// Wait until all previous stores have been written to memory
+	output data_mem_fence_o,
 	output [3:0] byte_select_o
 );
 
@@ -24,20 +55,44 @@ module cpu (
 /* ---------------------------------------------------
 * Related to Instruction Fetch (IF) Pipeline Section
 * --------------------------------------------------*/
+localparam BP_PHT_WIDTH = $clog2(BP_PHT_ENTRIES);
 // Next instruction address
-wire        instr_addr_src_s;
 wire [31:0] next_instr_addr_s;
-reg  [31:0] jmp_addr_mem_r;
+// Branch prediction of the instruction being fetched
+wire        pred_taken_s;
+wire [31:0] pred_target_s;
+wire [BP_PHT_WIDTH-1:0] pred_idx_s;
 // Current instruction address
 wire [31:0] instr_addr_s;
 reg  [31:0] instr_addr_r;
 // Instruction memory output
 wire [31:0] instruction_s;
+// Alignment buffer
+//   upper half of the last fetched word, not used yet by the instruction at instr_addr_r
+reg  [15:0] align_buf_r;
+reg         align_valid_r;
+wire [31:0] fetch_bits_s, rvc_instr_s;
+wire        rvc_s, fetch_valid_s, fetch_mem_s, align_keep_s;
+// Fetch queue
+wire fq_push_s, fq_pop_s, fq_full_s, fq_empty_s, fq_rst_s;
+wire [31:0] fq_instr_addr_s, fq_instr_s;
+wire        fq_rvc_s;
+wire        fq_pred_taken_s;
+wire [31:0] fq_pred_target_s;
+wire [BP_PHT_WIDTH-1:0] fq_pred_idx_s;
 // Stall control
-wire        rst_bubble_s;
-reg         rst_bubble_r;
+// Pipeline flush on mispredicted jumps/branches
+wire        flush_s;
+// Stages after fetch are stalled while a data memory access is pending
+wire        mem_stall_s;
+// Stages before EX are stalled while a multiplication/division is in progress or wfi waits for an interrupt
+wire        ex_stall_s, md_stall_s, wfi_stall_s;
 // Pipeline register
 reg  [31:0] instr_addr_id_r, instr_id_r;
+reg         rvc_id_r;
+reg         pred_taken_id_r;
+reg  [31:0] pred_target_id_r;
+reg  [BP_PHT_WIDTH-1:0] pred_idx_id_r;
 
 /* ---------------------------------------------------
 * Related to Instruction Decode (ID) Pipeline Section
@@ -53,13 +108,17 @@ wire [31:0] rs1_data_s, rs2_data_s;
 // Control signals
 wire [2:0]  imm_select_s;
 wire [2:0]  alu_op_s;
-wire jmp_addr_op_sel_s, reg_write_s, alu_pc_s, alu_src_s, mem_read_s, mem_write_s, mem_to_reg_s, branch_s, trap_s;
+wire jmp_addr_op_sel_s, reg_write_s, alu_pc_s, alu_src_s, mem_read_s, mem_write_s, mem_to_reg_s, branch_s, trap_s, fence_s, csr_s, muldiv_s, mret_s, wfi_s;
 reg hazard_nop_s;
 // Pipeline register
 reg  [31:0] immediate_ex_r, instr_addr_ex_r, rs1_data_ex_r, rs2_data_ex_r;
 reg  [2:0]  alu_op_ex_r;
 reg  [31:7] inst_ex_r;
-reg alu_pc_ex_r, alu_src_ex_r, reg_write_ex_r, mem_to_reg_ex_r, mem_read_ex_r, mem_write_ex_r, jmp_addr_op_sel_ex_r, branch_ex_r, trap_ex_r;
+reg alu_pc_ex_r, alu_src_ex_r, reg_write_ex_r, mem_to_reg_ex_r, mem_read_ex_r, mem_write_ex_r, jmp_addr_op_sel_ex_r, branch_ex_r, trap_ex_r, fence_ex_r, csr_ex_r, muldiv_ex_r, mret_ex_r, wfi_ex_r, valid_ex_r;
+reg         pred_taken_ex_r;
+reg  [31:0] pred_target_ex_r;
+reg  [BP_PHT_WIDTH-1:0] pred_idx_ex_r;
+reg         rvc_ex_r;
 
 /* ---------------------------------------------------
 * Related to Execute (EX) Pipeline Section
@@ -73,14 +132,36 @@ wire zero_s;
 // Jump
 wire  [31:0] op1_jump_addr_s, op2_jump_addr_s;
 wire [31:0] jmp_addr_s;
+// Branch resolution
+wire        jmp_taken_s, call_s, return_s, resolve_s, mispredict_s;
+wire [31:0] redirect_addr_s;
+// Multiplication/division unit
+wire        md_ready_s;
+wire [31:0] md_result_s;
+// Control and status registers
+wire [31:0] csr_rd_data_s, csr_wr_data_s;
+wire        csr_wr_s;
+// Interrupts and trap return
+wire        irq_s, irq_take_s, mret_take_s;
+// An enabled interrupt is pending, also if interrupts are globally disabled (end of wfi)
+wire        irq_wake_s;
+// Pipeline clock (stopped while sleeping in wfi)
+wire        clk_core_s, sleep_s;
+wire [31:0] trap_vector_s, mepc_s;
+// Performance counters events
+wire        instret_s;
+wire [5:0]  hpm_event_s;
+reg         refill_r;
 // Forwarding
 reg  [1:0] forward_op1_sel_s, forward_op2_sel_s;
 reg  [31:0] op1_forward_s;
 reg  [31:0] rs2_data_sel_s;
 // Pipeline register
 reg  [31:0] alu_result_mem_r, rs2_data_mem_r;
+// Address of the instruction in MEM (only read by the co-simulation of chip_top_sim, removed by synthesis)
+reg  [31:0] instr_addr_mem_r;
 reg  [4:0] rd_addr_mem_r;
-reg zero_mem_r, reg_write_mem_r, mem_to_reg_mem_r, branch_mem_r, mem_read_mem_r, mem_write_mem_r, trap_mem_r;
+reg reg_write_mem_r, mem_to_reg_mem_r, mem_read_mem_r, mem_write_mem_r, trap_mem_r, fence_mem_r, valid_mem_r;
 reg  [2:0] funct_3_mem_r;
 
 /* ---------------------------------------------------
@@ -100,44 +181,153 @@ reg mem_to_reg_wb_r, trap_wb_r;
 * Instruction Fetch (IF) Pipeline Section
 ******************************************************************************/
 
-// Signal to reset in case of external reset or jumps
-assign rst_bubble_s = (mem_ready_i) ? ((~instr_addr_src_s) & rst_ni) : 1'b1;
-
-// Flip-Flop to save the previous state of the reset signal
-always @(posedge clk_i) begin
-	if (mem_ready_i) begin
-		rst_bubble_r <= rst_bubble_s;
-	end
-end
+// Flush of the instructions after a mispredicted jump/branch, an interrupt or a trap return
+assign flush_s = mispredict_s | irq_take_s | mret_take_s;
 
 // Calculate address of next instruction
-assign next_instr_addr_s = instr_addr_r + 32'd4;
+assign next_instr_addr_s = (rvc_s == 1'b1) ? instr_addr_r + 32'd2 : instr_addr_r + 32'd4;
 
 // Multiplexer for selection of input for the program counter
-assign instr_addr_s = (instr_addr_src_s == 1'd0) ? next_instr_addr_s : jmp_addr_mem_r;
+//   redirect from EX on mispredictions, predicted address otherwise
+assign instr_addr_s = (flush_s == 1'b1)      ? redirect_addr_s :
+                      (pred_taken_s == 1'b1) ? pred_target_s   : next_instr_addr_s;
 
 // Program counter
-always @(posedge clk_i) begin
+// Fetch runs independently from the other stages while there is room in the fetch queue
+always @(posedge clk_core_s) begin
 	if(rst_ni == 1'd0) begin
 		instr_addr_r <= 32'd0;	
-	end else if (mem_ready_i && hazard_nop_s==1'b0) begin
-		instr_addr_r <= instr_addr_s;
+	end else if (flush_s || fq_push_s) begin
+		instr_addr_r <= {instr_addr_s[31:1], 1'b0};
 	end
 end
 
+// Branch predictor
+// Prediction is done while fetching, the predictor is trained when jumps/branches are resolved in EX
+branch_predictor #(
+	.MODE(BP_MODE),
+	.BTB_ENTRIES(BP_BTB_ENTRIES),
+	.PHT_ENTRIES(BP_PHT_ENTRIES),
+	.RAS_DEPTH(BP_RAS_DEPTH),
+	.COMPRESSED(RV32C)
+	)
+	inst_branch_predictor (
+	.clk_i(clk_core_s),
+	.rst_ni(rst_ni),
+	// Prediction
+	.fetch_i(fq_push_s),
+	.fetch_addr_i(instr_addr_r),
+	.fetch_rvc_i(rvc_s),
+	.pred_taken_o(pred_taken_s),
+	.pred_target_o(pred_target_s),
+	.pred_idx_o(pred_idx_s),
+	// Resolution
+	.resolve_i(resolve_s),
+	.resolve_branch_i(~alu_pc_ex_r),
+	.resolve_call_i(call_s),
+	.resolve_return_i(return_s),
+	.resolve_taken_i(jmp_taken_s),
+	.resolve_addr_i(instr_addr_ex_r),
+	.resolve_rvc_i(rvc_ex_r),
+	.resolve_target_i(jmp_addr_s),
+	.resolve_idx_i(pred_idx_ex_r),
+	.mispredict_i(mispredict_s),
+	.flush_i(irq_take_s | mret_take_s),
+	// Statistics
+	.cnt_clr_i(bp_cnt_clr_i),
+	.hit_cnt_o(bp_hit_cnt_o),
+	.miss_cnt_o(bp_miss_cnt_o)
+);
+
 // Instruction memory IOs
-assign instr_mem_addr_o = instr_addr_r;
-assign instr_mem_rd_o   = rst_ni; //& data_mem_ready_i;
+// Memory is read one word at a time, the word after the buffered halfword is read when the buffer is valid
+assign instr_mem_addr_o = (align_valid_r == 1'b1) ? {instr_addr_r[31:2]+30'd1, 2'b00} : {instr_addr_r[31:2], 2'b00};
+assign instr_mem_rd_o   = rst_ni & ~fq_full_s & ~(align_valid_r & rvc_s);
 assign instruction_s    = instr_mem_data_i;
 
+// Fetch alignment
+// Instructions are 32 bits or 16 bits (compressed) long and aligned to 16 bits
+//   a 32-bit instruction can be split between two words, the first half is taken from the buffer
+//   a compressed instruction in the buffer is decoded without reading the memory
+assign fetch_bits_s  = (align_valid_r == 1'b1)   ? {instruction_s[15:0], align_buf_r} :
+                       (instr_addr_r[1] == 1'b1) ? {16'd0, instruction_s[31:16]} : instruction_s;
+assign rvc_s         = (RV32C != 0) && (fetch_bits_s[1:0] != 2'b11);
+assign fetch_mem_s   = instr_mem_rd_o & instr_mem_ready_i;
+assign fetch_valid_s = (align_valid_r & rvc_s) | (fetch_mem_s & (align_valid_r | rvc_s | ~instr_addr_r[1]));
+// Upper half of the word just read is not part of the instruction
+//   it is the beginning of the next instruction, or of the current one when this starts in the upper half
+assign align_keep_s  = (align_valid_r | instr_addr_r[1]) ? ~rvc_s : rvc_s;
+
+always @(posedge clk_core_s) begin
+	if (rst_ni == 1'b0 || flush_s == 1'b1) begin
+		align_buf_r   <= 16'd0;
+		align_valid_r <= 1'b0;
+	end else if (fq_push_s) begin
+		// Buffer is not valid after a predicted jump
+		align_buf_r   <= instruction_s[31:16];
+		align_valid_r <= fetch_mem_s & align_keep_s & ~pred_taken_s;
+	end else if (fetch_mem_s) begin
+		// First half of an instruction starting in the upper half of the word
+		align_buf_r   <= instruction_s[31:16];
+		align_valid_r <= 1'b1;
+	end
+end
+
+// Expansion of compressed instructions to the equivalent 32-bit ones
+decompressor inst_decompressor (
+	.instr_i(fetch_bits_s[15:0]),
+	.instr_o(rvc_instr_s)
+);
+
+// Fetch queue
+// Instructions fetched after a taken jump are discarded
+assign fq_push_s = fetch_valid_s & ~fq_full_s & ~flush_s;
+assign fq_pop_s  = ~fq_empty_s & ~mem_stall_s & ~ex_stall_s & ~hazard_nop_s & ~flush_s;
+assign fq_rst_s  = rst_ni & ~flush_s;
+sync_fifo  #(
+	.DEPTH(FETCH_QUEUE_DEPTH),
+	.DATA_WIDTH(98+BP_PHT_WIDTH)
+	)
+	inst_fetch_queue (
+	// Write port
+	.clk_i(clk_core_s),
+	.rst_ni(fq_rst_s),
+	.wr_en_i(fq_push_s),
+  	.wr_data_i({pred_idx_s, pred_target_s, pred_taken_s, rvc_s, instr_addr_r, (rvc_s ? rvc_instr_s : fetch_bits_s)}),
+	.full_o(fq_full_s),
+	// Read port
+  	.rd_en_i(fq_pop_s),
+  	.rd_data_o({fq_pred_idx_s, fq_pred_target_s, fq_pred_taken_s, fq_rvc_s, fq_instr_addr_s, fq_instr_s}),
+  	.empty_o(fq_empty_s),
+	.not_empty_o()
+);
+
 // IF-ID pipeline register
-always @(posedge clk_i) begin
-	if (rst_ni == 1'd0) begin
-    	instr_addr_id_r <= 32'd0;
-		instr_id_r      <= 32'd0;
-	end else if (mem_ready_i && hazard_nop_s==1'b0) begin
-		instr_addr_id_r <= instr_addr_r;
-		instr_id_r      <= instruction_s;
+// A bubble is inserted when the fetch queue is empty
+always @(posedge clk_core_s) begin
+	if (rst_ni == 1'd0 || flush_s == 1'b1) begin
+    	instr_addr_id_r  <= 32'd0;
+		instr_id_r       <= 32'd0;
+		rvc_id_r         <= 1'b0;
+		pred_taken_id_r  <= 1'b0;
+		pred_target_id_r <= 32'd0;
+		pred_idx_id_r    <= 'd0;
+	end else if (mem_stall_s==1'b0 && ex_stall_s==1'b0 && hazard_nop_s==1'b0) begin
+		if (fq_empty_s == 1'b0) begin
+			instr_addr_id_r  <= fq_instr_addr_s;
+			instr_id_r       <= fq_instr_s;
+			rvc_id_r         <= fq_rvc_s;
+			pred_taken_id_r  <= fq_pred_taken_s;
+			pred_target_id_r <= fq_pred_target_s;
+			pred_idx_id_r    <= fq_pred_idx_s;
+		end else begin
+			instr_addr_id_r  <= 32'd0;
+			instr_id_r       <= 32'd0;
+			rvc_id_r         <= 1'b0;
+			pred_taken_id_r  <= 1'b0;
+			pred_target_id_r <= 32'd0;
+			pred_idx_id_r    <= 'd0;
+		end
 	end
 end
 
@@ -148,9 +338,9 @@ end
 
 // Register file
 register_file inst_register_file(
-	.clk_i(clk_i),
+	.clk_i(clk_core_s),
 	.rst_ni(rst_ni),
-	.stall_i(!mem_ready_i),
+	.stall_i(mem_stall_s),
 	
 	.reg_write_i(reg_write_wb_r),
     .write_addr_i(rd_addr_wb_r),
@@ -166,6 +356,9 @@ register_file inst_register_file(
 // Control unit
 control_unit inst_control_unit(
     .op_i(instr_id_r[6:0]),
+    .funct_3_i(instr_id_r[14:12]),
+    .funct_7_i(instr_id_r[31:25]),
+    .rs2_addr_i(instr_id_r[24:20]),
     
     .alu_op_o(alu_op_s),
     .imm_select_o(imm_select_s),
@@ -177,7 +370,12 @@ control_unit inst_control_unit(
     .mem_to_reg_o(mem_to_reg_s),
     .branch_o(branch_s),
     .add_sum_reg_o(jmp_addr_op_sel_s),
-	.trap_o(trap_s)
+	.trap_o(trap_s),
+	.fence_o(fence_s),
+	.csr_o(csr_s),
+	.muldiv_o(muldiv_s),
+	.mret_o(mret_s),
+	.wfi_o(wfi_s)
 );
 
 // Selector for the bits that form the immediate value
@@ -202,7 +400,7 @@ end
 always @(*) begin
 	hazard_nop_s = 1'b0;
 	// If read from data memory
-	if (mem_read_ex_r == 1'b1 && instr_addr_src_s==1'b0) begin
+	if (mem_read_ex_r == 1'b1) begin
 		// If destination register is one that must be read now
 		if (inst_ex_r[11:7] == instr_id_r[19:15] ||
 			inst_ex_r[11:7] == instr_id_r[24:20]) begin
@@ -214,9 +412,9 @@ end
 
 
 // ID-EX pipeline register
-always @(posedge clk_i) begin
-	if ((rst_bubble_s & rst_bubble_r & rst_ni) == 1'd0 ||
-		(hazard_nop_s == 1'b1 && mem_ready_i == 1'b1)) begin
+always @(posedge clk_core_s) begin
+	if (rst_ni == 1'd0 || flush_s == 1'b1 ||
+		(hazard_nop_s == 1'b1 && mem_stall_s == 1'b0)) begin
 		inst_ex_r       <= 25'd0;
 		instr_addr_ex_r <= 32'd0;
 		rs1_data_ex_r   <= 32'd0;
@@ -232,7 +430,17 @@ always @(posedge clk_i) begin
 		alu_pc_ex_r     <= 1'd0;
 		branch_ex_r     <= 1'd0;
 		trap_ex_r       <= 1'd0;
-	end else if (mem_ready_i) begin
+		fence_ex_r      <= 1'd0;
+		csr_ex_r        <= 1'd0;
+		muldiv_ex_r     <= 1'd0;
+		mret_ex_r       <= 1'd0;
+		wfi_ex_r        <= 1'd0;
+		valid_ex_r      <= 1'd0;
+		pred_taken_ex_r <= 1'b0;
+		pred_target_ex_r <= 32'd0;
+		pred_idx_ex_r   <= 'd0;
+		rvc_ex_r        <= 1'b0;
+	end else if (!mem_stall_s && !ex_stall_s) begin
 		inst_ex_r       <= instr_id_r[31:7];
 		instr_addr_ex_r <= instr_addr_id_r;
 		rs1_data_ex_r   <= rs1_data_s;
@@ -248,6 +456,17 @@ always @(posedge clk_i) begin
 		alu_pc_ex_r     <= alu_pc_s;
 		branch_ex_r     <= branch_s;
 		trap_ex_r       <= trap_s;
+		fence_ex_r      <= fence_s;
+		csr_ex_r        <= csr_s;
+		muldiv_ex_r     <= muldiv_s;
+		mret_ex_r       <= mret_s;
+		wfi_ex_r        <= wfi_s;
+		// Bubbles are all zeros instructions
+		valid_ex_r      <= (instr_id_r[6:0] != 7'd0);
+		pred_taken_ex_r <= pred_taken_id_r;
+		pred_target_ex_r <= pred_target_id_r;
+		pred_idx_ex_r   <= pred_idx_id_r;
+		rvc_ex_r        <= rvc_id_r;
 	end
 end
 
@@ -318,6 +537,7 @@ alu inst_alu(
 	.op1_i(op1_alu_s), 
 	.op2_i(op2_alu_s), 
 	.alu_ctrl_i(alu_ctrl_s), 
+	.compressed_i(rvc_ex_r),
 	
 	.data_o(alu_result_s),
 	.Zero_o(zero_s)
@@ -332,34 +552,134 @@ alu_control_unit inst_alu_control_unit(
 	.alu_ctrl_o(alu_ctrl_s)
 );
 
+// Branch resolution
+// Jumps and branches are resolved here and compared with the prediction done while fetching,
+//   resolution is delayed while the stage is stalled by a data memory access
+assign jmp_taken_s = branch_ex_r & zero_s;
+// Calls and returns (link register is x1 or x5)
+assign call_s   = branch_ex_r & alu_pc_ex_r & (inst_ex_r[11:7]==5'd1 || inst_ex_r[11:7]==5'd5);
+assign return_s = branch_ex_r & alu_pc_ex_r & jmp_addr_op_sel_ex_r & (inst_ex_r[11:7]==5'd0) &
+                  (inst_ex_r[19:15]==5'd1 || inst_ex_r[19:15]==5'd5);
+assign resolve_s = branch_ex_r & ~mem_stall_s & ~ex_stall_s & ~irq_take_s;
+// Wrong direction or wrong target (also instructions that are not jumps can be predicted as taken after an alias in the BTB)
+assign mispredict_s = ~mem_stall_s & ~ex_stall_s & ~irq_take_s & ~mret_ex_r &
+                      ((jmp_taken_s != pred_taken_ex_r) || (jmp_taken_s && jmp_addr_s != pred_target_ex_r));
+// Correct address of next instruction
+assign redirect_addr_s = (irq_take_s == 1'b1)  ? trap_vector_s :
+                         (mret_take_s == 1'b1) ? mepc_s        :
+                         (jmp_taken_s == 1'b1) ? jmp_addr_s    :
+                         (rvc_ex_r == 1'b1)    ? instr_addr_ex_r + 32'd2 : instr_addr_ex_r + 32'd4;
+
+// Interrupts
+// An interrupt is taken when a valid instruction is leaving EX: the instruction is discarded,
+//   its address is saved in mepc and the fetch restarts from the trap handler.
+//   Older instructions in MEM and WB are completed, so the trap is precise.
+//   wfi is never interrupted, the interrupt is taken by the following instruction
+assign irq_take_s  = irq_s & valid_ex_r & ~wfi_ex_r & ~mem_stall_s & ~ex_stall_s;
+// Return from trap, the fetch restarts from mepc
+assign mret_take_s = mret_ex_r & ~mem_stall_s & ~ex_stall_s & ~irq_take_s;
+
+// Wait for interrupt
+// wfi stays in EX until an enabled interrupt is pending, bubbles are sent to the memory stage.
+//   When the older instructions are completed and the fetch queue is full (no memory access in progress)
+//   the clock of the pipeline is stopped, the CSRs (and the wake-up condition) keep the free running clock
+assign wfi_stall_s = wfi_ex_r & ~irq_wake_s;
+assign sleep_s     = wfi_stall_s & ~valid_mem_r & ~instr_mem_rd_o;
+
+generate
+	if (CLOCK_GATING != 0) begin : gen_clock_gate
+		clock_gate inst_clock_gate (
+			.clk_i(clk_i),
+			.en_i(~sleep_s | ~rst_ni),
+			.clk_o(clk_core_s)
+		);
+	end else begin : gen_no_clock_gate
+		assign clk_core_s = clk_i;
+	end
+endgenerate
+
+assign ex_stall_s = md_stall_s | wfi_stall_s;
+
+// Multiplication/division unit (RV32M)
+// Operands are sampled when the instruction enters EX, the stages before EX are stalled until the result is ready
+assign md_stall_s = muldiv_ex_r & ~md_ready_s;
+muldiv #(
+	.MUL_PIPELINE(MUL_PIPELINE)
+	)
+	inst_muldiv (
+	.clk_i(clk_core_s),
+	.rst_ni(rst_ni),
+	.valid_i(muldiv_ex_r),
+	.ack_i(~mem_stall_s),
+	.funct_3_i(inst_ex_r[14:12]),
+	.op1_i(op1_forward_s),
+	.op2_i(op2_alu_s),
+	.ready_o(md_ready_s),
+	.result_o(md_result_s)
+);
+
+// Control and status registers (Zicsr)
+// Accessed when the instruction leaves the EX stage, the read value is written in rd through the ALU result
+// Source operand is rs1 or the 5-bit immediate in the rs1 field
+assign csr_wr_data_s = (inst_ex_r[14] == 1'b1) ? {27'd0, inst_ex_r[19:15]} : op1_forward_s;
+// csrrs/csrrc do not write the register when the source is x0 (or a zero immediate)
+assign csr_wr_s      = (inst_ex_r[13:12] == 2'b01) || (inst_ex_r[19:15] != 5'd0);
+csr_file inst_csr_file (
+	.clk_i(clk_i),
+	.rst_ni(rst_ni),
+	// Access from EX stage
+	.csr_en_i(csr_ex_r & ~mem_stall_s & ~irq_take_s),
+	.csr_addr_i(inst_ex_r[31:20]),
+	.csr_op_i(inst_ex_r[13:12]),
+	.csr_wr_i(csr_wr_s),
+	.csr_data_i(csr_wr_data_s),
+	.csr_data_o(csr_rd_data_s),
+	// Counted events
+	.instret_i(instret_s),
+	.hpm_event_i(hpm_event_s),
+	// Interrupts
+	.irq_external_i(irq_external_i),
+	.irq_timer_i(irq_timer_i),
+	.irq_software_i(irq_software_i),
+	.irq_o(irq_s),
+	.irq_wake_o(irq_wake_s),
+	.trap_enter_i(irq_take_s),
+	.trap_epc_i(instr_addr_ex_r),
+	.trap_return_i(mret_take_s),
+	.trap_vector_o(trap_vector_s),
+	.mepc_o(mepc_s)
+);
+
 // EX-MEM pipeline register
-always @(posedge clk_i) begin
-	if((rst_bubble_s & rst_ni) == 1'd0) begin
+// A bubble is inserted while a multiplication/division or wfi is in progress, or in place of an interrupted instruction
+always @(posedge clk_core_s) begin
+	if(rst_ni == 1'd0 || (ex_stall_s == 1'b1 && mem_stall_s == 1'b0) || irq_take_s == 1'b1) begin
 		alu_result_mem_r <= 32'd0;
 		rs2_data_mem_r   <= 32'd0;
+		instr_addr_mem_r <= 32'd0;
 		mem_read_mem_r   <= 1'd0;
 		mem_write_mem_r  <= 1'd0;
-		zero_mem_r       <= 1'd0;
 		rd_addr_mem_r    <= 5'd0;
 		reg_write_mem_r  <= 1'd0;
 		mem_to_reg_mem_r <= 1'd0;
-		jmp_addr_mem_r   <= 32'd0;
-		branch_mem_r     <= 1'd0;
 		funct_3_mem_r    <= 3'd0;
 		trap_mem_r       <= 1'd0;
-  	end else if (mem_ready_i) begin
-		alu_result_mem_r <= alu_result_s;
+		fence_mem_r      <= 1'd0;
+		valid_mem_r      <= 1'd0;
+  	end else if (!mem_stall_s) begin
+		alu_result_mem_r <= (csr_ex_r == 1'b1)    ? csr_rd_data_s :
+		                    (muldiv_ex_r == 1'b1) ? md_result_s   : alu_result_s;
 		rs2_data_mem_r   <= rs2_data_sel_s;
+		instr_addr_mem_r <= instr_addr_ex_r;
 		mem_read_mem_r   <= mem_read_ex_r;
 		mem_write_mem_r  <= mem_write_ex_r;
-		zero_mem_r       <= zero_s;
 		rd_addr_mem_r    <= inst_ex_r[11:7];
 		reg_write_mem_r  <= reg_write_ex_r;
 		mem_to_reg_mem_r <= mem_to_reg_ex_r;
-		jmp_addr_mem_r   <= jmp_addr_s;
-		branch_mem_r     <= branch_ex_r;
 		funct_3_mem_r    <= inst_ex_r[14:12];
 		trap_mem_r       <= trap_ex_r;
+		fence_mem_r      <= fence_ex_r;
+		valid_mem_r      <= valid_ex_r;
   	end
 end
 
@@ -411,13 +731,14 @@ assign data_mem_addr_o = alu_result_mem_r;
 //assign data_mem_data_o = rs2_data_mem_r;
 assign data_mem_rd_o   = mem_read_mem_r;
 assign data_mem_wr_o   = mem_write_mem_r;
+// Traps wait for the stores to be completed, so that memory is up to date when the trap is signaled
+assign data_mem_fence_o = fence_mem_r | trap_mem_r;
+// Wait for the end of the data memory access
+assign mem_stall_s     = (mem_read_mem_r | mem_write_mem_r | data_mem_fence_o) & ~data_mem_ready_i;
 //assign data_mem_o      = data_mem_data_i;
 
-// Signal to select the imput of the program counter
-assign instr_addr_src_s = branch_mem_r & zero_mem_r;
-
 // MEM-WB pipeline register
-always @(posedge clk_i) begin
+always @(posedge clk_core_s) begin
 	if(rst_ni == 1'd0) begin
 		data_mem_o_wb_r <= 32'd0;
 		alu_result_wb_r <= 32'd0;
@@ -425,7 +746,7 @@ always @(posedge clk_i) begin
 		reg_write_wb_r  <= 1'd0;
 		mem_to_reg_wb_r <= 1'd0;
 		trap_wb_r       <= 1'd0;
-  	end else if (mem_ready_i) begin
+  	end else if (!mem_stall_s) begin
 		data_mem_o_wb_r <= data_mem_o;
 		alu_result_wb_r <= alu_result_mem_r;
 		rd_addr_wb_r    <= rd_addr_mem_r;
@@ -445,4 +766,36 @@ assign reg_data_i_s = (mem_to_reg_wb_r == 1'd0) ? alu_result_wb_r : data_mem_o_w
 
 assign trap_o = trap_wb_r;
 
+
+/******************************************************************************
+* Performance counters events
+******************************************************************************/
+// Instruction is retired when it leaves the MEM stage
+assign instret_s = valid_mem_r & ~mem_stall_s;
+
+// After a flush, the decode stage waits for the instructions fetched from the correct address
+always @(posedge clk_core_s) begin
+	if (rst_ni == 1'b0) begin
+		refill_r <= 1'b0;
+	end else if (flush_s) begin
+		refill_r <= 1'b1;
+	end else if (fq_pop_s) begin
+		refill_r <= 1'b0;
+	end
+end
+
+// Stall cycles, each cycle is assigned to a single cause (cycles waiting in wfi are not counted)
+// Code copy (both memory interfaces are blocked)
+assign hpm_event_s[4] = copy_busy_i;
+// Multiplication/division
+assign hpm_event_s[5] = ~copy_busy_i & ~mem_stall_s & md_stall_s;
+// Data wait
+assign hpm_event_s[1] = ~copy_busy_i & mem_stall_s;
+// Load-use hazard
+assign hpm_event_s[2] = ~copy_busy_i & ~mem_stall_s & hazard_nop_s;
+// Branch flush (flush cycle and refill of the fetch queue, also after interrupts and trap returns)
+assign hpm_event_s[3] = ~copy_busy_i & ~mem_stall_s & ~hazard_nop_s & (flush_s | (refill_r & fq_empty_s));
+// Instruction wait
+assign hpm_event_s[0] = ~copy_busy_i & ~mem_stall_s & ~ex_stall_s & ~hazard_nop_s & ~flush_s & ~refill_r & fq_empty_s;
+
 endmodule
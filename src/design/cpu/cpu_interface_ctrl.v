@@ -1,4 +1,35 @@
-module cpu_interface_ctrl(	
+module cpu_interface_ctrl #(
+	// Instruction cache geometry
+	parameter ICACHE_WAYS=2,
+	parameter ICACHE_SETS=8,
+	parameter ICACHE_LINE_WORDS=4,
+	// Data cache geometry
+	parameter DCACHE_WAYS=2,
+	parameter DCACHE_SETS=8,
+	parameter DCACHE_LINE_WORDS=4,
+	// Address ranges not cached by the data cache (MMIO)
+	parameter DCACHE_N_UNCACHED=1,
+	parameter [(32*DCACHE_N_UNCACHED)-1:0] DCACHE_UNCACHED_BASE_ADDRESSES = 32'h00010000,
+	parameter [(32*DCACHE_N_UNCACHED)-1:0] DCACHE_UNCACHED_TOP_ADDRESSES  = 32'h0001ffff,
+	// SPI flash execute in place
+	// Words read ahead from flash
+	parameter SPI_PREFETCH_WORDS=4,
+	// Depth of the fifos of the SPI controller (bytes)
+	parameter SPI_FIFO_DEPTH=16,
+	// Reset value of the flash read command (0:Read, 1:Fast Read, 2:Dual Output, 3:Quad Output)
+	parameter SPI_READ_MODE=1,
+	// Words written to memory with a single burst while copying code from flash (power of 2, at least 2)
+	parameter COPY_BURST_WORDS=4,
+	// Number of stores buffered between the CPU data port and the data cache (power of 2, at least 2)
+	parameter STORE_BUFFER_DEPTH=4,
+	// Tightly-coupled instruction and data memories (size in bytes, 0 for no memory)
+	parameter ITCM_BASE_ADDRESS=32'h00100000,
+	parameter ITCM_SIZE=0,
+	parameter DTCM_BASE_ADDRESS=32'h00200000,
+	parameter DTCM_SIZE=0,
+	// Number of BUS masters with QoS statistics (at most 4)
+	parameter BUS_N_MST=2
+	)(	
 	input  clk_i,
 	input  rst_ni,
 
@@ -30,11 +61,10 @@ module cpu_interface_ctrl(
 	input  bready_i,
 	output [1:0] bresp_o,
 
-	// CPU stall signal
-	output reg mem_ready_o,
-
 	//// Instruction memory IOs
 	// Towards CPU
+	// Instruction and data interfaces are independent, each one is stalled only by its own cache
+	output cpu_instr_mem_ready_o,
 	input  cpu_instr_mem_rd_i,
 	input  [31:0] cpu_instr_mem_addr_i,
 	output [31:0] cpu_instr_mem_data_o,
@@ -45,11 +75,32 @@ module cpu_interface_ctrl(
 	output reg [31:0] bus_instr_mem_addr_o,
 	input  [31:0] bus_instr_mem_data_i,
 	output [31:0] bus_instr_mem_data_o,
+	output [7:0] bus_instr_mem_len_o,
+	// Direct interface to ITCM (read in the same cycle)
+	output [31:0] itcm_addr_o,
+	input  [31:0] itcm_data_i,
+	// Towards SPI controller (flash execute in place)
+	output spi_xip_en_o,
+	output spi_xip_cs_hold_o,
+	output [1:0] spi_xip_lanes_o,
+	output spi_xip_tx_wr_o,
+	output [7:0] spi_xip_tx_data_o,
+	output spi_xip_rx_rd_o,
+	input  [7:0] spi_xip_rx_data_i,
+	input  spi_xip_rx_not_empty_i,
+	output spi_xip_rx_flush_o,
+	input  spi_xip_busy_i,
+	// Arbitration of the SPI controller with the other flash readers
+	output spi_xip_req_o,
+	input  spi_xip_grant_i,
+	input  spi_xip_release_i,
 
 	// Data memory IOs
 	// Towards CPU
+	output cpu_data_mem_ready_o,
 	input  cpu_data_mem_rd_i,
 	input  cpu_data_mem_wr_i,
+	input  cpu_data_mem_fence_i,
 	input  [31:0] cpu_data_mem_addr_i,
 	input  [31:0] cpu_data_mem_data_i,
 	output [31:0] cpu_data_mem_data_o,
@@ -61,7 +112,28 @@ module cpu_interface_ctrl(
 	output [31:0] bus_data_mem_addr_o,
 	input  [31:0] bus_data_mem_data_i,
 	output [31:0] bus_data_mem_data_o,
-	output [3:0] bus_byte_select_o
+	output [3:0] bus_byte_select_o,
+	output [7:0] bus_data_mem_len_o,
+	// Direct interface to DTCM (read in the same cycle)
+	output dtcm_wr_o,
+	output [31:0] dtcm_addr_o,
+	output [31:0] dtcm_data_o,
+	output [3:0] dtcm_byte_select_o,
+	input  [31:0] dtcm_data_i,
+
+	// Code copy in progress, CPU memory interfaces are blocked
+	output copy_busy_o,
+
+	// CPU branch predictor statistics
+	output bp_cnt_clr_o,
+	input  [31:0] bp_hit_cnt_i,
+	input  [31:0] bp_miss_cnt_i,
+
+	// BUS QoS statistics (32 bits for each master)
+	output bus_stat_clr_o,
+	input  [(32*BUS_N_MST)-1:0] bus_stat_tr_cnt_i,
+	input  [(32*BUS_N_MST)-1:0] bus_stat_lat_cnt_i,
+	input  [(32*BUS_N_MST)-1:0] bus_stat_max_wait_i
 );
 
 // AXI to HS transation signals
@@ -77,24 +149,36 @@ axi_2_hs inst_axi_slave (
 	.arvalid_i(arvalid_i),
 	.aready_o(aready_o),
 	.araddr_i(araddr_i),
+	.arlen_i(8'd0),
+	.arsize_i(3'd2),
+	.arburst_i(2'b01),
+	.arid_i(1'b0),
 	// Read Data (R) channel
 	.rvalid_o(rvalid_o),
 	.rready_i(rready_i),
 	.rdata_o(rdata_o),
 	.rresp_o(rresp_o),
+	.rlast_o(),
+	.rid_o(),
 	// Write Address (AW) channel
 	.awvalid_i(awvalid_i),
 	.awready_o(awready_o),
 	.awaddr_i(awaddr_i),
+	.awlen_i(8'd0),
+	.awsize_i(3'd2),
+	.awburst_i(2'b01),
+	.awid_i(1'b0),
 	// Write Data (W) channel
 	.wvalid_i(wvalid_i),
 	.wready_o(wready_o),
 	.wdata_i(wdata_i),
 	.wstrb_i(wstrb_i),
+	.wlast_i(1'b1),
 	// Write Response (B) channel
 	.bvalid_o(bvalid_o),
 	.bready_i(bready_i),
 	.bresp_o(bresp_o),
+	.bid_o(),
 	// Handshake interface
 	.hs_read_o(hs_read_s),
 	.hs_write_o(hs_write_s),
@@ -110,30 +194,85 @@ axi_2_hs inst_axi_slave (
 * --------------------------------------------------*/
 // Status register signals
 reg executing_from_copy_s, executing_from_copy_r;
+// Signal indicating if the copy_fsm is not in idle
+wire copy_started_s;
+// Copy progress, bytes written to memory and clock cycles
+reg [31:0] copy_bytes_r, copy_cycles_r;
 // Control registers signals
 wire [31:0] start_addr_s, stop_addr_s;
 wire start_copy_s;
 // 0:SRAM, 1:DDR
 wire copy_destination_s;
+// Copy to ITCM (overrides copy_destination_s)
+wire copy_to_itcm_s;
 // Signal to clear the start_copy bit from hardware
 reg start_copy_clr_s;
+// Flash read command used by spi boot controller
+wire [1:0] spi_read_mode_s;
+// Instruction cache control and statistics
+wire icache_invalidate_sw_s, icache_cnt_clr_s;
+wire [31:0] icache_hit_cnt_s, icache_miss_cnt_s;
+// Data cache control and statistics
+wire dcache_clean_sw_s, dcache_flush_sw_s, dcache_cnt_clr_s, dcache_busy_s;
+wire [31:0] dcache_hit_cnt_s, dcache_miss_cnt_s, dcache_writeback_cnt_s;
+// BUS statistics of each master (0 for missing masters)
+wire [31:0] bus_stat_tr_cnt_s   [0:3];
+wire [31:0] bus_stat_lat_cnt_s  [0:3];
+wire [31:0] bus_stat_max_wait_s [0:3];
+genvar stat_idx;
+generate
+	for (stat_idx = 0; stat_idx < 4; stat_idx = stat_idx + 1) begin : gen_bus_stat
+		if (stat_idx < BUS_N_MST) begin : gen_mst
+			assign bus_stat_tr_cnt_s[stat_idx]   = bus_stat_tr_cnt_i[(stat_idx*32)+31:stat_idx*32];
+			assign bus_stat_lat_cnt_s[stat_idx]  = bus_stat_lat_cnt_i[(stat_idx*32)+31:stat_idx*32];
+			assign bus_stat_max_wait_s[stat_idx] = bus_stat_max_wait_i[(stat_idx*32)+31:stat_idx*32];
+		end else begin : gen_no_mst
+			assign bus_stat_tr_cnt_s[stat_idx]   = 32'd0;
+			assign bus_stat_lat_cnt_s[stat_idx]  = 32'd0;
+			assign bus_stat_max_wait_s[stat_idx] = 32'd0;
+		end
+	end
+endgenerate
 
 //// Register access
-// Reg_0 (0x00): Ctrl reg      (RW)
-// Reg_1 (0x04): Status reg    (RO)
-// Reg_2 (0x08): Start address (RW)
-// Reg_3 (0x0C): Stop address  (RW)
-reg [31:0] registers_r [0:3];
+// Reg_0 (0x00): Ctrl reg                  (RW)
+// Reg_1 (0x04): Status reg                (RO)
+// Reg_2 (0x08): Start address             (RW)
+// Reg_3 (0x0C): Stop address              (RW)
+// Reg_4 (0x10): I-cache hit counter       (RO)
+// Reg_5 (0x14): I-cache miss counter      (RO)
+// Reg_6 (0x18): D-cache hit counter       (RO)
+// Reg_7 (0x1C): D-cache miss counter      (RO)
+// Reg_8 (0x20): D-cache writeback counter (RO)
+// Reg_9 (0x24): SPI flash read config     (RW)
+// Reg_10 (0x28): Branch predictor hit counter        (RO)
+// Reg_11 (0x2C): Branch predictor mispredict counter (RO)
+// Reg_12 (0x30): Copy progress, bytes written        (RO)
+// Reg_13 (0x34): Copy duration, clock cycles         (RO)
+// Reg_16+4*m (0x40+0x10*m): BUS master m completed transactions (RO)
+// Reg_17+4*m (0x44+0x10*m): BUS master m latency sum             (RO)
+// Reg_18+4*m (0x48+0x10*m): BUS master m maximum address wait    (RO)
+reg [31:0] registers_r [0:31];
+integer i;
 always @(posedge clk_i) begin
     if (rst_ni == 0) begin
         // Reset of the registers
         registers_r[0] <= 32'd0;
 		registers_r[2] <= 32'd0;
 		registers_r[3] <= 32'd0;
+		registers_r[9] <= SPI_READ_MODE;
     end else begin
+		// Self clearing bits (high for one cycle after being written)
+		registers_r[0][2] <= 1'b0;
+		registers_r[0][3] <= 1'b0;
+		registers_r[0][4] <= 1'b0;
+		registers_r[0][5] <= 1'b0;
+		registers_r[0][6] <= 1'b0;
+		registers_r[0][7] <= 1'b0;
+		registers_r[0][8] <= 1'b0;
         // Writing in the registers
         if (hs_write_s == 1) begin
-            registers_r[hs_addr_s[3:2]] <= hs_data_i_s;
+            registers_r[hs_addr_s[6:2]] <= hs_data_i_s;
         end
 		// Clear of start_copy bit from hardware
 		if (start_copy_clr_s) begin
@@ -141,202 +280,223 @@ always @(posedge clk_i) begin
 		end
     end
 	// Register 1 is read-only (Status reg)
-	registers_r[1] <= {29'd0, boot_source_i, executing_from_copy_r};
+	registers_r[1] <= {27'd0, copy_started_s, dcache_busy_s, boot_source_i, executing_from_copy_r};
+	// Registers 4 and 5 are read-only (I-cache counters)
+	registers_r[4] <= icache_hit_cnt_s;
+	registers_r[5] <= icache_miss_cnt_s;
+	// Registers 6, 7 and 8 are read-only (D-cache counters)
+	registers_r[6] <= dcache_hit_cnt_s;
+	registers_r[7] <= dcache_miss_cnt_s;
+	registers_r[8] <= dcache_writeback_cnt_s;
+	// Only the read command field of register 9 is writable
+	registers_r[9][31:2] <= 30'd0;
+	// Registers 10 and 11 are read-only (branch predictor counters)
+	registers_r[10] <= bp_hit_cnt_i;
+	registers_r[11] <= bp_miss_cnt_i;
+	// Registers 12 and 13 are read-only (copy progress)
+	registers_r[12] <= copy_bytes_r;
+	registers_r[13] <= copy_cycles_r;
+	// Registers 14 and 15 are reserved, always read 0
+	for (i=14; i<16; i=i+1) begin
+		registers_r[i] <= 32'd0;
+	end
+	// Registers 16 to 31 are read-only (BUS statistics, 4 registers for each master)
+	for (i=0; i<4; i=i+1) begin
+		registers_r[16+4*i] <= bus_stat_tr_cnt_s[i];
+		registers_r[17+4*i] <= bus_stat_lat_cnt_s[i];
+		registers_r[18+4*i] <= bus_stat_max_wait_s[i];
+		registers_r[19+4*i] <= 32'd0;
+	end
 end
 // Signals from ctrl register
 assign start_copy_s       = registers_r[0][0];
 assign copy_destination_s = registers_r[0][1];
+assign icache_invalidate_sw_s = registers_r[0][2];
+assign icache_cnt_clr_s   = registers_r[0][3];
+assign dcache_clean_sw_s  = registers_r[0][4];
+assign dcache_flush_sw_s  = registers_r[0][5];
+assign dcache_cnt_clr_s   = registers_r[0][6];
+assign bus_stat_clr_o     = registers_r[0][7];
+assign bp_cnt_clr_o       = registers_r[0][8];
+assign copy_to_itcm_s     = registers_r[0][9];
 assign start_addr_s       = registers_r[2];
 assign stop_addr_s        = registers_r[3];
+assign spi_read_mode_s    = registers_r[9][1:0];
 //Output for register access
-assign hs_data_o_s = registers_r[hs_addr_s[3:2]];
+assign hs_data_o_s = registers_r[hs_addr_s[6:2]];
 // Latency of register access is 0
 assign hs_ready_s = 1'b1;
 
 /* ---------------------------------------------------
-* Single word memory access FSM
-* Manages simultaneus instruction and data memory accesses
+* Instruction and data interfaces
+* Each CPU interface is served directly by its own cache
 * --------------------------------------------------*/
-// Signals between stall_fsm, spi boot controller and bus
-reg  stall_instr_mem_rd_s, stall_data_mem_rd_s, stall_data_mem_wr_s;
+// Signals between CPU, caches, copy_fsm, spi boot controller and bus
 wire bus_instr_mem_ready_s;
 wire [31:0] bus_instr_mem_data_s;
-// Sample incoming data from bus
-reg [1:0] instr_reg_en_s;
-reg data_reg_en_s;
-reg [31:0] instr_r, data_r;
-always @(posedge clk_i) begin
-	if (rst_ni==1'b0) begin
-		instr_r <= 32'd0;
-		data_r  <= 32'd0;
-	end else begin
-		// Sample instruction interface input
-		if (instr_reg_en_s[0] || instr_reg_en_s[1]) begin
-			instr_r <= bus_instr_mem_data_s;
-		end
-		// Sample data interface input
-		if (data_reg_en_s) begin
-			data_r <= bus_data_mem_data_i;
-		end
-	end
-end
+wire icache_ready_s, dcache_ready_s;
+wire [31:0] icache_data_s, dcache_data_s;
+// Line fill of the instruction cache in progress
+wire icache_mem_rd_s;
+// Accesses to the tightly-coupled memories (completed in the same cycle)
+wire itcm_hit_s, itcm_ready_s, dtcm_hit_s, dtcm_ready_s;
+// Store buffer status
+wire sb_ready_s, sb_empty_s;
+// A copy can start only when no CPU access is waiting for the caches
+//   and all buffered stores have been written (loads that complete in the current cycle are allowed)
+wire cpu_idle_s;
+assign cpu_idle_s = (!cpu_instr_mem_rd_i || icache_ready_s || itcm_ready_s) && !icache_mem_rd_s &&
+                    sb_empty_s && (!cpu_data_mem_wr_i || dtcm_ready_s) &&
+                    (!(cpu_data_mem_rd_i || cpu_data_mem_fence_i) || sb_ready_s || dtcm_ready_s);
+
+/* ---------------------------------------------------
+* Tightly-coupled memories
+* Accesses inside the ITCM/DTCM ranges bypass the caches and the bus,
+*   they are completed in the same cycle (except while copying code)
+* --------------------------------------------------*/
+assign itcm_hit_s = (ITCM_SIZE != 0) && (cpu_instr_mem_addr_i >= ITCM_BASE_ADDRESS) && (cpu_instr_mem_addr_i < ITCM_BASE_ADDRESS + ITCM_SIZE);
+assign dtcm_hit_s = (DTCM_SIZE != 0) && (cpu_data_mem_addr_i >= DTCM_BASE_ADDRESS) && (cpu_data_mem_addr_i < DTCM_BASE_ADDRESS + DTCM_SIZE);
+// The ITCM can be filled by the copy_fsm through the bus, fetches wait until the copy ends
+assign itcm_ready_s = cpu_instr_mem_rd_i && itcm_hit_s && !start_copy_s && !copy_started_s;
+assign dtcm_ready_s = (cpu_data_mem_rd_i || cpu_data_mem_wr_i) && dtcm_hit_s && !copy_started_s;
+assign itcm_addr_o        = cpu_instr_mem_addr_i;
+assign dtcm_wr_o          = cpu_data_mem_wr_i && dtcm_ready_s;
+assign dtcm_addr_o        = cpu_data_mem_addr_i;
+assign dtcm_data_o        = cpu_data_mem_data_i;
+assign dtcm_byte_select_o = cpu_byte_select_i;
 
+/* ---------------------------------------------------
+* Copy from SPI memory FSM
+* The flash is read with a single stream from the start to the stop address,
+*   words are collected in the copy buffer and written to memory in bursts
+*   while the following words are still being received
+* --------------------------------------------------*/
+localparam COPY_BURST_WIDTH = $clog2(COPY_BURST_WORDS);
 // Signals and encoding for FSM status
-reg [2:0] stall_current_state_r, stall_next_state_s;
-localparam IDLE       = 3'd0;
-localparam WAIT_BOTH  = 3'd1;
-localparam WAIT_DATA  = 3'd2;
-localparam WAIT_INSTR = 3'd3;
-localparam HS_ACK     = 3'd4;
+reg [2:0] copy_current_state_r, copy_next_state_s;
+localparam COPY_IDLE    = 3'd0;
+localparam FLUSH_DCACHE = 3'd1;
+localparam WAIT_WORDS   = 3'd2;
+localparam WRITE_RAM    = 3'd3;
+localparam END_COPY     = 3'd4;
+// Bus control signals from copy_fsm
+wire copy_instr_mem_rd_s;
+reg  copy_data_mem_wr_s;
+// Request to flush data cache before copying
+reg copy_dcache_flush_s;
 // Signal indicating if the copy_fsm is not in idle
-wire copy_started_s;
+assign copy_started_s = (copy_current_state_r!=COPY_IDLE) ? 1'b1 : 1'b0;
+assign copy_busy_o    = copy_started_s;
+// Signal indicating if the copy_fsm is using the data memory bus interface
+wire copy_bus_s;
+assign copy_bus_s = (copy_current_state_r!=COPY_IDLE && copy_current_state_r!=FLUSH_DCACHE) ? 1'b1 : 1'b0;
 
-// FSM present state update
+// Address of the next word to be read from flash and of the next word to be written to memory
+//  and register indicating if code is being executed from the code copy in ram
+reg [31:0] copy_rd_addr_r, copy_wr_addr_r;
+wire copy_buf_wr_s, copy_buf_rd_s;
 always @(posedge clk_i) begin
 	if(rst_ni == 1'd0) begin
-		stall_current_state_r <= 'b0;
+		copy_rd_addr_r <= 'b0;
+		copy_wr_addr_r <= 'b0;
+		executing_from_copy_r <= 1'b0;
 	end else begin
-		stall_current_state_r <= stall_next_state_s;
-	end
-end
-
-// FSM next state calculation
-always @(*) begin
-	// Default next state
-	stall_next_state_s = stall_current_state_r;
-
- 	case(stall_current_state_r)
-		// Wait for data memory access
-		IDLE : begin
-			// Regulate access only when both an operation towards intruction and data interfaces are started
-			//   If a code copy is running don't do anything
-			if ((cpu_data_mem_rd_i || cpu_data_mem_wr_i) && !copy_started_s) begin
-				if (bus_instr_mem_ready_s && bus_data_mem_ready_i) begin
-					// If memories are immediatly ready stay in idle
-					//  and just forward CPU request
-					stall_next_state_s = IDLE;
-				end else if (!bus_instr_mem_ready_s && !bus_data_mem_ready_i) begin
-					// If memories are not ready, must wait for both
-					stall_next_state_s = WAIT_BOTH;
-				end else if (!bus_instr_mem_ready_s) begin
-					// If only instruction memory is not ready, wait for it
-					stall_next_state_s = WAIT_INSTR;
-				end else if (!bus_data_mem_ready_i) begin
-					// If only data memory is not ready, wait for it
-					stall_next_state_s = WAIT_DATA;
-				end
-			end
-		end
-		
-		// Wait for both memory transactions to finish
-  		WAIT_BOTH : begin
-			if (bus_instr_mem_ready_s && bus_data_mem_ready_i) begin
-				// If both memories are ready return to idle
-				stall_next_state_s = HS_ACK;
-			end else if (bus_instr_mem_ready_s) begin
-				// If only instruction memory is ready, wait for data memory
-				stall_next_state_s = WAIT_DATA;
-			end else if (bus_data_mem_ready_i) begin
-				// If only data memory is ready, wait for instruction memory
-				stall_next_state_s = WAIT_INSTR;
-			end
-		end
-
-		// Wait for data memory transaction to finish
-		WAIT_DATA : begin
-			if (bus_data_mem_ready_i) begin
-				stall_next_state_s = HS_ACK;
+		if (copy_current_state_r == COPY_IDLE) begin
+			copy_rd_addr_r <= start_addr_s;
+			copy_wr_addr_r <= start_addr_s;
+		end else begin
+			if (copy_buf_wr_s) begin
+				copy_rd_addr_r <= copy_rd_addr_r+4;
 			end
-		end
-
-		// Wait for instruction memory transaction to finish
-		WAIT_INSTR : begin
-			if (bus_instr_mem_ready_s) begin
-				stall_next_state_s = HS_ACK;
+			if (copy_buf_rd_s) begin
+				copy_wr_addr_r <= copy_wr_addr_r+4;
 			end
 		end
-
-		// Send acknowledge to hs interface
-		HS_ACK : begin
-			stall_next_state_s = IDLE;
-		end
-        
-        default : stall_next_state_s = IDLE;
-	endcase
+		executing_from_copy_r <= executing_from_copy_s;
+	end
 end
 
-// FSM output calculation
-always @(*) begin
-	// Default output values
-	// By default forward directly the requestr from the CPU
-	stall_instr_mem_rd_s = cpu_instr_mem_rd_i;
-	stall_data_mem_rd_s  = cpu_data_mem_rd_i;
-	stall_data_mem_wr_s  = cpu_data_mem_wr_i;
-	// Sampling of data from bus
-	instr_reg_en_s[0] = 1'b0;
-	data_reg_en_s     = 1'b0;
-
-	case(stall_current_state_r)
-		// Wait for data memory access
-  		IDLE : begin
-		end
-
-		// Wait for both memory transactions to finish
-  		WAIT_BOTH : begin
-			instr_reg_en_s[0] = 1'b1;
-			data_reg_en_s = 1'b1;
-		end
+// Flash is read while there are words left and room in the copy buffer
+//  (the stream is kept open by the spi boot controller since addresses are sequential)
+wire copy_buf_full_s;
+assign copy_instr_mem_rd_s = (copy_current_state_r==WAIT_WORDS || copy_current_state_r==WRITE_RAM) &&
+                             (copy_rd_addr_r != stop_addr_s) && !copy_buf_full_s;
+assign copy_buf_wr_s = copy_instr_mem_rd_s & bus_instr_mem_ready_s;
+// A word is removed at each beat accepted by the bus
+assign copy_buf_rd_s = (copy_current_state_r==WRITE_RAM) & bus_data_mem_ready_i;
+
+// Copy buffer, holds two bursts so that reads from flash continue during a burst
+wire [31:0] copy_buf_data_s;
+sync_fifo  #(
+	.DEPTH(2*COPY_BURST_WORDS),
+	.DATA_WIDTH(32)
+	)
+	inst_copy_buf (
+	// Write port
+	.clk_i(clk_i),
+	.rst_ni(rst_ni),
+	.wr_en_i(copy_buf_wr_s),
+  	.wr_data_i(bus_instr_mem_data_s),
+	.full_o(copy_buf_full_s),
+	// Read port
+  	.rd_en_i(copy_buf_rd_s),
+  	.rd_data_o(copy_buf_data_s),
+  	.empty_o(),
+	.not_empty_o()
+);
 
-		// Wait for data memory transaction to finish
-		WAIT_DATA : begin
-			stall_instr_mem_rd_s = 1'b0;
-			data_reg_en_s = 1'b1;
+// Copy buffer fill level counter
+reg [COPY_BURST_WIDTH+1:0] copy_buf_level_r;
+always @(posedge clk_i) begin
+	if(rst_ni == 1'd0) begin
+		copy_buf_level_r <= 'd0;
+	end else begin
+		if (copy_buf_wr_s==1'b1 && copy_buf_rd_s==1'b0) begin
+			copy_buf_level_r <= copy_buf_level_r+1;
+		end else if (copy_buf_wr_s==1'b0 && copy_buf_rd_s==1'b1) begin
+			copy_buf_level_r <= copy_buf_level_r-1;
 		end
+	end
+end
 
-		// Wait for instruction memory transaction to finish
-		WAIT_INSTR : begin
-			stall_data_mem_rd_s = 1'b0;
-			stall_data_mem_wr_s = 1'b0;
-			instr_reg_en_s[0] = 1'b1;
-		end
+// Length of the next burst: words left, without crossing a block of COPY_BURST_WORDS words
+wire [31:0] copy_words_left_s;
+wire [COPY_BURST_WIDTH:0] copy_block_words_s, copy_burst_words_s;
+assign copy_words_left_s  = (stop_addr_s - copy_wr_addr_r) >> 2;
+assign copy_block_words_s = COPY_BURST_WORDS - copy_wr_addr_r[COPY_BURST_WIDTH+1:2];
+assign copy_burst_words_s = (copy_words_left_s < copy_block_words_s) ? copy_words_left_s[COPY_BURST_WIDTH:0] : copy_block_words_s;
 
-		// Send acknowledge to hs interface
-		HS_ACK : begin
-			stall_data_mem_rd_s = 1'b0;
-			stall_data_mem_wr_s = 1'b0;
-			stall_instr_mem_rd_s = 1'b0;
-		end
-        
-        default : begin
+// Burst length (number of beats - 1) and beat counter of the current burst
+reg [7:0] copy_len_r, copy_beat_cnt_r;
+always @(posedge clk_i) begin
+	if(rst_ni == 1'd0) begin
+		copy_len_r      <= 'd0;
+		copy_beat_cnt_r <= 'd0;
+	end else begin
+		if (copy_current_state_r != WRITE_RAM) begin
+			copy_len_r      <= copy_burst_words_s-1;
+			copy_beat_cnt_r <= 'd0;
+		end else if (copy_buf_rd_s) begin
+			copy_beat_cnt_r <= copy_beat_cnt_r+1;
 		end
-	endcase
+	end
 end
 
-/* ---------------------------------------------------
-* Copy from SPI memory FSM
-* --------------------------------------------------*/
-// Signals and encoding for FSM status
-reg [2:0] copy_current_state_r, copy_next_state_s;
-localparam COPY_IDLE = 3'd0;
-localparam READ_ROM  = 3'd1;
-localparam WRITE_RAM = 3'd2;
-localparam INCR_ADDR = 3'd3;
-localparam END_COPY  = 3'd4;
-// Bus control signals from copy_fsm
-reg copy_instr_mem_rd_s, copy_data_mem_wr_s;
-// Signal indicating if the copy_fsm is not in idle
-assign copy_started_s = (copy_current_state_r!=COPY_IDLE) ? 1'b1 : 1'b0;
-
-// Register for word address that is being copied
-//  and register indicating if code is being executed from the code copy in ram
-reg [31:0] copy_word_addr_s, copy_word_addr_r;
+// Copy progress: bytes written to memory and clock cycles since the start of the copy
 always @(posedge clk_i) begin
 	if(rst_ni == 1'd0) begin
-		copy_word_addr_r <= 'b0;
-		executing_from_copy_r <= 1'b0;
+		copy_bytes_r  <= 'd0;
+		copy_cycles_r <= 'd0;
 	end else begin
-		copy_word_addr_r <= copy_word_addr_s;
-		executing_from_copy_r <= executing_from_copy_s;
+		if (copy_dcache_flush_s) begin
+			copy_bytes_r  <= 'd0;
+			copy_cycles_r <= 'd0;
+		end else if (copy_started_s) begin
+			if (copy_buf_rd_s) begin
+				copy_bytes_r <= copy_bytes_r+4;
+			end
+			copy_cycles_r <= copy_cycles_r+1;
+		end
 	end
 end
 
@@ -357,32 +517,31 @@ always @(*) begin
  	case(copy_current_state_r)
 		// Wait until a copy is started and the last cpu operation is finished
 		COPY_IDLE : begin
-			if (start_copy_s & mem_ready_o) begin
-				copy_next_state_s = READ_ROM;
+			if (start_copy_s & cpu_idle_s) begin
+				copy_next_state_s = FLUSH_DCACHE;
 			end
 		end
 
-		// Get data from code memory
-		READ_ROM : begin
-			if (bus_instr_mem_ready_s) begin
-				copy_next_state_s = WRITE_RAM;
+		// Write back modified data to memory before overwriting it
+		FLUSH_DCACHE : begin
+			if (!dcache_busy_s) begin
+				copy_next_state_s = WAIT_WORDS;
 			end
 		end
 
-		// Write data to ram (internal or ddr)
-		WRITE_RAM : begin
-			if (bus_data_mem_ready_i) begin
-				copy_next_state_s = INCR_ADDR;
+		// Wait until the words of the next burst are in the copy buffer
+		WAIT_WORDS : begin
+			if (copy_wr_addr_r == stop_addr_s) begin
+				copy_next_state_s = END_COPY;
+			end else if (copy_buf_level_r >= copy_burst_words_s) begin
+				copy_next_state_s = WRITE_RAM;
 			end
 		end
 
-		// Increment word address
-		INCR_ADDR : begin
-			// Check if next word needs to be copied
-			if (copy_word_addr_s == stop_addr_s) begin
-				copy_next_state_s = END_COPY;
-			end else begin
-				copy_next_state_s = READ_ROM;
+		// Write a burst to ram (internal or ddr)
+		WRITE_RAM : begin
+			if (copy_buf_rd_s && copy_beat_cnt_r == copy_len_r) begin
+				copy_next_state_s = WAIT_WORDS;
 			end
 		end
 
@@ -398,41 +557,36 @@ end
 // FSM output calculation
 always @(*) begin
 	// Default output values
-	copy_word_addr_s    = start_addr_s;
-	copy_instr_mem_rd_s = 1'b0;
 	copy_data_mem_wr_s  = 1'b0;
-	instr_reg_en_s[1]   = 1'b0;
 	executing_from_copy_s = executing_from_copy_r;
 	start_copy_clr_s    = 1'b0;
+	copy_dcache_flush_s = 1'b0;
 
 	case(copy_current_state_r)
   		// Wait until a copy is started
+		// Request data cache flush when starting
 		COPY_IDLE : begin
+			copy_dcache_flush_s = (copy_next_state_s==FLUSH_DCACHE) ? 1'b1 : 1'b0;
 		end
 
-		// Get data from code memory
-		READ_ROM : begin
-			copy_instr_mem_rd_s = 1'b1;
-			instr_reg_en_s[1]   = 1'b1;
-			copy_word_addr_s    = copy_word_addr_r;
+		// Wait for data cache flush
+		FLUSH_DCACHE : begin
 		end
 
-		// Write data to ram (internal or ddr)
-		WRITE_RAM : begin
-			copy_data_mem_wr_s = 1'b1;
-			copy_word_addr_s   = copy_word_addr_r;
+		// Wait for the words of the next burst
+		WAIT_WORDS : begin
 		end
 
-		// Increment word address
-		INCR_ADDR : begin
-			copy_word_addr_s = copy_word_addr_r+4;
+		// Write a burst to ram (internal or ddr)
+		WRITE_RAM : begin
+			copy_data_mem_wr_s = 1'b1;
 		end
 
-		// Set register to continue executing from ram
+		// Set register to continue executing from ram (code copied to the ITCM is called explicitly)
 		// Clear start copy bit
 		END_COPY : begin
 			start_copy_clr_s      = 1'b1;
-			executing_from_copy_s = 1'b1;
+			executing_from_copy_s = executing_from_copy_r || !copy_to_itcm_s;
 		end
 
         default : begin
@@ -440,9 +594,151 @@ always @(*) begin
 	endcase
 end
 
+/* ---------------------------------------------------
+* Instruction cache
+* Placed between the CPU instruction port and the bus/spi_boot_ctrl,
+*   it is bypassed by the copy_fsm and invalidated at the end of a copy
+* --------------------------------------------------*/
+wire icache_rd_s, icache_invalidate_s;
+wire [31:0] icache_mem_addr_s;
+wire [7:0] icache_mem_len_s;
+// Code memory changes after a copy, cached lines are not valid anymore
+assign icache_invalidate_s = icache_invalidate_sw_s || (copy_current_state_r==END_COPY);
+// No new requests from CPU once a copy has been requested
+assign icache_rd_s = cpu_instr_mem_rd_i && !itcm_hit_s && !start_copy_s && !copy_started_s;
+
+icache #(
+	.WAYS(ICACHE_WAYS),
+	.SETS(ICACHE_SETS),
+	.LINE_WORDS(ICACHE_LINE_WORDS)
+) inst_icache (
+	.clk_i(clk_i),
+	.rst_ni(rst_ni),
+	// Control
+	.invalidate_i(icache_invalidate_s),
+	.cnt_clr_i(icache_cnt_clr_s),
+	.cpu_ack_i(1'b1),
+	// Handshake interface from CPU
+	.cpu_rd_i(icache_rd_s),
+	.cpu_addr_i(cpu_instr_mem_addr_i),
+	.cpu_ready_o(icache_ready_s),
+	.cpu_data_o(icache_data_s),
+	// Handshake interface towards memory
+	.mem_ready_i(bus_instr_mem_ready_s && !copy_started_s),
+	.mem_data_i(bus_instr_mem_data_s),
+	.mem_rd_o(icache_mem_rd_s),
+	.mem_addr_o(icache_mem_addr_s),
+	.mem_len_o(icache_mem_len_s),
+	// Statistics
+	.hit_cnt_o(icache_hit_cnt_s),
+	.miss_cnt_o(icache_miss_cnt_s)
+);
+
+// The ITCM range is never cached, code written through the data port reaches the ITCM directly
+localparam DCACHE_N_RANGES = DCACHE_N_UNCACHED+1;
+localparam [(32*DCACHE_N_RANGES)-1:0] DCACHE_BASE_ADDRESSES = {ITCM_BASE_ADDRESS, DCACHE_UNCACHED_BASE_ADDRESSES};
+localparam [(32*DCACHE_N_RANGES)-1:0] DCACHE_TOP_ADDRESSES  = {ITCM_BASE_ADDRESS+ITCM_SIZE-1, DCACHE_UNCACHED_TOP_ADDRESSES};
+
+/* ---------------------------------------------------
+* Store buffer
+* Placed between the CPU data port and the data cache,
+*   stores are completed as soon as they are buffered and written to the cache in order
+* --------------------------------------------------*/
+wire sb_cpu_rd_s, sb_cpu_wr_s, sb_cpu_fence_s;
+wire [31:0] sb_data_s;
+wire sb_mem_rd_s, sb_mem_wr_s;
+wire [31:0] sb_mem_addr_s, sb_mem_data_s;
+wire [3:0] sb_mem_byte_select_s;
+// No requests from CPU while copying (or served by the DTCM)
+assign sb_cpu_rd_s    = cpu_data_mem_rd_i && !dtcm_hit_s && !copy_started_s;
+assign sb_cpu_wr_s    = cpu_data_mem_wr_i && !dtcm_hit_s && !copy_started_s;
+assign sb_cpu_fence_s = cpu_data_mem_fence_i && !copy_started_s;
+
+store_buffer #(
+	.DEPTH(STORE_BUFFER_DEPTH),
+	.N_UNCACHED(DCACHE_N_RANGES),
+	.UNCACHED_BASE_ADDRESSES(DCACHE_BASE_ADDRESSES),
+	.UNCACHED_TOP_ADDRESSES(DCACHE_TOP_ADDRESSES)
+	)
+	inst_store_buffer (
+	.clk_i(clk_i),
+	.rst_ni(rst_ni),
+	.empty_o(sb_empty_s),
+	// Handshake interface from CPU
+	.cpu_rd_i(sb_cpu_rd_s),
+	.cpu_wr_i(sb_cpu_wr_s),
+	.cpu_fence_i(sb_cpu_fence_s),
+	.cpu_addr_i(cpu_data_mem_addr_i),
+	.cpu_data_i(cpu_data_mem_data_i),
+	.cpu_byte_select_i(cpu_byte_select_i),
+	.cpu_ready_o(sb_ready_s),
+	.cpu_data_o(sb_data_s),
+	// Handshake interface towards data cache
+	.mem_ready_i(dcache_ready_s),
+	.mem_data_i(dcache_data_s),
+	.mem_rd_o(sb_mem_rd_s),
+	.mem_wr_o(sb_mem_wr_s),
+	.mem_addr_o(sb_mem_addr_s),
+	.mem_data_o(sb_mem_data_s),
+	.mem_byte_select_o(sb_mem_byte_select_s)
+);
+
+/* ---------------------------------------------------
+* Data cache
+* Placed between the CPU data port and the bus,
+*   it is flushed before a copy since the copy_fsm writes directly to memory
+* --------------------------------------------------*/
+wire dcache_rd_s, dcache_wr_s;
+wire dcache_mem_rd_s, dcache_mem_wr_s;
+wire [31:0] dcache_mem_addr_s, dcache_mem_data_s;
+wire [3:0] dcache_mem_byte_select_s;
+wire [7:0] dcache_mem_len_s;
+// No requests from CPU while copying
+assign dcache_rd_s = sb_mem_rd_s && !copy_started_s;
+assign dcache_wr_s = sb_mem_wr_s && !copy_started_s;
+
+dcache #(
+	.WAYS(DCACHE_WAYS),
+	.SETS(DCACHE_SETS),
+	.LINE_WORDS(DCACHE_LINE_WORDS),
+	.N_UNCACHED(DCACHE_N_RANGES),
+	.UNCACHED_BASE_ADDRESSES(DCACHE_BASE_ADDRESSES),
+	.UNCACHED_TOP_ADDRESSES(DCACHE_TOP_ADDRESSES)
+) inst_dcache (
+	.clk_i(clk_i),
+	.rst_ni(rst_ni),
+	// Control
+	.clean_i(dcache_clean_sw_s),
+	.flush_i(dcache_flush_sw_s || copy_dcache_flush_s),
+	.busy_o(dcache_busy_s),
+	.cnt_clr_i(dcache_cnt_clr_s),
+	.cpu_ack_i(1'b1),
+	// Handshake interface from CPU
+	.cpu_rd_i(dcache_rd_s),
+	.cpu_wr_i(dcache_wr_s),
+	.cpu_addr_i(sb_mem_addr_s),
+	.cpu_data_i(sb_mem_data_s),
+	.cpu_byte_select_i(sb_mem_byte_select_s),
+	.cpu_ready_o(dcache_ready_s),
+	.cpu_data_o(dcache_data_s),
+	// Handshake interface towards memory
+	.mem_ready_i(bus_data_mem_ready_i && !copy_bus_s),
+	.mem_data_i(bus_data_mem_data_i),
+	.mem_rd_o(dcache_mem_rd_s),
+	.mem_wr_o(dcache_mem_wr_s),
+	.mem_addr_o(dcache_mem_addr_s),
+	.mem_data_o(dcache_mem_data_s),
+	.mem_byte_select_o(dcache_mem_byte_select_s),
+	.mem_len_o(dcache_mem_len_s),
+	// Statistics
+	.hit_cnt_o(dcache_hit_cnt_s),
+	.miss_cnt_o(dcache_miss_cnt_s),
+	.writeback_cnt_o(dcache_writeback_cnt_s)
+);
+
 // Controller to boot from external spi memory
 // Use spi boot controller only when copying (receive transactions from copy_fsm) 
-//    or booting from SPI before having copied to RAM (receive transaction from stall_fsm)
+//    or booting from SPI before having copied to RAM (receive line fills from instruction cache)
 wire use_boot_ctrl_s;
 assign use_boot_ctrl_s = (copy_started_s || (!executing_from_copy_r && boot_source_i==2'd0));
 reg boot_ctrl_rd_s;
@@ -452,112 +748,122 @@ always @(*) begin
 		// Receive transactions from copy_fsm
 		boot_ctrl_rd_s   = copy_instr_mem_rd_s;
 `ifdef FPGA
-		boot_ctrl_addr_s = copy_word_addr_r + 32'h00130000;
+		boot_ctrl_addr_s = copy_rd_addr_r + 32'h00130000;
 `else
-        boot_ctrl_addr_s = copy_word_addr_r;
+        boot_ctrl_addr_s = copy_rd_addr_r;
 `endif
 	end else begin
 		if (use_boot_ctrl_s) begin
-			// Receive transaction from stall_fsm
-			boot_ctrl_rd_s = stall_instr_mem_rd_s;
+			// Receive line fills from instruction cache
+			boot_ctrl_rd_s = icache_mem_rd_s;
 		end else begin
 			// Block any transaction
 			boot_ctrl_rd_s = 1'b0;
 		end
-		// Always receive the address from stall_fsm
+		// Always receive the address from instruction cache
 `ifdef FPGA
-		boot_ctrl_addr_s = cpu_instr_mem_addr_i + 32'h00130000;
+		boot_ctrl_addr_s = icache_mem_addr_s + 32'h00130000;
 `else
-       boot_ctrl_addr_s = cpu_instr_mem_addr_i;
+       boot_ctrl_addr_s = icache_mem_addr_s;
 `endif
 	end
 end
 
-// Signals between spi boot controller and bus
-wire spi_instr_mem_rd_s, spi_instr_mem_ready_s;
-wire [31:0] spi_instr_mem_addr_s, spi_instr_mem_data_s;
-spi_boot_ctrl inst_spi_boot_ctrl (
+// Signals from spi boot controller
+// The stream from flash is kept open while the boot controller is in use
+wire spi_instr_mem_ready_s;
+wire [31:0] spi_instr_mem_data_s;
+spi_boot_ctrl #(
+	.PREFETCH_WORDS(SPI_PREFETCH_WORDS),
+	.SPI_FIFO_DEPTH(SPI_FIFO_DEPTH)
+	)
+	inst_spi_boot_ctrl (
 	.clk_i(clk_i),
 	.rst_ni(rst_ni),
+	// Flash read command
+	.read_mode_i(spi_read_mode_s),
+	.close_i(!use_boot_ctrl_s),
+	// Arbitration of the SPI controller
+	.spi_req_o(spi_xip_req_o),
+	.spi_grant_i(spi_xip_grant_i),
+	.spi_release_i(spi_xip_release_i),
 	// Handshake interface from CPU
 	.cpu_hs_read_i(boot_ctrl_rd_s),
 	.cpu_hs_addr_i(boot_ctrl_addr_s),
 	.cpu_hs_ready_o(spi_instr_mem_ready_s),
 	.cpu_hs_data_o(spi_instr_mem_data_s),
-	// Handshake interface to interconnect
-	.bus_hs_ready_i(bus_instr_mem_ready_i),
-	.bus_hs_data_i(bus_instr_mem_data_i),
-	.bus_hs_rd_o(spi_instr_mem_rd_s),
-	.bus_hs_wr_o(bus_instr_mem_wr_o),
-	.bus_hs_addr_o(spi_instr_mem_addr_s),
-	.bus_hs_data_o(bus_instr_mem_data_o)
+	// Direct interface to SPI controller
+	.spi_xip_en_o(spi_xip_en_o),
+	.spi_cs_hold_o(spi_xip_cs_hold_o),
+	.spi_lanes_o(spi_xip_lanes_o),
+	.spi_tx_wr_o(spi_xip_tx_wr_o),
+	.spi_tx_data_o(spi_xip_tx_data_o),
+	.spi_rx_rd_o(spi_xip_rx_rd_o),
+	.spi_rx_data_i(spi_xip_rx_data_i),
+	.spi_rx_not_empty_i(spi_xip_rx_not_empty_i),
+	.spi_rx_flush_o(spi_xip_rx_flush_o),
+	.spi_busy_i(spi_xip_busy_i)
 );
 
 /* ---------------------------------------------------
 * CPU stall control
-* CPU needs to be halted while waiting for the bus and while coying code
+* Each interface is ready when its cache or tightly-coupled memory serves the access
+*   (caches do not serve the CPU while copying code)
 * --------------------------------------------------*/
-always @(*) begin
-	if (copy_started_s) begin
-		// Stop CPU while copying code
-		mem_ready_o = 1'b0;
-	end else begin
-		if (stall_next_state_s==IDLE && stall_current_state_r==IDLE) begin
-			// If no simultaneus instruction/data interfaces operations
-			//   connect directly CPU stall signal to ready signal from bus or spi boot ctrl
-			if (use_boot_ctrl_s) begin
-				// CPU stalled by spi boot controller
-				mem_ready_o = spi_instr_mem_ready_s;
-			end else begin
-				// CPU stalled by bus boot controller
-				mem_ready_o = bus_instr_mem_ready_i;
-			end
-		end else if (stall_current_state_r==HS_ACK) begin
-			// stall_fsm has concluded the transactions, start CPU
-			mem_ready_o = 1'b1;
-		end else begin
-			// CPU stalled by stall_fsm
-			mem_ready_o = 1'b0;
-		end
-	end
-end
+assign cpu_instr_mem_ready_o = icache_ready_s || itcm_ready_s;
+assign cpu_data_mem_ready_o  = sb_ready_s || dtcm_ready_s;
 
 /* ---------------------------------------------------
-* Multiplexing of bus interfaces (select stall_fsm/spi_boot_ctrl)
+* Multiplexing of bus interfaces (select caches/copy_fsm/spi_boot_ctrl)
 * --------------------------------------------------*/
 // Instruction memory interface signals
 assign bus_instr_mem_ready_s = (use_boot_ctrl_s) ? spi_instr_mem_ready_s : bus_instr_mem_ready_i;
 assign bus_instr_mem_data_s  = (use_boot_ctrl_s) ? spi_instr_mem_data_s  : bus_instr_mem_data_i;
-assign bus_instr_mem_rd_o    = (use_boot_ctrl_s) ? spi_instr_mem_rd_s    : stall_instr_mem_rd_s;
-// Provide to cpu instruction got from bus (it needs to be taken from the instruciton interface sampling register if concurrent intruction/data accesses)
-assign cpu_instr_mem_data_o  = (stall_current_state_r!=HS_ACK) ? bus_instr_mem_data_s : instr_r;
+assign bus_instr_mem_rd_o    = (use_boot_ctrl_s) ? 1'b0                  : icache_mem_rd_s;
+// Line fills are read as bursts
+assign bus_instr_mem_len_o   = icache_mem_len_s;
+// Instruction interface never writes on the bus
+assign bus_instr_mem_wr_o    = 1'b0;
+assign bus_instr_mem_data_o  = 32'd0;
+// Provide to cpu instruction got from cache or ITCM
+assign cpu_instr_mem_data_o  = (itcm_hit_s) ? itcm_data_i : icache_data_s;
 // Select address for bus instruction interface
 //  Code can be in external SPI memory, internal SRAM or external DDR
 //    depending on boot mode, and if code has been copyed to ram 
 always @(*) begin
 	if (use_boot_ctrl_s) begin
-		// Use address form SPI boot controller
-		bus_instr_mem_addr_o = spi_instr_mem_addr_s;
+		// SPI boot controller does not use the bus
+		bus_instr_mem_addr_o = 32'd0;
 	end else if ((!executing_from_copy_r && boot_source_i==2'd1) || (executing_from_copy_r && copy_destination_s==1'd0)) begin
 		// Use address of internal SRAM
-		bus_instr_mem_addr_o = {15'd0, cpu_instr_mem_addr_i[16:0]};
+		bus_instr_mem_addr_o = {15'd0, icache_mem_addr_s[16:0]};
 	end else begin
 		// Use address of external DDR
-		bus_instr_mem_addr_o = {4'hf, cpu_instr_mem_addr_i[27:0]};
+		bus_instr_mem_addr_o = {4'hf, icache_mem_addr_s[27:0]};
 	end 
 end
 
 // Data memory interface signals
-// Data memory towards bus (from copy_fsm or from stall_fsm)
+// Data memory towards bus (from copy_fsm or from data cache)
 // Add offset to memory where to copy code
-wire [31:0] copy_data_addr_s;
-assign copy_data_addr_s    = (copy_destination_s==1'd0) ? {15'd0, copy_word_addr_r[16:0]} : {4'hf, copy_word_addr_r[27:0]};
-assign bus_data_mem_addr_o = (copy_started_s) ? copy_data_addr_s   : cpu_data_mem_addr_i;
-assign bus_data_mem_data_o = (copy_started_s) ? instr_r            : cpu_data_mem_data_i;
-assign bus_data_mem_wr_o   = (copy_started_s) ? copy_data_mem_wr_s : stall_data_mem_wr_s;
-assign bus_data_mem_rd_o   = (copy_started_s) ? 1'b0               : stall_data_mem_rd_s;
-assign bus_byte_select_o   = (copy_started_s) ? 4'hf               : cpu_byte_select_i;
-// Provide to cpu data got from bus (it always needs to be taken from data interface sampling register)
-assign cpu_data_mem_data_o = data_r;
+//  (code copied to the ITCM is placed from its base address)
+reg [31:0] copy_data_addr_s;
+always @(*) begin
+	if (copy_to_itcm_s) begin
+		copy_data_addr_s = ITCM_BASE_ADDRESS + (copy_wr_addr_r - start_addr_s);
+	end else if (copy_destination_s==1'd0) begin
+		copy_data_addr_s = {15'd0, copy_wr_addr_r[16:0]};
+	end else begin
+		copy_data_addr_s = {4'hf, copy_wr_addr_r[27:0]};
+	end
+end
+assign bus_data_mem_addr_o = (copy_bus_s) ? copy_data_addr_s   : dcache_mem_addr_s;
+assign bus_data_mem_data_o = (copy_bus_s) ? copy_buf_data_s    : dcache_mem_data_s;
+assign bus_data_mem_wr_o   = (copy_bus_s) ? copy_data_mem_wr_s : dcache_mem_wr_s;
+assign bus_data_mem_rd_o   = (copy_bus_s) ? 1'b0               : dcache_mem_rd_s;
+assign bus_byte_select_o   = (copy_bus_s) ? 4'hf               : dcache_mem_byte_select_s;
+assign bus_data_mem_len_o  = (copy_bus_s) ? copy_len_r         : dcache_mem_len_s;
+// Provide to cpu data got from store buffer (forwarded from buffered stores or from cache) or DTCM
+assign cpu_data_mem_data_o = (dtcm_hit_s) ? dtcm_data_i : sb_data_s;
 
 endmodule
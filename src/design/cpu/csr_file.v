@@ -0,0 +1,252 @@
+module csr_file (
+	input  clk_i,
+	input  rst_ni,
+
+	// Access from the EX stage (csrrw, csrrs, csrrc and immediate versions)
+	// Instruction is executed when csr_en_i is high
+	input  csr_en_i,
+	input  [11:0] csr_addr_i,
+	// Operation (funct3[1:0] of the instruction, 1: write, 2: set, 3: clear)
+	input  [1:0] csr_op_i,
+	// Register is written (low for csrrs/csrrc with rs1=x0)
+	input  csr_wr_i,
+	input  [31:0] csr_data_i,
+	output reg [31:0] csr_data_o,
+
+	// Counted events
+	// Instruction retired
+	input  instret_i,
+	// Events of the hpmcounters 3 to 8
+	// 0: instruction wait, 1: data wait, 2: load-use hazard, 3: branch flush, 4: code copy, 5: multiplication/division
+	input  [5:0] hpm_event_i,
+
+	// Interrupt requests (levels)
+	input  irq_external_i,
+	input  irq_timer_i,
+	input  irq_software_i,
+	// An enabled interrupt is pending (taken by the next instruction leaving EX)
+	output irq_o,
+	// An enabled interrupt is pending, regardless of the global enable (end of wfi)
+	output irq_wake_o,
+	// Trap entry, the instruction in EX is not executed and its address is saved in mepc
+	input  trap_enter_i,
+	input  [31:0] trap_epc_i,
+	// Return from trap (mret)
+	input  trap_return_i,
+	// Address of the trap handler and return address
+	output [31:0] trap_vector_o,
+	output [31:0] mepc_o
+);
+
+localparam N_HPM = 6;
+
+// CSR addresses
+localparam MCYCLE        = 12'hB00;
+localparam MINSTRET      = 12'hB02;
+localparam MHPMCOUNTER3  = 12'hB03;
+localparam MCYCLEH       = 12'hB80;
+localparam MINSTRETH     = 12'hB82;
+localparam MHPMCOUNTER3H = 12'hB83;
+localparam CYCLE         = 12'hC00;
+localparam INSTRET       = 12'hC02;
+localparam HPMCOUNTER3   = 12'hC03;
+localparam CYCLEH        = 12'hC80;
+localparam INSTRETH      = 12'hC82;
+localparam HPMCOUNTER3H  = 12'hC83;
+localparam MCOUNTINHIBIT = 12'h320;
+localparam MHPMEVENT3    = 12'h323;
+localparam MSTATUS       = 12'h300;
+localparam MIE           = 12'h304;
+localparam MTVEC         = 12'h305;
+localparam MSCRATCH      = 12'h340;
+localparam MEPC          = 12'h341;
+localparam MCAUSE        = 12'h342;
+localparam MTVAL         = 12'h343;
+localparam MIP           = 12'h344;
+
+// Interrupt bits in mie/mip and cause codes
+localparam IRQ_SOFTWARE = 3;
+localparam IRQ_TIMER    = 7;
+localparam IRQ_EXTERNAL = 11;
+
+// Counters
+reg [63:0] mcycle_r, minstret_r;
+reg [63:0] mhpmcounter_r [0:N_HPM-1];
+// Counting inhibited (bit 0: mcycle, bit 2: minstret, bits 3 to 8: hpmcounters)
+reg [8:0] mcountinhibit_r;
+// Trap registers
+// mstatus: global interrupt enable and its value before the trap (privilege is always machine mode)
+reg mstatus_mie_r, mstatus_mpie_r;
+// mie: software, timer and external interrupt enables (other bits are zero)
+reg [11:0] mie_r;
+wire [11:0] mip_s;
+// mtvec: base address and mode (0: direct, 1: vectored)
+reg [31:0] mtvec_r;
+reg [31:0] mscratch_r, mepc_r;
+// mcause: interrupt flag and cause code
+reg mcause_irq_r;
+reg [3:0] mcause_code_r;
+
+/* ---------------------------------------------------
+* Interrupts
+* --------------------------------------------------*/
+assign mip_s = {irq_external_i, 3'd0, irq_timer_i, 3'd0, irq_software_i, 3'd0};
+
+// Pending and enabled interrupt with the highest priority (external, software, timer)
+wire [11:0] irq_pending_s;
+reg  [3:0]  irq_code_s;
+assign irq_pending_s = mip_s & mie_r;
+always @(*) begin
+	if (irq_pending_s[IRQ_EXTERNAL]) begin
+		irq_code_s = IRQ_EXTERNAL;
+	end else if (irq_pending_s[IRQ_SOFTWARE]) begin
+		irq_code_s = IRQ_SOFTWARE;
+	end else begin
+		irq_code_s = IRQ_TIMER;
+	end
+end
+assign irq_o = mstatus_mie_r & (|irq_pending_s);
+assign irq_wake_o = |irq_pending_s;
+
+// In vectored mode interrupts jump to base+4*cause
+assign trap_vector_o = (mtvec_r[0] == 1'b1) ? {mtvec_r[31:2], 2'b00} + {irq_code_s, 2'b00} : {mtvec_r[31:2], 2'b00};
+assign mepc_o        = mepc_r;
+
+/* ---------------------------------------------------
+* Read
+* --------------------------------------------------*/
+integer i;
+always @(*) begin
+	csr_data_o = 32'd0;
+	case (csr_addr_i)
+		MCYCLE, CYCLE       : csr_data_o = mcycle_r[31:0];
+		MCYCLEH, CYCLEH     : csr_data_o = mcycle_r[63:32];
+		MINSTRET, INSTRET   : csr_data_o = minstret_r[31:0];
+		MINSTRETH, INSTRETH : csr_data_o = minstret_r[63:32];
+		MCOUNTINHIBIT       : csr_data_o = {23'd0, mcountinhibit_r};
+		MSTATUS             : csr_data_o = {19'd0, 2'b11, 3'd0, mstatus_mpie_r, 3'd0, mstatus_mie_r, 3'd0};
+		MIE                 : csr_data_o = {20'd0, mie_r};
+		MIP                 : csr_data_o = {20'd0, mip_s};
+		MTVEC               : csr_data_o = mtvec_r;
+		MSCRATCH            : csr_data_o = mscratch_r;
+		MEPC                : csr_data_o = mepc_r;
+		MCAUSE              : csr_data_o = {mcause_irq_r, 27'd0, mcause_code_r};
+		MTVAL               : csr_data_o = 32'd0;
+		default : begin
+			for (i=0; i<N_HPM; i=i+1) begin
+				if (csr_addr_i==MHPMCOUNTER3+i || csr_addr_i==HPMCOUNTER3+i) begin
+					csr_data_o = mhpmcounter_r[i][31:0];
+				end
+				if (csr_addr_i==MHPMCOUNTER3H+i || csr_addr_i==HPMCOUNTER3H+i) begin
+					csr_data_o = mhpmcounter_r[i][63:32];
+				end
+				// Events are fixed, the selector reads the event number
+				if (csr_addr_i==MHPMEVENT3+i) begin
+					csr_data_o = i+1;
+				end
+			end
+		end
+	endcase
+end
+
+/* ---------------------------------------------------
+* Write and counters update
+* --------------------------------------------------*/
+// Value to write
+reg [31:0] wr_data_s;
+always @(*) begin
+	case (csr_op_i)
+		2'b10   : wr_data_s = csr_data_o | csr_data_i;
+		2'b11   : wr_data_s = csr_data_o & ~csr_data_i;
+		default : wr_data_s = csr_data_i;
+	endcase
+end
+
+// Only machine mode registers are writable, user mode counters are read-only shadows
+wire wr_s;
+assign wr_s = csr_en_i & csr_wr_i;
+
+always @(posedge clk_i) begin
+	if (rst_ni == 1'b0) begin
+		mcycle_r        <= 64'd0;
+		minstret_r      <= 64'd0;
+		mcountinhibit_r <= 9'd0;
+		mstatus_mie_r   <= 1'b0;
+		mstatus_mpie_r  <= 1'b0;
+		mie_r           <= 12'd0;
+		mtvec_r         <= 32'd0;
+		mscratch_r      <= 32'd0;
+		mepc_r          <= 32'd0;
+		mcause_irq_r    <= 1'b0;
+		mcause_code_r   <= 4'd0;
+		for (i=0; i<N_HPM; i=i+1) begin
+			mhpmcounter_r[i] <= 64'd0;
+		end
+	end else begin
+		// Counting
+		if (!mcountinhibit_r[0]) begin
+			mcycle_r <= mcycle_r+1;
+		end
+		if (!mcountinhibit_r[2] && instret_i) begin
+			minstret_r <= minstret_r+1;
+		end
+		for (i=0; i<N_HPM; i=i+1) begin
+			if (!mcountinhibit_r[3+i] && hpm_event_i[i]) begin
+				mhpmcounter_r[i] <= mhpmcounter_r[i]+1;
+			end
+		end
+
+		// Software writes have priority over counting
+		if (wr_s) begin
+			case (csr_addr_i)
+				MCYCLE        : mcycle_r[31:0]    <= wr_data_s;
+				MCYCLEH       : mcycle_r[63:32]   <= wr_data_s;
+				MINSTRET      : minstret_r[31:0]  <= wr_data_s;
+				MINSTRETH     : minstret_r[63:32] <= wr_data_s;
+				MCOUNTINHIBIT : mcountinhibit_r   <= {wr_data_s[8:2], 1'b0, wr_data_s[0]};
+				MSTATUS       : begin
+					mstatus_mie_r  <= wr_data_s[3];
+					mstatus_mpie_r <= wr_data_s[7];
+				end
+				MIE           : begin
+					mie_r[IRQ_SOFTWARE] <= wr_data_s[IRQ_SOFTWARE];
+					mie_r[IRQ_TIMER]    <= wr_data_s[IRQ_TIMER];
+					mie_r[IRQ_EXTERNAL] <= wr_data_s[IRQ_EXTERNAL];
+				end
+				// Reserved modes are not stored
+				MTVEC         : mtvec_r           <= {wr_data_s[31:2], 1'b0, wr_data_s[0] & ~wr_data_s[1]};
+				MSCRATCH      : mscratch_r        <= wr_data_s;
+				// Instructions are aligned at least to 16 bits
+				MEPC          : mepc_r            <= {wr_data_s[31:1], 1'b0};
+				MCAUSE        : begin
+					mcause_irq_r  <= wr_data_s[31];
+					mcause_code_r <= wr_data_s[3:0];
+				end
+				default : begin
+					for (i=0; i<N_HPM; i=i+1) begin
+						if (csr_addr_i==MHPMCOUNTER3+i) begin
+							mhpmcounter_r[i][31:0] <= wr_data_s;
+						end
+						if (csr_addr_i==MHPMCOUNTER3H+i) begin
+							mhpmcounter_r[i][63:32] <= wr_data_s;
+						end
+					end
+				end
+			endcase
+		end
+
+		// Trap entry and return
+		if (trap_enter_i) begin
+			mepc_r         <= trap_epc_i;
+			mcause_irq_r   <= 1'b1;
+			mcause_code_r  <= irq_code_s;
+			mstatus_mpie_r <= mstatus_mie_r;
+			mstatus_mie_r  <= 1'b0;
+		end else if (trap_return_i) begin
+			mstatus_mie_r  <= mstatus_mpie_r;
+			mstatus_mpie_r <= 1'b1;
+		end
+	end
+end
+
+endmodule
@@ -0,0 +1,143 @@
+module decompressor (
+	// Compressed instruction (RV32C)
+	input  [15:0] instr_i,
+	// Equivalent 32-bit instruction (all zeros for illegal/unsupported encodings)
+	output reg [31:0] instr_o
+);
+
+// Opcodes of the expanded instructions
+localparam OP_LOAD   = 7'b0000011;
+localparam OP_STORE  = 7'b0100011;
+localparam OP_IMM    = 7'b0010011;
+localparam OP_REG    = 7'b0110011;
+localparam OP_LUI    = 7'b0110111;
+localparam OP_BRANCH = 7'b1100011;
+localparam OP_JAL    = 7'b1101111;
+localparam OP_JALR   = 7'b1100111;
+localparam OP_SYSTEM = 7'b1110011;
+
+// Register fields
+//   full registers (rd/rs1 and rs2) and 3-bit registers (x8 to x15) of the CIW, CL, CS, CA and CB formats
+wire [4:0] rd_s, rs2_s, rd_p_s, rs2_p_s;
+assign rd_s    = instr_i[11:7];
+assign rs2_s   = instr_i[6:2];
+assign rd_p_s  = {2'b01, instr_i[9:7]};
+assign rs2_p_s = {2'b01, instr_i[4:2]};
+
+// Immediates (already sign extended or zero extended to 32 bits)
+wire [31:0] imm_ci_s, imm_addi4spn_s, imm_lw_s, imm_lwsp_s, imm_swsp_s, imm_addi16sp_s, imm_j_s, imm_b_s;
+// c.addi, c.li, c.andi, c.lui (shifted in the U immediate), shifts
+assign imm_ci_s       = {{27{instr_i[12]}}, instr_i[6:2]};
+// c.addi4spn
+assign imm_addi4spn_s = {22'd0, instr_i[10:7], instr_i[12:11], instr_i[5], instr_i[6], 2'b00};
+// c.lw, c.sw
+assign imm_lw_s       = {25'd0, instr_i[5], instr_i[12:10], instr_i[6], 2'b00};
+// c.lwsp
+assign imm_lwsp_s     = {24'd0, instr_i[3:2], instr_i[12], instr_i[6:4], 2'b00};
+// c.swsp
+assign imm_swsp_s     = {24'd0, instr_i[8:7], instr_i[12:9], 2'b00};
+// c.addi16sp
+assign imm_addi16sp_s = {{23{instr_i[12]}}, instr_i[4:3], instr_i[5], instr_i[2], instr_i[6], 4'd0};
+// c.j, c.jal
+assign imm_j_s        = {{21{instr_i[12]}}, instr_i[8], instr_i[10:9], instr_i[6], instr_i[7], instr_i[2], instr_i[11], instr_i[5:3], 1'b0};
+// c.beqz, c.bnez
+assign imm_b_s        = {{24{instr_i[12]}}, instr_i[6:5], instr_i[2], instr_i[11:10], instr_i[4:3], 1'b0};
+
+always @(*) begin
+	instr_o = 32'd0;
+
+	case ({instr_i[1:0], instr_i[15:13]})
+		//// Quadrant 0
+		// c.addi4spn -> addi rd', x2, nzuimm
+		5'b00_000 : begin
+			if (imm_addi4spn_s != 32'd0) begin
+				instr_o = {imm_addi4spn_s[11:0], 5'd2, 3'b000, rs2_p_s, OP_IMM};
+			end
+		end
+		// c.lw -> lw rd', offset(rs1')
+		5'b00_010 : instr_o = {imm_lw_s[11:0], rd_p_s, 3'b010, rs2_p_s, OP_LOAD};
+		// c.sw -> sw rs2', offset(rs1')
+		5'b00_110 : instr_o = {imm_lw_s[11:5], rs2_p_s, rd_p_s, 3'b010, imm_lw_s[4:0], OP_STORE};
+
+		//// Quadrant 1
+		// c.nop, c.addi -> addi rd, rd, nzimm
+		5'b01_000 : instr_o = {imm_ci_s[11:0], rd_s, 3'b000, rd_s, OP_IMM};
+		// c.jal -> jal x1, offset
+		5'b01_001 : instr_o = {imm_j_s[20], imm_j_s[10:1], imm_j_s[11], imm_j_s[19:12], 5'd1, OP_JAL};
+		// c.li -> addi rd, x0, imm
+		5'b01_010 : instr_o = {imm_ci_s[11:0], 5'd0, 3'b000, rd_s, OP_IMM};
+		// c.addi16sp -> addi x2, x2, nzimm
+		// c.lui -> lui rd, nzimm
+		5'b01_011 : begin
+			if (rd_s == 5'd2) begin
+				instr_o = {imm_addi16sp_s[11:0], 5'd2, 3'b000, 5'd2, OP_IMM};
+			end else begin
+				instr_o = {imm_ci_s[19:0], rd_s, OP_LUI};
+			end
+		end
+		// c.srli, c.srai, c.andi, c.sub, c.xor, c.or, c.and
+		5'b01_100 : begin
+			case (instr_i[11:10])
+				// c.srli -> srli rd', rd', shamt
+				2'b00 : instr_o = {7'b0000000, instr_i[6:2], rd_p_s, 3'b101, rd_p_s, OP_IMM};
+				// c.srai -> srai rd', rd', shamt
+				2'b01 : instr_o = {7'b0100000, instr_i[6:2], rd_p_s, 3'b101, rd_p_s, OP_IMM};
+				// c.andi -> andi rd', rd', imm
+				2'b10 : instr_o = {imm_ci_s[11:0], rd_p_s, 3'b111, rd_p_s, OP_IMM};
+				// c.sub, c.xor, c.or, c.and -> op rd', rd', rs2'
+				2'b11 : begin
+					case (instr_i[6:5])
+						2'b00 : instr_o = {7'b0100000, rs2_p_s, rd_p_s, 3'b000, rd_p_s, OP_REG};
+						2'b01 : instr_o = {7'b0000000, rs2_p_s, rd_p_s, 3'b100, rd_p_s, OP_REG};
+						2'b10 : instr_o = {7'b0000000, rs2_p_s, rd_p_s, 3'b110, rd_p_s, OP_REG};
+						2'b11 : instr_o = {7'b0000000, rs2_p_s, rd_p_s, 3'b111, rd_p_s, OP_REG};
+					endcase
+				end
+			endcase
+		end
+		// c.j -> jal x0, offset
+		5'b01_101 : instr_o = {imm_j_s[20], imm_j_s[10:1], imm_j_s[11], imm_j_s[19:12], 5'd0, OP_JAL};
+		// c.beqz -> beq rs1', x0, offset
+		5'b01_110 : instr_o = {imm_b_s[12], imm_b_s[10:5], 5'd0, rd_p_s, 3'b000, imm_b_s[4:1], imm_b_s[11], OP_BRANCH};
+		// c.bnez -> bne rs1', x0, offset
+		5'b01_111 : instr_o = {imm_b_s[12], imm_b_s[10:5], 5'd0, rd_p_s, 3'b001, imm_b_s[4:1], imm_b_s[11], OP_BRANCH};
+
+		//// Quadrant 2
+		// c.slli -> slli rd, rd, shamt
+		5'b10_000 : instr_o = {7'b0000000, instr_i[6:2], rd_s, 3'b001, rd_s, OP_IMM};
+		// c.lwsp -> lw rd, offset(x2)
+		5'b10_010 : instr_o = {imm_lwsp_s[11:0], 5'd2, 3'b010, rd_s, OP_LOAD};
+		// c.jr, c.mv, c.ebreak, c.jalr, c.add
+		5'b10_100 : begin
+			if (instr_i[12] == 1'b0) begin
+				if (rs2_s == 5'd0) begin
+					// c.jr -> jalr x0, 0(rs1)
+					instr_o = {12'd0, rd_s, 3'b000, 5'd0, OP_JALR};
+				end else begin
+					// c.mv -> add rd, x0, rs2
+					instr_o = {7'b0000000, rs2_s, 5'd0, 3'b000, rd_s, OP_REG};
+				end
+			end else begin
+				if (rs2_s == 5'd0) begin
+					if (rd_s == 5'd0) begin
+						// c.ebreak -> ebreak
+						instr_o = {12'd1, 5'd0, 3'b000, 5'd0, OP_SYSTEM};
+					end else begin
+						// c.jalr -> jalr x1, 0(rs1)
+						instr_o = {12'd0, rd_s, 3'b000, 5'd1, OP_JALR};
+					end
+				end else begin
+					// c.add -> add rd, rd, rs2
+					instr_o = {7'b0000000, rs2_s, rd_s, 3'b000, rd_s, OP_REG};
+				end
+			end
+		end
+		// c.swsp -> sw rs2, offset(x2)
+		5'b10_110 : instr_o = {imm_swsp_s[11:5], rs2_s, 5'd2, 3'b010, imm_swsp_s[4:0], OP_STORE};
+
+		default : begin
+		end
+	endcase
+end
+
+endmodule
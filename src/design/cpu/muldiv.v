@@ -0,0 +1,213 @@
+module muldiv #(
+	// Multiplier implementation
+	// 0: single cycle, 1: two stages (partial products registered, one stall cycle)
+	parameter MUL_PIPELINE=1
+	)(
+	input  clk_i,
+	input  rst_ni,
+
+	// Instruction in the EX stage
+	//   valid_i is high while a mul/div instruction is in EX, ack_i when it leaves the stage
+	input  valid_i,
+	input  ack_i,
+	// Operation (funct3 of the instruction)
+	// 0: mul, 1: mulh, 2: mulhsu, 3: mulhu, 4: div, 5: divu, 6: rem, 7: remu
+	input  [2:0] funct_3_i,
+	input  [31:0] op1_i,
+	input  [31:0] op2_i,
+
+	// Result available, the EX stage is stalled while valid_i is high and ready_o is low
+	output ready_o,
+	output reg [31:0] result_o
+);
+
+/* ---------------------------------------------------
+* Operands
+* --------------------------------------------------*/
+wire is_div_s;
+// Operands are signed (mulh, mulhsu for op1, div, rem)
+wire op1_signed_s, op2_signed_s;
+assign is_div_s     = funct_3_i[2];
+assign op1_signed_s = is_div_s ? ~funct_3_i[0] : (funct_3_i[1:0] != 2'b11);
+assign op2_signed_s = is_div_s ? ~funct_3_i[0] : (funct_3_i[1:0] == 2'b01);
+
+// Sign extended to 33 bits, so that a single signed multiplier covers all combinations
+wire signed [32:0] op1_ext_s, op2_ext_s;
+assign op1_ext_s = {op1_signed_s & op1_i[31], op1_i};
+assign op2_ext_s = {op2_signed_s & op2_i[31], op2_i};
+
+/* ---------------------------------------------------
+* Multiplier
+* --------------------------------------------------*/
+// Partial products of op1 with the lower and upper halves of op2
+wire signed [49:0] pp_lo_s, pp_hi_s;
+assign pp_lo_s = op1_ext_s * $signed({1'b0, op2_ext_s[15:0]});
+assign pp_hi_s = op1_ext_s * $signed(op2_ext_s[32:16]);
+
+reg  signed [49:0] pp_lo_r, pp_hi_r;
+reg  [1:0] mul_sel_r;
+wire signed [65:0] product_s;
+wire [1:0] mul_sel_s;
+generate
+	if (MUL_PIPELINE == 0) begin : gen_mul_comb
+		assign product_s = (pp_hi_s <<< 16) + pp_lo_s;
+		assign mul_sel_s = funct_3_i[1:0];
+	end else begin : gen_mul_pipe
+		assign product_s = (pp_hi_r <<< 16) + pp_lo_r;
+		assign mul_sel_s = mul_sel_r;
+	end
+endgenerate
+
+/* ---------------------------------------------------
+* Divider
+* --------------------------------------------------*/
+// Absolute values
+wire [31:0] dividend_abs_s, divisor_abs_s;
+wire q_neg_s, r_neg_s;
+assign dividend_abs_s = (op1_signed_s & op1_i[31]) ? -op1_i : op1_i;
+assign divisor_abs_s  = (op2_signed_s & op2_i[31]) ? -op2_i : op2_i;
+assign q_neg_s = op1_signed_s & (op1_i[31] ^ op2_i[31]);
+assign r_neg_s = op1_signed_s & op1_i[31];
+
+// Leading zeros of the dividend, the division starts from its first non-zero bit
+reg [5:0] clz_s;
+integer i;
+always @(*) begin
+	clz_s = 6'd32;
+	for (i=0; i<32; i=i+1) begin
+		if (dividend_abs_s[i]) begin
+			clz_s = 31-i;
+		end
+	end
+end
+
+// Restoring division, one quotient bit for each cycle
+reg  [31:0] rem_r, quo_r, divisor_r;
+reg  [5:0]  cnt_r;
+reg  q_neg_r, r_neg_r, is_rem_r;
+wire [32:0] rem_shift_s, rem_sub_s;
+assign rem_shift_s = {rem_r, quo_r[31]};
+assign rem_sub_s   = rem_shift_s - {1'b0, divisor_r};
+
+/* ---------------------------------------------------
+* FSM
+* --------------------------------------------------*/
+localparam IDLE = 2'd0;
+localparam MUL  = 2'd1;
+localparam DIV  = 2'd2;
+localparam DONE = 2'd3;
+reg [1:0] state_r, state_s;
+
+// Next state
+always @(*) begin
+	state_s = state_r;
+	case (state_r)
+		IDLE : begin
+			if (valid_i) begin
+				if (!is_div_s) begin
+					// Single cycle multiplier does not leave the idle state
+					state_s = (MUL_PIPELINE == 0) ? IDLE : MUL;
+				end else if (divisor_abs_s == 32'd0 || dividend_abs_s < divisor_abs_s) begin
+					// Division by zero and dividend smaller than divisor do not iterate
+					state_s = DONE;
+				end else begin
+					state_s = DIV;
+				end
+			end
+		end
+		MUL : begin
+			state_s = (ack_i) ? IDLE : DONE;
+		end
+		DIV : begin
+			if (cnt_r == 6'd1) begin
+				state_s = DONE;
+			end
+		end
+		DONE : begin
+			if (ack_i) begin
+				state_s = IDLE;
+			end
+		end
+		default : state_s = IDLE;
+	endcase
+end
+
+// State update and datapath
+always @(posedge clk_i) begin
+	if (rst_ni == 1'b0) begin
+		state_r   <= IDLE;
+		pp_lo_r   <= 'd0;
+		pp_hi_r   <= 'd0;
+		mul_sel_r <= 2'd0;
+		rem_r     <= 32'd0;
+		quo_r     <= 32'd0;
+		divisor_r <= 32'd0;
+		cnt_r     <= 6'd0;
+		q_neg_r   <= 1'b0;
+		r_neg_r   <= 1'b0;
+		is_rem_r  <= 1'b0;
+	end else begin
+		state_r <= state_s;
+		case (state_r)
+			IDLE : begin
+				if (valid_i) begin
+					// Operands are sampled here, forwarded values are not used anymore
+					pp_lo_r   <= pp_lo_s;
+					pp_hi_r   <= pp_hi_s;
+					mul_sel_r <= funct_3_i[1:0];
+					q_neg_r   <= q_neg_s;
+					r_neg_r   <= r_neg_s;
+					is_rem_r  <= funct_3_i[1];
+					divisor_r <= divisor_abs_s;
+					rem_r     <= 32'd0;
+					quo_r     <= dividend_abs_s << clz_s;
+					cnt_r     <= 6'd32 - clz_s;
+					if (divisor_abs_s == 32'd0) begin
+						// Quotient is all ones, remainder is the dividend
+						quo_r   <= 32'hffffffff;
+						rem_r   <= op1_i;
+						q_neg_r <= 1'b0;
+						r_neg_r <= 1'b0;
+					end else if (dividend_abs_s < divisor_abs_s) begin
+						// Quotient is zero, remainder is the dividend
+						quo_r   <= 32'd0;
+						rem_r   <= op1_i;
+						r_neg_r <= 1'b0;
+					end
+				end
+			end
+			DIV : begin
+				if (rem_sub_s[32] == 1'b0) begin
+					rem_r <= rem_sub_s[31:0];
+				end else begin
+					rem_r <= rem_shift_s[31:0];
+				end
+				quo_r <= {quo_r[30:0], ~rem_sub_s[32]};
+				cnt_r <= cnt_r-1;
+			end
+			default : begin
+			end
+		endcase
+	end
+end
+
+/* ---------------------------------------------------
+* Output
+* --------------------------------------------------*/
+// Product is kept in the partial products registers until the instruction leaves EX
+assign ready_o = (state_r == MUL) || (state_r == DONE) ||
+                 (state_r == IDLE && valid_i && !is_div_s && MUL_PIPELINE == 0);
+
+always @(*) begin
+	if (is_div_s) begin
+		if (is_rem_r) begin
+			result_o = (r_neg_r) ? -rem_r : rem_r;
+		end else begin
+			result_o = (q_neg_r) ? -quo_r : quo_r;
+		end
+	end else begin
+		result_o = (mul_sel_s == 2'b00) ? product_s[31:0] : product_s[63:32];
+	end
+end
+
+endmodule
@@ -0,0 +1,162 @@
+module store_buffer #(
+	// Number of buffered stores (power of 2, at least 2)
+	parameter DEPTH=4,
+	// Address ranges that are strongly ordered (MMIO): loads wait for all previous stores
+	parameter N_UNCACHED=1,
+	parameter [(32*N_UNCACHED)-1:0] UNCACHED_BASE_ADDRESSES = 32'h00010000,
+	parameter [(32*N_UNCACHED)-1:0] UNCACHED_TOP_ADDRESSES  = 32'h0001ffff
+	)(
+	input  clk_i,
+	input  rst_ni,
+
+	// Buffer is empty (all stores have been written to memory)
+	output empty_o,
+
+	// Handshake interface from CPU
+	// Stores complete as soon as they are buffered
+	// Fences complete when all buffered stores have been written to memory
+	input  cpu_rd_i,
+	input  cpu_wr_i,
+	input  cpu_fence_i,
+	input  [31:0] cpu_addr_i,
+	input  [31:0] cpu_data_i,
+	input  [3:0] cpu_byte_select_i,
+	output cpu_ready_o,
+	output reg [31:0] cpu_data_o,
+
+	// Handshake interface towards memory
+	input  mem_ready_i,
+	input  [31:0] mem_data_i,
+	output mem_rd_o,
+	output mem_wr_o,
+	output [31:0] mem_addr_o,
+	output [31:0] mem_data_o,
+	output [3:0] mem_byte_select_o
+);
+
+localparam PTR_WIDTH = $clog2(DEPTH);
+
+// Buffered stores
+reg [29:0] addr_r [0:DEPTH-1];
+reg [31:0] data_r [0:DEPTH-1];
+reg [3:0]  be_r   [0:DEPTH-1];
+// Pointers (oldest entry is pointed by rd_ptr_r)
+reg [PTR_WIDTH:0] wr_ptr_r, rd_ptr_r;
+wire [PTR_WIDTH:0] cnt_s;
+wire full_s;
+assign cnt_s   = wr_ptr_r - rd_ptr_r;
+assign empty_o = (wr_ptr_r == rd_ptr_r) ? 1'b1 : 1'b0;
+assign full_s  = (cnt_s == DEPTH) ? 1'b1 : 1'b0;
+
+// Store being written to memory, waiting for the end of the transaction
+reg drain_busy_r;
+
+/* ---------------------------------------------------
+* Load lookup
+* --------------------------------------------------*/
+// Check if the address is in a strongly ordered region
+reg uncached_s;
+integer r;
+always @(*) begin
+	uncached_s = 1'b0;
+	for (r=0; r<N_UNCACHED; r=r+1) begin
+		if (cpu_addr_i >= UNCACHED_BASE_ADDRESSES[(r*32)+31:r*32] && cpu_addr_i <= UNCACHED_TOP_ADDRESSES[(r*32)+31:r*32]) begin
+			uncached_s = 1'b1;
+		end
+	end
+end
+
+// Merge the bytes of all buffered stores to the loaded word, from the oldest to the youngest
+reg match_s;
+reg [3:0] fwd_be_s;
+reg [31:0] fwd_data_s;
+reg [PTR_WIDTH-1:0] idx_s;
+integer k, b;
+always @(*) begin
+	match_s    = 1'b0;
+	fwd_be_s   = 4'd0;
+	fwd_data_s = 32'd0;
+	idx_s      = 'd0;
+	for (k=0; k<DEPTH; k=k+1) begin
+		idx_s = rd_ptr_r[PTR_WIDTH-1:0] + k;
+		if (k < cnt_s && addr_r[idx_s] == cpu_addr_i[31:2]) begin
+			match_s  = 1'b1;
+			fwd_be_s = fwd_be_s | be_r[idx_s];
+			for (b=0; b<4; b=b+1) begin
+				if (be_r[idx_s][b]) begin
+					fwd_data_s[(b*8)+:8] = data_r[idx_s][(b*8)+:8];
+				end
+			end
+		end
+	end
+end
+
+// Load served by the buffer: the whole word has been written by buffered stores
+wire fwd_s;
+assign fwd_s = cpu_rd_i && !uncached_s && match_s && fwd_be_s==4'hf;
+// Load served by memory
+//   it can overtake buffered stores to other addresses, except in strongly ordered regions
+//   it waits for the stores it partially overlaps
+wire load_s;
+assign load_s = cpu_rd_i && !drain_busy_r && (uncached_s ? empty_o : !match_s);
+// Write oldest store to memory when the memory interface is not used by a load
+wire drain_s;
+assign drain_s = !empty_o && !load_s;
+
+/* ---------------------------------------------------
+* Memory interface
+* --------------------------------------------------*/
+assign mem_rd_o          = load_s;
+assign mem_wr_o          = drain_s;
+assign mem_addr_o        = (drain_s) ? {addr_r[rd_ptr_r[PTR_WIDTH-1:0]], 2'b00} : cpu_addr_i;
+assign mem_data_o        = data_r[rd_ptr_r[PTR_WIDTH-1:0]];
+assign mem_byte_select_o = (drain_s) ? be_r[rd_ptr_r[PTR_WIDTH-1:0]] : cpu_byte_select_i;
+
+/* ---------------------------------------------------
+* CPU interface
+* --------------------------------------------------*/
+assign cpu_ready_o = (cpu_wr_i)    ? !full_s :
+                     (cpu_fence_i) ? empty_o :
+                     (cpu_rd_i)    ? (fwd_s || (load_s && mem_ready_i)) : 1'b0;
+always @(*) begin
+	if (fwd_s) begin
+		cpu_data_o = fwd_data_s;
+	end else begin
+		cpu_data_o = mem_data_i;
+	end
+end
+
+// Buffer update
+integer i;
+always @(posedge clk_i) begin
+	if (rst_ni == 1'b0) begin
+		wr_ptr_r     <= 'd0;
+		rd_ptr_r     <= 'd0;
+		drain_busy_r <= 1'b0;
+		for (i=0; i<DEPTH; i=i+1) begin
+			addr_r[i] <= 30'd0;
+			data_r[i] <= 32'd0;
+			be_r[i]   <= 4'd0;
+		end
+	end else begin
+		// New store from CPU
+		if (cpu_wr_i && !full_s) begin
+			addr_r[wr_ptr_r[PTR_WIDTH-1:0]] <= cpu_addr_i[31:2];
+			data_r[wr_ptr_r[PTR_WIDTH-1:0]] <= cpu_data_i;
+			be_r[wr_ptr_r[PTR_WIDTH-1:0]]   <= cpu_byte_select_i;
+			wr_ptr_r <= wr_ptr_r+1;
+		end
+		// Oldest store written to memory
+		// A started write is kept on the interface until memory is ready
+		if (drain_s) begin
+			if (mem_ready_i) begin
+				rd_ptr_r     <= rd_ptr_r+1;
+				drain_busy_r <= 1'b0;
+			end else begin
+				drain_busy_r <= 1'b1;
+			end
+		end
+	end
+end
+
+endmodule
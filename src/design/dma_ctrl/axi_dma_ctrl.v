@@ -0,0 +1,207 @@
+module axi_dma_ctrl #(
+	// Number of channels (1 to 7)
+	parameter N_CH=4,
+	// Maximum number of beats of memory to memory bursts
+	parameter BURST_LEN=8,
+	// Number of peripheral request lines (index 0 is reserved for memory)
+	parameter N_REQ=4
+	)(
+	input  clk_i,
+	input  rst_ni,
+
+	//// Registers AXI interface
+	// Read Address (AR) channel
+	input  arvalid_i,
+	output aready_o,
+	input  [31:0] araddr_i,
+	// Read Data (R) channel
+	output rvalid_o,
+	input  rready_i,
+	output [31:0] rdata_o,
+	output [1:0] rresp_o,
+	// Write Address (AW) channel
+	input  awvalid_i,
+	output awready_o,
+	input  [31:0] awaddr_i,
+	// Write Data (W) channel
+	input  wvalid_i,
+	output wready_o,
+	input  [31:0] wdata_i,
+	input  [3:0] wstrb_i,
+	// Write Response (B) channel
+	output bvalid_o,
+	input  bready_i,
+	output [1:0] bresp_o,
+
+	//// Transfers AXI interface
+	// Read Address (AR) channel
+	output mst_arvalid_o,
+	input  mst_aready_i,
+	output [31:0] mst_araddr_o,
+	output [7:0] mst_arlen_o,
+	output [2:0] mst_arsize_o,
+	output [1:0] mst_arburst_o,
+	// Read Data (R) channel
+	input  mst_rvalid_i,
+	output mst_rready_o,
+	input  [31:0] mst_rdata_i,
+	input  [1:0] mst_rresp_i,
+	input  mst_rlast_i,
+	// Write Address (AW) channel
+	output mst_awvalid_o,
+	input  mst_awready_i,
+	output [31:0] mst_awaddr_o,
+	output [7:0] mst_awlen_o,
+	output [2:0] mst_awsize_o,
+	output [1:0] mst_awburst_o,
+	// Write Data (W) channel
+	output mst_wvalid_o,
+	input  mst_wready_i,
+	output [31:0] mst_wdata_o,
+	output [3:0] mst_wstrb_o,
+	output mst_wlast_o,
+	// Write Response (B) channel
+	input  mst_bvalid_i,
+	output mst_bready_o,
+	input  [1:0] mst_bresp_i,
+
+	//// Peripheral flow control
+	input  [N_REQ-1:0] rd_req_i,
+	input  [N_REQ-1:0] wr_req_i,
+
+	// Completed channels
+	output [N_CH-1:0] done_o
+);
+
+wire dma_rd_en_s, dma_wr_en_s, dma_ready_s;
+wire [31:0] dma_addr_s, dma_data_i_s, dma_data_o_s;
+
+wire mem_rd_s, mem_wr_s, mem_ready_s;
+wire [31:0] mem_addr_s, mem_data_o_s, mem_data_i_s;
+wire [7:0] mem_len_s;
+wire [3:0] mem_byte_select_s;
+
+axi_2_hs inst_axi_slave (
+	.clk_i(clk_i),
+	.rst_ni(rst_ni),
+	//// AXI interface
+	// Read Address (AR) channel
+	.arvalid_i(arvalid_i),
+	.aready_o(aready_o),
+	.araddr_i(araddr_i),
+	.arlen_i(8'd0),
+	.arsize_i(3'd2),
+	.arburst_i(2'b01),
+	.arid_i(1'b0),
+	// Read Data (R) channel
+	.rvalid_o(rvalid_o),
+	.rready_i(rready_i),
+	.rdata_o(rdata_o),
+	.rresp_o(rresp_o),
+	.rlast_o(),
+	.rid_o(),
+	// Write Address (AW) channel
+	.awvalid_i(awvalid_i),
+	.awready_o(awready_o),
+	.awaddr_i(awaddr_i),
+	.awlen_i(8'd0),
+	.awsize_i(3'd2),
+	.awburst_i(2'b01),
+	.awid_i(1'b0),
+	// Write Data (W) channel
+	.wvalid_i(wvalid_i),
+	.wready_o(wready_o),
+	.wdata_i(wdata_i),
+	.wstrb_i(wstrb_i),
+	.wlast_i(1'b1),
+	// Write Response (B) channel
+	.bvalid_o(bvalid_o),
+	.bready_i(bready_i),
+	.bresp_o(bresp_o),
+	.bid_o(),
+	// Handshake interface
+	.hs_read_o(dma_rd_en_s),
+	.hs_write_o(dma_wr_en_s),
+	.hs_addr_o(dma_addr_s),
+	.hs_data_o(dma_data_i_s),
+	.hs_ready_i(dma_ready_s),
+	.hs_data_i(dma_data_o_s),
+	.byte_select_o()
+);
+
+dma_ctrl #(
+	.N_CH(N_CH),
+	.BURST_LEN(BURST_LEN),
+	.N_REQ(N_REQ)
+	)
+	inst_dma (
+	.clk_i(clk_i),
+	.rst_ni(rst_ni),
+	// Handshake interface (registers access)
+	.hs_read_i(dma_rd_en_s),
+	.hs_write_i(dma_wr_en_s),
+	.hs_addr_i(dma_addr_s[7:0]),
+	.hs_data_i(dma_data_i_s),
+	.hs_ready_o(dma_ready_s),
+	.hs_data_o(dma_data_o_s),
+	// Handshake interface towards memory
+	.mst_rd_o(mem_rd_s),
+	.mst_wr_o(mem_wr_s),
+	.mst_addr_o(mem_addr_s),
+	.mst_data_o(mem_data_o_s),
+	.mst_len_o(mem_len_s),
+	.mst_byte_select_o(mem_byte_select_s),
+	.mst_ready_i(mem_ready_s),
+	.mst_data_i(mem_data_i_s),
+	// Peripheral flow control
+	.rd_req_i(rd_req_i),
+	.wr_req_i(wr_req_i),
+	.done_o(done_o)
+);
+
+hs_2_axi inst_axi_master(
+	.clk_i(clk_i),
+	.rst_ni(rst_ni),
+	// Handshake interface
+	.hs_read_i(mem_rd_s),
+	.hs_write_i(mem_wr_s),
+	.hs_addr_i(mem_addr_s),
+	.hs_data_i(mem_data_o_s),
+	.hs_len_i(mem_len_s),
+	.hs_ready_o(mem_ready_s),
+	.hs_data_o(mem_data_i_s),
+	.byte_select_i(mem_byte_select_s),
+	//// AXI interface
+	// Read Address (AR) channel
+	.arvalid_o(mst_arvalid_o),
+	.aready_i(mst_aready_i),
+	.araddr_o(mst_araddr_o),
+	.arlen_o(mst_arlen_o),
+	.arsize_o(mst_arsize_o),
+	.arburst_o(mst_arburst_o),
+	// Read Data (R) channel
+	.rvalid_i(mst_rvalid_i),
+	.rready_o(mst_rready_o),
+	.rdata_i(mst_rdata_i),
+	.rresp_i(mst_rresp_i),
+	.rlast_i(mst_rlast_i),
+	// Write Address (AW) channel
+	.awvalid_o(mst_awvalid_o),
+	.awready_i(mst_awready_i),
+	.awaddr_o(mst_awaddr_o),
+	.awlen_o(mst_awlen_o),
+	.awsize_o(mst_awsize_o),
+	.awburst_o(mst_awburst_o),
+	// Write Data (W) channel
+	.wvalid_o(mst_wvalid_o),
+	.wready_i(mst_wready_i),
+	.wdata_o(mst_wdata_o),
+	.wstrb_o(mst_wstrb_o),
+	.wlast_o(mst_wlast_o),
+	// Write Response (B) channel
+	.bvalid_i(mst_bvalid_i),
+	.bready_o(mst_bready_o),
+	.bresp_i(mst_bresp_i)
+);
+
+endmodule
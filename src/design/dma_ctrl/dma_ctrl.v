@@ -0,0 +1,364 @@
+module dma_ctrl #(
+	// Number of channels (1 to 7)
+	parameter N_CH=4,
+	// Maximum number of beats of memory to memory bursts (power of 2, at most 256)
+	parameter BURST_LEN=8,
+	// Number of peripheral request lines (index 0 is reserved for memory, always ready)
+	parameter N_REQ=4
+	)(
+	input  clk_i,
+	input  rst_ni,
+
+	// Handshake interface (registers access)
+	input  hs_read_i,
+	input  hs_write_i,
+	input  [7:0] hs_addr_i,
+	input  [31:0] hs_data_i,
+	output hs_ready_o,
+	output reg [31:0] hs_data_o,
+
+	// Handshake interface towards memory (AXI master)
+	// Bursts of mst_len_o+1 beats, mst_ready_i is asserted once per beat
+	output reg mst_rd_o,
+	output reg mst_wr_o,
+	output reg [31:0] mst_addr_o,
+	output reg [31:0] mst_data_o,
+	output reg [7:0] mst_len_o,
+	output reg [3:0] mst_byte_select_o,
+	input  mst_ready_i,
+	input  [31:0] mst_data_i,
+
+	// Peripheral flow control
+	// rd_req_i: data available to be read, wr_req_i: room available to be written
+	input  [N_REQ-1:0] rd_req_i,
+	input  [N_REQ-1:0] wr_req_i,
+
+	// Completed channels (same as the done bits of the status register)
+	output [N_CH-1:0] done_o
+);
+
+localparam CH_WIDTH    = (N_CH > 1) ? $clog2(N_CH) : 1;
+localparam BEAT_WIDTH  = $clog2(BURST_LEN)+1;
+
+/* ---------------------------------------------------
+* Registers
+* --------------------------------------------------*/
+//// Register access
+// 0x00: Status reg (bits N_CH-1:0 done, write 1 to clear; bits 16+N_CH-1:16 busy, RO)
+// 0x04: Peripheral request lines (RO, bits N_REQ-1:0 read requests, bits 16+N_REQ-1:16 write requests)
+// Channel c registers at 0x20*(c+1):
+// +0x00: Source address           (RW)
+// +0x04: Destination address      (RW)
+// +0x08: Number of transfers left (RW)
+// +0x0C: Configuration            (RW)
+//        bit 0: enable (cleared when the transfer and the descriptors chain are completed)
+//        bit 1: increment source address, bit 2: increment destination address
+//        bit 3: byte transfers (words otherwise)
+//        bits 5:4: source request line, bits 7:6: destination request line (0: memory)
+// +0x10: Next descriptor address  (RW, 0: last transfer)
+// Descriptors in memory are 5 words with the same layout of the channel registers
+reg [31:0] src_r  [0:N_CH-1];
+reg [31:0] dst_r  [0:N_CH-1];
+reg [31:0] cnt_r  [0:N_CH-1];
+reg [7:0]  cfg_r  [0:N_CH-1];
+reg [31:0] next_r [0:N_CH-1];
+reg [N_CH-1:0] done_r;
+wire [N_CH-1:0] busy_s;
+
+// Configuration fields
+localparam CFG_EN      = 0;
+localparam CFG_SRC_INC = 1;
+localparam CFG_DST_INC = 2;
+localparam CFG_BYTE    = 3;
+
+genvar g;
+generate
+	for (g = 0; g < N_CH; g = g + 1) begin : gen_busy
+		assign busy_s[g] = cfg_r[g][CFG_EN];
+	end
+endgenerate
+assign done_o = done_r;
+
+// Register access decoding
+wire [2:0] reg_ch_s;
+wire [2:0] reg_idx_s;
+assign reg_ch_s  = hs_addr_i[7:5];
+assign reg_idx_s = hs_addr_i[4:2];
+
+always @(*) begin
+	hs_data_o = 32'd0;
+	if (reg_ch_s == 3'd0) begin
+		case (reg_idx_s)
+			3'd0 : hs_data_o = {busy_s, 16'd0} | done_r;
+			3'd1 : hs_data_o = {wr_req_i, 16'd0} | rd_req_i;
+			default : begin
+			end
+		endcase
+	end else if (reg_ch_s <= N_CH) begin
+		case (reg_idx_s)
+			3'd0 : hs_data_o = src_r[reg_ch_s-1];
+			3'd1 : hs_data_o = dst_r[reg_ch_s-1];
+			3'd2 : hs_data_o = cnt_r[reg_ch_s-1];
+			3'd3 : hs_data_o = {24'd0, cfg_r[reg_ch_s-1]};
+			3'd4 : hs_data_o = next_r[reg_ch_s-1];
+			default : begin
+			end
+		endcase
+	end
+end
+// Latency of register access is 0
+assign hs_ready_o = 1'b1;
+
+/* ---------------------------------------------------
+* Channel selection
+* --------------------------------------------------*/
+// A channel is ready when it is enabled and its request lines are active
+//   channels with no transfers left are ready to load the next descriptor or to complete
+reg [N_CH-1:0] ch_ready_s;
+integer c;
+always @(*) begin
+	for (c = 0; c < N_CH; c = c + 1) begin
+		ch_ready_s[c] = cfg_r[c][CFG_EN] &&
+		                (cnt_r[c] == 32'd0 || (rd_req_i[cfg_r[c][5:4]] && wr_req_i[cfg_r[c][7:6]]));
+	end
+end
+
+// Channels are served in round-robin order, one burst at a time
+reg [CH_WIDTH-1:0] ch_r, sel_s;
+reg sel_valid_s;
+integer k, idx;
+always @(*) begin
+	sel_s       = ch_r;
+	sel_valid_s = 1'b0;
+	for (k = N_CH; k >= 1; k = k - 1) begin
+		idx = ch_r + k;
+		if (idx >= N_CH) begin
+			idx = idx - N_CH;
+		end
+		if (ch_ready_s[idx]) begin
+			sel_s       = idx[CH_WIDTH-1:0];
+			sel_valid_s = 1'b1;
+		end
+	end
+end
+
+// Number of beats of the next burst
+//   peripherals, byte transfers and fixed addresses are served one transfer at a time
+reg [BEAT_WIDTH-1:0] sel_beats_s;
+always @(*) begin
+	if (cfg_r[sel_s][CFG_BYTE] || !cfg_r[sel_s][CFG_SRC_INC] || !cfg_r[sel_s][CFG_DST_INC] ||
+	    cfg_r[sel_s][5:4] != 2'd0 || cfg_r[sel_s][7:6] != 2'd0) begin
+		sel_beats_s = 'd1;
+	end else if (cnt_r[sel_s] < BURST_LEN) begin
+		sel_beats_s = cnt_r[sel_s][BEAT_WIDTH-1:0];
+	end else begin
+		sel_beats_s = BURST_LEN;
+	end
+end
+
+/* ---------------------------------------------------
+* Transfer FSM
+* --------------------------------------------------*/
+localparam IDLE    = 2'd0;
+localparam DESC_RD = 2'd1;
+localparam RD      = 2'd2;
+localparam WR      = 2'd3;
+reg [1:0] current_state_r, next_state_s;
+
+// Burst buffer
+reg [31:0] buf_r [0:BURST_LEN-1];
+reg [BEAT_WIDTH-1:0] beats_r, beat_cnt_r;
+wire last_beat_s;
+assign last_beat_s = (beat_cnt_r == beats_r-1) ? 1'b1 : 1'b0;
+
+// Byte lanes of byte transfers
+wire [1:0] src_lane_s, dst_lane_s;
+wire [7:0] byte_s;
+assign src_lane_s = src_r[ch_r][1:0];
+assign dst_lane_s = dst_r[ch_r][1:0];
+assign byte_s     = buf_r[0] >> (8*src_lane_s);
+
+// FSM present state update
+always @(posedge clk_i) begin
+	if (rst_ni == 1'b0) begin
+		current_state_r <= IDLE;
+	end else begin
+		current_state_r <= next_state_s;
+	end
+end
+
+// FSM next state calculation
+always @(*) begin
+	next_state_s = current_state_r;
+	case (current_state_r)
+		// Select next channel
+		IDLE : begin
+			if (sel_valid_s) begin
+				if (cnt_r[sel_s] != 32'd0) begin
+					next_state_s = RD;
+				end else if (next_r[sel_s] != 32'd0) begin
+					next_state_s = DESC_RD;
+				end
+			end
+		end
+		// Load of the next descriptor
+		DESC_RD : begin
+			if (mst_ready_i && beat_cnt_r == 'd4) begin
+				next_state_s = IDLE;
+			end
+		end
+		// Read burst from source
+		RD : begin
+			if (mst_ready_i && last_beat_s) begin
+				next_state_s = WR;
+			end
+		end
+		// Write burst to destination
+		WR : begin
+			if (mst_ready_i && last_beat_s) begin
+				next_state_s = IDLE;
+			end
+		end
+		default : next_state_s = IDLE;
+	endcase
+end
+
+// FSM output calculation
+always @(*) begin
+	mst_rd_o          = 1'b0;
+	mst_wr_o          = 1'b0;
+	mst_addr_o        = 32'd0;
+	mst_data_o        = 32'd0;
+	mst_len_o         = 8'd0;
+	mst_byte_select_o = 4'hf;
+	case (current_state_r)
+		DESC_RD : begin
+			mst_rd_o   = 1'b1;
+			mst_addr_o = next_r[ch_r];
+			mst_len_o  = 8'd4;
+		end
+		RD : begin
+			mst_rd_o   = 1'b1;
+			mst_addr_o = {src_r[ch_r][31:2], 2'b00};
+			mst_len_o  = beats_r-1;
+		end
+		WR : begin
+			mst_wr_o   = 1'b1;
+			mst_addr_o = {dst_r[ch_r][31:2], 2'b00};
+			mst_len_o  = beats_r-1;
+			if (cfg_r[ch_r][CFG_BYTE]) begin
+				mst_data_o        = {4{byte_s}};
+				mst_byte_select_o = 4'b0001 << dst_lane_s;
+			end else begin
+				mst_data_o        = buf_r[beat_cnt_r];
+			end
+		end
+		default : begin
+		end
+	endcase
+end
+
+// Done bits are set at the end of the descriptors chain and cleared by writing 1
+//   (both can happen in the same cycle, for different channels)
+reg [N_CH-1:0] done_set_s, done_clr_s;
+always @(*) begin
+	done_set_s = 'd0;
+	if (current_state_r == IDLE && sel_valid_s && cnt_r[sel_s] == 32'd0 && next_r[sel_s] == 32'd0) begin
+		done_set_s[sel_s] = 1'b1;
+	end
+	done_clr_s = (hs_write_i && reg_ch_s == 3'd0 && reg_idx_s == 3'd0) ? hs_data_i[N_CH-1:0] : 'd0;
+end
+
+// Channels and transfer state update
+integer i;
+always @(posedge clk_i) begin
+	if (rst_ni == 1'b0) begin
+		ch_r       <= 'd0;
+		beats_r    <= 'd0;
+		beat_cnt_r <= 'd0;
+		done_r     <= 'd0;
+		for (i = 0; i < N_CH; i = i + 1) begin
+			src_r[i]  <= 32'd0;
+			dst_r[i]  <= 32'd0;
+			cnt_r[i]  <= 32'd0;
+			cfg_r[i]  <= 8'd0;
+			next_r[i] <= 32'd0;
+		end
+		for (i = 0; i < BURST_LEN; i = i + 1) begin
+			buf_r[i] <= 32'd0;
+		end
+	end else begin
+		//// Transfers
+		case (current_state_r)
+			IDLE : begin
+				beat_cnt_r <= 'd0;
+				if (sel_valid_s) begin
+					ch_r    <= sel_s;
+					beats_r <= sel_beats_s;
+					// End of the transfer and of the descriptors chain
+					if (done_set_s[sel_s]) begin
+						cfg_r[sel_s][CFG_EN] <= 1'b0;
+					end
+				end
+			end
+			DESC_RD : begin
+				if (mst_ready_i) begin
+					beat_cnt_r <= beat_cnt_r+1;
+					case (beat_cnt_r[2:0])
+						3'd0 : src_r[ch_r]  <= mst_data_i;
+						3'd1 : dst_r[ch_r]  <= mst_data_i;
+						3'd2 : cnt_r[ch_r]  <= mst_data_i;
+						// Channel stays enabled until the end of the chain, unless it has been disabled
+						//   while the descriptor was read
+						3'd3 : cfg_r[ch_r]  <= {mst_data_i[7:1], cfg_r[ch_r][CFG_EN]};
+						default : next_r[ch_r] <= mst_data_i;
+					endcase
+				end
+			end
+			RD : begin
+				if (mst_ready_i) begin
+					buf_r[beat_cnt_r] <= mst_data_i;
+					beat_cnt_r <= (last_beat_s) ? 'd0 : beat_cnt_r+1;
+				end
+			end
+			WR : begin
+				if (mst_ready_i) begin
+					beat_cnt_r <= beat_cnt_r+1;
+					if (last_beat_s) begin
+						// Burst completed, move addresses
+						if (cfg_r[ch_r][CFG_SRC_INC]) begin
+							src_r[ch_r] <= (cfg_r[ch_r][CFG_BYTE]) ? src_r[ch_r]+1 : src_r[ch_r]+(beats_r<<2);
+						end
+						if (cfg_r[ch_r][CFG_DST_INC]) begin
+							dst_r[ch_r] <= (cfg_r[ch_r][CFG_BYTE]) ? dst_r[ch_r]+1 : dst_r[ch_r]+(beats_r<<2);
+						end
+						cnt_r[ch_r] <= cnt_r[ch_r]-beats_r;
+					end
+				end
+			end
+			default : begin
+			end
+		endcase
+
+		done_r <= (done_r | done_set_s) & ~done_clr_s;
+
+		//// Register writes
+		// Registers of an enabled channel should not be written, except to disable it
+		//   (the channel stops at the end of the current burst)
+		if (hs_write_i) begin
+			if (reg_ch_s != 3'd0 && reg_ch_s <= N_CH) begin
+				case (reg_idx_s)
+					3'd0 : src_r[reg_ch_s-1]  <= hs_data_i;
+					3'd1 : dst_r[reg_ch_s-1]  <= hs_data_i;
+					3'd2 : cnt_r[reg_ch_s-1]  <= hs_data_i;
+					3'd3 : cfg_r[reg_ch_s-1]  <= hs_data_i[7:0];
+					3'd4 : next_r[reg_ch_s-1] <= hs_data_i;
+					default : begin
+					end
+				endcase
+			end
+		end
+	end
+end
+
+endmodule
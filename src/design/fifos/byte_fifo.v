@@ -0,0 +1,82 @@
+module byte_fifo #(
+		// Number of bytes (power of 2, at least 4)
+		parameter DEPTH=16
+		) (
+	input clk_i, 
+	input rst_ni,
+	// Write port
+	// Up to 4 bytes are pushed per cycle, starting from the lowest byte of wr_data_i
+	//   bytes that do not fit in the fifo are discarded
+	input [2:0] wr_cnt_i,
+  	input [31:0] wr_data_i,
+	output full_o,
+	// Read port
+	// Up to 4 bytes are popped per cycle, rd_data_o holds the 4 oldest bytes (oldest in the lowest byte,
+	//   bytes not present in the fifo are read as 0)
+	//   only the bytes present in the fifo are popped
+  	input [2:0] rd_cnt_i,
+  	output [31:0] rd_data_o,
+  	output empty_o,
+	output not_empty_o,
+	// Number of bytes in the fifo
+	output [$clog2(DEPTH):0] level_o
+);
+
+localparam PTR_WIDTH = $clog2(DEPTH);
+
+// Pointers and fill level
+reg [PTR_WIDTH-1:0] wr_ptr_r, rd_ptr_r;
+reg [PTR_WIDTH:0] level_r;
+// Free space
+wire [PTR_WIDTH:0] free_s;
+// Number of bytes actually pushed/popped
+wire [2:0] wr_cnt_s, rd_cnt_s;
+
+// FIFO registers
+reg [7:0] fifo_r [0:DEPTH-1];
+
+assign free_s   = DEPTH - level_r;
+assign wr_cnt_s = (free_s < wr_cnt_i)  ? free_s[2:0]  : wr_cnt_i;
+assign rd_cnt_s = (level_r < rd_cnt_i) ? level_r[2:0] : rd_cnt_i;
+
+// Pointers update
+always @(posedge clk_i) begin
+	if (rst_ni==1'b0) begin
+		wr_ptr_r <= 'd0; 
+		rd_ptr_r <= 'd0;
+		level_r  <= 'd0;
+	end else begin
+		wr_ptr_r <= wr_ptr_r + wr_cnt_s;
+		rd_ptr_r <= rd_ptr_r + rd_cnt_s;
+		level_r  <= level_r + wr_cnt_s - rd_cnt_s;
+	end
+end
+
+// Full/empty conditions
+assign full_o = (level_r == DEPTH);
+assign empty_o = (level_r == 'd0);
+assign not_empty_o = ~empty_o;
+assign level_o = level_r;
+
+// FIFO registers update
+// Data are not reset, only the bytes between the pointers are valid
+integer i;
+always @(posedge clk_i) begin
+	for (i=0; i<4; i=i+1) begin
+		if (i < wr_cnt_s) begin
+			fifo_r[(wr_ptr_r + i) % DEPTH] <= wr_data_i[i*8 +: 8];
+		end
+	end
+end
+
+// Asynchronous read of the 4 oldest bytes
+genvar k;
+generate
+	for (k=0; k<4; k=k+1) begin : gen_rd_data
+		wire [PTR_WIDTH-1:0] rd_idx_s;
+		assign rd_idx_s = rd_ptr_r + k;
+		assign rd_data_o[(k*8)+7:k*8] = (level_r > k) ? fifo_r[rd_idx_s] : 8'd0;
+	end
+endgenerate
+
+endmodule
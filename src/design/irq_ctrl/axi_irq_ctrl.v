@@ -0,0 +1,112 @@
+module axi_irq_ctrl #(
+	// Number of interrupt sources, including the reserved source 0
+	parameter N_SRC=8
+	)(
+	input  clk_i,
+	input  rst_ni,
+
+	//// AXI interface
+	// Read Address (AR) channel
+	input  arvalid_i,
+	output aready_o,
+	input  [31:0] araddr_i,
+	// Read Data (R) channel
+	output rvalid_o,
+	input  rready_i,
+	output [31:0] rdata_o,
+	output [1:0] rresp_o,
+	// Write Address (AW) channel
+	input  awvalid_i,
+	output awready_o,
+	input  [31:0] awaddr_i,
+	// Write Data (W) channel
+	input  wvalid_i,
+	output wready_o,
+	input  [31:0] wdata_i,
+	input  [3:0] wstrb_i,
+	// Write Response (B) channel
+	output bvalid_o,
+	input  bready_i,
+	output [1:0] bresp_o,
+
+	// Interrupt sources (source 0 is not used)
+	input  [N_SRC-1:0] src_i,
+
+	// Interrupt requests towards the CPU
+	output meip_o,
+	output msip_o,
+	output mtip_o
+);
+
+wire irq_rd_en_s, irq_wr_en_s, irq_ready_s;
+wire [31:0] irq_addr_s, irq_data_i_s, irq_data_o_s;
+
+axi_2_hs inst_axi_slave (
+	.clk_i(clk_i),
+	.rst_ni(rst_ni),
+	//// AXI interface
+	// Read Address (AR) channel
+	.arvalid_i(arvalid_i),
+	.aready_o(aready_o),
+	.araddr_i(araddr_i),
+	.arlen_i(8'd0),
+	.arsize_i(3'd2),
+	.arburst_i(2'b01),
+	.arid_i(1'b0),
+	// Read Data (R) channel
+	.rvalid_o(rvalid_o),
+	.rready_i(rready_i),
+	.rdata_o(rdata_o),
+	.rresp_o(rresp_o),
+	.rlast_o(),
+	.rid_o(),
+	// Write Address (AW) channel
+	.awvalid_i(awvalid_i),
+	.awready_o(awready_o),
+	.awaddr_i(awaddr_i),
+	.awlen_i(8'd0),
+	.awsize_i(3'd2),
+	.awburst_i(2'b01),
+	.awid_i(1'b0),
+	// Write Data (W) channel
+	.wvalid_i(wvalid_i),
+	.wready_o(wready_o),
+	.wdata_i(wdata_i),
+	.wstrb_i(wstrb_i),
+	.wlast_i(1'b1),
+	// Write Response (B) channel
+	.bvalid_o(bvalid_o),
+	.bready_i(bready_i),
+	.bresp_o(bresp_o),
+	.bid_o(),
+	// Handshake interface
+	.hs_read_o(irq_rd_en_s),
+	.hs_write_o(irq_wr_en_s),
+	.hs_addr_o(irq_addr_s),
+	.hs_data_o(irq_data_i_s),
+	.hs_ready_i(irq_ready_s),
+	.hs_data_i(irq_data_o_s),
+	.byte_select_o()
+);
+
+irq_ctrl #(
+	.N_SRC(N_SRC)
+	)
+	inst_irq_ctrl (
+	.clk_i(clk_i),
+	.rst_ni(rst_ni),
+	// Handshake interface
+	.hs_read_i(irq_rd_en_s),
+	.hs_write_i(irq_wr_en_s),
+	.hs_addr_i(irq_addr_s[7:0]),
+	.hs_data_i(irq_data_i_s),
+	.hs_ready_o(irq_ready_s),
+	.hs_data_o(irq_data_o_s),
+	// Interrupts
+	.src_i(src_i),
+	.meip_o(meip_o),
+	.msip_o(msip_o),
+	.mtip_o(mtip_o)
+);
+
+endmodule
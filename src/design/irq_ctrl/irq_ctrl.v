@@ -0,0 +1,144 @@
+module irq_ctrl #(
+	// Number of interrupt sources, including the reserved source 0 (at most 32)
+	parameter N_SRC=8
+	)(
+	input  clk_i,
+	input  rst_ni,
+
+	// Handshake interface
+	input  hs_read_i,
+	input  hs_write_i,
+	input  [7:0] hs_addr_i,
+	input  [31:0] hs_data_i,
+	output hs_ready_o,
+	output reg [31:0] hs_data_o,
+
+	// Interrupt sources (levels, source 0 is not used)
+	input  [N_SRC-1:0] src_i,
+
+	// Interrupt requests towards the CPU
+	// External interrupt (highest priority source above threshold)
+	output meip_o,
+	// Software interrupt
+	output msip_o,
+	// Timer interrupt (mtime >= mtimecmp)
+	output mtip_o
+);
+
+/* ---------------------------------------------------
+* Registers
+* --------------------------------------------------*/
+//// Register access
+// 0x00: Pending   (RO, sources levels)
+// 0x04: Enable    (RW)
+// 0x08: Threshold (RW, only sources with a higher priority raise the external interrupt)
+// 0x0C: Claim     (RO, highest priority pending and enabled source, 0 if none)
+// 0x10: Software interrupt (RW, bit 0)
+// 0x20+0x4*i: Priority of source i (RW, 0 disables the source)
+// 0x40: mtime LSW     (RW, incremented every clock cycle)
+// 0x44: mtime MSW     (RW)
+// 0x48: mtimecmp LSW  (RW)
+// 0x4C: mtimecmp MSW  (RW)
+reg  [N_SRC-1:0] enable_r;
+reg  [2:0] threshold_r;
+reg  msip_r;
+reg  [2:0] priority_r [0:N_SRC-1];
+reg  [63:0] mtime_r, mtimecmp_r;
+wire [N_SRC-1:0] pending_s;
+reg  [4:0] claim_s;
+
+// Source 0 is reserved (claim value when nothing is pending)
+assign pending_s = {src_i[N_SRC-1:1], 1'b0};
+
+integer i;
+always @(posedge clk_i) begin
+	if (rst_ni == 1'b0) begin
+		enable_r    <= 'd0;
+		threshold_r <= 3'd0;
+		msip_r      <= 1'b0;
+		mtimecmp_r  <= {64{1'b1}};
+		for (i = 0; i < N_SRC; i = i + 1) begin
+			priority_r[i] <= 3'd1;
+		end
+	end else if (hs_write_i) begin
+		case (hs_addr_i)
+			8'h04 : enable_r    <= hs_data_i[N_SRC-1:0];
+			8'h08 : threshold_r <= hs_data_i[2:0];
+			8'h10 : msip_r      <= hs_data_i[0];
+			8'h48 : mtimecmp_r[31:0]  <= hs_data_i;
+			8'h4C : mtimecmp_r[63:32] <= hs_data_i;
+			default : begin
+				for (i = 1; i < N_SRC; i = i + 1) begin
+					if (hs_addr_i == 8'h20+4*i) begin
+						priority_r[i] <= hs_data_i[2:0];
+					end
+				end
+			end
+		endcase
+	end
+end
+
+always @(*) begin
+	hs_data_o = 32'd0;
+	case (hs_addr_i)
+		8'h00 : hs_data_o = pending_s;
+		8'h04 : hs_data_o = enable_r;
+		8'h08 : hs_data_o = {29'd0, threshold_r};
+		8'h0C : hs_data_o = {27'd0, claim_s};
+		8'h10 : hs_data_o = {31'd0, msip_r};
+		8'h40 : hs_data_o = mtime_r[31:0];
+		8'h44 : hs_data_o = mtime_r[63:32];
+		8'h48 : hs_data_o = mtimecmp_r[31:0];
+		8'h4C : hs_data_o = mtimecmp_r[63:32];
+		default : begin
+			for (i = 1; i < N_SRC; i = i + 1) begin
+				if (hs_addr_i == 8'h20+4*i) begin
+					hs_data_o = {29'd0, priority_r[i]};
+				end
+			end
+		end
+	endcase
+end
+// Latency of register access is 0
+assign hs_ready_o = 1'b1;
+
+/* ---------------------------------------------------
+* Machine timer
+* --------------------------------------------------*/
+// Counter of clock cycles, a write to one half replaces the increment in that cycle
+always @(posedge clk_i) begin
+	if (rst_ni == 1'b0) begin
+		mtime_r <= 64'd0;
+	end else if (hs_write_i && hs_addr_i == 8'h40) begin
+		mtime_r[31:0] <= hs_data_i;
+	end else if (hs_write_i && hs_addr_i == 8'h44) begin
+		mtime_r[63:32] <= hs_data_i;
+	end else begin
+		mtime_r <= mtime_r + 64'd1;
+	end
+end
+
+// Timer interrupt is a level, cleared by writing a new mtimecmp
+assign mtip_o = (mtime_r >= mtimecmp_r) ? 1'b1 : 1'b0;
+
+/* ---------------------------------------------------
+* Priority resolution
+* --------------------------------------------------*/
+// Sources are levels, the handler clears the cause in the peripheral
+//   ties are won by the lowest source index
+reg [2:0] claim_prio_s;
+always @(*) begin
+	claim_s      = 5'd0;
+	claim_prio_s = threshold_r;
+	for (i = N_SRC-1; i > 0; i = i - 1) begin
+		if (pending_s[i] && enable_r[i] && priority_r[i] > threshold_r && priority_r[i] >= claim_prio_s) begin
+			claim_s      = i;
+			claim_prio_s = priority_r[i];
+		end
+	end
+end
+
+assign meip_o = (claim_s != 5'd0) ? 1'b1 : 1'b0;
+assign msip_o = msip_r;
+
+endmodule
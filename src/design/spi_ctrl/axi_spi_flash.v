@@ -0,0 +1,188 @@
+module axi_spi_flash #(
+	// Width of the transaction IDs
+	parameter ID_WIDTH=1,
+	// Number of words fetched ahead of the bus (power of 2, at least 2)
+	parameter PREFETCH_WORDS=4,
+	// Depth of the fifos of the SPI controller (bytes)
+	parameter SPI_FIFO_DEPTH=16,
+	// Flash read command (0:Read, 1:Fast Read, 2:Dual Output, 3:Quad Output)
+	parameter READ_MODE=3,
+	// Cycles without reads after which the stream is closed and the SPI controller is released
+	parameter IDLE_CYCLES=64
+	)(
+	input  clk_i,
+	input  rst_ni,
+
+	//// AXI interface (read-only, writes are ignored)
+	// Read Address (AR) channel
+	input  arvalid_i,
+	output aready_o,
+	input  [31:0] araddr_i,
+	input  [7:0] arlen_i,
+	input  [2:0] arsize_i,
+	input  [1:0] arburst_i,
+	input  [ID_WIDTH-1:0] arid_i,
+
+	// Read Data (R) channel
+	output rvalid_o,
+	input  rready_i,
+	output [31:0] rdata_o,
+	output [1:0] rresp_o,
+	output rlast_o,
+	output [ID_WIDTH-1:0] rid_o,
+
+	// Write Address (AW) channel
+	input  awvalid_i,
+	output awready_o,
+	input  [31:0] awaddr_i,
+	input  [7:0] awlen_i,
+	input  [2:0] awsize_i,
+	input  [1:0] awburst_i,
+	input  [ID_WIDTH-1:0] awid_i,
+
+	// Write Data (W) channel
+	input  wvalid_i,
+	output wready_o,
+	input  [31:0] wdata_i,
+	input  [3:0] wstrb_i,
+	input  wlast_i,
+
+	// Write Response (B) channel
+	output bvalid_o,
+	input  bready_i,
+	output [1:0] bresp_o,
+	output [ID_WIDTH-1:0] bid_o,
+
+	// Arbitration of the SPI controller with the other flash readers
+	output spi_xip_req_o,
+	input  spi_xip_grant_i,
+	input  spi_xip_release_i,
+
+	// Direct interface to SPI controller
+	output spi_xip_en_o,
+	output spi_xip_cs_hold_o,
+	output [1:0] spi_xip_lanes_o,
+	output spi_xip_tx_wr_o,
+	output [7:0] spi_xip_tx_data_o,
+	output spi_xip_rx_rd_o,
+	input  [7:0] spi_xip_rx_data_i,
+	input  spi_xip_rx_not_empty_i,
+	output spi_xip_rx_flush_o,
+	input  spi_xip_busy_i
+);
+
+wire flash_rd_en_s, flash_wr_en_s, flash_ready_s;
+wire [31:0] flash_addr_s, flash_data_o_s;
+
+axi_2_hs #(
+	.ID_WIDTH(ID_WIDTH)
+	)
+	inst_axi_slave (
+	.clk_i(clk_i),
+	.rst_ni(rst_ni),
+	//// AXI interface
+	// Read Address (AR) channel
+	.arvalid_i(arvalid_i),
+	.aready_o(aready_o),
+	.araddr_i(araddr_i),
+	.arlen_i(arlen_i),
+	.arsize_i(arsize_i),
+	.arburst_i(arburst_i),
+	.arid_i(arid_i),
+	// Read Data (R) channel
+	.rvalid_o(rvalid_o),
+	.rready_i(rready_i),
+	.rdata_o(rdata_o),
+	.rresp_o(rresp_o),
+	.rlast_o(rlast_o),
+	.rid_o(rid_o),
+	// Write Address (AW) channel
+	.awvalid_i(awvalid_i),
+	.awready_o(awready_o),
+	.awaddr_i(awaddr_i),
+	.awlen_i(awlen_i),
+	.awsize_i(awsize_i),
+	.awburst_i(awburst_i),
+	.awid_i(awid_i),
+	// Write Data (W) channel
+	.wvalid_i(wvalid_i),
+	.wready_o(wready_o),
+	.wdata_i(wdata_i),
+	.wstrb_i(wstrb_i),
+	.wlast_i(wlast_i),
+	// Write Response (B) channel
+	.bvalid_o(bvalid_o),
+	.bready_i(bready_i),
+	.bresp_o(bresp_o),
+	.bid_o(bid_o),
+	// Handshake interface
+	.hs_read_o(flash_rd_en_s),
+	.hs_write_o(flash_wr_en_s),
+	.hs_addr_o(flash_addr_s),
+	.hs_data_o(),
+	.hs_ready_i(flash_ready_s),
+	.hs_data_i(flash_data_o_s),
+	.byte_select_o()
+);
+
+// Offset of the window inside the flash (24bit flash addresses)
+wire [31:0] flash_rd_addr_s;
+`ifdef FPGA
+// Skip the FPGA configuration stored at the beginning of the flash
+assign flash_rd_addr_s = {8'd0, flash_addr_s[23:0]} + 32'h00130000;
+`else
+assign flash_rd_addr_s = {8'd0, flash_addr_s[23:0]};
+`endif
+
+// Idle counter, the stream is closed when no read arrives for IDLE_CYCLES cycles
+reg [$clog2(IDLE_CYCLES+1)-1:0] idle_cnt_r;
+wire idle_s;
+always @(posedge clk_i) begin
+	if(rst_ni == 1'd0 || flash_rd_en_s == 1'b1) begin
+		idle_cnt_r <= 'd0;
+	end else begin
+		if (!idle_s) begin
+			idle_cnt_r <= idle_cnt_r+1;
+		end
+	end
+end
+assign idle_s = (idle_cnt_r == IDLE_CYCLES) ? 1'b1 : 1'b0;
+
+// Reads are served by a flash read stream, sequential accesses (bursts) do not pay the command overhead again
+wire stream_ready_s;
+spi_boot_ctrl #(
+	.PREFETCH_WORDS(PREFETCH_WORDS),
+	.SPI_FIFO_DEPTH(SPI_FIFO_DEPTH)
+	)
+	inst_spi_stream (
+	.clk_i(clk_i),
+	.rst_ni(rst_ni),
+	// Flash read command
+	.read_mode_i(READ_MODE[1:0]),
+	.close_i(idle_s),
+	// Arbitration of the SPI controller
+	.spi_req_o(spi_xip_req_o),
+	.spi_grant_i(spi_xip_grant_i),
+	.spi_release_i(spi_xip_release_i),
+	// Handshake interface from bus
+	.cpu_hs_read_i(flash_rd_en_s),
+	.cpu_hs_addr_i(flash_rd_addr_s),
+	.cpu_hs_ready_o(stream_ready_s),
+	.cpu_hs_data_o(flash_data_o_s),
+	// Direct interface to SPI controller
+	.spi_xip_en_o(spi_xip_en_o),
+	.spi_cs_hold_o(spi_xip_cs_hold_o),
+	.spi_lanes_o(spi_xip_lanes_o),
+	.spi_tx_wr_o(spi_xip_tx_wr_o),
+	.spi_tx_data_o(spi_xip_tx_data_o),
+	.spi_rx_rd_o(spi_xip_rx_rd_o),
+	.spi_rx_data_i(spi_xip_rx_data_i),
+	.spi_rx_not_empty_i(spi_xip_rx_not_empty_i),
+	.spi_rx_flush_o(spi_xip_rx_flush_o),
+	.spi_busy_i(spi_xip_busy_i)
+);
+
+// Writes are acknowledged without effect
+assign flash_ready_s = stream_ready_s | flash_wr_en_s;
+
+endmodule
@@ -1,4 +1,7 @@
-module axi_spi_mst(	
+module axi_spi_mst #(
+	// Depth of TX/RX fifos (bytes, power of 2, at least 4)
+	parameter FIFO_DEPTH=16
+	)(	
 	input  clk_i,
 	input  rst_ni,
 
@@ -30,16 +33,38 @@ module axi_spi_mst(
 	input  bready_i,
 	output [1:0] bresp_o,
 
+	// Direct interface for flash execute in place
+	input  xip_en_i,
+	input  xip_cs_hold_i,
+	input  [1:0] xip_lanes_i,
+	input  xip_tx_wr_i,
+	input  [7:0] xip_tx_data_i,
+	input  xip_rx_rd_i,
+	output [7:0] xip_rx_data_o,
+	output xip_rx_not_empty_o,
+	input  xip_rx_flush_i,
+	output xip_busy_o,
+
+	// DMA requests
+	output dma_rx_req_o,
+	output dma_tx_req_o,
+
+	// Interrupt request
+	output irq_o,
+
 	// SPI interface
+	// IO0:MOSI, IO1:MISO, IO2:WP#, IO3:HOLD#
 	output sck_o,
 	output cs_no,
-	output mosi_o,
-	input  miso_i 
+	output [3:0] sio_o,
+	output [3:0] sio_oe_o,
+	input  [3:0] sio_i
 );
 
 wire spi_rd_en_s, spi_wr_en_s, spi_ready_s;
 wire [31:0] spi_addr_s, spi_data_i_s;
-wire [7:0] spi_data_o_s;
+wire [31:0] spi_data_o_s;
+wire [3:0] spi_byte_select_s;
 
 axi_2_hs inst_axi_slave (
 	.clk_i(clk_i),
@@ -49,49 +74,82 @@ axi_2_hs inst_axi_slave (
 	.arvalid_i(arvalid_i),
 	.aready_o(aready_o),
 	.araddr_i(araddr_i),
+	.arlen_i(8'd0),
+	.arsize_i(3'd2),
+	.arburst_i(2'b01),
+	.arid_i(1'b0),
 	// Read Data (R) channel
 	.rvalid_o(rvalid_o),
 	.rready_i(rready_i),
 	.rdata_o(rdata_o),
 	.rresp_o(rresp_o),
+	.rlast_o(),
+	.rid_o(),
 	// Write Address (AW) channel
 	.awvalid_i(awvalid_i),
 	.awready_o(awready_o),
 	.awaddr_i(awaddr_i),
+	.awlen_i(8'd0),
+	.awsize_i(3'd2),
+	.awburst_i(2'b01),
+	.awid_i(1'b0),
 	// Write Data (W) channel
 	.wvalid_i(wvalid_i),
 	.wready_o(wready_o),
 	.wdata_i(wdata_i),
 	.wstrb_i(wstrb_i),
+	.wlast_i(1'b1),
 	// Write Response (B) channel
 	.bvalid_o(bvalid_o),
 	.bready_i(bready_i),
 	.bresp_o(bresp_o),
+	.bid_o(),
 	// Handshake interface
 	.hs_read_o(spi_rd_en_s),
 	.hs_write_o(spi_wr_en_s),
 	.hs_addr_o(spi_addr_s),
 	.hs_data_o(spi_data_i_s),
 	.hs_ready_i(spi_ready_s),
-	.hs_data_i({24'd0, spi_data_o_s}),
-	.byte_select_o()
+	.hs_data_i(spi_data_o_s),
+	.byte_select_o(spi_byte_select_s)
 );
 
-spi_mst inst_spi_mst(	
+spi_mst #(
+	.FIFO_DEPTH(FIFO_DEPTH)
+	)
+	inst_spi_mst(	
 	.clk_i(clk_i),
 	.rst_ni(rst_ni),
 	// Handshake interface
 	.hs_read_i(spi_rd_en_s),
 	.hs_write_i(spi_wr_en_s),
-	.hs_addr_i(spi_addr_s[4:0]),
-	.hs_data_i(spi_data_i_s[7:0]),
+	.hs_addr_i(spi_addr_s[5:0]),
+	.hs_data_i(spi_data_i_s),
+	.hs_byte_select_i(spi_byte_select_s),
 	.hs_ready_o(spi_ready_s),
 	.hs_data_o(spi_data_o_s),
+	// Direct interface for flash execute in place
+	.xip_en_i(xip_en_i),
+	.xip_cs_hold_i(xip_cs_hold_i),
+	.xip_lanes_i(xip_lanes_i),
+	.xip_tx_wr_i(xip_tx_wr_i),
+	.xip_tx_data_i(xip_tx_data_i),
+	.xip_rx_rd_i(xip_rx_rd_i),
+	.xip_rx_data_o(xip_rx_data_o),
+	.xip_rx_not_empty_o(xip_rx_not_empty_o),
+	.xip_rx_flush_i(xip_rx_flush_i),
+	.xip_busy_o(xip_busy_o),
+	// DMA requests
+	.dma_rx_req_o(dma_rx_req_o),
+	.dma_tx_req_o(dma_tx_req_o),
+	// Interrupt request
+	.irq_o(irq_o),
 	// SPI interface
 	.sck_o(sck_o),
 	.cs_no(cs_no),
-	.mosi_o(mosi_o),
-	.miso_i(miso_i) 
+	.sio_o(sio_o),
+	.sio_oe_o(sio_oe_o),
+	.sio_i(sio_i)
 );
 
 endmodule
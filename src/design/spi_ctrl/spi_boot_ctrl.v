@@ -1,88 +1,200 @@
-module spi_boot_ctrl(	
+module spi_boot_ctrl #(
+	// Number of words fetched ahead of the CPU (power of 2, at least 2)
+	parameter PREFETCH_WORDS=4,
+	// Depth of the fifos of the SPI controller (bytes, at least 4)
+	parameter SPI_FIFO_DEPTH=16
+	)(
 	input  clk_i,
 	input  rst_ni,
 
+	// Flash read command
+	// 0:Read (0x03), 1:Fast Read (0x0B), 2:Dual Output Fast Read (0x3B), 3:Quad Output Fast Read (0x6B)
+	input  [1:0] read_mode_i,
+	// Terminate the flash read stream
+	input  close_i,
+
+	// Arbitration of the SPI controller (shared with other flash readers)
+	// Request: a read is pending or a stream is open
+	output spi_req_o,
+	// A new stream is opened only while granted
+	input  spi_grant_i,
+	// Another reader is waiting: close the stream when no read is pending, do not open a new one
+	input  spi_release_i,
+
 	// Handshake interface from CPU
 	input  cpu_hs_read_i,
 	input  [31:0] cpu_hs_addr_i,
-	output reg cpu_hs_ready_o,
+	output cpu_hs_ready_o,
 	output [31:0] cpu_hs_data_o,
-	
-	// Handshake interface to interconnect
-	input  bus_hs_ready_i,
-	input  [31:0] bus_hs_data_i,
-	output reg bus_hs_rd_o,
-	output reg bus_hs_wr_o,
-	output reg [31:0] bus_hs_addr_o,
-	output reg [31:0] bus_hs_data_o
+
+	// Direct interface to SPI controller
+	output reg spi_xip_en_o,
+	output reg spi_cs_hold_o,
+	output reg [1:0] spi_lanes_o,
+	output reg spi_tx_wr_o,
+	output reg [7:0] spi_tx_data_o,
+	output reg spi_rx_rd_o,
+	input  [7:0] spi_rx_data_i,
+	input  spi_rx_not_empty_i,
+	output reg spi_rx_flush_o,
+	input  spi_busy_i
 );
 
-// Counter for shift register bytes
+// Maximum number of bytes requested to the SPI controller and not yet received
+// (at most 8, limited by the SPI controller fifo depth)
+localparam MAX_PENDING = (SPI_FIFO_DEPTH < 8) ? SPI_FIFO_DEPTH : 8;
+localparam BUF_WIDTH   = $clog2(PREFETCH_WORDS);
+
+/* ---------------------------------------------------
+* Stream state
+* --------------------------------------------------*/
+// Flash address of the next word to be sent to the CPU
+reg  [31:0] stream_addr_r;
+// Read command of the current stream
+reg  [1:0] mode_r;
+// Counter for header bytes (command, address and dummy byte)
 reg  [2:0] cnt_r;
 reg  cnt_en_s, cnt_clr_s;
-wire cnt_tc_s;
+wire [2:0] hdr_last_s;
+// Bytes requested to SPI controller and not yet received
+reg  [3:0] pending_r;
+// Word assembly from received bytes
+reg  [23:0] asm_r;
+reg  [1:0] asm_cnt_r;
+// Prefetch buffer
+reg  [BUF_WIDTH:0] buf_level_r;
+wire buf_wr_s, buf_rd_s, buf_empty_s, buf_rst_s;
+// Stream control
+reg  load_en_s, stream_en_s, buf_flush_s;
+wire hit_s, can_push_s;
+
+// Read command does not need a dummy byte
+assign hdr_last_s = (mode_r==2'd0) ? 3'd3 : 3'd4;
+
+// Header byte to be sent
+always @(*) begin
+	case (cnt_r)
+		3'd0 : begin
+			case (mode_r)
+				2'd0    : spi_tx_data_o = 8'h03;
+				2'd1    : spi_tx_data_o = 8'h0B;
+				2'd2    : spi_tx_data_o = 8'h3B;
+				default : spi_tx_data_o = 8'h6B;
+			endcase
+		end
+		3'd1    : spi_tx_data_o = stream_addr_r[23:16];
+		3'd2    : spi_tx_data_o = stream_addr_r[15:8];
+		3'd3    : spi_tx_data_o = stream_addr_r[7:0];
+		// Dummy bytes
+		default : spi_tx_data_o = 8'd0;
+	endcase
+end
+
+// Counter for header bytes
+always @(posedge clk_i) begin
+	if(rst_ni == 1'd0 || cnt_clr_s == 1'b1) begin
+		cnt_r <= 'b0;
+	end else begin
+		if (cnt_en_s) begin
+			cnt_r <= cnt_r+1;
+		end
+	end
+end
 
-// Shift register to send/receive SPI data
-reg  load_en_s, shift_en_s;
-reg  [7:0] shift_reg_r [7:0];
-integer i;
+// Stream address and command
 always @(posedge clk_i) begin
 	if (rst_ni == 1'd0) begin
-		for (i=0; i<8; i=i+1) begin
-            shift_reg_r[i] <= 8'd0;
-        end
+		stream_addr_r <= 'b0;
+		mode_r        <= 'b0;
 	end else begin
-		if (load_en_s == 1'b1) begin
-			// Parrallel load values to send to SPI controller
-			// Flash read command
-			shift_reg_r[7] <= 8'd3;
-			// Instruction address
-			shift_reg_r[6] <= cpu_hs_addr_i[23:16];
-			shift_reg_r[5] <= cpu_hs_addr_i[15:8];
-			shift_reg_r[4] <= cpu_hs_addr_i[7:0];
-			// Dummy bytes to receive data
-			shift_reg_r[3] <= 8'd0;
-			shift_reg_r[2] <= 8'd0;
-			shift_reg_r[1] <= 8'd0;
-			shift_reg_r[0] <= 8'd0;
-		end else if (shift_en_s & bus_hs_ready_i) begin
-			// Shift data during TX and RX
-			shift_reg_r[7] <= shift_reg_r[6];
-			shift_reg_r[6] <= shift_reg_r[5];
-			shift_reg_r[5] <= shift_reg_r[4];
-			shift_reg_r[4] <= shift_reg_r[3];
-			shift_reg_r[3] <= shift_reg_r[2];
-			shift_reg_r[2] <= shift_reg_r[1];
-			shift_reg_r[1] <= shift_reg_r[0];
-			// Receive data from SPI controller
-    		shift_reg_r[0] <= bus_hs_data_i[7:0];
+		if (load_en_s) begin
+			// Start a new stream from the requested word
+			stream_addr_r <= {cpu_hs_addr_i[31:2], 2'b00};
+			mode_r        <= read_mode_i;
+		end else if (buf_rd_s) begin
+			stream_addr_r <= stream_addr_r+4;
 		end
 	end
 end
 
-// Counter for shift register bytes
+// Request bytes while there is room for them in the prefetch buffer
+assign can_push_s = ((buf_level_r*4 + asm_cnt_r + pending_r) < PREFETCH_WORDS*4) && (pending_r < MAX_PENDING);
+
+// Pending bytes counter
 always @(posedge clk_i) begin
-	if(rst_ni == 1'd0 || cnt_clr_s == 1'b1) begin
-		cnt_r <= 'b0;
+	if(rst_ni == 1'd0 || stream_en_s == 1'b0) begin
+		pending_r <= 'd0;
 	end else begin
-		if (cnt_en_s & bus_hs_ready_i) begin
-			cnt_r <= cnt_r+1;
+		if (spi_tx_wr_o==1'b1 && spi_rx_rd_o==1'b0) begin
+			pending_r <= pending_r+1;
+		end else if (spi_tx_wr_o==1'b0 && spi_rx_rd_o==1'b1) begin
+			pending_r <= pending_r-1;
+		end
+	end
+end
+
+// Assemble little endian words from received bytes
+always @(posedge clk_i) begin
+	if(rst_ni == 1'd0 || stream_en_s == 1'b0) begin
+		asm_r     <= 'b0;
+		asm_cnt_r <= 'b0;
+	end else begin
+		if (spi_rx_rd_o) begin
+			asm_r     <= {spi_rx_data_i, asm_r[23:8]};
+			asm_cnt_r <= asm_cnt_r+1;
 		end
 	end
 end
-assign cnt_tc_s = (cnt_r == 3'd7) ? 1'b1 : 1'b0;
+assign buf_wr_s = stream_en_s & spi_rx_rd_o & (asm_cnt_r==2'd3);
+
+// Requested word is the head of the stream
+assign hit_s    = (cpu_hs_addr_i[31:2]==stream_addr_r[31:2]) ? 1'b1 : 1'b0;
+assign buf_rd_s = stream_en_s & cpu_hs_read_i & hit_s & ~buf_empty_s;
 
+// Prefetch buffer
+assign buf_rst_s = rst_ni & ~buf_flush_s;
+sync_fifo  #(
+	.DEPTH(PREFETCH_WORDS),
+	.DATA_WIDTH(32)
+	)
+	inst_prefetch_buf (
+	// Write port
+	.clk_i(clk_i),
+	.rst_ni(buf_rst_s),
+	.wr_en_i(buf_wr_s),
+  	.wr_data_i({spi_rx_data_i, asm_r}),
+	.full_o(),
+	// Read port
+  	.rd_en_i(buf_rd_s),
+  	.rd_data_o(cpu_hs_data_o),
+  	.empty_o(buf_empty_s),
+	.not_empty_o()
+);
+
+// Prefetch buffer fill level counter
+always @(posedge clk_i) begin
+	if(rst_ni == 1'd0 || buf_flush_s == 1'b1) begin
+		buf_level_r <= 'd0;
+	end else begin
+		if (buf_wr_s==1'b1 && buf_rd_s==1'b0) begin
+			buf_level_r <= buf_level_r+1;
+		end else if (buf_wr_s==1'b0 && buf_rd_s==1'b1) begin
+			buf_level_r <= buf_level_r-1;
+		end
+	end
+end
+assign cpu_hs_ready_o = buf_rd_s;
+
+/* ---------------------------------------------------
+* FSM
+* --------------------------------------------------*/
 // Signals and encoding for FSM status
-reg [4:0] current_state_r, next_state_s;
-localparam IDLE          = 5'd0;
-localparam SET_INHIBIT   = 5'd1;
-localparam FILL_TX_FIFO  = 5'd2;
-localparam WAIT_BUS_1    = 5'd3;
-localparam RESET_INHIBIT = 5'd4;
-localparam WAIT_DATA     = 5'd5;
-localparam RECEIVE_DATA  = 5'd6;
-localparam WAIT_BUS_2    = 5'd7;
-localparam SEND_TO_CPU   = 5'd8;
+reg [2:0] current_state_r, next_state_s;
+localparam IDLE        = 3'd0;
+localparam SEND_HEADER = 3'd1;
+localparam WAIT_HEADER = 3'd2;
+localparam STREAM      = 3'd3;
+localparam CLOSE       = 3'd4;
 
 // FSM present state update
 always @(posedge clk_i) begin
@@ -98,81 +210,47 @@ always @(*) begin
 	// Default next state
 	next_state_s = current_state_r;
 
- 	case(current_state_r)		
+ 	case(current_state_r)
 		// Wait for new request from hs interface
   		IDLE : begin
-			if (cpu_hs_read_i) begin
-				// Send data to SPI controller
-				next_state_s = SET_INHIBIT;
-			end
-		end
-
-		// Set inhibit of spi controller
-  		SET_INHIBIT : begin
-			if (bus_hs_ready_i) begin
-				// Start sending data to SPI controller
-				next_state_s = FILL_TX_FIFO;
+			if (cpu_hs_read_i & ~close_i & spi_grant_i & ~spi_release_i) begin
+				// Open a stream from the requested address
+				next_state_s = SEND_HEADER;
 			end
 		end
 
-		// Send 1 byte to SPI controller
-		FILL_TX_FIFO : begin
-			next_state_s = WAIT_BUS_1;
-		end
-
-		// Wait acknowledge from bus
-		WAIT_BUS_1 : begin
-			if (bus_hs_ready_i) begin
-				// Check if all the data has been sent to the controller
-				if (cnt_tc_s) begin
-					// Start SPI transation
-					next_state_s = RESET_INHIBIT;
-				end else begin
-					// Send next byte
-					next_state_s = FILL_TX_FIFO;
-				end
+		// Send command, address and dummy byte to SPI controller
+		SEND_HEADER : begin
+			if (cnt_r == hdr_last_s) begin
+				next_state_s = WAIT_HEADER;
 			end
 		end
 
-		// Start SPI transation realeasing TX inhibit
-		RESET_INHIBIT : begin
-			if (bus_hs_ready_i) begin
-				next_state_s = WAIT_DATA;
+		// Discard bytes received while sending the header
+		WAIT_HEADER : begin
+			if (spi_rx_rd_o && cnt_r == hdr_last_s) begin
+				next_state_s = STREAM;
 			end
 		end
 
-		// Wait until RX fifo is filled with 8 bytes
-		WAIT_DATA : begin
-			if (bus_hs_ready_i && (bus_hs_data_i == 32'd8) ) begin
-				// Get data from SPI controller
-			    next_state_s = RECEIVE_DATA;
+		// Keep reading sequential data from flash
+		STREAM : begin
+			if (close_i || (cpu_hs_read_i && !hit_s)) begin
+				// Non sequential access, restart from new address
+				next_state_s = CLOSE;
+			end else if (spi_release_i && !cpu_hs_read_i) begin
+				// Leave the SPI controller to the other reader
+				next_state_s = CLOSE;
 			end
 		end
-		
-		// Get data from SPI controller
-		RECEIVE_DATA : begin
-			next_state_s = WAIT_BUS_2;
-		end
 
-		// Wait acknowledge from bus
-		WAIT_BUS_2 : begin
-			// Check if all the data has been received to the controller
-			if (bus_hs_ready_i) begin
-				if (cnt_tc_s) begin
-					// Send intruction to the cpu
-					next_state_s = SEND_TO_CPU;
-				end else begin
-					// Get next byte
-					next_state_s = RECEIVE_DATA;
-				end
+		// Wait for the bytes still in transfer and release chip select
+		CLOSE : begin
+			if (!spi_busy_i) begin
+				next_state_s = IDLE;
 			end
 		end
 
-		// Send intruction to the cpu
-		SEND_TO_CPU : begin
-			next_state_s = IDLE;
-		end
-        
         default : next_state_s = IDLE;
 	endcase
 end
@@ -180,87 +258,68 @@ end
 // FSM output calculation
 always @(*) begin
 	// Default output values
-	cpu_hs_ready_o = 1'b0;
-	bus_hs_rd_o    = 1'b0;
-	bus_hs_wr_o    = 1'b0;
-	bus_hs_addr_o  = 32'b0;
-	bus_hs_data_o  = 32'b0;
+	spi_xip_en_o   = 1'b1;
+	spi_cs_hold_o  = 1'b1;
+	spi_lanes_o    = 2'd0;
+	spi_tx_wr_o    = 1'b0;
+	spi_rx_rd_o    = 1'b0;
+	spi_rx_flush_o = 1'b0;
 
-	load_en_s  = 1'b0;
-	shift_en_s = 1'b0;
+	load_en_s   = 1'b0;
+	stream_en_s = 1'b0;
+	buf_flush_s = 1'b0;
 
 	cnt_en_s  = 1'b0;
 	cnt_clr_s = 1'b0;
 
 	case(current_state_r)
 		// Wait for new request from hs interface
+		// SPI controller is available to the bus
+		// Data left in RX fifo is discarded when opening a stream
   		IDLE : begin
-			load_en_s = 1'b1;
+			spi_xip_en_o   = 1'b0;
+			spi_cs_hold_o  = 1'b0;
+			spi_rx_flush_o = (next_state_s == SEND_HEADER) ? 1'b1 : 1'b0;
+			load_en_s      = 1'b1;
+			cnt_clr_s      = 1'b1;
 		end
 
-		// Set inhibit of spi controller
-		SET_INHIBIT : begin
-			cnt_clr_s     = 1'b1;
-			bus_hs_wr_o   = 1'b1;
-			bus_hs_addr_o = 32'h10200;
-			bus_hs_data_o = 32'h4;
+		// Send command, address and dummy byte to SPI controller
+		SEND_HEADER : begin
+			spi_tx_wr_o = 1'b1;
+			cnt_en_s    = 1'b1;
+			cnt_clr_s   = (cnt_r == hdr_last_s) ? 1'b1 : 1'b0;
 		end
 
-		// Send 1 byte to SPI controller
-		FILL_TX_FIFO : begin
-			bus_hs_wr_o   = 1'b1;
-			bus_hs_addr_o = 32'h10208;
-			bus_hs_data_o = {24'd0, shift_reg_r[7]};
+		// Discard bytes received while sending the header
+		WAIT_HEADER : begin
+			spi_rx_rd_o = spi_rx_not_empty_i;
+			cnt_en_s    = spi_rx_not_empty_i;
 		end
 
-		// Wait acknowledge from bus
-		// Keep signals until transaction is done
-		WAIT_BUS_1 : begin
-			cnt_en_s      = 1'b1;
-			shift_en_s    = 1'b1;
-			bus_hs_wr_o   = 1'b1;
-			bus_hs_addr_o = 32'h10208;
-			bus_hs_data_o = {24'd0, shift_reg_r[7]};
+		// Keep reading sequential data from flash
+		// Data is received on the lanes of the selected command
+		STREAM : begin
+			spi_lanes_o = (mode_r==2'd3) ? 2'd2 : (mode_r==2'd2) ? 2'd1 : 2'd0;
+			stream_en_s = 1'b1;
+			spi_tx_wr_o = (next_state_s == STREAM) ? can_push_s : 1'b0;
+			spi_rx_rd_o = spi_rx_not_empty_i;
 		end
 
-		// Start SPI transation realeasing TX inhibit
-		RESET_INHIBIT : begin
-			cnt_clr_s     = 1'b1;
-			bus_hs_wr_o   = 1'b1;
-			bus_hs_addr_o = 32'h10200;
-			bus_hs_data_o = 32'h0;
+		// Wait for the bytes still in transfer and release chip select
+		// Discard all data received
+		CLOSE : begin
+			spi_cs_hold_o  = 1'b0;
+			spi_lanes_o    = (mode_r==2'd3) ? 2'd2 : (mode_r==2'd2) ? 2'd1 : 2'd0;
+			spi_rx_flush_o = ~spi_busy_i;
+			buf_flush_s    = 1'b1;
 		end
 
-		// Wait until RX fifo is filled with 8 bytes
-		WAIT_DATA : begin
-			bus_hs_rd_o   = 1'b1;
-			bus_hs_addr_o = 32'h10214;
-		end
-		
-		// Get data from SPI controller
-		RECEIVE_DATA : begin
-			bus_hs_rd_o   = 1'b1;
-			bus_hs_addr_o = 32'h1020c;
-		end
-
-		// Wait acknowledge from bus
-		// Keep signals until transaction is done
-		WAIT_BUS_2 : begin
-			cnt_en_s      = 1'b1;
-			shift_en_s    = 1'b1;
-			bus_hs_rd_o   = 1'b1;
-			bus_hs_addr_o = 32'h1020c;
-		end
-
-		// Send intruction to the cpu
-		SEND_TO_CPU : begin
-			cpu_hs_ready_o = 1'b1;
-		end
-        
         default : begin
 		end
 	endcase
 end
-assign cpu_hs_data_o = {shift_reg_r[0], shift_reg_r[1], shift_reg_r[2], shift_reg_r[3]};
+
+assign spi_req_o = (current_state_r!=IDLE) | cpu_hs_read_i;
 
 endmodule
@@ -1,4 +1,5 @@
 module spi_mst #(
+	// Depth of TX/RX fifos (bytes, power of 2, at least 4)
 	parameter FIFO_DEPTH=16
 	)(	
 	input  clk_i,
@@ -7,29 +8,62 @@ module spi_mst #(
 	// Handshake interface
 	input  hs_read_i,
 	input  hs_write_i,
-	input  [4:0] hs_addr_i,
-	input  [7:0] hs_data_i,
+	input  [5:0] hs_addr_i,
+	input  [31:0] hs_data_i,
+	input  [3:0] hs_byte_select_i,
 	output hs_ready_o,
-	output [7:0] hs_data_o,
+	output [31:0] hs_data_o,
+
+	// Direct interface for flash execute in place
+	// While enabled, TX inhibit, LSB first and the lane control register are ignored
+	input  xip_en_i,
+	// Keep chip select low with clock stopped when TX fifo is empty
+	input  xip_cs_hold_i,
+	// Data lanes used to receive (0:single, 1:dual, 2:quad)
+	input  [1:0] xip_lanes_i,
+	input  xip_tx_wr_i,
+	input  [7:0] xip_tx_data_i,
+	input  xip_rx_rd_i,
+	output [7:0] xip_rx_data_o,
+	output xip_rx_not_empty_o,
+	input  xip_rx_flush_i,
+	// Transaction in progress or data waiting in TX fifo
+	output xip_busy_o,
+
+	// DMA requests (inactive during execute in place)
+	// RX: data available in RX fifo, TX: room available in TX fifo (4 bytes in word mode)
+	output dma_rx_req_o,
+	output dma_tx_req_o,
+
+	// Interrupt request (level, inactive during execute in place)
+	output irq_o,
 
 	// SPI interface
+	// IO0:MOSI, IO1:MISO, IO2:WP#, IO3:HOLD#
 	output sck_o,
 	output reg cs_no,
-	output mosi_o,
-	input  miso_i 
+	output [3:0] sio_o,
+	output [3:0] sio_oe_o,
+	input  [3:0] sio_i
 );
 
 /* ---------------------------------------------------
 * Register Access
 * --------------------------------------------------*/
-wire [7:0] rx_fifo_data_o_s;
-reg  [7:0] rx_fifo_level_r, tx_fifo_level_r;
+wire [31:0] rx_fifo_data_o_s;
+localparam LEVEL_WIDTH = $clog2(FIFO_DEPTH)+1;
+wire [LEVEL_WIDTH-1:0] rx_fifo_level_s, tx_fifo_level_s;
 // Status register signals
-wire tx_fifo_full_s, tx_fifo_empty_s, rx_fifo_full_s, rx_fifo_empty_s;
+wire tx_fifo_full_s, tx_fifo_empty_s, rx_fifo_full_s, rx_fifo_empty_s, shift_idle_s;
 // Control register signals
-wire rst_tx_fifo_s, rst_rx_fifo_s, tx_inhibit_s, clk_pol_s, clk_phase_s, lsb_first;
+wire rst_tx_fifo_s, rst_rx_fifo_s, tx_inhibit_s, clk_pol_s, clk_phase_s, lsb_first, dma_word_s;
+// Data lanes
+wire [1:0] lanes_s;
+wire dual_s, quad_s, lanes_tx_s, cs_hold_s;
 // Clock divider
 wire [15:0] clk_div_s;
+// Interrupt sources
+wire [2:0] irq_status_s;
 
 //// Register access
 // Reg_0 (0x00): Ctrl reg      (RW)
@@ -40,7 +74,15 @@ wire [15:0] clk_div_s;
 // Reg_5 (0x14): RX fifo level (RO)
 // Reg_6 (0x18): Clk_div low   (RW)
 // Reg_7 (0x1C): Clk_div high  (RW)
-reg [7:0] registers_r [0:7];
+// Reg_8 (0x20): Irq enable    (RW)
+// Reg_9 (0x24): Irq status    (RO)
+// Reg_10 (0x28): RX watermark (RW)
+// Reg_11 (0x2C): TX watermark (RW)
+// 0x30: TX fifo packed data (WO, each byte enabled by the byte select is pushed, from the lowest one)
+// 0x34: RX fifo packed data (RO, up to 4 bytes are popped, the oldest in the lowest byte)
+// Reg_14 (0x38): Lane ctrl    (RW)
+// The fifo levels are read with the full width of the counters
+reg [7:0] registers_r [0:14];
 always @(posedge clk_i) begin
     if (rst_ni == 0) begin
         // Reset of the registers
@@ -52,37 +94,52 @@ always @(posedge clk_i) begin
         registers_r[6] <= 8'd2;
 `endif
 		registers_r[7] <= 8'd0;
+		registers_r[8] <= 8'd0;
+		// Interrupt when RX fifo is not empty, or when TX fifo is empty
+		registers_r[10] <= 8'd1;
+		registers_r[11] <= 8'd0;
+		registers_r[14] <= 8'd0;
     end else begin
         // Writing in the registers
-        if (hs_write_i == 1'b1) begin
-            registers_r[hs_addr_i[4:2]] <= hs_data_i;
+        if (hs_write_i == 1'b1 && (hs_addr_i[5:2] <= 4'd11 || hs_addr_i[5:2] == 4'd14)) begin
+            registers_r[hs_addr_i[5:2]] <= hs_data_i[7:0];
         end
 		// Self clearing bits
 		registers_r[0][0] <= (registers_r[3][0]) ? 1'b0 : registers_r[0][0];
 		registers_r[0][1] <= (registers_r[3][1]) ? 1'b0 : registers_r[0][1];
     end
 	// Register 1 is read-only (Status reg)
-	registers_r[1] <= {4'd0, tx_fifo_full_s, tx_fifo_empty_s, rx_fifo_full_s, rx_fifo_empty_s};
+	registers_r[1] <= {2'd0, xip_en_i, shift_idle_s, tx_fifo_full_s, tx_fifo_empty_s, rx_fifo_full_s, rx_fifo_empty_s};
 	// Register 3 is read-only (RX fifo data)
-	registers_r[3] <= rx_fifo_data_o_s;
-	// Register 4 is read-only (TX fifo level)
-	registers_r[4] <= tx_fifo_level_r;
-	// Register 5 is read-only (RX fifo level)
-	registers_r[5] <= rx_fifo_level_r;
+	registers_r[3] <= rx_fifo_data_o_s[7:0];
 	// Register 2 is write only (TX fifo data), always read 0 back
 	registers_r[2] <= 8'd0;
+	// Register 9 is read-only (Irq status)
+	registers_r[9] <= {5'd0, irq_status_s};
 end
 // Signals from ctrl register
 assign rst_tx_fifo_s = (rst_ni & ~registers_r[0][0]);
-assign rst_rx_fifo_s = (rst_ni & ~registers_r[0][1]);
-assign tx_inhibit_s  = registers_r[0][2];
+assign rst_rx_fifo_s = (rst_ni & ~registers_r[0][1] & ~xip_rx_flush_i);
+assign tx_inhibit_s  = registers_r[0][2] & ~xip_en_i;
 assign clk_pol_s     = registers_r[0][3];
 assign clk_phase_s   = registers_r[0][4];
-assign lsb_first     = registers_r[0][5];
+assign lsb_first     = registers_r[0][5] & ~xip_en_i;
+assign dma_word_s    = registers_r[0][6];
+// Signals from lane ctrl register (replaced by the execute in place interface while enabled)
+assign lanes_s    = (xip_en_i) ? xip_lanes_i   : registers_r[14][1:0];
+assign lanes_tx_s = registers_r[14][2] & ~xip_en_i;
+assign cs_hold_s  = (xip_en_i) ? xip_cs_hold_i : registers_r[14][3];
+// Lane value 3 is reserved and uses a single lane
+assign dual_s = (lanes_s==2'd1) ? 1'b1 : 1'b0;
+assign quad_s = (lanes_s==2'd2) ? 1'b1 : 1'b0;
 // Values from clock divider registers
 assign clk_div_s = {registers_r[7], registers_r[6]};
 // Output for register access
-assign hs_data_o = registers_r[hs_addr_i[4:2]];
+assign hs_data_o = (hs_addr_i[5:2] == 4'd4)  ? tx_fifo_level_s  :
+                   (hs_addr_i[5:2] == 4'd5)  ? rx_fifo_level_s  :
+                   (hs_addr_i[5:2] == 4'd13) ? rx_fifo_data_o_s :
+                   (hs_addr_i[5:2] == 4'd14) ? {24'd0, registers_r[14]} :
+                   (hs_addr_i[5:2] <= 4'd11) ? {24'd0, registers_r[hs_addr_i[5:2]]} : 32'd0;
 // Latency of register access is 0
 assign hs_ready_o = 1'b1;
 
@@ -114,6 +171,7 @@ localparam SET_CS         = 3'd1;
 localparam DATA           = 3'd2;
 localparam POP_PUSH_FIFOS = 3'd3;
 localparam RESET_CS       = 3'd4;
+localparam HOLD_CS        = 3'd5;
 
 // FSM present state update
 always @(posedge clk_i) begin
@@ -156,9 +214,12 @@ always @(*) begin
 		// Remove transmitted byte from tx fifo
 		// Add received byte into rx fifo
   		POP_PUSH_FIFOS : begin
-			if ((tx_fifo_level_r!=1) & ~tx_inhibit_s) begin
+			if ((tx_fifo_level_s!=1) & ~tx_inhibit_s) begin
 				// Continue transmission of next byte
 				next_state_s = DATA;
+			end else if (cs_hold_s) begin
+				// Keep chip select until next byte
+				next_state_s = HOLD_CS;
 			end else begin
 				// Return to idle
 				next_state_s = RESET_CS;
@@ -173,6 +234,16 @@ always @(*) begin
 				next_state_s = IDLE;
 			end
 		end
+
+		// Keep chip select low with clock stopped
+		// Resume transmission when new data is available
+  		HOLD_CS : begin
+			if (tx_fifo_not_empty_s & ~tx_inhibit_s) begin
+				next_state_s = DATA;
+			end else if (~cs_hold_s) begin
+				next_state_s = RESET_CS;
+			end
+		end
         
         default : next_state_s = IDLE;
 	endcase
@@ -226,6 +297,12 @@ always @(*) begin
 			bit_cnt_clr_s = 1'b1;
 		end
 
+		// Keep chip select low with clock stopped
+  		HOLD_CS : begin
+			cs_no         = 1'b0;
+			bit_cnt_clr_s = 1'b1;
+		end
+
         default : begin
 		end
 	endcase
@@ -265,7 +342,9 @@ always @(posedge clk_i) begin
 		end
 	end
 end
-assign bit_cnt_tc_s = (bit_cnt_r==3'd7) ? 1'b1: 1'b0;
+// A byte takes 8 bit times on single lane, 4 on dual lanes and 2 on quad lanes
+assign bit_cnt_tc_s = (quad_s) ? (bit_cnt_r==3'd1) :
+                      (dual_s) ? (bit_cnt_r==3'd3) : (bit_cnt_r==3'd7);
 
 // Output clock generation
 always @(posedge clk_i) begin
@@ -286,62 +365,81 @@ assign sck_o = edge_cnt_r[0] ^ clk_pol_s;
 * TX Section
 * --------------------------------------------------*/
 // TX fifo
-assign tx_fifo_wr_s = (hs_write_i && hs_addr_i[4:2]==3'd2) ? 1'b1 : 1'b0;
-wire [7:0] tx_data_s;
-sync_fifo  #(
-	.DEPTH(FIFO_DEPTH),
-	.DATA_WIDTH(8)
+wire tx_fifo_wr_packed_s;
+assign tx_fifo_wr_s        = ((hs_write_i && hs_addr_i[5:2]==4'd2) || xip_tx_wr_i) ? 1'b1 : 1'b0;
+assign tx_fifo_wr_packed_s = (hs_write_i && hs_addr_i[5:2]==4'd12) ? 1'b1 : 1'b0;
+// Bytes enabled by the byte select are packed starting from the lowest one
+reg [2:0] tx_packed_cnt_s;
+reg [31:0] tx_packed_data_s;
+integer k;
+always @(*) begin
+	tx_packed_cnt_s  = 3'd0;
+	tx_packed_data_s = 32'd0;
+	for (k=0; k<4; k=k+1) begin
+		if (hs_byte_select_i[k]) begin
+			tx_packed_data_s[tx_packed_cnt_s*8 +: 8] = hs_data_i[k*8 +: 8];
+			tx_packed_cnt_s = tx_packed_cnt_s + 3'd1;
+		end
+	end
+end
+wire [2:0] tx_fifo_wr_cnt_s;
+assign tx_fifo_wr_cnt_s = (tx_fifo_wr_packed_s) ? tx_packed_cnt_s : {2'd0, tx_fifo_wr_s};
+wire [31:0] tx_data_s, tx_fifo_data_i_s;
+assign tx_fifo_data_i_s = (xip_tx_wr_i)         ? {24'd0, xip_tx_data_i} :
+                          (tx_fifo_wr_packed_s) ? tx_packed_data_s       : hs_data_i;
+byte_fifo  #(
+	.DEPTH(FIFO_DEPTH)
 	)
 	inst_tx_fifo (	
-	// Write port
 	.clk_i(clk_i), 
 	.rst_ni(rst_tx_fifo_s),
-	.wr_en_i(tx_fifo_wr_s),
-  	.wr_data_i(hs_data_i),
+	// Write port
+	.wr_cnt_i(tx_fifo_wr_cnt_s),
+  	.wr_data_i(tx_fifo_data_i_s),
 	.full_o(tx_fifo_full_s),
 	// Read port
-  	.rd_en_i(tx_fifo_rd_s),
+  	.rd_cnt_i({2'd0, tx_fifo_rd_s}),
   	.rd_data_o(tx_data_s),
   	.empty_o(tx_fifo_empty_s),
-	.not_empty_o(tx_fifo_not_empty_s)
+	.not_empty_o(tx_fifo_not_empty_s),
+	.level_o(tx_fifo_level_s)
 );
 
-// TX fifo fill level counter
-always @(posedge clk_i) begin
-	if(rst_ni == 1'd0) begin
-		tx_fifo_level_r <= 'd0;
-	end else begin
-		if (rst_tx_fifo_s==1'b0) begin
-			// Reset counter when fifo is reset
-			tx_fifo_level_r <='d0;
-		end else if (tx_fifo_wr_s==1'b1 && tx_fifo_rd_s==1'b0) begin
-			// Increase counter if fifo when filled
-			tx_fifo_level_r <= tx_fifo_level_r+1;
-		end else if (tx_fifo_wr_s==1'b0 && tx_fifo_rd_s==1'b1) begin
-			// Increase counter if fifo when emptied
-			tx_fifo_level_r <= tx_fifo_level_r-1;
-		end
-	end
-end
-
 // Select bit order depending on register field
 wire correct_bit_order_data_s;
 assign correct_bit_order_data_s = (lsb_first) ? tx_data_s[bit_cnt_r] : tx_data_s[7-bit_cnt_r];
 
+// Data on the lanes, most significant bits first on multiple lanes (IO3 or IO1 carries the msb)
+// IO2/IO3 are kept high (WP#/HOLD# inactive) when not used as data lanes
+reg [3:0] lanes_data_s;
+always @(*) begin
+	if (quad_s) begin
+		lanes_data_s = tx_data_s[{~bit_cnt_r[0], 2'b00} +: 4];
+	end else if (dual_s) begin
+		lanes_data_s = {2'b11, tx_data_s[{~bit_cnt_r[1:0], 1'b0} +: 2]};
+	end else begin
+		lanes_data_s = {3'b110, correct_bit_order_data_s};
+	end
+end
+
 // Delay for clock phase 1 configurations
-reg mosi_r;
+reg [3:0] sio_r;
 always @(posedge clk_i) begin
 	if(rst_ni == 1'd0) begin
-		mosi_r <= 1'd0;
+		sio_r <= 4'b1100;
 	end else begin
 		if (sck_en_s & clk_div_tc_s) begin
 			// Sample every time there is a terminal count from clock divider
-			mosi_r <= correct_bit_order_data_s;
+			sio_r <= lanes_data_s;
 		end
 	end
 end
 // Output data (select between direct and delayed data depending on clock phase)
-assign mosi_o = (clk_phase_s) ? mosi_r : correct_bit_order_data_s;
+assign sio_o = (clk_phase_s) ? sio_r : lanes_data_s;
+// On a single lane IO1 is the only input
+// On multiple lanes the data lanes are all driven when transmitting, all released when receiving
+assign sio_oe_o = (quad_s) ? {4{lanes_tx_s}} :
+                  (dual_s) ? {2'b11, {2{lanes_tx_s}}} : 4'b1101;
 
 
 /* ---------------------------------------------------
@@ -354,48 +452,71 @@ always @(posedge clk_i) begin
 		rx_data_r <= 'b0;
 	end else begin
 		if (clk_div_en_s==1'b1 && clk_div_tc_s && (edge_cnt_r[0]==(clk_pol_s | clk_phase_s))) begin
-			rx_data_r <= (lsb_first) ? {miso_i, rx_data_r[7:1]} : {rx_data_r[6:0], miso_i};
+			if (quad_s) begin
+				rx_data_r <= {rx_data_r[3:0], sio_i[3:0]};
+			end else if (dual_s) begin
+				rx_data_r <= {rx_data_r[5:0], sio_i[1:0]};
+			end else begin
+				rx_data_r <= (lsb_first) ? {sio_i[1], rx_data_r[7:1]} : {rx_data_r[6:0], sio_i[1]};
+			end
 		end
 	end
 end
 
 // RX fifo
-wire rx_fifo_rd_s;
-assign rx_fifo_rd_s = (hs_read_i && hs_addr_i[4:2]==3'd3) ? 1'b1 : 1'b0;
-sync_fifo  #(
-	.DEPTH(FIFO_DEPTH),
-	.DATA_WIDTH(8)
+// A read of the packed data register pops up to 4 bytes, the bytes not present in the fifo are read as 0
+wire rx_fifo_rd_s, rx_fifo_rd_packed_s;
+wire [2:0] rx_fifo_rd_cnt_s;
+assign rx_fifo_rd_s        = ((hs_read_i && hs_addr_i[5:2]==4'd3) || xip_rx_rd_i) ? 1'b1 : 1'b0;
+assign rx_fifo_rd_packed_s = (hs_read_i && hs_addr_i[5:2]==4'd13) ? 1'b1 : 1'b0;
+assign rx_fifo_rd_cnt_s    = (rx_fifo_rd_packed_s) ? 3'd4 : {2'd0, rx_fifo_rd_s};
+byte_fifo  #(
+	.DEPTH(FIFO_DEPTH)
 	)
 	inst_rx_fifo (	
-	// Write port
 	.clk_i(clk_i), 
 	.rst_ni(rst_rx_fifo_s),
-	.wr_en_i(rx_fifo_wr_s),
-  	.wr_data_i(rx_data_r),
+	// Write port
+	.wr_cnt_i({2'd0, rx_fifo_wr_s}),
+  	.wr_data_i({24'd0, rx_data_r}),
 	.full_o(rx_fifo_full_s),
 	// Read port
-  	.rd_en_i(rx_fifo_rd_s),
+  	.rd_cnt_i(rx_fifo_rd_cnt_s),
   	.rd_data_o(rx_fifo_data_o_s),
   	.empty_o(rx_fifo_empty_s),
-	.not_empty_o()
+	.not_empty_o(xip_rx_not_empty_o),
+	.level_o(rx_fifo_level_s)
 );
+assign xip_rx_data_o = rx_fifo_data_o_s[7:0];
 
-// RX fifo fill level counter
-always @(posedge clk_i) begin
-	if(rst_ni == 1'd0) begin
-		rx_fifo_level_r <= 'd0;
-	end else begin
-		if (rst_rx_fifo_s==1'b0) begin
-			// Reset counter when fifo is reset
-			rx_fifo_level_r <='d0;
-		end else if (rx_fifo_wr_s==1'b1 && rx_fifo_rd_s==1'b0) begin
-			// Increase counter if fifo when filled
-			rx_fifo_level_r <= rx_fifo_level_r+1;
-		end else if (rx_fifo_wr_s==1'b0 && rx_fifo_rd_s==1'b1) begin
-			// Increase counter if fifo when emptied
-			rx_fifo_level_r <= rx_fifo_level_r-1;
-		end
-	end
-end
+
+/* ---------------------------------------------------
+* Execute in place interface
+* --------------------------------------------------*/
+// Busy until the last byte has been sent
+assign xip_busy_o = (current_state_r!=IDLE) | tx_fifo_not_empty_s;
+
+// No byte is being transferred (the lanes can be changed when also the TX fifo is empty)
+assign shift_idle_s = (current_state_r==IDLE || current_state_r==HOLD_CS) ? 1'b1 : 1'b0;
+
+/* ---------------------------------------------------
+* DMA requests
+* --------------------------------------------------*/
+// In word mode the requests wait for 4 bytes (or 4 free bytes), to be used with the packed data registers
+assign dma_rx_req_o = ((dma_word_s) ? (rx_fifo_level_s >= 4) : ~rx_fifo_empty_s) & ~xip_en_i;
+assign dma_tx_req_o = ((dma_word_s) ? (FIFO_DEPTH-tx_fifo_level_s >= 4) : ~tx_fifo_full_s) & ~xip_en_i;
+
+
+/* ---------------------------------------------------
+* Interrupts
+* --------------------------------------------------*/
+// Sources are levels, they are cleared by serving the fifos
+// Bit 0: RX fifo level at or above the RX watermark
+// Bit 1: TX fifo level at or below the TX watermark
+// Bit 2: Transfer completed (TX fifo empty and last byte sent)
+assign irq_status_s[0] = (rx_fifo_level_s >= registers_r[10]) ? 1'b1 : 1'b0;
+assign irq_status_s[1] = (tx_fifo_level_s <= registers_r[11]) ? 1'b1 : 1'b0;
+assign irq_status_s[2] = ~xip_busy_o;
+assign irq_o = |(irq_status_s & registers_r[8][2:0]) & ~xip_en_i;
 
 endmodule
@@ -0,0 +1,78 @@
+module spi_xip_arb (
+	input  clk_i,
+	input  rst_ni,
+
+	// Flash readers (0: boot controller, 1: flash window)
+	// Arbitration
+	input  [1:0] req_i,
+	output [1:0] grant_o,
+	output [1:0] release_o,
+	// Direct interfaces to SPI controller
+	input  [1:0] xip_en_i,
+	input  [1:0] xip_cs_hold_i,
+	input  [3:0] xip_lanes_i,
+	input  [1:0] xip_tx_wr_i,
+	input  [15:0] xip_tx_data_i,
+	input  [1:0] xip_rx_rd_i,
+	output [7:0] xip_rx_data_o,
+	output [1:0] xip_rx_not_empty_o,
+	input  [1:0] xip_rx_flush_i,
+	output xip_busy_o,
+
+	// Direct interface towards SPI controller
+	output spi_xip_en_o,
+	output spi_xip_cs_hold_o,
+	output [1:0] spi_xip_lanes_o,
+	output spi_xip_tx_wr_o,
+	output [7:0] spi_xip_tx_data_o,
+	output spi_xip_rx_rd_o,
+	input  [7:0] spi_xip_rx_data_i,
+	input  spi_xip_rx_not_empty_i,
+	output spi_xip_rx_flush_o,
+	input  spi_xip_busy_i
+);
+
+/* ---------------------------------------------------
+* Ownership of the SPI controller
+* --------------------------------------------------*/
+// Reader owning the SPI controller
+reg owner_r;
+// Owner has opened a stream since it got the SPI controller
+reg started_r;
+wire other_req_s;
+assign other_req_s = req_i[~owner_r];
+
+// Ownership passes to the other reader when the owner has no open stream
+//  (a new owner is left to open its stream before being asked to release it)
+always @(posedge clk_i) begin
+	if(rst_ni == 1'd0) begin
+		owner_r   <= 1'b0;
+		started_r <= 1'b0;
+	end else begin
+		if (~xip_en_i[owner_r] && other_req_s && (started_r || ~req_i[owner_r])) begin
+			owner_r   <= ~owner_r;
+			started_r <= 1'b0;
+		end else if (xip_en_i[owner_r]) begin
+			started_r <= 1'b1;
+		end
+	end
+end
+assign grant_o   = (owner_r) ? 2'b10 : 2'b01;
+assign release_o = grant_o & {2{other_req_s & started_r}};
+
+/* ---------------------------------------------------
+* Multiplexing of the direct interfaces
+* --------------------------------------------------*/
+assign spi_xip_en_o       = xip_en_i[owner_r];
+assign spi_xip_cs_hold_o  = xip_cs_hold_i[owner_r];
+assign spi_xip_lanes_o    = xip_lanes_i[owner_r*2 +: 2];
+assign spi_xip_tx_wr_o    = xip_tx_wr_i[owner_r];
+assign spi_xip_tx_data_o  = xip_tx_data_i[owner_r*8 +: 8];
+assign spi_xip_rx_rd_o    = xip_rx_rd_i[owner_r];
+assign spi_xip_rx_flush_o = xip_rx_flush_i[owner_r];
+// Received data is seen only by the owner
+assign xip_rx_data_o      = spi_xip_rx_data_i;
+assign xip_rx_not_empty_o = grant_o & {2{spi_xip_rx_not_empty_i}};
+assign xip_busy_o         = spi_xip_busy_i;
+
+endmodule
@@ -0,0 +1,135 @@
+module axi_tcm #(
+	// Width of the transaction IDs
+	parameter ID_WIDTH=1,
+	// Size of the memory (bytes, power of 2, 0 for no memory)
+	parameter SIZE=1024
+	)(
+	input  clk_i,
+	input  rst_ni,
+
+	//// AXI interface
+	// Read Address (AR) channel
+	input  arvalid_i,
+	output aready_o,
+	input  [31:0] araddr_i,
+	input  [7:0] arlen_i,
+	input  [2:0] arsize_i,
+	input  [1:0] arburst_i,
+	input  [ID_WIDTH-1:0] arid_i,
+
+	// Read Data (R) channel
+	output rvalid_o,
+	input  rready_i,
+	output [31:0] rdata_o,
+	output [1:0] rresp_o,
+	output rlast_o,
+	output [ID_WIDTH-1:0] rid_o,
+
+	// Write Address (AW) channel
+	input  awvalid_i,
+	output awready_o,
+	input  [31:0] awaddr_i,
+	input  [7:0] awlen_i,
+	input  [2:0] awsize_i,
+	input  [1:0] awburst_i,
+	input  [ID_WIDTH-1:0] awid_i,
+
+	// Write Data (W) channel
+	input  wvalid_i,
+	output wready_o,
+	input  [31:0] wdata_i,
+	input  [3:0] wstrb_i,
+	input  wlast_i,
+
+	// Write Response (B) channel
+	output bvalid_o,
+	input  bready_i,
+	output [1:0] bresp_o,
+	output [ID_WIDTH-1:0] bid_o,
+
+	// CPU port, accesses are completed in the same cycle (no wait states)
+	input  cpu_wr_i,
+	input  [31:0] cpu_addr_i,
+	input  [31:0] cpu_data_i,
+	input  [3:0] cpu_byte_select_i,
+	output [31:0] cpu_data_o
+);
+
+wire tcm_rd_en_s, tcm_wr_en_s, tcm_ready_s;
+wire [31:0] tcm_addr_s, tcm_data_o_s, tcm_data_i_s;
+wire [3:0] tcm_byte_select_s;
+
+axi_2_hs #(
+	.ID_WIDTH(ID_WIDTH)
+	)
+	inst_axi_slave (
+	.clk_i(clk_i),
+	.rst_ni(rst_ni),
+	//// AXI interface
+	// Read Address (AR) channel
+	.arvalid_i(arvalid_i),
+	.aready_o(aready_o),
+	.araddr_i(araddr_i),
+	.arlen_i(arlen_i),
+	.arsize_i(arsize_i),
+	.arburst_i(arburst_i),
+	.arid_i(arid_i),
+	// Read Data (R) channel
+	.rvalid_o(rvalid_o),
+	.rready_i(rready_i),
+	.rdata_o(rdata_o),
+	.rresp_o(rresp_o),
+	.rlast_o(rlast_o),
+	.rid_o(rid_o),
+	// Write Address (AW) channel
+	.awvalid_i(awvalid_i),
+	.awready_o(awready_o),
+	.awaddr_i(awaddr_i),
+	.awlen_i(awlen_i),
+	.awsize_i(awsize_i),
+	.awburst_i(awburst_i),
+	.awid_i(awid_i),
+	// Write Data (W) channel
+	.wvalid_i(wvalid_i),
+	.wready_o(wready_o),
+	.wdata_i(wdata_i),
+	.wstrb_i(wstrb_i),
+	.wlast_i(wlast_i),
+	// Write Response (B) channel
+	.bvalid_o(bvalid_o),
+	.bready_i(bready_i),
+	.bresp_o(bresp_o),
+	.bid_o(bid_o),
+	// Handshake interface
+	.hs_read_o(tcm_rd_en_s),
+	.hs_write_o(tcm_wr_en_s),
+	.hs_addr_o(tcm_addr_s),
+	.hs_data_o(tcm_data_i_s),
+	.hs_ready_i(tcm_ready_s),
+	.hs_data_i(tcm_data_o_s),
+	.byte_select_o(tcm_byte_select_s)
+);
+
+tcm #(
+	.SIZE(SIZE)
+	)
+	inst_tcm (
+	.clk_i(clk_i),
+	.rst_ni(rst_ni),
+	// CPU port
+	.cpu_wr_i(cpu_wr_i),
+	.cpu_addr_i(cpu_addr_i),
+	.cpu_data_i(cpu_data_i),
+	.cpu_byte_select_i(cpu_byte_select_i),
+	.cpu_data_o(cpu_data_o),
+	// Handshake interface from bus
+	.hs_read_i(tcm_rd_en_s),
+	.hs_write_i(tcm_wr_en_s),
+	.hs_addr_i(tcm_addr_s),
+	.hs_data_i(tcm_data_i_s),
+	.hs_byte_select_i(tcm_byte_select_s),
+	.hs_ready_o(tcm_ready_s),
+	.hs_data_o(tcm_data_o_s)
+);
+
+endmodule
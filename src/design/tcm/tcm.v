@@ -0,0 +1,62 @@
+module tcm #(
+	// Size of the memory (bytes, power of 2, 0 for no memory)
+	parameter SIZE=1024
+	)(
+	input  clk_i,
+	input  rst_ni,
+
+	// CPU port, accesses are completed in the same cycle (no wait states)
+	input  cpu_wr_i,
+	input  [31:0] cpu_addr_i,
+	input  [31:0] cpu_data_i,
+	input  [3:0] cpu_byte_select_i,
+	output [31:0] cpu_data_o,
+
+	// Handshake interface from bus
+	// Accesses wait while the CPU is writing
+	input  hs_read_i,
+	input  hs_write_i,
+	input  [31:0] hs_addr_i,
+	input  [31:0] hs_data_i,
+	input  [3:0] hs_byte_select_i,
+	output hs_ready_o,
+	output [31:0] hs_data_o
+);
+
+localparam WORDS = SIZE/4;
+localparam ADDR_WIDTH = (WORDS > 1) ? $clog2(WORDS) : 1;
+
+// The CPU has priority over the bus
+wire hs_wr_s;
+assign hs_ready_o = (hs_read_i | hs_write_i) & ~cpu_wr_i;
+assign hs_wr_s    = hs_write_i & ~cpu_wr_i;
+
+generate
+	if (SIZE > 0) begin : gen_mem
+		// Memory registers, read without latency
+		reg [31:0] mem_r [0:WORDS-1];
+		wire [ADDR_WIDTH-1:0] cpu_idx_s, hs_idx_s;
+		assign cpu_idx_s = cpu_addr_i[ADDR_WIDTH+1:2];
+		assign hs_idx_s  = hs_addr_i[ADDR_WIDTH+1:2];
+
+		// Byte writes from the CPU or from the bus
+		integer i;
+		always @(posedge clk_i) begin
+			for (i = 0; i < 4; i = i + 1) begin
+				if (cpu_wr_i && cpu_byte_select_i[i]) begin
+					mem_r[cpu_idx_s][(i*8)+:8] <= cpu_data_i[(i*8)+:8];
+				end else if (hs_wr_s && hs_byte_select_i[i]) begin
+					mem_r[hs_idx_s][(i*8)+:8] <= hs_data_i[(i*8)+:8];
+				end
+			end
+		end
+
+		assign cpu_data_o = mem_r[cpu_idx_s];
+		assign hs_data_o  = mem_r[hs_idx_s];
+	end else begin : gen_no_mem
+		assign cpu_data_o = 32'd0;
+		assign hs_data_o  = 32'd0;
+	end
+endgenerate
+
+endmodule
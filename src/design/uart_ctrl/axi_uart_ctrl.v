@@ -1,4 +1,7 @@
-module axi_uart_ctrl(	
+module axi_uart_ctrl #(
+	// Depth of TX/RX fifos (bytes, power of 2, at least 4)
+	parameter FIFO_DEPTH=16
+	)(	
 	input  clk_i,
 	input  rst_ni,
 
@@ -30,6 +33,13 @@ module axi_uart_ctrl(
 	input  bready_i,
 	output [1:0] bresp_o,
 
+	// DMA requests
+	output dma_rx_req_o,
+	output dma_tx_req_o,
+
+	// Interrupt request
+	output irq_o,
+
 	//// UART interface
 	input  rx_i,
 	output tx_o
@@ -37,7 +47,8 @@ module axi_uart_ctrl(
 
 wire uart_rd_en_s, uart_wr_en_s, uart_ready_s;
 wire [31:0] uart_addr_s, uart_data_i_s;
-wire [7:0] uart_data_o_s;
+wire [31:0] uart_data_o_s;
+wire [3:0] uart_byte_select_s;
 
 axi_2_hs inst_axi_slave (
 	.clk_i(clk_i),
@@ -47,44 +58,65 @@ axi_2_hs inst_axi_slave (
 	.arvalid_i(arvalid_i),
 	.aready_o(aready_o),
 	.araddr_i(araddr_i),
+	.arlen_i(8'd0),
+	.arsize_i(3'd2),
+	.arburst_i(2'b01),
+	.arid_i(1'b0),
 	// Read Data (R) channel
 	.rvalid_o(rvalid_o),
 	.rready_i(rready_i),
 	.rdata_o(rdata_o),
 	.rresp_o(rresp_o),
+	.rlast_o(),
+	.rid_o(),
 	// Write Address (AW) channel
 	.awvalid_i(awvalid_i),
 	.awready_o(awready_o),
 	.awaddr_i(awaddr_i),
+	.awlen_i(8'd0),
+	.awsize_i(3'd2),
+	.awburst_i(2'b01),
+	.awid_i(1'b0),
 	// Write Data (W) channel
 	.wvalid_i(wvalid_i),
 	.wready_o(wready_o),
 	.wdata_i(wdata_i),
 	.wstrb_i(wstrb_i),
+	.wlast_i(1'b1),
 	// Write Response (B) channel
 	.bvalid_o(bvalid_o),
 	.bready_i(bready_i),
 	.bresp_o(bresp_o),
+	.bid_o(),
 	// Handshake interface
 	.hs_read_o(uart_rd_en_s),
 	.hs_write_o(uart_wr_en_s),
 	.hs_addr_o(uart_addr_s),
 	.hs_data_o(uart_data_i_s),
 	.hs_ready_i(uart_ready_s),
-	.hs_data_i({24'd0, uart_data_o_s}),
-	.byte_select_o()
+	.hs_data_i(uart_data_o_s),
+	.byte_select_o(uart_byte_select_s)
 );
 
-uart_ctrl inst_uart(	
+uart_ctrl #(
+	.FIFO_DEPTH(FIFO_DEPTH)
+	)
+	inst_uart(	
 	.clk_i(clk_i),
 	.rst_ni(rst_ni),
 	// Handshake interface
 	.hs_read_i(uart_rd_en_s),
 	.hs_write_i(uart_wr_en_s),
-	.hs_addr_i(uart_addr_s[4:0]),
-	.hs_data_i(uart_data_i_s[7:0]),
+	.hs_addr_i(uart_addr_s[5:0]),
+	.hs_data_i(uart_data_i_s),
+	.hs_byte_select_i(uart_byte_select_s),
 	.hs_ready_o(uart_ready_s),
 	.hs_data_o(uart_data_o_s),
+	// DMA requests
+	.dma_rx_req_o(dma_rx_req_o),
+	.dma_tx_req_o(dma_tx_req_o),
+	// Interrupt request
+	.irq_o(irq_o),
 	//// UART interface
 	.rx_i(rx_i),
 	.tx_o(tx_o)
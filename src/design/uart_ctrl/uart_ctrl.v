@@ -1,4 +1,5 @@
 module uart_ctrl #(
+	// Depth of TX/RX fifos (bytes, power of 2, at least 4)
 	parameter FIFO_DEPTH=16
 	)(	
 	input  clk_i,
@@ -7,10 +8,19 @@ module uart_ctrl #(
 	// Handshake interface
 	input  hs_read_i,
 	input  hs_write_i,
-	input  [4:0] hs_addr_i,
-	input  [7:0] hs_data_i,
+	input  [5:0] hs_addr_i,
+	input  [31:0] hs_data_i,
+	input  [3:0] hs_byte_select_i,
 	output hs_ready_o,
-	output [7:0] hs_data_o,
+	output [31:0] hs_data_o,
+
+	// DMA requests
+	// RX: data available in RX fifo, TX: room available in TX fifo (4 bytes in word mode)
+	output dma_rx_req_o,
+	output dma_tx_req_o,
+
+	// Interrupt request (level)
+	output irq_o,
 
 	//// UART interface
 	input  rx_i,
@@ -20,14 +30,19 @@ module uart_ctrl #(
 /* ---------------------------------------------------
 * Register Access Section
 * --------------------------------------------------*/
-wire [7:0] rx_fifo_data_o_s;
+wire [31:0] rx_fifo_data_o_s;
 // Status register signals
 reg overrun_error_r, rx_frame_error_r;
 wire tx_fifo_full_s, tx_fifo_empty_s, rx_fifo_full_s, rx_fifo_not_empty_s;
 // Controll register signals
-wire rst_tx_fifo_s, rst_rx_fifo_s;
+wire rst_tx_fifo_s, rst_rx_fifo_s, dma_word_s;
 // Clock divider
 wire [15:0] clk_div_s;
+// FIFO levels
+localparam LEVEL_WIDTH = $clog2(FIFO_DEPTH)+1;
+wire [LEVEL_WIDTH-1:0] tx_fifo_level_s, rx_fifo_level_s;
+// Interrupt sources
+wire [3:0] irq_status_s;
 
 //// Register access
 // Reg_0 (0x00): RX fifo data (RO)
@@ -36,7 +51,15 @@ wire [15:0] clk_div_s;
 // Reg_3 (0x0C): Ctrl reg     (RW)
 // Reg_4 (0x10): Clk_div low  (RW)
 // Reg_5 (0x14): Clk_div high (RW)
-reg [7:0] registers_r [0:5];
+// Reg_6 (0x18): Irq enable   (RW)
+// Reg_7 (0x1C): Irq status   (RO)
+// Reg_8 (0x20): RX watermark (RW)
+// Reg_9 (0x24): TX watermark (RW)
+// 0x28: TX fifo level             (RO)
+// 0x2C: RX fifo level             (RO)
+// 0x30: TX fifo packed data (WO, each byte enabled by the byte select is pushed, from the lowest one)
+// 0x34: RX fifo packed data (RO, up to 4 bytes are popped, the oldest in the lowest byte)
+reg [7:0] registers_r [0:9];
 
 always @(posedge clk_i) begin
     if (rst_ni == 0) begin
@@ -45,10 +68,14 @@ always @(posedge clk_i) begin
 		// Minimum value for 8x oversampling
 		registers_r[4] <= 8'h08;
 		registers_r[5] <= 8'h00;
+		registers_r[6] <= 8'h00;
+		// Interrupt when RX fifo is not empty, or when TX fifo is empty
+		registers_r[8] <= 8'h01;
+		registers_r[9] <= 8'h00;
     end else begin
         // Writing in the registers
-        if (hs_write_i == 1) begin
-            registers_r[hs_addr_i[4:2]] <= hs_data_i;
+        if (hs_write_i == 1 && hs_addr_i[5:2] <= 4'd9) begin
+            registers_r[hs_addr_i[5:2]] <= hs_data_i[7:0];
         end
 
 		// Self clearing bits
@@ -56,19 +83,25 @@ always @(posedge clk_i) begin
 		registers_r[3][1] <= (registers_r[3][1]) ? 1'b0 : registers_r[3][1];
     end
 	// Register 0 is read-only (RX fifo data)
-	registers_r[0] <= rx_fifo_data_o_s;
+	registers_r[0] <= rx_fifo_data_o_s[7:0];
 	// Register 1 is write only (TX fifo data), always read 0 back
 	registers_r[1] <= 8'd0;
 	// Register 2 is read-only (Status reg)
 	registers_r[2] <= {1'b0, rx_frame_error_r, overrun_error_r, 1'b0, tx_fifo_full_s, tx_fifo_empty_s, rx_fifo_full_s, rx_fifo_not_empty_s};
+	// Register 7 is read-only (Irq status)
+	registers_r[7] <= {4'd0, irq_status_s};
 end
 // Signals from ctrl register
 assign rst_tx_fifo_s = (rst_ni && ~registers_r[3][0]);
 assign rst_rx_fifo_s = (rst_ni && ~registers_r[3][1]);
+assign dma_word_s    = registers_r[3][2];
 // Values from clock divider registers
 assign clk_div_s = {registers_r[5], registers_r[4]};
 //Output for register access
-assign hs_data_o = registers_r[hs_addr_i[4:2]];
+assign hs_data_o = (hs_addr_i[5:2] == 4'd10) ? tx_fifo_level_s  :
+                   (hs_addr_i[5:2] == 4'd11) ? rx_fifo_level_s  :
+                   (hs_addr_i[5:2] == 4'd13) ? rx_fifo_data_o_s :
+                   (hs_addr_i[5:2] <= 4'd9)  ? {24'd0, registers_r[hs_addr_i[5:2]]} : 32'd0;
 // Latency of register access is 0
 assign hs_ready_o = 1'b1;
 
@@ -78,25 +111,43 @@ assign hs_ready_o = 1'b1;
 * --------------------------------------------------*/
 //// TX fifo
 reg tx_fifo_rd_s;
-wire tx_fifo_wr_s, tx_fifo_not_empty_s;
-assign tx_fifo_wr_s = (hs_write_i && hs_addr_i[4:2]==3'd1) ? 1'b1 : 1'b0;
-wire [7:0] tx_fifo_data_o_s;
-sync_fifo  #(
-	.DEPTH(FIFO_DEPTH),
-	.DATA_WIDTH(8)
+wire tx_fifo_wr_s, tx_fifo_wr_packed_s, tx_fifo_not_empty_s;
+assign tx_fifo_wr_s        = (hs_write_i && hs_addr_i[5:2]==4'd1) ? 1'b1 : 1'b0;
+assign tx_fifo_wr_packed_s = (hs_write_i && hs_addr_i[5:2]==4'd12) ? 1'b1 : 1'b0;
+// Bytes enabled by the byte select are packed starting from the lowest one
+reg [2:0] tx_packed_cnt_s;
+reg [31:0] tx_packed_data_s;
+integer k;
+always @(*) begin
+	tx_packed_cnt_s  = 3'd0;
+	tx_packed_data_s = 32'd0;
+	for (k=0; k<4; k=k+1) begin
+		if (hs_byte_select_i[k]) begin
+			tx_packed_data_s[tx_packed_cnt_s*8 +: 8] = hs_data_i[k*8 +: 8];
+			tx_packed_cnt_s = tx_packed_cnt_s + 3'd1;
+		end
+	end
+end
+wire [2:0] tx_fifo_wr_cnt_s;
+assign tx_fifo_wr_cnt_s = (tx_fifo_wr_packed_s) ? tx_packed_cnt_s : {2'd0, tx_fifo_wr_s};
+wire [31:0] tx_fifo_data_i_s, tx_fifo_data_o_s;
+assign tx_fifo_data_i_s = (tx_fifo_wr_packed_s) ? tx_packed_data_s : hs_data_i;
+byte_fifo  #(
+	.DEPTH(FIFO_DEPTH)
 	)
 	inst_tx_fifo (	
-	// Write port
 	.clk_i(clk_i), 
 	.rst_ni(rst_tx_fifo_s),
-	.wr_en_i(tx_fifo_wr_s),
-  	.wr_data_i(hs_data_i),
+	// Write port
+	.wr_cnt_i(tx_fifo_wr_cnt_s),
+  	.wr_data_i(tx_fifo_data_i_s),
 	.full_o(tx_fifo_full_s),
 	// Read port
-  	.rd_en_i(tx_fifo_rd_s),
+  	.rd_cnt_i({2'd0, tx_fifo_rd_s}),
   	.rd_data_o(tx_fifo_data_o_s),
   	.empty_o(tx_fifo_empty_s),
-	.not_empty_o(tx_fifo_not_empty_s)
+	.not_empty_o(tx_fifo_not_empty_s),
+	.level_o(tx_fifo_level_s)
 );
 
 
@@ -272,32 +323,36 @@ reg [2:0] rx_bit_cnt_r;
 wire rx_bit_cnt_tc_s;
 
 // RX FIFO
-wire rx_fifo_rd_s;
-assign rx_fifo_rd_s = (hs_read_i && hs_addr_i[4:2]==3'd0) ? 1'b1 : 1'b0;
+// A read of the packed data register pops up to 4 bytes, the bytes not present in the fifo are read as 0
+wire rx_fifo_rd_s, rx_fifo_rd_packed_s;
+wire [2:0] rx_fifo_rd_cnt_s;
+assign rx_fifo_rd_s        = (hs_read_i && hs_addr_i[5:2]==4'd0) ? 1'b1 : 1'b0;
+assign rx_fifo_rd_packed_s = (hs_read_i && hs_addr_i[5:2]==4'd13) ? 1'b1 : 1'b0;
+assign rx_fifo_rd_cnt_s    = (rx_fifo_rd_packed_s) ? 3'd4 : {2'd0, rx_fifo_rd_s};
 reg rx_fifo_wr_s;
 reg rx_fifo_data_sh_en_s;
 reg [7:0] rx_fifo_data_r;
-sync_fifo  #(
-	.DEPTH(FIFO_DEPTH),
-	.DATA_WIDTH(8)
+byte_fifo  #(
+	.DEPTH(FIFO_DEPTH)
 	)
 	inst_rx_fifo (	
-	// Write port
 	.clk_i(clk_i), 
 	.rst_ni(rst_rx_fifo_s),
-	.wr_en_i(rx_fifo_wr_s),
-  	.wr_data_i(rx_fifo_data_r),
+	// Write port
+	.wr_cnt_i({2'd0, rx_fifo_wr_s}),
+  	.wr_data_i({24'd0, rx_fifo_data_r}),
 	.full_o(rx_fifo_full_s),
 	// Read port
-  	.rd_en_i(rx_fifo_rd_s),
+  	.rd_cnt_i(rx_fifo_rd_cnt_s),
   	.rd_data_o(rx_fifo_data_o_s),
   	.empty_o(),
-	.not_empty_o(rx_fifo_not_empty_s)
+	.not_empty_o(rx_fifo_not_empty_s),
+	.level_o(rx_fifo_level_s)
 );
 
 // RX fifo overrun error flag
 wire overrun_error_clr_s;
-assign overrun_error_clr_s = (hs_read_i && hs_addr_i[4:2]==3'd2) ? 1'b1 : 1'b0;
+assign overrun_error_clr_s = (hs_read_i && hs_addr_i[5:2]==4'd2) ? 1'b1 : 1'b0;
 always @(posedge clk_i) begin
     if (rst_ni == 1'd0) begin
     	overrun_error_r <= 1'b0;
@@ -315,7 +370,7 @@ end
 // RX frame error flag
 reg rx_frame_err_set_s;
 wire rx_frame_error_clr_s;
-assign rx_frame_error_clr_s = (hs_read_i && hs_addr_i[4:2]==3'd2) ? 1'b1 : 1'b0;
+assign rx_frame_error_clr_s = (hs_read_i && hs_addr_i[5:2]==4'd2) ? 1'b1 : 1'b0;
 always @(posedge clk_i) begin
     if (rst_ni == 1'd0) begin
     	rx_frame_error_r <= 1'b0;
@@ -546,4 +601,25 @@ always @(posedge clk_i) begin
 end
 assign rx_bit_cnt_tc_s = (rx_bit_cnt_r==3'd7) ? 1'b1: 1'b0;
 
+/* ---------------------------------------------------
+* Interrupts
+* --------------------------------------------------*/
+// Sources are levels, they are cleared by serving the fifos or reading the status register (errors)
+// Bit 0: RX fifo level at or above the RX watermark
+// Bit 1: TX fifo level at or below the TX watermark
+// Bit 2: Transmission completed (TX fifo empty and last frame sent)
+// Bit 3: RX error (overrun or frame error)
+assign irq_status_s[0] = (rx_fifo_level_s >= registers_r[8]) ? 1'b1 : 1'b0;
+assign irq_status_s[1] = (tx_fifo_level_s <= registers_r[9]) ? 1'b1 : 1'b0;
+assign irq_status_s[2] = tx_fifo_empty_s & (tx_current_state_r == TX_IDLE);
+assign irq_status_s[3] = overrun_error_r | rx_frame_error_r;
+assign irq_o = |(irq_status_s & registers_r[6][3:0]);
+
+/* ---------------------------------------------------
+* DMA requests
+* --------------------------------------------------*/
+// In word mode the requests wait for 4 bytes (or 4 free bytes), to be used with the packed data registers
+assign dma_rx_req_o = (dma_word_s) ? (rx_fifo_level_s >= 4) : rx_fifo_not_empty_s;
+assign dma_tx_req_o = (dma_word_s) ? (FIFO_DEPTH-tx_fifo_level_s >= 4) : ~tx_fifo_full_s;
+
 endmodule
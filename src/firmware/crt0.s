@@ -8,6 +8,32 @@ _start:
     la gp, __global_pointer
     la sp, __stack_top
     .option pop
+
+    # Copy code and data of the tightly-coupled memories from their load address
+    la t0, __itcm_load
+    la t1, __itcm_start
+    la t2, __itcm_end
+1:
+    bgeu t1, t2, 2f
+    lw t3, 0(t0)
+    sw t3, 0(t1)
+    addi t0, t0, 4
+    addi t1, t1, 4
+    j 1b
+2:
+    la t0, __dtcm_load
+    la t1, __dtcm_start
+    la t2, __dtcm_end
+3:
+    bgeu t1, t2, 4f
+    lw t3, 0(t0)
+    sw t3, 0(t1)
+    addi t0, t0, 4
+    addi t1, t1, 4
+    j 3b
+4:
+    # Wait until the ITCM has been written before fetching from it
+    fence
     
     # Go to main
     jal ra, main
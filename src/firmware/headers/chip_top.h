@@ -5,9 +5,22 @@
 #define CPU_INTERFACE_BASE_ADDR (unsigned char*)0x00010000
 #define UART_BASE_ADDR          (unsigned char*)0x00010100
 #define SPI_MASTER_BASE_ADDR    (unsigned char*)0x00010200
+#define DMA_BASE_ADDR           (unsigned char*)0x00010300
+#define IRQ_CTRL_BASE_ADDR      (unsigned char*)0x00010400
+#define SPI_FLASH_BASE_ADDR     (unsigned char*)0x20000000
+// Base address of the tightly-coupled memories (size set by ITCM_SIZE/DTCM_SIZE of chip_top)
+#define ITCM_BASE_ADDR          (unsigned char*)0x00100000
+#define DTCM_BASE_ADDR          (unsigned char*)0x00200000
+
+// Place a function in the ITCM or a variable in the DTCM (zero wait states)
+#define ITCM_CODE __attribute__((section(".itcm"), noinline))
+#define DTCM_DATA __attribute__((section(".dtcm")))
 
 // Dereference of memory address (use word address)
 #define REG_ADDR(addr) *((volatile unsigned int*)(addr))
 
+// Wait until all previous stores have been written to memory (drain of the store buffer)
+#define FENCE() __asm__ volatile ("fence" ::: "memory")
+
 #endif // CHIP_TOP_H
 
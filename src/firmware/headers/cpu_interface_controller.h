@@ -9,28 +9,85 @@
 #define CPU_INTERFACE_STATUS_REGISTER  REG_ADDR(CPU_INTERFACE_BASE_ADDR + 0x4)
 #define CPU_INTERFACE_START_ADDRESS    REG_ADDR(CPU_INTERFACE_BASE_ADDR + 0x8)
 #define CPU_INTERFACE_STOP_ADDRESS     REG_ADDR(CPU_INTERFACE_BASE_ADDR + 0xC)
+#define CPU_INTERFACE_ICACHE_HITS      REG_ADDR(CPU_INTERFACE_BASE_ADDR + 0x10)
+#define CPU_INTERFACE_ICACHE_MISSES    REG_ADDR(CPU_INTERFACE_BASE_ADDR + 0x14)
+#define CPU_INTERFACE_DCACHE_HITS      REG_ADDR(CPU_INTERFACE_BASE_ADDR + 0x18)
+#define CPU_INTERFACE_DCACHE_MISSES    REG_ADDR(CPU_INTERFACE_BASE_ADDR + 0x1C)
+#define CPU_INTERFACE_DCACHE_WRITEBACKS REG_ADDR(CPU_INTERFACE_BASE_ADDR + 0x20)
+#define CPU_INTERFACE_SPI_READ_CONFIG  REG_ADDR(CPU_INTERFACE_BASE_ADDR + 0x24)
+#define CPU_INTERFACE_BP_HITS          REG_ADDR(CPU_INTERFACE_BASE_ADDR + 0x28)
+#define CPU_INTERFACE_BP_MISSES        REG_ADDR(CPU_INTERFACE_BASE_ADDR + 0x2C)
+#define CPU_INTERFACE_COPY_BYTES       REG_ADDR(CPU_INTERFACE_BASE_ADDR + 0x30)
+#define CPU_INTERFACE_COPY_CYCLES      REG_ADDR(CPU_INTERFACE_BASE_ADDR + 0x34)
+// BUS QoS statistics of master m (0:CPU instruction, 1:CPU data, 2:DMA)
+#define CPU_INTERFACE_BUS_TRANSACTIONS(m) REG_ADDR(CPU_INTERFACE_BASE_ADDR + 0x40 + 0x10*(m))
+#define CPU_INTERFACE_BUS_LATENCY(m)      REG_ADDR(CPU_INTERFACE_BASE_ADDR + 0x44 + 0x10*(m))
+#define CPU_INTERFACE_BUS_MAX_WAIT(m)     REG_ADDR(CPU_INTERFACE_BASE_ADDR + 0x48 + 0x10*(m))
 
 //// CPU_INTERFACE_CONTROL_REGISTER
 // control_register fields masks
-#define CPU_INTERFACE_CONTROL_START_COPY_M (0x1)
-#define CPU_INTERFACE_CONTROL_DEST_M       (0x2)
+#define CPU_INTERFACE_CONTROL_START_COPY_M   (0x1)
+#define CPU_INTERFACE_CONTROL_DEST_M         (0x2)
+#define CPU_INTERFACE_CONTROL_ICACHE_INV_M   (0x4)
+#define CPU_INTERFACE_CONTROL_ICACHE_CLR_M   (0x8)
+#define CPU_INTERFACE_CONTROL_DCACHE_CLEAN_M (0x10)
+#define CPU_INTERFACE_CONTROL_DCACHE_FLUSH_M (0x20)
+#define CPU_INTERFACE_CONTROL_DCACHE_CLR_M   (0x40)
+#define CPU_INTERFACE_CONTROL_BUS_STAT_CLR_M (0x80)
+#define CPU_INTERFACE_CONTROL_BP_CLR_M       (0x100)
+#define CPU_INTERFACE_CONTROL_COPY_ITCM_M    (0x200)
 // control_register fields set
 #define CPU_INTERFACE_CONTROL_START_COPY_S(val) (val << 0)
 #define CPU_INTERFACE_CONTROL_DEST_S(val)       (val << 1)
+#define CPU_INTERFACE_CONTROL_ICACHE_INV_S(val) (val << 2)
+#define CPU_INTERFACE_CONTROL_ICACHE_CLR_S(val) (val << 3)
+#define CPU_INTERFACE_CONTROL_DCACHE_CLEAN_S(val) (val << 4)
+#define CPU_INTERFACE_CONTROL_DCACHE_FLUSH_S(val) (val << 5)
+#define CPU_INTERFACE_CONTROL_DCACHE_CLR_S(val)   (val << 6)
+#define CPU_INTERFACE_CONTROL_BUS_STAT_CLR_S(val) (val << 7)
+#define CPU_INTERFACE_CONTROL_BP_CLR_S(val)       (val << 8)
+#define CPU_INTERFACE_CONTROL_COPY_ITCM_S(val)    (val << 9)
 // control_register fields get
 #define CPU_INTERFACE_CONTROL_START_COPY_G(val) ((val & CPU_INTERFACE_CONTROL_START_COPY_M) >> 0)
 #define CPU_INTERFACE_CONTROL_DEST_G(val)       ((val & CPU_INTERFACE_CONTROL_DEST_M) >> 1)
+#define CPU_INTERFACE_CONTROL_ICACHE_INV_G(val) ((val & CPU_INTERFACE_CONTROL_ICACHE_INV_M) >> 2)
+#define CPU_INTERFACE_CONTROL_ICACHE_CLR_G(val) ((val & CPU_INTERFACE_CONTROL_ICACHE_CLR_M) >> 3)
+#define CPU_INTERFACE_CONTROL_DCACHE_CLEAN_G(val) ((val & CPU_INTERFACE_CONTROL_DCACHE_CLEAN_M) >> 4)
+#define CPU_INTERFACE_CONTROL_DCACHE_FLUSH_G(val) ((val & CPU_INTERFACE_CONTROL_DCACHE_FLUSH_M) >> 5)
+#define CPU_INTERFACE_CONTROL_DCACHE_CLR_G(val)   ((val & CPU_INTERFACE_CONTROL_DCACHE_CLR_M) >> 6)
+#define CPU_INTERFACE_CONTROL_BUS_STAT_CLR_G(val) ((val & CPU_INTERFACE_CONTROL_BUS_STAT_CLR_M) >> 7)
+#define CPU_INTERFACE_CONTROL_BP_CLR_G(val)       ((val & CPU_INTERFACE_CONTROL_BP_CLR_M) >> 8)
+#define CPU_INTERFACE_CONTROL_COPY_ITCM_G(val)    ((val & CPU_INTERFACE_CONTROL_COPY_ITCM_M) >> 9)
 
 //// CPU_INTERFACE_STATUS_REGISTER
 // status_register fields masks
 #define CPU_INTERFACE_STATUS_EXECUTING_M   (0x1)
 #define CPU_INTERFACE_STATUS_BOOT_SOURCE_M (0x6)
+#define CPU_INTERFACE_STATUS_DCACHE_BUSY_M (0x8)
+#define CPU_INTERFACE_STATUS_COPY_BUSY_M   (0x10)
 // status_register fields set
 #define CPU_INTERFACE_STATUS_EXECUTING_S(val)   (val << 0)
 #define CPU_INTERFACE_STATUS_BOOT_SOURCE_S(val) (val << 1)
+#define CPU_INTERFACE_STATUS_DCACHE_BUSY_S(val) (val << 3)
+#define CPU_INTERFACE_STATUS_COPY_BUSY_S(val)   (val << 4)
 // status_register fields get
 #define CPU_INTERFACE_STATUS_EXECUTING_G(val)   ((val & CPU_INTERFACE_STATUS_EXECUTING_M) >> 0)
 #define CPU_INTERFACE_STATUS_BOOT_SOURCE_G(val) ((val & CPU_INTERFACE_STATUS_BOOT_SOURCE_M) >> 1)
+#define CPU_INTERFACE_STATUS_DCACHE_BUSY_G(val) ((val & CPU_INTERFACE_STATUS_DCACHE_BUSY_M) >> 3)
+#define CPU_INTERFACE_STATUS_COPY_BUSY_G(val)   ((val & CPU_INTERFACE_STATUS_COPY_BUSY_M) >> 4)
+
+//// CPU_INTERFACE_SPI_READ_CONFIG
+// Flash read commands
+#define CPU_INTERFACE_SPI_READ       (0x0)
+#define CPU_INTERFACE_SPI_FAST_READ  (0x1)
+#define CPU_INTERFACE_SPI_DUAL_READ  (0x2)
+#define CPU_INTERFACE_SPI_QUAD_READ  (0x3)
+// spi_read_config fields masks
+#define CPU_INTERFACE_SPI_READ_MODE_M (0x3)
+// spi_read_config fields set
+#define CPU_INTERFACE_SPI_READ_MODE_S(val) (val << 0)
+// spi_read_config fields get
+#define CPU_INTERFACE_SPI_READ_MODE_G(val) ((val & CPU_INTERFACE_SPI_READ_MODE_M) >> 0)
 
 #endif // CPU_INTERFACE_CONTROLLER_H
 
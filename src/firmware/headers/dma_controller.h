@@ -0,0 +1,68 @@
+#ifndef DMA_CONTROLLER_H
+#define DMA_CONTROLLER_H
+
+// Include base addresses and macros
+#include "chip_top.h"
+
+// Number of channels
+#define DMA_N_CH 4
+
+// Register addresses
+#define DMA_STATUS_REGISTER  REG_ADDR(DMA_BASE_ADDR + 0x00)
+#define DMA_REQUEST_REGISTER REG_ADDR(DMA_BASE_ADDR + 0x04)
+// Channel registers (ch from 0 to DMA_N_CH-1)
+#define DMA_CH_SRC_ADDR(ch)  REG_ADDR(DMA_BASE_ADDR + 0x20*((ch)+1) + 0x00)
+#define DMA_CH_DST_ADDR(ch)  REG_ADDR(DMA_BASE_ADDR + 0x20*((ch)+1) + 0x04)
+#define DMA_CH_COUNT(ch)     REG_ADDR(DMA_BASE_ADDR + 0x20*((ch)+1) + 0x08)
+#define DMA_CH_CONFIG(ch)    REG_ADDR(DMA_BASE_ADDR + 0x20*((ch)+1) + 0x0C)
+#define DMA_CH_NEXT(ch)      REG_ADDR(DMA_BASE_ADDR + 0x20*((ch)+1) + 0x10)
+
+//// DMA_STATUS_REGISTER
+// status_register fields masks (done bits are cleared writing 1)
+#define DMA_STATUS_DONE_M (0x0000000F)
+#define DMA_STATUS_BUSY_M (0x000F0000)
+// status_register fields value set
+#define DMA_STATUS_DONE_S(val) (val << 0)
+// status_register fields value get
+#define DMA_STATUS_DONE_G(val) ((val & DMA_STATUS_DONE_M) >> 0)
+#define DMA_STATUS_BUSY_G(val) ((val & DMA_STATUS_BUSY_M) >> 16)
+
+//// DMA_CH_CONFIG
+// config fields masks
+#define DMA_CONFIG_EN_M      (0x01)
+#define DMA_CONFIG_SRC_INC_M (0x02)
+#define DMA_CONFIG_DST_INC_M (0x04)
+#define DMA_CONFIG_BYTE_M    (0x08)
+#define DMA_CONFIG_SRC_REQ_M (0x30)
+#define DMA_CONFIG_DST_REQ_M (0xC0)
+// config fields value set
+#define DMA_CONFIG_EN_S(val)      (val << 0)
+#define DMA_CONFIG_SRC_INC_S(val) (val << 1)
+#define DMA_CONFIG_DST_INC_S(val) (val << 2)
+#define DMA_CONFIG_BYTE_S(val)    (val << 3)
+#define DMA_CONFIG_SRC_REQ_S(val) (val << 4)
+#define DMA_CONFIG_DST_REQ_S(val) (val << 6)
+// config fields value get
+#define DMA_CONFIG_EN_G(val)      ((val & DMA_CONFIG_EN_M) >> 0)
+#define DMA_CONFIG_SRC_INC_G(val) ((val & DMA_CONFIG_SRC_INC_M) >> 1)
+#define DMA_CONFIG_DST_INC_G(val) ((val & DMA_CONFIG_DST_INC_M) >> 2)
+#define DMA_CONFIG_BYTE_G(val)    ((val & DMA_CONFIG_BYTE_M) >> 3)
+#define DMA_CONFIG_SRC_REQ_G(val) ((val & DMA_CONFIG_SRC_REQ_M) >> 4)
+#define DMA_CONFIG_DST_REQ_G(val) ((val & DMA_CONFIG_DST_REQ_M) >> 6)
+
+// Request lines (source: data available, destination: room available)
+#define DMA_REQ_MEMORY 0
+#define DMA_REQ_UART   1
+#define DMA_REQ_SPI    2
+
+// Descriptor in memory (word aligned), loaded when the count of the channel reaches zero
+//   the channel stays enabled until a descriptor with next=0 is completed
+typedef struct {
+    unsigned int src;
+    unsigned int dst;
+    unsigned int count;
+    unsigned int config;
+    unsigned int next;
+} dma_descriptor_t;
+
+#endif // DMA_CONTROLLER_H
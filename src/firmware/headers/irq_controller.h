@@ -0,0 +1,55 @@
+#ifndef IRQ_CONTROLLER_H
+#define IRQ_CONTROLLER_H
+
+// Include base addresses and macros
+#include "chip_top.h"
+// Include CSR access macros
+#include "perf_counters.h"
+
+// Number of interrupt sources (source 0 is reserved)
+#define IRQ_N_SRC 8
+
+// Register addresses
+#define IRQ_PENDING_REGISTER   REG_ADDR(IRQ_CTRL_BASE_ADDR + 0x00)
+#define IRQ_ENABLE_REGISTER    REG_ADDR(IRQ_CTRL_BASE_ADDR + 0x04)
+#define IRQ_THRESHOLD_REGISTER REG_ADDR(IRQ_CTRL_BASE_ADDR + 0x08)
+#define IRQ_CLAIM_REGISTER     REG_ADDR(IRQ_CTRL_BASE_ADDR + 0x0C)
+#define IRQ_SOFTWARE_REGISTER  REG_ADDR(IRQ_CTRL_BASE_ADDR + 0x10)
+// Priority of source src (from 1 to IRQ_N_SRC-1, 0 disables the source)
+#define IRQ_PRIORITY(src)      REG_ADDR(IRQ_CTRL_BASE_ADDR + 0x20 + 0x4*(src))
+
+// Interrupt sources
+#define IRQ_SRC_UART 1
+#define IRQ_SRC_SPI  2
+#define IRQ_SRC_DMA  3
+
+//// CPU trap registers
+// mstatus fields masks
+#define MSTATUS_MIE_M  (0x8)
+#define MSTATUS_MPIE_M (0x80)
+// mie/mip fields masks
+#define MIE_MSIE_M (0x8)
+#define MIE_MTIE_M (0x80)
+#define MIE_MEIE_M (0x800)
+// mcause fields
+#define MCAUSE_IRQ_M       (0x80000000)
+#define MCAUSE_CODE_M      (0x0000000F)
+#define MCAUSE_SOFTWARE    3
+#define MCAUSE_TIMER       7
+#define MCAUSE_EXTERNAL    11
+// mtvec modes (in vectored mode the handler of interrupt code is at base+4*code)
+#define MTVEC_DIRECT   0
+#define MTVEC_VECTORED 1
+
+// Set/clear bits of a control and status register
+#define CSR_SET(csr, val)   __asm__ volatile ("csrs " #csr ", %0" :: "r"(val))
+#define CSR_CLEAR(csr, val) __asm__ volatile ("csrc " #csr ", %0" :: "r"(val))
+
+// Installation of the trap handler (function declared with __attribute__((interrupt("machine"), aligned(4))),
+//   the two lowest bits of mtvec select the mode)
+#define IRQ_SET_HANDLER(handler) CSR_WRITE(mtvec, ((unsigned int)(handler) & ~0x3) | MTVEC_DIRECT)
+// Global enable/disable of the interrupts
+#define IRQ_GLOBAL_ENABLE()  CSR_SET(mstatus, MSTATUS_MIE_M)
+#define IRQ_GLOBAL_DISABLE() CSR_CLEAR(mstatus, MSTATUS_MIE_M)
+
+#endif // IRQ_CONTROLLER_H
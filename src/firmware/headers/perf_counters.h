@@ -0,0 +1,65 @@
+#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+
+// Read of a control and status register (use the register name, e.g. CSR_READ(mcycle))
+#define CSR_READ(csr) ({ unsigned int __csr_val; __asm__ volatile ("csrr %0, " #csr : "=r"(__csr_val)); __csr_val; })
+// Write of a control and status register
+#define CSR_WRITE(csr, val) __asm__ volatile ("csrw " #csr ", %0" :: "r"(val))
+// Read of a 64-bit counter (high half is read again if the low half has wrapped around)
+#define CSR_READ64(csr, csrh) ({ \
+    unsigned int __csr_hi, __csr_lo; \
+    do { \
+        __csr_hi = CSR_READ(csrh); \
+        __csr_lo = CSR_READ(csr); \
+    } while (__csr_hi != CSR_READ(csrh)); \
+    ((unsigned long long)__csr_hi << 32) | __csr_lo; })
+
+//// Counters (lower 32 bits)
+// Clock cycles
+#define PERF_CYCLE()         CSR_READ(cycle)
+// Retired instructions
+#define PERF_INSTRET()       CSR_READ(instret)
+// Stall cycles by cause
+// Decode waiting for the instruction memory
+#define PERF_INSTR_WAIT()    CSR_READ(hpmcounter3)
+// Pipeline waiting for a load/store/fence
+#define PERF_DATA_WAIT()     CSR_READ(hpmcounter4)
+// Bubble inserted after a load whose result is used by the next instruction
+#define PERF_LOAD_USE()      CSR_READ(hpmcounter5)
+// Flush and refill after a mispredicted jump/branch
+#define PERF_BRANCH_FLUSH()  CSR_READ(hpmcounter6)
+// CPU blocked by the code copy from SPI flash
+#define PERF_COPY_STALL()    CSR_READ(hpmcounter7)
+// Decode waiting for a multiplication/division
+#define PERF_MULDIV_STALL()  CSR_READ(hpmcounter8)
+
+//// Counters (64 bits)
+#define PERF_CYCLE64()       CSR_READ64(cycle, cycleh)
+#define PERF_INSTRET64()     CSR_READ64(instret, instreth)
+
+//// Counters control
+// Reset of all counters
+#define PERF_RESET() do { \
+    CSR_WRITE(mcycle, 0);       CSR_WRITE(mcycleh, 0); \
+    CSR_WRITE(minstret, 0);     CSR_WRITE(minstreth, 0); \
+    CSR_WRITE(mhpmcounter3, 0); CSR_WRITE(mhpmcounter3h, 0); \
+    CSR_WRITE(mhpmcounter4, 0); CSR_WRITE(mhpmcounter4h, 0); \
+    CSR_WRITE(mhpmcounter5, 0); CSR_WRITE(mhpmcounter5h, 0); \
+    CSR_WRITE(mhpmcounter6, 0); CSR_WRITE(mhpmcounter6h, 0); \
+    CSR_WRITE(mhpmcounter7, 0); CSR_WRITE(mhpmcounter7h, 0); \
+    CSR_WRITE(mhpmcounter8, 0); CSR_WRITE(mhpmcounter8h, 0); \
+} while (0)
+
+// mcountinhibit fields masks (a '1' stops the counter)
+#define PERF_INHIBIT_CYCLE_M        (0x1)
+#define PERF_INHIBIT_INSTRET_M      (0x4)
+#define PERF_INHIBIT_INSTR_WAIT_M   (0x8)
+#define PERF_INHIBIT_DATA_WAIT_M    (0x10)
+#define PERF_INHIBIT_LOAD_USE_M     (0x20)
+#define PERF_INHIBIT_BRANCH_FLUSH_M (0x40)
+#define PERF_INHIBIT_COPY_STALL_M   (0x80)
+#define PERF_INHIBIT_MULDIV_STALL_M (0x100)
+// Stop/restart counters
+#define PERF_INHIBIT(mask) CSR_WRITE(mcountinhibit, mask)
+
+#endif // PERF_COUNTERS_H
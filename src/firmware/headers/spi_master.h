@@ -13,6 +13,17 @@
 #define SPI_MASTER_RX_FIFO_LEVEL     REG_ADDR(SPI_MASTER_BASE_ADDR + 0x14)
 #define SPI_MASTER_CLOCK_DIVIDER_LSB REG_ADDR(SPI_MASTER_BASE_ADDR + 0x18)
 #define SPI_MASTER_CLOCK_DIVIDER_MSB REG_ADDR(SPI_MASTER_BASE_ADDR + 0x1C)
+#define SPI_MASTER_IRQ_ENABLE        REG_ADDR(SPI_MASTER_BASE_ADDR + 0x20)
+#define SPI_MASTER_IRQ_STATUS        REG_ADDR(SPI_MASTER_BASE_ADDR + 0x24)
+#define SPI_MASTER_RX_WATERMARK      REG_ADDR(SPI_MASTER_BASE_ADDR + 0x28)
+#define SPI_MASTER_TX_WATERMARK      REG_ADDR(SPI_MASTER_BASE_ADDR + 0x2C)
+// Up to 4 bytes per access (first byte in the lowest byte)
+#define SPI_MASTER_TX_FIFO_PACKED_DATA REG_ADDR(SPI_MASTER_BASE_ADDR + 0x30)
+#define SPI_MASTER_RX_FIFO_PACKED_DATA REG_ADDR(SPI_MASTER_BASE_ADDR + 0x34)
+#define SPI_MASTER_LANE_CONTROL        REG_ADDR(SPI_MASTER_BASE_ADDR + 0x38)
+
+// Memory mapped flash window (read-only, use byte offset inside the flash)
+#define SPI_FLASH_WORD(offset) REG_ADDR(SPI_FLASH_BASE_ADDR + (offset))
 
 //// SPI_MASTER_CONTROL_REGISTER
 // control_register fields masks
@@ -22,6 +33,7 @@
 #define SPI_MASTER_CONTROL_CLOCK_POLARITY_M   (0x08)
 #define SPI_MASTER_CONTROL_CLOCK_PHASE_M      (0x10)
 #define SPI_MASTER_CONTROL_ENABLE_LSB_FIRST_M (0x20)
+#define SPI_MASTER_CONTROL_DMA_WORD_M         (0x40)
 // control_register fields set
 #define SPI_MASTER_CONTROL_TX_FIFO_RESET_S(val)    (val << 0)
 #define SPI_MASTER_CONTROL_RX_FIFO_RESET_S(val)    (val << 1)
@@ -29,6 +41,7 @@
 #define SPI_MASTER_CONTROL_CLOCK_POLARITY_S(val)   (val << 3)
 #define SPI_MASTER_CONTROL_CLOCK_PHASE_S(val)      (val << 4)
 #define SPI_MASTER_CONTROL_ENABLE_LSB_FIRST_S(val) (val << 5)
+#define SPI_MASTER_CONTROL_DMA_WORD_S(val)         (val << 6)
 // control_register fields get
 #define SPI_MASTER_CONTROL_TX_FIFO_RESET_G(val)    ((val & SPI_MASTER_CONTROL_TX_FIFO_RESET_M) >> 0)
 #define SPI_MASTER_CONTROL_RX_FIFO_RESET_G(val)    ((val & SPI_MASTER_CONTROL_RX_FIFO_RESET_M) >> 1)
@@ -36,6 +49,7 @@
 #define SPI_MASTER_CONTROL_CLOCK_POLARITY_G(val)   ((val & SPI_MASTER_CONTROL_CLOCK_POLARITY_M) >> 3)
 #define SPI_MASTER_CONTROL_CLOCK_PHASE_G(val)      ((val & SPI_MASTER_CONTROL_CLOCK_PHASE_M) >> 4)
 #define SPI_MASTER_CONTROL_ENABLE_LSB_FIRST_G(val) ((val & SPI_MASTER_CONTROL_ENABLE_LSB_FIRST_M) >> 5)
+#define SPI_MASTER_CONTROL_DMA_WORD_G(val)         ((val & SPI_MASTER_CONTROL_DMA_WORD_M) >> 6)
 
 //// SPI_MASTER_STATUS_REGISTER
 // status_register fields masks
@@ -43,16 +57,54 @@
 #define SPI_MASTER_STATUS_RX_FIFO_FULL_M  (0x02)
 #define SPI_MASTER_STATUS_TX_FIFO_EMPTY_M (0x04)
 #define SPI_MASTER_STATUS_TX_FIFO_FULL_M  (0x08)
+#define SPI_MASTER_STATUS_IDLE_M          (0x10)
+#define SPI_MASTER_STATUS_XIP_ACTIVE_M    (0x20)
 // status_register fields set
 #define SPI_MASTER_STATUS_RX_FIFO_EMPTY_S(val) (val << 0)
 #define SPI_MASTER_STATUS_RX_FIFO_FULL_S(val)  (val << 1)
 #define SPI_MASTER_STATUS_TX_FIFO_EMPTY_S(val) (val << 2)
 #define SPI_MASTER_STATUS_TX_FIFO_FULL_S(val)  (val << 3)
+#define SPI_MASTER_STATUS_IDLE_S(val)          (val << 4)
+#define SPI_MASTER_STATUS_XIP_ACTIVE_S(val)    (val << 5)
 // status_register fields get
 #define SPI_MASTER_STATUS_RX_FIFO_EMPTY_G(val) ((val & SPI_MASTER_STATUS_RX_FIFO_EMPTY_M) >> 0)
 #define SPI_MASTER_STATUS_RX_FIFO_FULL_G(val)  ((val & SPI_MASTER_STATUS_RX_FIFO_FULL_M) >> 1)
 #define SPI_MASTER_STATUS_TX_FIFO_EMPTY_G(val) ((val & SPI_MASTER_STATUS_TX_FIFO_EMPTY_M) >>2)
 #define SPI_MASTER_STATUS_TX_FIFO_FULL_G(val)  ((val & SPI_MASTER_STATUS_TX_FIFO_FULL_M) >> 3)
+#define SPI_MASTER_STATUS_IDLE_G(val)          ((val & SPI_MASTER_STATUS_IDLE_M) >> 4)
+#define SPI_MASTER_STATUS_XIP_ACTIVE_G(val)    ((val & SPI_MASTER_STATUS_XIP_ACTIVE_M) >> 5)
+
+//// SPI_MASTER_LANE_CONTROL
+// lane_control fields masks
+#define SPI_MASTER_LANE_CONTROL_LANES_M    (0x03)
+#define SPI_MASTER_LANE_CONTROL_TRANSMIT_M (0x04)
+#define SPI_MASTER_LANE_CONTROL_CS_HOLD_M  (0x08)
+// lane_control fields set
+#define SPI_MASTER_LANE_CONTROL_LANES_S(val)    (val << 0)
+#define SPI_MASTER_LANE_CONTROL_TRANSMIT_S(val) (val << 2)
+#define SPI_MASTER_LANE_CONTROL_CS_HOLD_S(val)  (val << 3)
+// lane_control fields get
+#define SPI_MASTER_LANE_CONTROL_LANES_G(val)    ((val & SPI_MASTER_LANE_CONTROL_LANES_M) >> 0)
+#define SPI_MASTER_LANE_CONTROL_TRANSMIT_G(val) ((val & SPI_MASTER_LANE_CONTROL_TRANSMIT_M) >> 2)
+#define SPI_MASTER_LANE_CONTROL_CS_HOLD_G(val)  ((val & SPI_MASTER_LANE_CONTROL_CS_HOLD_M) >> 3)
+// lanes field values
+#define SPI_MASTER_LANES_SINGLE (0)
+#define SPI_MASTER_LANES_DUAL   (1)
+#define SPI_MASTER_LANES_QUAD   (2)
+
+//// SPI_MASTER_IRQ_ENABLE, SPI_MASTER_IRQ_STATUS
+// irq fields masks
+#define SPI_MASTER_IRQ_RX_WATERMARK_M (0x01)
+#define SPI_MASTER_IRQ_TX_WATERMARK_M (0x02)
+#define SPI_MASTER_IRQ_DONE_M         (0x04)
+// irq fields set
+#define SPI_MASTER_IRQ_RX_WATERMARK_S(val) (val << 0)
+#define SPI_MASTER_IRQ_TX_WATERMARK_S(val) (val << 1)
+#define SPI_MASTER_IRQ_DONE_S(val)         (val << 2)
+// irq fields get
+#define SPI_MASTER_IRQ_RX_WATERMARK_G(val) ((val & SPI_MASTER_IRQ_RX_WATERMARK_M) >> 0)
+#define SPI_MASTER_IRQ_TX_WATERMARK_G(val) ((val & SPI_MASTER_IRQ_TX_WATERMARK_M) >> 1)
+#define SPI_MASTER_IRQ_DONE_G(val)         ((val & SPI_MASTER_IRQ_DONE_M) >> 2)
 
 #endif // SPI_MASTER_H
 
@@ -0,0 +1,45 @@
+#ifndef TIMER_H
+#define TIMER_H
+
+// Include base addresses, CSR macros and interrupt fields
+#include "irq_controller.h"
+
+// Register addresses (mtime is incremented every clock cycle)
+#define TIMER_MTIME_LSW    REG_ADDR(IRQ_CTRL_BASE_ADDR + 0x40)
+#define TIMER_MTIME_MSW    REG_ADDR(IRQ_CTRL_BASE_ADDR + 0x44)
+#define TIMER_MTIMECMP_LSW REG_ADDR(IRQ_CTRL_BASE_ADDR + 0x48)
+#define TIMER_MTIMECMP_MSW REG_ADDR(IRQ_CTRL_BASE_ADDR + 0x4C)
+
+// Read of mtime (high half is read again if the low half has wrapped around)
+#define TIMER_READ() ({ \
+    unsigned int __tmr_hi, __tmr_lo; \
+    do { \
+        __tmr_hi = TIMER_MTIME_MSW; \
+        __tmr_lo = TIMER_MTIME_LSW; \
+    } while (__tmr_hi != TIMER_MTIME_MSW); \
+    ((unsigned long long)__tmr_hi << 32) | __tmr_lo; })
+
+// Write of mtimecmp (the high half is set to the maximum first, so no interrupt is raised by the intermediate value)
+#define TIMER_SET_CMP(val) do { \
+    unsigned long long __tmr_cmp = (val); \
+    TIMER_MTIMECMP_MSW = 0xFFFFFFFF; \
+    TIMER_MTIMECMP_LSW = (unsigned int)__tmr_cmp; \
+    TIMER_MTIMECMP_MSW = (unsigned int)(__tmr_cmp >> 32); \
+} while (0)
+
+// Wait for an enabled interrupt (the clock of the pipeline is stopped while waiting)
+#define WFI() __asm__ volatile ("wfi")
+
+// Wait for a number of clock cycles sleeping in wfi
+//   the timer interrupt is enabled in mie only to wake up the CPU, it is not taken if mstatus.MIE is 0
+#define TIMER_DELAY(cycles) do { \
+    unsigned long long __tmr_end = TIMER_READ() + (cycles); \
+    TIMER_SET_CMP(__tmr_end); \
+    CSR_SET(mie, MIE_MTIE_M); \
+    while (TIMER_READ() < __tmr_end) { \
+        WFI(); \
+    } \
+    CSR_CLEAR(mie, MIE_MTIE_M); \
+} while (0)
+
+#endif // TIMER_H
@@ -11,6 +11,15 @@
 #define UART_CONTROL_REGISTER  REG_ADDR(UART_BASE_ADDR + 0x0C)
 #define UART_CLOCK_DIVIDER_LSB REG_ADDR(UART_BASE_ADDR + 0x10)
 #define UART_CLOCK_DIVIDER_MSB REG_ADDR(UART_BASE_ADDR + 0x14)
+#define UART_IRQ_ENABLE        REG_ADDR(UART_BASE_ADDR + 0x18)
+#define UART_IRQ_STATUS        REG_ADDR(UART_BASE_ADDR + 0x1C)
+#define UART_RX_WATERMARK      REG_ADDR(UART_BASE_ADDR + 0x20)
+#define UART_TX_WATERMARK      REG_ADDR(UART_BASE_ADDR + 0x24)
+#define UART_TX_FIFO_LEVEL     REG_ADDR(UART_BASE_ADDR + 0x28)
+#define UART_RX_FIFO_LEVEL     REG_ADDR(UART_BASE_ADDR + 0x2C)
+// Up to 4 bytes per access (first byte in the lowest byte)
+#define UART_TX_FIFO_PACKED_DATA REG_ADDR(UART_BASE_ADDR + 0x30)
+#define UART_RX_FIFO_PACKED_DATA REG_ADDR(UART_BASE_ADDR + 0x34)
 
 //// UART_STATUS_REGISTER
 // status_register fields masks
@@ -39,12 +48,32 @@
 // control_register fields masks
 #define UART_CONTROL_TX_FIFO_RESET_M (0x01)
 #define UART_CONTROL_RX_FIFO_RESET_M (0x02)
+#define UART_CONTROL_DMA_WORD_M      (0x04)
 // control_register fields value set
 #define UART_CONTROL_TX_FIFO_RESET_S(val) (val << 0)
 #define UART_CONTROL_RX_FIFO_RESET_S(val) (val << 1)
+#define UART_CONTROL_DMA_WORD_S(val)      (val << 2)
 // control_register fields value get
 #define UART_CONTROL_TX_FIFO_RESET_G(val) ((val & UART_CONTROL_TX_FIFO_RESET_M) >> 0)
 #define UART_CONTROL_RX_FIFO_RESET_G(val) ((val & UART_CONTROL_RX_FIFO_RESET_M) >> 1)
+#define UART_CONTROL_DMA_WORD_G(val)      ((val & UART_CONTROL_DMA_WORD_M) >> 2)
+
+//// UART_IRQ_ENABLE, UART_IRQ_STATUS
+// irq fields masks
+#define UART_IRQ_RX_WATERMARK_M (0x01)
+#define UART_IRQ_TX_WATERMARK_M (0x02)
+#define UART_IRQ_TX_DONE_M      (0x04)
+#define UART_IRQ_RX_ERROR_M     (0x08)
+// irq fields value set
+#define UART_IRQ_RX_WATERMARK_S(val) (val << 0)
+#define UART_IRQ_TX_WATERMARK_S(val) (val << 1)
+#define UART_IRQ_TX_DONE_S(val)      (val << 2)
+#define UART_IRQ_RX_ERROR_S(val)     (val << 3)
+// irq fields value get
+#define UART_IRQ_RX_WATERMARK_G(val) ((val & UART_IRQ_RX_WATERMARK_M) >> 0)
+#define UART_IRQ_TX_WATERMARK_G(val) ((val & UART_IRQ_TX_WATERMARK_M) >> 1)
+#define UART_IRQ_TX_DONE_G(val)      ((val & UART_IRQ_TX_DONE_M) >> 2)
+#define UART_IRQ_RX_ERROR_G(val)     ((val & UART_IRQ_RX_ERROR_M) >> 3)
 
 #endif // UART_CONTROLLER_H
 
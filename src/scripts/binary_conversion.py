@@ -1,48 +1,37 @@
+import struct
 import sys
 
+# Memory initialization files of the FPGA SRAM banks ($readmemb format)
+# The simulations load the ELF file directly
+
 def binary_to_ascii_text(input_file, output_file):
     with open(input_file, 'rb') as bin_file:
         # Read the entire binary file
         binary_data = bin_file.read()
 
-    # Prepare to store the binary string
-    binary_string = ''
-
-    # Process the binary data in 4-byte (32-bit) chunks
-    for i in range(0, len(binary_data), 4):
-        chunk = binary_data[i:i + 4]
-        # Reverse the order of bytes in the chunk for endianness
-        reversed_chunk = chunk[::-1]
-        # Convert the reversed chunk to a string of '1's and '0's
-        binary_string += ''.join(format(byte, '08b') for byte in reversed_chunk)
-
-    # Split the binary string into chunks of 32 bits
-    chunks = [binary_string[i:i + 32] for i in range(0, len(binary_string), 32)]
+    # Code with compressed instructions can end in the middle of a word, the last word is padded with zeros
+    binary_data = binary_data.ljust((len(binary_data) + 3) // 4 * 4, b'\x00')
 
-    # Write the chunks to the output text file
+    # One little-endian 32-bit word for each line, as a string of '1's and '0's
     with open(output_file, 'w') as text_file:
-        for chunk in chunks:
-            text_file.write(chunk + '\n')
+        text_file.writelines('{:032b}\n'.format(word[0]) for word in struct.iter_unpack('<I', binary_data))
 
-def split_lines_reverse_endianness(file_name, output_file_name):
-    with open(file_name, 'r') as file, open(output_file_name, 'w') as output_file:
-        for line in file:
-            line = line.strip()
-            # Split the line into 4 bytes
-            bytes = [line[i:i+8] for i in range(0, len(line), 8)]
-            # Reverse the order of the bytes
-            bytes = bytes[::-1]
-            # Write each byte to the output file
-            for byte in bytes:
-                output_file.write(byte + '\n')
+def split_banks(file_name, banks):
+    # Consecutive words are stored in different SRAM banks, one file for each bank
+    with open(file_name, 'r') as file:
+        lines = file.readlines()
+    for bank in range(banks):
+        with open(file_name.replace('.txt', '_%x.txt' % bank), 'w') as bank_file:
+            bank_file.writelines(lines[bank::banks])
 
 if __name__ == "__main__":
-    if len(sys.argv) != 3:
-        print("Usage: python binary_to_text.py <input_file> <output_file>")
+    if len(sys.argv) != 3 and len(sys.argv) != 4:
+        print("Usage: python binary_conversion.py <input_file> <output_file> [sram_banks]")
         sys.exit(1)
 
     input_file = sys.argv[1]
     output_file = sys.argv[2]
     binary_to_ascii_text(input_file, output_file)
-    new_output_file = output_file.replace('.txt', '_8.txt')
-    split_lines_reverse_endianness(output_file, new_output_file)
+    # Images for the FPGA SRAM banks (software_0.txt, software_1.txt, ...)
+    if len(sys.argv) == 4 and int(sys.argv[3]) > 1:
+        split_banks(output_file, int(sys.argv[3]))
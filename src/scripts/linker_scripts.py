@@ -0,0 +1,130 @@
+import os
+import sys
+
+# Size of a SRAM bank (bytes)
+BANK_SIZE = 2048
+# Address space of the SPI flash (code executed in place or copied to memory)
+FLASH_SIZE = 16 * 1024 * 1024
+# Flash window (data port view of the flash)
+FLASH_WINDOW_BASE = 0x20000000
+# DDR memory (FPGA only)
+DDR_BASE = 0xf0000000
+DDR_SIZE = 256 * 1024 * 1024
+# Tightly-coupled memories (size set by ITCM_SIZE/DTCM_SIZE of chip_top)
+ITCM_BASE = 0x00100000
+DTCM_BASE = 0x00200000
+
+TEMPLATE = """OUTPUT_FORMAT("elf32-littleriscv", "elf32-littleriscv",
+	      "elf32-littleriscv")
+OUTPUT_ARCH(riscv)
+ENTRY(_start)
+
+/* Generated by src/scripts/linker_scripts.py for {ram_size} bytes of SRAM */
+
+/* Define memories */
+MEMORY
+{{
+   /* Code memory (0x{code_start:08x} - 0x{code_end:08x}) */
+   CODE (rx)   : ORIGIN = 0x{code_start:08x}, LENGTH = {code_len}
+   /* Data memory (0x{data_start:08x} - 0x{data_end:08x}) */
+   DATA (rwx)  : ORIGIN = 0x{data_start:08x}, LENGTH = {data_len}
+   /* Tightly-coupled memories, loaded by crt0 */
+   ITCM (rx)   : ORIGIN = 0x{itcm_start:08x}, LENGTH = {itcm_len}
+   DTCM (rw)   : ORIGIN = 0x{dtcm_start:08x}, LENGTH = {dtcm_len}
+}}
+
+/* Define sections */
+SECTIONS
+{{
+  /* Define stack pointer reset value (highest ram address) */
+  PROVIDE(__stack_top = 0x{stack_top:08x});
+
+  /* Define .text section, containing all the executable code */
+  .text : {{ *(.text .text.*) }} > CODE
+
+  /* Define .itcm and .dtcm sections, stored in code memory and copied by crt0 */
+  .itcm : ALIGN(4)
+  {{
+    __itcm_start = .;
+    *(.itcm .itcm.*)
+    . = ALIGN(4);
+    __itcm_end = .;
+  }} > ITCM AT> CODE
+  /* Load address as seen from the data port */
+  __itcm_load = LOADADDR(.itcm) + 0x{load_offset:x};
+
+  .dtcm : ALIGN(4)
+  {{
+    __dtcm_start = .;
+    *(.dtcm .dtcm.*)
+    . = ALIGN(4);
+    __dtcm_end = .;
+  }} > DTCM AT> CODE
+  __dtcm_load = LOADADDR(.dtcm) + 0x{load_offset:x};
+
+  /* Define .data section, containing all the initialized data */
+  .data : {{ *(.data .data.*) }} > DATA
+
+  .sdata :
+  {{
+    /* Define global pointer reset value (inside the sdata section) */
+    __global_pointer = . + 0x{gp_offset:x};
+    *(.srodata .srodata*)
+    *(.sdata .sdata*)
+  }} > DATA
+
+  /* Define .bss section, containing all the uninitialized data */
+  __bss_start = .;
+  .bss : {{ *(.bss .bss.*) }} > DATA
+}}
+"""
+
+def linker_script(ram_size, code_start, code_len, data_start, data_len, tcm_sizes, load_offset=0):
+    return TEMPLATE.format(
+        ram_size=ram_size,
+        itcm_start=ITCM_BASE,
+        itcm_len=tcm_sizes[0],
+        dtcm_start=DTCM_BASE,
+        dtcm_len=tcm_sizes[1],
+        load_offset=load_offset,
+        code_start=code_start,
+        code_end=code_start + code_len - 1,
+        code_len=code_len,
+        data_start=data_start,
+        data_end=data_start + data_len - 1,
+        data_len=data_len,
+        stack_top=data_start + data_len - 8,
+        # Global pointer is reachable with a 12 bit offset from the whole small data area
+        gp_offset=min(0x800, data_len // 2))
+
+def generate(ram_banks, output_dir, itcm_size=0, dtcm_size=0):
+    ram_size = ram_banks * BANK_SIZE
+    tcm_sizes = (itcm_size, dtcm_size)
+    scripts = {
+        # Code and data in SRAM (3/4 code, 1/4 data)
+        'linker_script_sram.ld': linker_script(ram_size, 0, ram_size * 3 // 4, ram_size * 3 // 4, ram_size // 4, tcm_sizes),
+        # Code in flash (copied to the lower half of SRAM), data in the upper half of SRAM
+        #   (TCM contents are read by crt0 through the flash window)
+        'linker_script_spi_boot_sram.ld': linker_script(ram_size, 0, FLASH_SIZE, ram_size // 2, ram_size // 2, tcm_sizes, FLASH_WINDOW_BASE),
+        # Code in flash, data in DDR
+        'linker_script_spi_boot_ddr.ld': linker_script(ram_size, 0, FLASH_SIZE, DDR_BASE, DDR_SIZE, tcm_sizes, FLASH_WINDOW_BASE),
+    }
+    os.makedirs(output_dir, exist_ok=True)
+    for name, content in scripts.items():
+        with open(os.path.join(output_dir, name), 'w') as script_file:
+            script_file.write(content)
+
+if __name__ == "__main__":
+    if len(sys.argv) not in (3, 5):
+        print("Usage: python linker_scripts.py <ram_banks> <output_dir> [<itcm_size> <dtcm_size>]")
+        sys.exit(1)
+
+    ram_banks = int(sys.argv[1])
+    if ram_banks < 1 or (ram_banks & (ram_banks - 1)) != 0:
+        print("Error: number of SRAM banks must be a power of 2")
+        sys.exit(1)
+    tcm_sizes = [int(size, 0) for size in sys.argv[3:5]] if len(sys.argv) == 5 else [0, 0]
+    if any(size < 0 or (size & (size - 1)) != 0 for size in tcm_sizes):
+        print("Error: size of the tightly-coupled memories must be 0 or a power of 2")
+        sys.exit(1)
+    generate(ram_banks, sys.argv[2], *tcm_sizes)
@@ -1,7 +1,7 @@
 # Load binary file into testbench ram
 proc load_code {} {
 	set input_file "$::env(OBJ_DIR)/$::env(TEST_NAME).bin"
-	set mem_path "sim:/chip_top_tb/DUT/inst_ram_wrapper/inst_ram/mem"
+	set banks $::env(RAM_BANKS)
 
 	set cmd "change"
 	set addr 0
@@ -13,7 +13,9 @@ proc load_code {} {
 	while {[string length $bin_data] != 0} {
 		binary scan $bin_data i data
 		set data [format "%x" $data]
-		append cmd " $mem_path\($addr) $data"
+		# Consecutive words are stored in different banks
+		set mem_path "sim:/chip_top_tb/DUT/inst_ram_wrapper/gen_bank\[[expr $addr % $banks]\]/inst_ram/mem"
+		append cmd " $mem_path\([expr $addr / $banks]) $data"
 		incr addr
 		
 		set bin_data [read $fp 4]
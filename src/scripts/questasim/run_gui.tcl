@@ -2,7 +2,9 @@
 # Logging every signal, including register-file and sram
 add log -r /*
 add log sim:/chip_top_tb/DUT/inst_cpu/inst_register_file/registers
-add log sim:/chip_top_tb/DUT/inst_ram_wrapper/inst_ram/mem
+for {set bank 0} {$bank < $::env(RAM_BANKS)} {incr bank} {
+	add log sim:/chip_top_tb/DUT/inst_ram_wrapper/gen_bank\[$bank\]/inst_ram/mem
+}
 
 # Loading waves format only in wave file is present
 if {[file exist wave.do]} {
@@ -0,0 +1,152 @@
+import argparse
+import fnmatch
+import json
+import os
+import subprocess
+import sys
+import time
+from concurrent.futures import ThreadPoolExecutor
+
+from run_regression import TOP_DIR, prepare
+
+BENCH_DIR = os.path.join(TOP_DIR, 'src', 'bench')
+# Every benchmark writes its files in its own directory for each linker script
+RESULTS_DIR = os.path.join(TOP_DIR, 'obj', 'bench')
+# The design is built in its own directory for each SRAM size used by the benchmarks
+BUILD_DIR = os.path.join(RESULTS_DIR, 'build')
+LINKER_SCRIPTS = ['sram', 'spi_boot_sram', 'spi_boot_ddr']
+# There is no DDR model in simulation, benchmarks with data in DDR are only built
+# Runs booting from the SPI flash model are not validated yet, spi_boot_sram is only built
+#   (its numbers would not be comparable with the ones of the other scripts until they are)
+BUILD_ONLY = ['spi_boot_sram', 'spi_boot_ddr']
+# Fields of perf_report.json printed in the summary table
+COLUMNS = ['cycles', 'instret', 'cpi', 'bytes_per_cycle', 'return_value']
+
+def find_benches():
+    return [d for d in sorted(os.listdir(BENCH_DIR)) if os.path.isfile(os.path.join(BENCH_DIR, d, 'Makefile'))]
+
+def ram_banks(bench):
+    # Number of SRAM banks the benchmark needs (RAM_BANKS of base.mk if it is enough)
+    result = subprocess.run(['make', '-s', 'ram_banks'], cwd=os.path.join(BENCH_DIR, bench), stdout=subprocess.PIPE, stderr=subprocess.DEVNULL, text=True)
+    return int(result.stdout.strip()) if result.returncode == 0 else None
+
+def bench_skip(bench):
+    # Reason why the benchmark cannot be built (sources outside of the repository not set)
+    result = subprocess.run(['make', '-s', 'bench_skip'], cwd=os.path.join(BENCH_DIR, bench), stdout=subprocess.PIPE, stderr=subprocess.DEVNULL, text=True)
+    return result.stdout.strip() if result.returncode == 0 else None
+
+def build_variables(banks):
+    # Shared files of the build directory (design, linker scripts) depend on RAM_BANKS
+    return ['RAM_BANKS=%d' % banks, 'OBJ_DIR=' + os.path.join(BUILD_DIR, 'ram_banks_%d' % banks)]
+
+def run_bench(bench, script, banks, skip):
+    output_dir = os.path.join(RESULTS_DIR, script, bench)
+    os.makedirs(output_dir, exist_ok=True)
+    if skip:
+        return {'bench': bench, 'linker_script': script, 'ram_banks': banks, 'status': 'skipped', 'duration': 0.0,
+                'log': None, 'report': None, 'reason': skip}
+    linker_script = os.path.join(BUILD_DIR, 'ram_banks_%d' % banks, 'firmware', 'linker_script_%s.ld' % script)
+    build_only = script in BUILD_ONLY
+    target = os.path.join(output_dir, bench + '.elf') if build_only else 'batch'
+    command = ['make', target, 'OUTPUT_DIR=' + output_dir, 'LINKER_SCRIPT=' + linker_script] + build_variables(banks)
+    # Files of a previous run must not be read if the simulation stops before writing them
+    report_file = os.path.join(output_dir, 'perf_report.json')
+    tc_file = os.path.join(output_dir, 'tc.out')
+    for file_name in (report_file, tc_file):
+        if os.path.isfile(file_name):
+            os.remove(file_name)
+
+    start = time.time()
+    result = subprocess.run(command, cwd=os.path.join(BENCH_DIR, bench), stdout=subprocess.PIPE, stderr=subprocess.STDOUT, text=True)
+    duration = time.time() - start
+    log_file = os.path.join(output_dir, 'make.log')
+    with open(log_file, 'w') as log:
+        log.write(result.stdout)
+
+    # The report is valid only if the program has ended (trap asserted before the timeout)
+    report = None
+    trapped = False
+    if not build_only and os.path.isfile(tc_file):
+        with open(tc_file, 'r', errors='replace') as tc:
+            trapped = 'Trap asserted' in tc.read()
+    if trapped and os.path.isfile(report_file):
+        with open(report_file, 'r') as report_json:
+            report = json.load(report_json)
+
+    # Benchmarks return the number of errors found while checking their results
+    if result.returncode != 0:
+        status = 'fail'
+    elif build_only:
+        status = 'built'
+    elif report is None or report['return_value'] != 0:
+        status = 'fail'
+    else:
+        status = 'pass'
+    return {'bench': bench, 'linker_script': script, 'ram_banks': banks, 'status': status, 'duration': round(duration, 3),
+            'log': log_file, 'report': report, 'reason': None}
+
+def git_commit():
+    result = subprocess.run(['git', 'rev-parse', '--short', 'HEAD'], cwd=TOP_DIR, stdout=subprocess.PIPE, stderr=subprocess.DEVNULL, text=True)
+    return result.stdout.strip() if result.returncode == 0 else None
+
+def format_value(value):
+    if value is None:
+        return '-'
+    return ('%.4f' % value) if isinstance(value, float) else str(value)
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description='Build and run the benchmarks of src/bench for each linker script')
+    parser.add_argument('patterns', nargs='*', help='run only the benchmarks matching these names (wildcards allowed)')
+    parser.add_argument('-j', '--jobs', type=int, default=os.cpu_count(), help='number of benchmarks run at the same time')
+    parser.add_argument('--linker-script', choices=LINKER_SCRIPTS, action='append', help='use only this linker script (can be repeated)')
+    parser.add_argument('--json', default=os.path.join(RESULTS_DIR, 'bench_results.json'), help='file of the results')
+    args = parser.parse_args()
+
+    benches = find_benches()
+    if args.patterns:
+        benches = [b for b in benches if any(fnmatch.fnmatch(b, p) for p in args.patterns)]
+    if not benches:
+        print('Error: no benchmarks selected')
+        sys.exit(1)
+    scripts = args.linker_script or LINKER_SCRIPTS
+
+    banks = {b: ram_banks(b) for b in benches}
+    unknown = [b for b in benches if banks[b] is None]
+    if unknown:
+        print('Error: SRAM size of %s not found' % ', '.join(unknown))
+        sys.exit(1)
+
+    # Benchmarks built from sources that are not available are skipped
+    skip = {b: bench_skip(b) for b in benches}
+
+    # The design is compiled and the linker scripts are generated once for each SRAM size
+    for n in sorted(set(banks[b] for b in benches if not skip[b])):
+        bench = next(b for b in benches if banks[b] == n and not skip[b])
+        if not prepare(os.path.join(BENCH_DIR, bench), build_variables(n)):
+            print('Error: design compilation failed (%d SRAM banks)' % n)
+            sys.exit(1)
+
+    runs = [(b, s, banks[b], skip[b]) for s in scripts for b in benches]
+    results = []
+    with ThreadPoolExecutor(max_workers=max(1, args.jobs)) as executor:
+        for result in executor.map(lambda r: run_bench(*r), runs):
+            reason = (' (%s)' % result['reason']) if result['status'] == 'skipped' else ''
+            print('%-7s %s/%s%s' % (result['status'].upper(), result['linker_script'], result['bench'], reason), flush=True)
+            results.append(result)
+
+    os.makedirs(os.path.dirname(os.path.abspath(args.json)), exist_ok=True)
+    with open(args.json, 'w') as json_file:
+        json.dump({'commit': git_commit(), 'results': results}, json_file, indent=2)
+
+    print('')
+    print('%-14s %-16s' % ('linker_script', 'bench') + ''.join('%16s' % c for c in COLUMNS))
+    for r in results:
+        report = r['report'] or {}
+        print('%-14s %-16s' % (r['linker_script'], r['bench']) + ''.join('%16s' % format_value(report.get(c)) for c in COLUMNS))
+    print('')
+    print('Results written in %s' % args.json)
+
+    failed = [r for r in results if r['status'] == 'fail']
+    for r in failed:
+        print('BENCHMARK %s/%s FAILED! (log: %s)' % (r['linker_script'], r['bench'], r['log']))
+    sys.exit(1 if failed else 0)
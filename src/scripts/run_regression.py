@@ -0,0 +1,171 @@
+import argparse
+import fnmatch
+import json
+import os
+import re
+import subprocess
+import sys
+import time
+import xml.etree.ElementTree as ET
+from concurrent.futures import ThreadPoolExecutor
+
+# Directories of the project (this script is in src/scripts)
+TOP_DIR = os.path.abspath(os.path.join(os.path.dirname(__file__), '..', '..'))
+SIM_DIR = os.path.join(TOP_DIR, 'src', 'sim')
+# Every test writes its files in its own directory
+REGRESSION_DIR = os.path.join(TOP_DIR, 'obj', 'regression')
+# Clock period and reset release time of the testbench (ns)
+CLOCK_NS = 10
+RESET_NS = 5 * CLOCK_NS
+
+def no_regression(test_dir):
+    # Demo programs that never end set NO_REGRESSION=1 in their makefile
+    with open(os.path.join(test_dir, 'Makefile'), 'r') as makefile:
+        return re.search(r'^\s*(export\s+)?NO_REGRESSION\s*:?=\s*1\s*$', makefile.read(), re.MULTILINE) is not None
+
+def find_tests():
+    # ISA tests (one assembly file each) and C tests (one directory each)
+    tests = []
+    riscv_dir = os.path.join(SIM_DIR, 'riscv_test')
+    for file_name in sorted(os.listdir(os.path.join(riscv_dir, 'S'))):
+        if file_name.endswith('.S'):
+            tests.append({'suite': 'riscv_test', 'name': file_name[:-2], 'dir': riscv_dir})
+    for dir_name in sorted(os.listdir(SIM_DIR)):
+        test_dir = os.path.join(SIM_DIR, dir_name)
+        if dir_name != 'riscv_test' and os.path.isfile(os.path.join(test_dir, 'Makefile')) and not no_regression(test_dir):
+            tests.append({'suite': 'sim', 'name': dir_name, 'dir': test_dir})
+    return tests
+
+def select_tests(tests, suites, patterns, shard):
+    tests = [t for t in tests if t['suite'] in suites]
+    if patterns:
+        tests = [t for t in tests if any(fnmatch.fnmatch(t['name'], p) for p in patterns)]
+    # Shard i of n gets every n-th test, so shards have similar lengths
+    index, count = shard
+    return tests[index::count]
+
+def prepare(test_dir, variables=()):
+    # Compile the design and generate the linker script once, before starting tests in parallel
+    result = subprocess.run(['make', 'prepare'] + list(variables), cwd=test_dir, stdout=subprocess.PIPE, stderr=subprocess.STDOUT, text=True)
+    if result.returncode != 0:
+        print(result.stdout)
+    return result.returncode == 0
+
+def run_test(test, target):
+    output_dir = os.path.join(REGRESSION_DIR, test['suite'], test['name'])
+    os.makedirs(output_dir, exist_ok=True)
+    command = ['make', target, 'OUTPUT_DIR=' + output_dir]
+    if test['suite'] == 'riscv_test':
+        command.append('TEST_NAME=' + test['name'])
+
+    start = time.time()
+    result = subprocess.run(command, cwd=test['dir'], stdout=subprocess.PIPE, stderr=subprocess.STDOUT, text=True)
+    duration = time.time() - start
+    log_file = os.path.join(output_dir, 'make.log')
+    with open(log_file, 'w') as log:
+        log.write(result.stdout)
+
+    # Simulated time when the trap has been asserted (end of the program)
+    cycles = None
+    timed_out = False
+    tc_file = os.path.join(output_dir, 'tc.out')
+    if os.path.isfile(tc_file):
+        with open(tc_file, 'r', errors='replace') as tc:
+            tc_log = tc.read()
+        match = re.search(r'Trap asserted at time\s+(\d+)\s*ns', tc_log)
+        if match:
+            cycles = (int(match.group(1)) - RESET_NS) // CLOCK_NS
+        timed_out = 'timed out' in tc_log
+
+    # Self-checking tests (REF_MODEL=self) are not compared with Ripes, tests with NO_COSIM are run with batch_ref
+    checked = 'Register-files match' in result.stdout or 'Self-check passed' in result.stdout
+    if target == 'batch_ref':
+        passed = result.returncode == 0 and checked
+    elif target == 'batch_cosim':
+        passed = result.returncode == 0 and ('Co-simulation passed' in result.stdout or checked)
+    else:
+        passed = result.returncode == 0 and cycles is not None
+    status = 'pass' if passed else ('timeout' if timed_out else 'fail')
+    return dict(test, status=status, cycles=cycles, duration=round(duration, 3), log=log_file, output=result.stdout)
+
+def write_json(results, file_name):
+    summary = {
+        'tests': len(results),
+        'passed': sum(r['status'] == 'pass' for r in results),
+        'results': [{k: r[k] for k in ('suite', 'name', 'status', 'cycles', 'duration', 'log')} for r in results],
+    }
+    with open(file_name, 'w') as json_file:
+        json.dump(summary, json_file, indent=2)
+
+def write_junit(results, file_name):
+    testsuites = ET.Element('testsuites')
+    for suite in sorted(set(r['suite'] for r in results)):
+        suite_results = [r for r in results if r['suite'] == suite]
+        testsuite = ET.SubElement(testsuites, 'testsuite', name=suite, tests=str(len(suite_results)),
+                                  failures=str(sum(r['status'] != 'pass' for r in suite_results)),
+                                  time='%.3f' % sum(r['duration'] for r in suite_results))
+        for r in suite_results:
+            testcase = ET.SubElement(testsuite, 'testcase', classname=suite, name=r['name'], time='%.3f' % r['duration'])
+            if r['cycles'] is not None:
+                ET.SubElement(ET.SubElement(testcase, 'properties'), 'property', name='cycles', value=str(r['cycles']))
+            if r['status'] != 'pass':
+                failure = ET.SubElement(testcase, 'failure', message=r['status'])
+                # Last lines of the log are enough to see the cause of the failure
+                failure.text = '\n'.join(r['output'].splitlines()[-40:])
+    ET.ElementTree(testsuites).write(file_name, encoding='utf-8', xml_declaration=True)
+
+def parse_shard(value):
+    index, count = (int(v) for v in value.split('/'))
+    if count < 1 or not 0 <= index < count:
+        raise argparse.ArgumentTypeError('shard must be <index>/<count> with 0 <= index < count')
+    return index, count
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description='Run the riscv_test and sim tests in parallel')
+    parser.add_argument('patterns', nargs='*', help='run only the tests matching these names (wildcards allowed)')
+    parser.add_argument('-j', '--jobs', type=int, default=os.cpu_count(), help='number of tests run at the same time')
+    parser.add_argument('--suite', choices=['riscv_test', 'sim', 'all'], default='all', help='test suite to run')
+    parser.add_argument('--shard', type=parse_shard, default=(0, 1), help='run only shard <index>/<count> of the selected tests')
+    parser.add_argument('--no-ref', action='store_true', help='do not compare with the Ripes reference model (make batch)')
+    parser.add_argument('--cosim', action='store_true', help='compare every instruction with the reference ISS (make batch_cosim, Verilator only)')
+    parser.add_argument('--json', help='write a JSON summary to this file')
+    parser.add_argument('--junit', help='write a JUnit XML summary to this file')
+    parser.add_argument('--list', action='store_true', help='print the selected tests and exit')
+    args = parser.parse_args()
+
+    suites = ['riscv_test', 'sim'] if args.suite == 'all' else [args.suite]
+    tests = select_tests(find_tests(), suites, args.patterns, args.shard)
+    if args.list:
+        for test in tests:
+            print('%s/%s' % (test['suite'], test['name']))
+        sys.exit(0)
+    if not tests:
+        print('Error: no tests selected')
+        sys.exit(1)
+
+    # The design is compiled once, then the tests only build their software and run the simulation
+    if not prepare(tests[0]['dir']):
+        print('Error: design compilation failed')
+        sys.exit(1)
+
+    target = 'batch_cosim' if args.cosim else ('batch' if args.no_ref else 'batch_ref')
+    results = []
+    with ThreadPoolExecutor(max_workers=max(1, args.jobs)) as executor:
+        for result in executor.map(lambda t: run_test(t, target), tests):
+            cycles = '' if result['cycles'] is None else '%d cycles' % result['cycles']
+            print('%-7s %s/%s %s' % (result['status'].upper(), result['suite'], result['name'], cycles), flush=True)
+            results.append(result)
+
+    if args.json:
+        write_json(results, args.json)
+    if args.junit:
+        write_junit(results, args.junit)
+
+    failed = [r for r in results if r['status'] != 'pass']
+    print('')
+    print('-----------')
+    print('%d/%d tests passed' % (len(results) - len(failed), len(results)))
+    for r in failed:
+        print('TEST %s/%s FAILED! (log: %s)' % (r['suite'], r['name'], r['log']))
+    print('-----------')
+    sys.exit(1 if failed else 0)
@@ -1,5 +1,6 @@
 #include "uart_controller.h"
 #include "spi_master.h"
+#include "timer.h"
 
 // Read 4-bytes at a time from SPI flash and print
 //  them on the UART terminal
@@ -24,7 +25,6 @@ int main() {
 	volatile unsigned int addr;
 	volatile unsigned int read_value;
 	
-	volatile unsigned int delay_cnt;
 	char i;
 	
 	// Baud rate 115200
@@ -59,18 +59,14 @@ int main() {
 		// TX inhibit
 		SPI_MASTER_CONTROL_REGISTER = SPI_MASTER_CONTROL_TX_INHIBIT_M;
 		
-		// Read command
-		SPI_MASTER_TX_FIFO_DATA = 0x03;
-		// Addr
-		SPI_MASTER_TX_FIFO_DATA = (addr >> 16) & 0xff;
-		SPI_MASTER_TX_FIFO_DATA = (addr >> 8) & 0xff;
-		SPI_MASTER_TX_FIFO_DATA = addr & 0xff;
+		// Read command and addr (4 bytes in a single access, first byte in the lowest byte)
+		SPI_MASTER_TX_FIFO_PACKED_DATA = 0x03 |
+		                                 (((addr >> 16) & 0xff) << 8) |
+		                                 (((addr >> 8) & 0xff) << 16) |
+		                                 ((addr & 0xff) << 24);
 		
 		// 32bit data
-		SPI_MASTER_TX_FIFO_DATA = 0;
-		SPI_MASTER_TX_FIFO_DATA = 0;
-		SPI_MASTER_TX_FIFO_DATA = 0;
-		SPI_MASTER_TX_FIFO_DATA = 0;
+		SPI_MASTER_TX_FIFO_PACKED_DATA = 0;
 
 		// Release TX inhibit
 		SPI_MASTER_CONTROL_REGISTER = 0x0;
@@ -80,21 +76,18 @@ int main() {
 		
 		// Wait until SPI fifo is empty
 		while((SPI_MASTER_STATUS_TX_FIFO_EMPTY_S(SPI_MASTER_STATUS_REGISTER))==0);
-		for(delay_cnt=0; delay_cnt<233; delay_cnt++);
+		TIMER_DELAY(2000);
 		
 		// Discard dummy bytes
-		read_value = SPI_MASTER_RX_FIFO_DATA;
-		read_value = SPI_MASTER_RX_FIFO_DATA;
-		read_value = SPI_MASTER_RX_FIFO_DATA;
-		read_value = SPI_MASTER_RX_FIFO_DATA;
+		read_value = SPI_MASTER_RX_FIFO_PACKED_DATA;
 		
 		// Print flash content
 		print_uart('0');
 		print_uart('x');
+		read_value = SPI_MASTER_RX_FIFO_PACKED_DATA;
 		for(i=0; i<4; i++) {
-			read_value = SPI_MASTER_RX_FIFO_DATA;
-			print_uart(hex_to_ascii((read_value>>4)&0xf));
-			print_uart(hex_to_ascii(read_value & 0xf));
+			print_uart(hex_to_ascii((read_value>>(8*i+4))&0xf));
+			print_uart(hex_to_ascii((read_value>>(8*i))&0xf));
 		}
 		// New line
 		print_uart('\r');
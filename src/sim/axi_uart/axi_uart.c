@@ -1,4 +1,5 @@
 #include "uart_controller.h"
+#include "timer.h"
 
 // Periodically check if any character has been received
 //  from UART and print it back
@@ -11,7 +12,6 @@ void print_uart(char chr) {
 }
 
 int main() {
-	volatile unsigned int delay_cnt;
 
 	// Baud rate 115200
 	UART_CLOCK_DIVIDER_LSB = 0x64; 
@@ -38,6 +38,6 @@ int main() {
 		print_uart('\n');
 
 		// Delay
-		for(delay_cnt=0; delay_cnt<233000; delay_cnt++);
+		TIMER_DELAY(2000000);
 	}
 }
@@ -1,5 +1,6 @@
 #include "cpu_interface_controller.h"
 #include "uart_controller.h"
+#include "timer.h"
 
 // Copy executable code from external flash to internal
 //   ram while printing uart messages
@@ -12,7 +13,6 @@ void print_uart(char chr) {
 }
 
 int main() {
-	volatile unsigned int delay_cnt;
     unsigned char i;
 	
 	// Baud rate 115200
@@ -28,7 +28,7 @@ int main() {
 		print_uart('H');
 		print_uart('\r');
 		print_uart('\n');
-        for(delay_cnt=0; delay_cnt<23300; delay_cnt++);
+        TIMER_DELAY(200000);
     }
 
     // Flash address from where to start copying
@@ -49,6 +49,6 @@ int main() {
 		print_uart('M');
 		print_uart('\r');
 		print_uart('\n');
-	    for(delay_cnt=0; delay_cnt<23300; delay_cnt++);
+	    TIMER_DELAY(200000);
 	}
 }
@@ -2,29 +2,36 @@
 export OUTPUT_DIR
 export TEST_DIR
 export SRC_DIR
+export RAM_BANKS
+export ITCM_SIZE
+export DTCM_SIZE
 
 # Simulation directory for testcase
 OUTPUT_DIR := $(subst $(SRC_DIR),$(OBJ_DIR),$(CURRENT_DIR))
 
+# Boot source of the testbench (0: SPI flash for the spi_boot_* linker scripts, 1: SRAM)
+#  code linked at address 0 by the spi_boot_* scripts is loaded in the flash model
+BOOT_SOURCE=$(if $(findstring spi_boot,$(notdir $(LINKER_SCRIPT))),0,1)
+
 ifeq ($(SIMULATOR), questasim)
 #######################################################
 #############  Questasim specific targets  #############
 #######################################################
 
-# Start simulation in Questasim batch mode (compile design and generate software image)
+# Start simulation in Questasim batch mode (compile design and software)
 .PHONY: batch
-batch : analyze $(OUTPUT_DIR)/$(TEST_NAME).txt
+batch : analyze $(OUTPUT_DIR)/$(TEST_NAME).elf
 	cd $(OUTPUT_DIR) ; \
-	vsim $(WORK_DIR).chip_top_tb -l tc.out -quiet -batch -do "run -all" \
-	+SRAM_FILE_NAME=$(OUTPUT_DIR)/$(TEST_NAME).txt +VCD_ENABLE=0 +SIM_TIMEOUT_NS=$(SIM_TIMEOUT_NS)
+	vsim $(WORK_DIR).chip_top_tb -GRAM_BANKS=$(RAM_BANKS) -GITCM_SIZE=$(ITCM_SIZE) -GDTCM_SIZE=$(DTCM_SIZE) -l tc.out -quiet -batch -do "run -all" \
+	+ELF_FILE_NAME=$(OUTPUT_DIR)/$(TEST_NAME).elf +VCD_ENABLE=0 +SIM_TIMEOUT_NS=$(SIM_TIMEOUT_NS) +BOOT_SOURCE=$(BOOT_SOURCE)
 
 
-# Start simulation in Questasim gui mode (compile design and generate software image)
+# Start simulation in Questasim gui mode (compile design and software)
 .PHONY: gui
-gui : analyze $(OUTPUT_DIR)/$(TEST_NAME).txt
+gui : analyze $(OUTPUT_DIR)/$(TEST_NAME).elf
 	cd $(OUTPUT_DIR) ; \
-	vsim $(WORK_DIR).chip_top_tb -l tc.out -quiet -do $(SRC_DIR)/scripts/questasim/run_gui.tcl \
-	+SRAM_FILE_NAME=$(OUTPUT_DIR)/$(TEST_NAME).txt +VCD_ENABLE=0 +SIM_TIMEOUT_NS=$(SIM_TIMEOUT_NS)
+	vsim $(WORK_DIR).chip_top_tb -GRAM_BANKS=$(RAM_BANKS) -GITCM_SIZE=$(ITCM_SIZE) -GDTCM_SIZE=$(DTCM_SIZE) -l tc.out -quiet -do $(SRC_DIR)/scripts/questasim/run_gui.tcl \
+	+ELF_FILE_NAME=$(OUTPUT_DIR)/$(TEST_NAME).elf +VCD_ENABLE=0 +SIM_TIMEOUT_NS=$(SIM_TIMEOUT_NS) +BOOT_SOURCE=$(BOOT_SOURCE)
 
 
 # Compile design and testbench with Questasim
@@ -39,18 +46,18 @@ else ifeq ($(SIMULATOR), icarus)
 ##############  Icarus specific targets  ##############
 #######################################################
 
-# Start simulation with Icarus (compile design and generate software image)
+# Start simulation with Icarus (compile design and software)
 .PHONY: batch
-batch : analyze $(OBJ_DIR)/chip_top_tb.vvp $(OUTPUT_DIR)/$(TEST_NAME).txt
+batch : analyze $(OBJ_DIR)/chip_top_tb.vvp $(OUTPUT_DIR)/$(TEST_NAME).elf
 	cd $(OUTPUT_DIR) ; \
 	vvp -n -l tc.out $(OBJ_DIR)/chip_top_tb.vvp \
-	+SRAM_FILE_NAME=$(OUTPUT_DIR)/$(TEST_NAME).txt +VCD_ENABLE=0 +SIM_TIMEOUT_NS=$(SIM_TIMEOUT_NS)
+	+ELF_FILE_NAME=$(OUTPUT_DIR)/$(TEST_NAME).elf +VCD_ENABLE=0 +SIM_TIMEOUT_NS=$(SIM_TIMEOUT_NS) +BOOT_SOURCE=$(BOOT_SOURCE)
 
 
-gui : analyze $(OBJ_DIR)/chip_top_tb.vvp $(OUTPUT_DIR)/$(TEST_NAME).txt
+gui : analyze $(OBJ_DIR)/chip_top_tb.vvp $(OUTPUT_DIR)/$(TEST_NAME).elf
 	cd $(OUTPUT_DIR) ; \
 	vvp -n -l tc.out $(OBJ_DIR)/chip_top_tb.vvp \
-	+SRAM_FILE_NAME=$(OUTPUT_DIR)/$(TEST_NAME).txt +VCD_ENABLE=1  +SIM_TIMEOUT_NS=$(SIM_TIMEOUT_NS) && \
+	+ELF_FILE_NAME=$(OUTPUT_DIR)/$(TEST_NAME).elf +VCD_ENABLE=1  +SIM_TIMEOUT_NS=$(SIM_TIMEOUT_NS) +BOOT_SOURCE=$(BOOT_SOURCE) && \
 	gtkwave dump.vcd
 
 
@@ -66,24 +73,115 @@ analyze : $(OUTPUT_DIR) .check_sources $(OBJ_DIR)/chip_top_tb.vvp
 	make -f $(SRC_DIR)/testbench/Makefile analyze
 
 
-# Re-compile only if any of the source files has been updated
-$(OBJ_DIR)/chip_top_tb.vvp : $(SRC_DIR)/design/srclist.txt $(SRC_DIR)/testbench/srclist.txt
+# Re-compile only if any of the source files (or the memory sizes) has been updated
+$(OBJ_DIR)/chip_top_tb.vvp : $(SRC_DIR)/design/srclist.txt $(SRC_DIR)/testbench/srclist.txt $(TOP_DIR)/base.mk
 	iverilog -Wanachronisms -Wimplicit -Wimplicit-dimensions -Wmacro-replacement -Wportbind -Wselect-range \
-	-o $(OBJ_DIR)/chip_top_tb.vvp \
+	-Pchip_top_tb.RAM_BANKS=$(RAM_BANKS) -Pchip_top_tb.ITCM_SIZE=$(ITCM_SIZE) -Pchip_top_tb.DTCM_SIZE=$(DTCM_SIZE) -o $(OBJ_DIR)/chip_top_tb.vvp \
+	-I $(SRC_DIR)/testbench \
 	-c $(SRC_DIR)/design/srclist.txt -c $(SRC_DIR)/testbench/srclist.txt
 
+
+else ifeq ($(SIMULATOR), verilator)
+#######################################################
+#############  Verilator specific targets  #############
+#######################################################
+
+# Start simulation with the Verilator model (compile design and software)
+#  (exit status of the model is kept, it is not 0 on timeout)
+.PHONY: batch
+batch : analyze $(OUTPUT_DIR)/$(TEST_NAME).elf
+	cd $(OUTPUT_DIR) ; \
+	$(VERILATOR_DIR)/Vchip_top_sim \
+	+ELF_FILE_NAME=$(OUTPUT_DIR)/$(TEST_NAME).elf +VCD_ENABLE=0 +SIM_TIMEOUT_NS=$(SIM_TIMEOUT_NS) +BOOT_SOURCE=$(BOOT_SOURCE) > tc.out 2>&1 ; \
+	status=$$? ; cat tc.out ; exit $$status
+
+
+# Start simulation with lock-step comparison against the reference ISS (no Ripes run needed)
+#  (exit status is not 0 if a mismatch is found)
+# Tests setting NO_COSIM write memory with the DMA or the copy FSM, which the ISS does not see
+.PHONY: batch_cosim
+ifeq ($(NO_COSIM), 1)
+batch_cosim : batch_ref
+	@echo "Co-simulation not supported by $(TEST_NAME), results checked with batch_ref"
+else
+batch_cosim : analyze $(OUTPUT_DIR)/$(TEST_NAME).elf
+	cd $(OUTPUT_DIR) ; \
+	$(VERILATOR_DIR)/Vchip_top_sim \
+	+ELF_FILE_NAME=$(OUTPUT_DIR)/$(TEST_NAME).elf +VCD_ENABLE=0 +SIM_TIMEOUT_NS=$(SIM_TIMEOUT_NS) +BOOT_SOURCE=$(BOOT_SOURCE) +COSIM=1 > tc.out 2>&1 ; \
+	status=$$? ; cat tc.out ; exit $$status
+endif
+
+
+gui : analyze $(OUTPUT_DIR)/$(TEST_NAME).elf
+	cd $(OUTPUT_DIR) ; \
+	$(VERILATOR_DIR)/Vchip_top_sim \
+	+ELF_FILE_NAME=$(OUTPUT_DIR)/$(TEST_NAME).elf +VCD_ENABLE=1 +SIM_TIMEOUT_NS=$(SIM_TIMEOUT_NS) +BOOT_SOURCE=$(BOOT_SOURCE) > tc.out 2>&1 ; \
+	status=$$? ; cat tc.out ; \
+	if [ $$status -ne 0 ] ; then exit $$status ; fi ; \
+	gtkwave dump.vcd
+
+
+# Build the Verilator model
+.PHONY: analyze
+analyze : $(OUTPUT_DIR) .check_sources $(VERILATOR_DIR)/Vchip_top_sim
+
+
+# Check if any of the source files has been updated
+.PHONY: .check_sources
+.check_sources :
+	make -f $(SRC_DIR)/design/Makefile analyze
+	make -f $(SRC_DIR)/testbench/Makefile analyze
+
+
+# Design files of srclist.txt (paths use the SRC_DIR variable)
+VERILATOR_SOURCES = $(subst $$(SRC_DIR),$(SRC_DIR),$(shell cat $(SRC_DIR)/design/srclist.txt)) \
+	$(SRC_DIR)/testbench/spi_flash_model.v $(SRC_DIR)/testbench/chip_top_sim.v $(SRC_DIR)/testbench/chip_top_sim.cpp \
+	$(SRC_DIR)/testbench/riscv_iss.cpp $(SRC_DIR)/testbench/verilator.vlt
+
+# Re-build the model only if any of the source files (or the memory sizes) has been updated
+#  (the model is shared by all the tests, the software image is loaded when the simulation starts)
+# Warnings stop the build, waivers are in verilator.vlt
+$(VERILATOR_DIR)/Vchip_top_sim : $(SRC_DIR)/design/srclist.txt $(SRC_DIR)/testbench/srclist.txt $(TOP_DIR)/base.mk
+	verilator --cc --exe --build -j 0 -O3 --trace --timescale 1ns/1ns \
+	-I$(SRC_DIR)/testbench -CFLAGS -I$(SRC_DIR)/testbench \
+	--top-module chip_top_sim -GRAM_BANKS=$(RAM_BANKS) -GITCM_SIZE=$(ITCM_SIZE) -GDTCM_SIZE=$(DTCM_SIZE) \
+	--Mdir $(VERILATOR_DIR) -o Vchip_top_sim $(VERILATOR_SOURCES)
+
 endif
 
 ######################################################
 ##################  Common targets  ##################
 ######################################################
 
+# The reference ISS is linked in the C++ harness of the Verilator model
+ifneq ($(SIMULATOR), verilator)
+.PHONY: batch_cosim
+batch_cosim :
+	@echo "Error: co-simulation requires SIMULATOR=verilator" ; exit 1
+endif
+
+
+# Compile the design and generate the linker script without running any test
+#  (used by run_regression.py before starting the tests in parallel)
+.PHONY: prepare
+prepare : analyze $(LINKER_SCRIPT)
+
+
 # Start simulation in batch mode and compare results with reference model
+# Tests setting REF_MODEL=self check their results and return the number of errors in a0
+#  (Ripes does not model the peripherals)
 .PHONY: batch_ref
+ifeq ($(REF_MODEL), self)
+batch_ref : batch
+	cd $(OUTPUT_DIR) ; \
+	grep -q "Trap asserted" tc.out && grep -q "^x10:.0.(0x00000000)$$" register_file_dut.txt && \
+	echo "Self-check passed"
+else
 batch_ref : golden batch
 	cd $(OUTPUT_DIR) ; \
 	diff $(OUTPUT_DIR)/register_file_golden.txt $(OUTPUT_DIR)/register_file_dut.txt && \
-    echo "Register-files match" \
+    echo "Register-files match"
+endif
 
 
 # Calculate the expected results with the ripes simulator
@@ -91,20 +189,40 @@ batch_ref : golden batch
 golden : $(OUTPUT_DIR)/register_file_golden.txt
 
 
+# ISA extensions enabled in the reference model (same as the firmware)
+ifeq ($(RV32M)$(RV32C), 11)
+RIPES_ISAEXTS=M,C
+else ifeq ($(RV32M), 1)
+RIPES_ISAEXTS=M
+else ifeq ($(RV32C), 1)
+RIPES_ISAEXTS=C
+else
+RIPES_ISAEXTS=
+endif
+
 # Calculate the expected results with the ripes simulator
 $(OUTPUT_DIR)/register_file_golden.txt : $(OUTPUT_DIR)/$(TEST_NAME).bin
-	ripes --mode cli --proc "RV32_5S" --timeout 60000 --src $< -t bin --regs --output $@
+	ripes --mode cli --proc "RV32_5S" --isaexts "$(RIPES_ISAEXTS)" --timeout 60000 --src $< -t bin --regs --output $@
+
+
+# Generate the linker scripts for the SRAM and tightly-coupled memories sizes
+$(OBJ_DIR)/firmware/%.ld : $(SRC_DIR)/scripts/linker_scripts.py $(TOP_DIR)/base.mk
+	python3 $(SRC_DIR)/scripts/linker_scripts.py $(RAM_BANKS) $(OBJ_DIR)/firmware $(ITCM_SIZE) $(DTCM_SIZE)
+
+
+# Compile C code, the testbenches load the segments of the ELF file at their addresses
+$(OUTPUT_DIR)/$(TEST_NAME).elf : $(SOURCE_FILES) $(LINKER_SCRIPT) $(OUTPUT_DIR)
+	$(ARCH)-gcc $(OPTS) $(CRT0) $(SOURCE_FILES) -o $@
 
 
-# Compile C code and produce binary file
-$(OUTPUT_DIR)/$(TEST_NAME).bin : $(SOURCE_FILES) $(OUTPUT_DIR)
-	$(ARCH)-gcc $(OPTS) $(CRT0) $(SOURCE_FILES) -o $(OUTPUT_DIR)/$(TEST_NAME).elf
-	$(ARCH)-objcopy $(OUTPUT_DIR)/$(TEST_NAME).elf $@ -O binary
+# Produce binary file (Ripes input)
+$(OUTPUT_DIR)/$(TEST_NAME).bin : $(OUTPUT_DIR)/$(TEST_NAME).elf
+	$(ARCH)-objcopy $< $@ -O binary
 
 
-# Compile C code and produce binary file
+# Memory initialization files of the FPGA SRAM banks (not used by the simulations)
 $(OUTPUT_DIR)/$(TEST_NAME).txt : $(OUTPUT_DIR)/$(TEST_NAME).bin
-	python3 $(SRC_DIR)/scripts/binary_conversion.py $< $@
+	python3 $(SRC_DIR)/scripts/binary_conversion.py $< $@ $(RAM_BANKS)
 
 
 # Creating simulation directory
@@ -0,0 +1,75 @@
+#include "cpu_interface_controller.h"
+#include "dma_controller.h"
+#include "irq_controller.h"
+
+// Copy a buffer with a chain of two transfers on channel 1: word bursts from
+//  SRAM to SRAM, then a descriptor loaded from memory with byte transfers
+//  from SRAM to the DTCM.
+// The done bit, the DMA source of the interrupt controller and the copied
+//  data are checked, the number of errors is returned (a0 at the end of the simulation)
+
+#define N_WORDS 16
+#define DMA_CH  1
+
+unsigned int src[N_WORDS];
+unsigned int dst[N_WORDS];
+DTCM_DATA unsigned int dst_tcm[N_WORDS];
+dma_descriptor_t desc;
+
+int main() {
+	unsigned int i, errors;
+
+	for (i=0; i<N_WORDS; i++) {
+		src[i] = (i << 16) | (0xA500 + i);
+	}
+
+	// Second transfer of the chain: byte transfers to the DTCM
+	desc.src    = (unsigned int)src;
+	desc.dst    = (unsigned int)dst_tcm;
+	desc.count  = 4*N_WORDS;
+	desc.config = DMA_CONFIG_EN_M | DMA_CONFIG_SRC_INC_M | DMA_CONFIG_DST_INC_M | DMA_CONFIG_BYTE_M;
+	desc.next   = 0;
+
+	// The DMA does not access the D-cache: write back source and descriptor,
+	//  and invalidate the lines of the destination
+	FENCE();
+	CPU_INTERFACE_CONTROL_REGISTER = CPU_INTERFACE_CONTROL_DCACHE_FLUSH_M;
+	while (CPU_INTERFACE_STATUS_DCACHE_BUSY_G(CPU_INTERFACE_STATUS_REGISTER));
+
+	// First transfer: word bursts between memories (request lines 0)
+	DMA_CH_SRC_ADDR(DMA_CH) = (unsigned int)src;
+	DMA_CH_DST_ADDR(DMA_CH) = (unsigned int)dst;
+	DMA_CH_COUNT(DMA_CH)    = N_WORDS;
+	DMA_CH_NEXT(DMA_CH)     = (unsigned int)&desc;
+	DMA_CH_CONFIG(DMA_CH)   = DMA_CONFIG_EN_M | DMA_CONFIG_SRC_INC_M | DMA_CONFIG_DST_INC_M;
+
+	// Wait for the end of the chain
+	while (!(DMA_STATUS_DONE_G(DMA_STATUS_REGISTER) & (1 << DMA_CH)));
+
+	errors = 0;
+	// Channel is disabled and the done level reaches the interrupt controller
+	if (DMA_STATUS_BUSY_G(DMA_STATUS_REGISTER) != 0) {
+		errors++;
+	}
+	if (!(IRQ_PENDING_REGISTER & (1 << IRQ_SRC_DMA))) {
+		errors++;
+	}
+	// Done bit is cleared writing 1
+	DMA_STATUS_REGISTER = DMA_STATUS_DONE_S(1 << DMA_CH);
+	if (DMA_STATUS_DONE_G(DMA_STATUS_REGISTER) != 0) {
+		errors++;
+	}
+	if (IRQ_PENDING_REGISTER & (1 << IRQ_SRC_DMA)) {
+		errors++;
+	}
+
+	for (i=0; i<N_WORDS; i++) {
+		if (dst[i] != src[i]) {
+			errors++;
+		}
+		if (dst_tcm[i] != src[i]) {
+			errors++;
+		}
+	}
+	return errors;
+}
@@ -0,0 +1,86 @@
+#include "irq_controller.h"
+#include "uart_controller.h"
+#include "spi_master.h"
+
+// Take the software interrupt, the UART RX interrupt (bytes sent on the
+//  TX/RX loopback of the testbench) and the SPI transfer completed interrupt,
+//  the SPI one only after lowering the threshold of the interrupt controller.
+// The number of errors is returned (a0 at the end of the simulation)
+
+#define N_BYTES 4
+
+volatile unsigned int sw_count, spi_count, rx_count;
+volatile unsigned char rx_data[N_BYTES];
+
+// Trap handler (direct mode, mtvec needs a 4-byte aligned address), the interrupt
+//  controller is claimed for external interrupts
+void __attribute__((interrupt("machine"), aligned(4))) trap_handler(void) {
+	unsigned int cause, src;
+
+	cause = CSR_READ(mcause);
+	if (cause == (MCAUSE_IRQ_M | MCAUSE_SOFTWARE)) {
+		IRQ_SOFTWARE_REGISTER = 0;
+		sw_count++;
+	} else if (cause == (MCAUSE_IRQ_M | MCAUSE_EXTERNAL)) {
+		src = IRQ_CLAIM_REGISTER;
+		if (src == IRQ_SRC_UART) {
+			// Reading the fifo clears the interrupt level
+			while (UART_STATUS_RX_FIFO_NOT_EMPTY_G(UART_STATUS_REGISTER)) {
+				if (rx_count < N_BYTES) {
+					rx_data[rx_count] = UART_RX_FIFO_DATA;
+				}
+				rx_count++;
+			}
+		} else if (src == IRQ_SRC_SPI) {
+			// Level stays high while the SPI master is idle
+			SPI_MASTER_IRQ_ENABLE = 0;
+			spi_count++;
+		}
+	}
+}
+
+int main() {
+	unsigned int i, errors;
+
+	errors = 0;
+	IRQ_SET_HANDLER(trap_handler);
+	CSR_SET(mie, MIE_MSIE_M | MIE_MEIE_M);
+	IRQ_GLOBAL_ENABLE();
+
+	// Software interrupt
+	IRQ_SOFTWARE_REGISTER = 1;
+	while (sw_count == 0);
+
+	// UART RX interrupt (RX watermark is 1 after reset), fast baud rate
+	UART_CLOCK_DIVIDER_LSB = 0x40;
+	UART_CLOCK_DIVIDER_MSB = 0x00;
+	UART_IRQ_ENABLE = UART_IRQ_RX_WATERMARK_M;
+	IRQ_ENABLE_REGISTER = (1 << IRQ_SRC_UART) | (1 << IRQ_SRC_SPI);
+	for (i=0; i<N_BYTES; i++) {
+		UART_TX_FIFO_DATA = 'a' + i;
+	}
+	while (rx_count < N_BYTES);
+	for (i=0; i<N_BYTES; i++) {
+		if (rx_data[i] != 'a' + i) {
+			errors++;
+		}
+	}
+
+	// SPI interrupt (master is idle) is pending but masked by the threshold
+	IRQ_THRESHOLD_REGISTER = 1;
+	SPI_MASTER_IRQ_ENABLE = SPI_MASTER_IRQ_DONE_M;
+	if (!(IRQ_PENDING_REGISTER & (1 << IRQ_SRC_SPI))) {
+		errors++;
+	}
+	if (IRQ_CLAIM_REGISTER != 0 || spi_count != 0) {
+		errors++;
+	}
+	// Higher priority than the threshold
+	IRQ_PRIORITY(IRQ_SRC_SPI) = 2;
+	while (spi_count == 0);
+
+	if (sw_count != 1 || rx_count != N_BYTES || spi_count != 1) {
+		errors++;
+	}
+	return errors;
+}
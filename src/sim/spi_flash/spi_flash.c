@@ -0,0 +1,79 @@
+#include "spi_master.h"
+
+// Read the same flash area through the memory mapped window (Quad Output
+//  Fast Read issued by the window) and through the SPI master registers,
+//  on a single lane and on 4 lanes.
+// The number of mismatching words is returned (a0 at the end of the simulation)
+
+#define FLASH_OFFSET 0x100
+#define N_WORDS      16
+
+// Wait until the TX fifo is empty and no byte is being transferred
+void spi_wait_idle() {
+	while ((SPI_MASTER_STATUS_REGISTER & (SPI_MASTER_STATUS_TX_FIFO_EMPTY_M | SPI_MASTER_STATUS_IDLE_M)) !=
+	       (SPI_MASTER_STATUS_TX_FIFO_EMPTY_M | SPI_MASTER_STATUS_IDLE_M));
+}
+
+// Read words from flash with the SPI master registers
+// Command and address are sent on a single lane, data is received on the selected lanes
+void spi_read(unsigned int cmd, unsigned int offset, unsigned int lanes, unsigned int *data, unsigned int n_words) {
+	unsigned int i, j;
+
+	// Wait until the flash window has released the SPI master
+	while (SPI_MASTER_STATUS_XIP_ACTIVE_G(SPI_MASTER_STATUS_REGISTER));
+
+	// Keep chip select asserted between command and data
+	SPI_MASTER_LANE_CONTROL = SPI_MASTER_LANE_CONTROL_CS_HOLD_M;
+	// Command and address (4 bytes in a single access, first byte in the lowest byte)
+	SPI_MASTER_TX_FIFO_PACKED_DATA = cmd |
+	                                 (((offset >> 16) & 0xff) << 8) |
+	                                 (((offset >> 8) & 0xff) << 16) |
+	                                 ((offset & 0xff) << 24);
+	// Dummy byte of the fast read commands
+	if (cmd != 0x03) {
+		SPI_MASTER_TX_FIFO_DATA = 0;
+	}
+	spi_wait_idle();
+	// Discard the bytes received while sending the command
+	SPI_MASTER_CONTROL_REGISTER = SPI_MASTER_CONTROL_RX_FIFO_RESET_M;
+
+	// Receive on the selected lanes, 4 words at a time (16 byte fifos)
+	SPI_MASTER_LANE_CONTROL = SPI_MASTER_LANE_CONTROL_CS_HOLD_M | SPI_MASTER_LANE_CONTROL_LANES_S(lanes);
+	for (i=0; i<n_words; i+=4) {
+		for (j=0; j<4; j++) {
+			SPI_MASTER_TX_FIFO_PACKED_DATA = 0;
+		}
+		spi_wait_idle();
+		for (j=0; j<4; j++) {
+			data[i+j] = SPI_MASTER_RX_FIFO_PACKED_DATA;
+		}
+	}
+
+	// Release chip select
+	SPI_MASTER_LANE_CONTROL = 0;
+}
+
+int main() {
+	unsigned int window[N_WORDS], single[N_WORDS], quad[N_WORDS];
+	unsigned int i, errors;
+
+	// Sequential reads from the window are served by a single flash read stream
+	for (i=0; i<N_WORDS; i++) {
+		window[i] = SPI_FLASH_WORD(FLASH_OFFSET + 4*i);
+	}
+
+	// Same data with Read (single lane) and Quad Output Fast Read
+	spi_read(0x03, FLASH_OFFSET, SPI_MASTER_LANES_SINGLE, single, N_WORDS);
+	spi_read(0x6B, FLASH_OFFSET, SPI_MASTER_LANES_QUAD, quad, N_WORDS);
+
+	errors = 0;
+	for (i=0; i<N_WORDS; i++) {
+		if (window[i] != single[i]) {
+			errors++;
+		}
+		if (quad[i] != single[i]) {
+			errors++;
+		}
+	}
+	return errors;
+}
@@ -0,0 +1,57 @@
+#include "chip_top.h"
+
+// Run a function placed in the ITCM on data placed in the DTCM (both copied
+//  by crt0), then write a small function in the ITCM through the data port
+//  and call it.
+// The number of errors is returned (a0 at the end of the simulation)
+
+#define N_WORDS 8
+
+// End of the code copied to the ITCM (linker script)
+extern unsigned int __itcm_end[];
+
+// Initialized data, copied from code memory by crt0
+DTCM_DATA unsigned int table[N_WORDS] = {3, 1, 4, 1, 5, 9, 2, 6};
+DTCM_DATA unsigned int prefix[N_WORDS];
+
+// Prefix sums of the table, returns the total
+ITCM_CODE unsigned int prefix_sum() {
+	unsigned int i, sum;
+
+	sum = 0;
+	for (i=0; i<N_WORDS; i++) {
+		sum += table[i];
+		prefix[i] = sum;
+	}
+	return sum;
+}
+
+int main() {
+	unsigned int errors;
+	unsigned int (*func)(void);
+
+	errors = 0;
+
+	// Sections are linked at the base addresses of the memories
+	if (((unsigned int)prefix_sum & 0xFFF00000) != (unsigned int)ITCM_BASE_ADDR) {
+		errors++;
+	}
+	if (((unsigned int)table & 0xFFF00000) != (unsigned int)DTCM_BASE_ADDR) {
+		errors++;
+	}
+
+	if (prefix_sum() != 31 || prefix[3] != 9 || prefix[N_WORDS-1] != 31) {
+		errors++;
+	}
+
+	// li a0, 0x5a; ret
+	__itcm_end[0] = 0x05a00513;
+	__itcm_end[1] = 0x00008067;
+	// Stores are completed before the fetch
+	FENCE();
+	func = (unsigned int (*)(void))__itcm_end;
+	if (func() != 0x5a) {
+		errors++;
+	}
+	return errors;
+}
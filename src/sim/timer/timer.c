@@ -0,0 +1,59 @@
+#include "timer.h"
+
+// Sleep in wfi with TIMER_DELAY (interrupts disabled, the timer only wakes
+//  up the CPU), then take the timer interrupt with a handler.
+// While sleeping the cycle counter keeps running and almost no instructions
+//  are retired (the pipeline clock is stopped).
+// The number of errors is returned (a0 at the end of the simulation)
+
+#define DELAY     4000
+#define IRQ_DELAY 500
+
+volatile unsigned int timer_count;
+volatile unsigned long long irq_time;
+
+// Trap handler (direct mode, mtvec needs a 4-byte aligned address)
+void __attribute__((interrupt("machine"), aligned(4))) trap_handler(void) {
+	if (CSR_READ(mcause) == (MCAUSE_IRQ_M | MCAUSE_TIMER)) {
+		irq_time = TIMER_READ();
+		// A new compare value clears the interrupt
+		TIMER_SET_CMP(0xFFFFFFFFFFFFFFFFULL);
+		timer_count++;
+	}
+}
+
+int main() {
+	unsigned long long start, cmp;
+	unsigned int cycles, instret, errors;
+
+	errors = 0;
+
+	// Sleep for DELAY cycles
+	start   = TIMER_READ();
+	cycles  = PERF_CYCLE();
+	instret = PERF_INSTRET();
+	TIMER_DELAY(DELAY);
+	cycles  = PERF_CYCLE() - cycles;
+	instret = PERF_INSTRET() - instret;
+	if (TIMER_READ() - start < DELAY || cycles < DELAY) {
+		errors++;
+	}
+	if (instret > DELAY/10) {
+		errors++;
+	}
+
+	// Timer interrupt
+	IRQ_SET_HANDLER(trap_handler);
+	CSR_SET(mie, MIE_MTIE_M);
+	IRQ_GLOBAL_ENABLE();
+	cmp = TIMER_READ() + IRQ_DELAY;
+	TIMER_SET_CMP(cmp);
+	while (timer_count == 0);
+	if (irq_time < cmp) {
+		errors++;
+	}
+	if ((CSR_READ(mip) & MIE_MTIE_M) || timer_count != 1) {
+		errors++;
+	}
+	return errors;
+}
@@ -0,0 +1,301 @@
+// C++ harness of the Verilator simulation (SIMULATOR=verilator)
+// Drives clock and reset of chip_top_sim, provides the software image to the SRAM and the flash
+//   and stops at the end of the program or at the timeout, like chip_top_tb
+// Arguments: +ELF_FILE_NAME=<file> +SIM_TIMEOUT_NS=<ns> +VCD_ENABLE=<0/1> +COSIM=<0/1> +BOOT_SOURCE=<0:SPI/1:SRAM>
+// With +COSIM=1 every retired instruction is compared with the reference ISS (riscv_iss.cpp)
+//   and the simulation stops at the first mismatch
+// Exit status is 1 on timeout and on co-simulation mismatch
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "riscv_iss.h"
+#include "verilated.h"
+#include "verilated_vcd_c.h"
+#include "Vchip_top_sim.h"
+#include "Vchip_top_sim__Dpi.h"
+
+// Clock period (ns)
+static const uint64_t CLOCK = 10;
+// Reset is released after 5 clock periods
+static const uint64_t RESET_NS = CLOCK * 5;
+// Default timeout (1 ms)
+static const uint64_t DEFAULT_TIMEOUT_NS = 1000000;
+
+// Address map of the memories loaded from the software image (there is no DDR model)
+static const uint32_t SRAM_MAX_SIZE     = 0x00020000;
+static const uint32_t FLASH_WINDOW_BASE = 0x20000000;
+static const uint32_t FLASH_MAX_SIZE    = 0x01000000;
+
+// Software image, SRAM words and flash bytes
+static std::vector<uint32_t> sram_image;
+static std::vector<uint8_t> flash_image;
+// Code is executed from flash address 0 (+BOOT_SOURCE=0)
+static bool boot_from_flash = false;
+
+// Store a block of the image at its load address (false if no memory is mapped there)
+//   flash is set for code executed from flash, stored at the same address in the flash
+static bool image_store(uint32_t addr, const uint8_t *data, size_t size, bool flash) {
+    if (flash) {
+        if (static_cast<uint64_t>(addr) + size > FLASH_MAX_SIZE) {
+            return false;
+        }
+        if (flash_image.size() < addr + size) {
+            flash_image.resize(addr + size, 0);
+        }
+        std::memcpy(&flash_image[addr], data, size);
+        return true;
+    }
+    if (static_cast<uint64_t>(addr) + size <= SRAM_MAX_SIZE) {
+        if (sram_image.size() < (addr + size + 3) / 4) {
+            sram_image.resize((addr + size + 3) / 4, 0);
+        }
+        for (size_t i = 0; i < size; i++) {
+            const uint32_t byte_addr = addr + static_cast<uint32_t>(i);
+            sram_image[byte_addr / 4] |= static_cast<uint32_t>(data[i]) << (8 * (byte_addr % 4));
+        }
+        return true;
+    }
+    if (addr >= FLASH_WINDOW_BASE && static_cast<uint64_t>(addr - FLASH_WINDOW_BASE) + size <= FLASH_MAX_SIZE) {
+        const size_t offset = addr - FLASH_WINDOW_BASE;
+        if (flash_image.size() < offset + size) {
+            flash_image.resize(offset + size, 0);
+        }
+        std::memcpy(&flash_image[offset], data, size);
+        return true;
+    }
+    return false;
+}
+
+static uint32_t read_le(const std::vector<uint8_t> &file, size_t offset, size_t size) {
+    uint32_t value = 0;
+    for (size_t i = 0; i < size && offset + i < file.size(); i++) {
+        value |= static_cast<uint32_t>(file[offset + i]) << (8 * i);
+    }
+    return value;
+}
+
+// Load the segments of an ELF file at their load addresses (a file without ELF header is
+//   a raw image of the boot memory)
+// When booting from SPI the code segments (read-only, or stored at a load address different
+//   from their address like .itcm/.dtcm) are stored in the flash
+static bool load_image(const std::string &file_name) {
+    std::ifstream stream(file_name, std::ios::binary);
+    if (!stream) {
+        return false;
+    }
+    const std::vector<uint8_t> file((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+
+    if (file.size() < 52 || read_le(file, 0, 4) != 0x464c457f) {
+        image_store(0, file.data(), std::min<size_t>(file.size(), boot_from_flash ? FLASH_MAX_SIZE : SRAM_MAX_SIZE), boot_from_flash);
+        return true;
+    }
+    // Program headers of ELF32 files
+    const uint32_t ph_offset = read_le(file, 0x1c, 4);
+    const uint32_t ph_size   = read_le(file, 0x2a, 2);
+    const uint32_t ph_num    = read_le(file, 0x2c, 2);
+    for (uint32_t i = 0; i < ph_num; i++) {
+        const size_t   header = ph_offset + static_cast<size_t>(i) * ph_size;
+        const uint32_t type   = read_le(file, header, 4);
+        const uint32_t offset = read_le(file, header + 4, 4);
+        const uint32_t vaddr  = read_le(file, header + 8, 4);
+        const uint32_t addr   = read_le(file, header + 12, 4);
+        const uint32_t size   = read_le(file, header + 16, 4);
+        const uint32_t flags  = read_le(file, header + 24, 4);
+        // Code segments are not writable (PF_W) or are copied from their load address
+        const bool flash = boot_from_flash && (!(flags & 2) || vaddr != addr);
+        // Loadable segments with content in the file (.bss is cleared by crt0)
+        if (type != 1 || size == 0) {
+            continue;
+        }
+        if (static_cast<uint64_t>(offset) + size > file.size()) {
+            fprintf(stderr, "Error: segment at 0x%08x is truncated in %s\n", addr, file_name.c_str());
+            return false;
+        }
+        if (!image_store(addr, &file[offset], size, flash)) {
+            printf("Warning: segment at 0x%08x (%u bytes) is outside of SRAM and flash, not loaded\n", addr, size);
+        }
+    }
+    return true;
+}
+
+// Word of the software image, read when chip_top_sim initializes the SRAM banks
+//   (words after the end of the image are 0)
+unsigned int sram_image_word(unsigned int index) {
+    return (index < sram_image.size()) ? sram_image[index] : 0;
+}
+
+// Flash content of the software image, read by chip_top_sim on the first clock edge
+unsigned int flash_image_size() {
+    return static_cast<unsigned int>(flash_image.size());
+}
+
+unsigned char flash_image_byte(unsigned int index) {
+    return (index < flash_image.size()) ? flash_image[index] : 0;
+}
+
+/* ---------------------------------------------------
+* Lock-step co-simulation
+* --------------------------------------------------*/
+static bool cosim_enable = false;
+static bool cosim_failed = false;
+static uint64_t cosim_instret = 0;
+static RiscvIss iss;
+
+static void cosim_mismatch(const char *reason, const IssCommit &dut, const IssCommit &model) {
+    printf("Error: co-simulation mismatch (%s) at instruction %llu\n", reason, static_cast<unsigned long long>(cosim_instret));
+    printf("  CPU: %s\n", iss_commit_string(dut).c_str());
+    printf("  ISS: %s\n", iss_commit_string(model).c_str());
+    cosim_failed = true;
+}
+
+// Memories of the model, called once by chip_top_sim (returns 1 if the co-simulation is enabled)
+int cosim_init(unsigned int ram_size, unsigned int itcm_size, unsigned int dtcm_size) {
+    if (!cosim_enable) {
+        return 0;
+    }
+    iss.add_memory(0x00000000, ram_size);
+    iss.add_memory(0x00100000, itcm_size);
+    iss.add_memory(0x00200000, dtcm_size);
+    for (size_t i = 0; i < sram_image.size(); i++) {
+        iss.write_word(static_cast<uint32_t>(4 * i), sram_image[i]);
+    }
+    return 1;
+}
+
+// Instruction leaving the MEM stage of the CPU (returns 1 on mismatch)
+int cosim_retire(unsigned int pc, svBit rd_write, unsigned int rd, unsigned int rd_value,
+                 svBit store, unsigned int addr, unsigned int data, unsigned int mask) {
+    IssCommit dut = {};
+    dut.pc         = pc;
+    dut.rd_write   = rd_write && (rd != 0);
+    dut.rd         = rd;
+    dut.rd_value   = rd_value;
+    dut.store      = store;
+    dut.mem_addr   = addr;
+    dut.store_data = data;
+    dut.store_mask = mask;
+
+    const IssCommit model = iss.step(rd_value);
+    cosim_instret++;
+
+    // Only the bytes written in memory are compared (sb/sh drive the data on all lanes)
+    uint32_t byte_mask = 0;
+    for (unsigned int i = 0; i < 4; i++) {
+        byte_mask |= ((mask >> i) & 1) ? (0xffu << (8 * i)) : 0;
+    }
+    if (model.illegal) {
+        cosim_mismatch("illegal instruction", dut, model);
+    } else if (dut.pc != model.pc) {
+        cosim_mismatch("pc", dut, model);
+    } else if (dut.rd_write != model.rd_write || (dut.rd_write && (dut.rd != model.rd || dut.rd_value != model.rd_value))) {
+        cosim_mismatch("register write", dut, model);
+    } else if (dut.store != model.store || (dut.store && (dut.mem_addr != model.mem_addr || dut.store_mask != model.store_mask ||
+                                                         (dut.store_data & byte_mask) != (model.store_data & byte_mask)))) {
+        cosim_mismatch("store", dut, model);
+    }
+    return cosim_failed ? 1 : 0;
+}
+
+// Interrupt taken by the CPU before the instruction at epc (returns 1 on mismatch)
+int cosim_interrupt(unsigned int epc, unsigned int vector, unsigned int cause) {
+    if (epc != iss.pc()) {
+        printf("Error: co-simulation mismatch (interrupt) at instruction %llu\n", static_cast<unsigned long long>(cosim_instret));
+        printf("  CPU: interrupt %u, mepc 0x%08x\n", cause, epc);
+        printf("  ISS: pc 0x%08x\n", iss.pc());
+        cosim_failed = true;
+        return 1;
+    }
+    iss.interrupt(vector, cause);
+    return 0;
+}
+
+// Value of a +NAME=value argument (empty if the argument is not specified)
+static std::string plusarg(VerilatedContext *contextp, const char *name) {
+    const std::string prefix = std::string(name) + "=";
+    const char *arg = contextp->commandArgsPlusMatch(prefix.c_str());
+    if (arg == nullptr || arg[0] == '\0') {
+        return "";
+    }
+    return std::string(arg + prefix.size() + 1);
+}
+
+int main(int argc, char **argv) {
+    const std::unique_ptr<VerilatedContext> contextp{new VerilatedContext};
+    contextp->commandArgs(argc, argv);
+
+    // Load software into memory
+    const std::string elf_file_name = plusarg(contextp.get(), "ELF_FILE_NAME");
+    if (elf_file_name.empty()) {
+        fprintf(stderr, "Error: ELF_FILE_NAME argument is not specified\n");
+        return 1;
+    }
+    boot_from_flash = (plusarg(contextp.get(), "BOOT_SOURCE") == "0");
+    if (!load_image(elf_file_name)) {
+        fprintf(stderr, "Error: cannot load %s\n", elf_file_name.c_str());
+        return 1;
+    }
+
+    // Simulation timeout value (in nanoseconds)
+    const std::string timeout_arg = plusarg(contextp.get(), "SIM_TIMEOUT_NS");
+    uint64_t timeout_ns = timeout_arg.empty() ? 0 : std::stoull(timeout_arg);
+    if (timeout_ns == 0) {
+        timeout_ns = DEFAULT_TIMEOUT_NS;
+    }
+
+    cosim_enable = (plusarg(contextp.get(), "COSIM") == "1");
+    // Instruction fetches of the model read its memory at address 0, which is the SRAM
+    if (cosim_enable && boot_from_flash) {
+        fprintf(stderr, "Error: co-simulation is supported only when booting from SRAM\n");
+        return 1;
+    }
+
+    // Save VCD file (tracing must be enabled before the model is built)
+    const bool vcd_enable = (plusarg(contextp.get(), "VCD_ENABLE") == "1");
+    contextp->traceEverOn(vcd_enable);
+
+    const std::unique_ptr<Vchip_top_sim> top{new Vchip_top_sim{contextp.get()}};
+    std::unique_ptr<VerilatedVcdC> vcd;
+    if (vcd_enable) {
+        vcd.reset(new VerilatedVcdC);
+        top->trace(vcd.get(), 99);
+        vcd->open("dump.vcd");
+    }
+
+    // Clock starts low, one half period for each evaluation
+    top->clk_i  = 0;
+    top->rst_ni = 0;
+    while (!contextp->gotFinish() && contextp->time() < timeout_ns) {
+        // Releasing reset
+        if (contextp->time() >= RESET_NS) {
+            top->rst_ni = 1;
+        }
+        top->eval();
+        if (vcd) {
+            vcd->dump(contextp->time());
+        }
+        contextp->timeInc(CLOCK / 2);
+        top->clk_i = !top->clk_i;
+    }
+
+    // The model stops itself when the trap is asserted (register file is written by chip_top_sim)
+    const bool timed_out = !contextp->gotFinish();
+    if (timed_out) {
+        printf("Warning: Simulation timed out at time %llu ns\n", static_cast<unsigned long long>(contextp->time()));
+    } else if (cosim_enable && !cosim_failed) {
+        printf("Co-simulation passed: %llu instructions compared\n", static_cast<unsigned long long>(cosim_instret));
+    }
+
+    top->final();
+    if (vcd) {
+        vcd->close();
+    }
+    // Exit status is not 0 on mismatch and on timeout, so make and the runners see the failure
+    return (cosim_failed || timed_out) ? 1 : 0;
+}
@@ -0,0 +1,163 @@
+`timescale  1ns/1ns
+
+// Top level for the Verilator simulation (SIMULATOR=verilator)
+// Same environment as chip_top_tb without timing constructs: clock, reset,
+//   timeout and waveforms are handled by the C++ harness (chip_top_sim.cpp)
+module chip_top_sim #(
+	// Number of 2KB SRAM banks (set by the makefile, must match the linker script)
+	parameter RAM_BANKS = 1,
+	// Size of the tightly-coupled memories (set by the makefile, must match the linker script)
+	parameter ITCM_SIZE = 0,
+	parameter DTCM_SIZE = 0
+	)(
+	input  clk_i,
+	input  rst_ni,
+	// CPU has executed ecall/ebreak (end of the program)
+	output trap_o
+);
+
+wire spi_cs_ns, spi_sck_s;
+wire [3:0] spi_io_s;
+wire uart_loop;
+// Boot source (+BOOT_SOURCE argument set by the makefile from the linker script, SRAM by default)
+reg [1:0] boot_source_r;
+initial begin
+	if (!$value$plusargs("BOOT_SOURCE=%d", boot_source_r)) begin
+		boot_source_r = 2'd1;
+	end
+end
+chip_top #(
+	.RAM_BANKS(RAM_BANKS),
+	.ITCM_SIZE(ITCM_SIZE),
+	.DTCM_SIZE(DTCM_SIZE)
+	)
+	DUT(
+	.clk_i(clk_i),
+	.rst_ni(rst_ni),
+	// Boot source strapping pins
+	// 0:SPI, 1:SRAM, 2:DDR
+	.boot_source_i(boot_source_r),
+	// UART
+	.tx_o(uart_loop),
+	.rx_i(uart_loop),
+	// SPI
+	.spi_sck_o(spi_sck_s),
+	.spi_cs_no(spi_cs_ns),
+	.spi_io(spi_io_s)
+);
+
+
+// Quad SPI flash connected to the SPI master
+localparam FLASH_SIZE = 65536;
+// Lanes are pulled up when not driven (WP#/HOLD# inactive)
+pullup(spi_io_s[0]);
+pullup(spi_io_s[1]);
+pullup(spi_io_s[2]);
+pullup(spi_io_s[3]);
+spi_flash_model #(
+	.SIZE(FLASH_SIZE)
+	)
+	inst_spi_flash (
+	.sck_i(spi_sck_s),
+	.cs_ni(spi_cs_ns),
+	.sio(spi_io_s)
+);
+
+
+// Software image, the harness reads the +ELF_FILE_NAME file and places its segments
+//   in the SRAM and in the flash
+// Consecutive words are stored in different SRAM banks
+import "DPI-C" function int unsigned sram_image_word(input int unsigned index);
+import "DPI-C" function int unsigned flash_image_size();
+import "DPI-C" function byte unsigned flash_image_byte(input int unsigned index);
+
+genvar bank_idx;
+generate
+	for (bank_idx = 0; bank_idx < RAM_BANKS; bank_idx = bank_idx + 1) begin : gen_sram_load
+		integer row;
+		initial begin
+			for (row = 0; row < 512; row = row + 1) begin
+				DUT.inst_ram_wrapper.gen_bank[bank_idx].inst_ram.mem[row] = {1'b0, sram_image_word((row*RAM_BANKS)+bank_idx)};
+			end
+		end
+	end
+endgenerate
+
+// The flash is written on the first clock edge, after the initialization of the flash model
+reg flash_loaded_r = 1'b0;
+integer flash_idx;
+always @(posedge clk_i) begin
+	if (!flash_loaded_r) begin
+		if (flash_image_size() > FLASH_SIZE) begin
+			$display("Warning: flash image (%0d bytes) is larger than the flash model, not fully loaded", flash_image_size());
+		end
+		for (flash_idx = 0; flash_idx < flash_image_size() && flash_idx < FLASH_SIZE; flash_idx = flash_idx + 1) begin
+			inst_spi_flash.mem[flash_idx] = flash_image_byte(flash_idx);
+		end
+		flash_loaded_r <= 1'b1;
+	end
+end
+
+
+// Lock-step co-simulation with the reference ISS of the harness (+COSIM=1)
+// Each instruction leaving the MEM stage is executed by the model and its pc, register write
+//   and store are compared, the simulation stops at the first mismatch
+import "DPI-C" function int cosim_init(input int unsigned ram_size, input int unsigned itcm_size, input int unsigned dtcm_size);
+import "DPI-C" function int cosim_retire(input int unsigned pc, input bit rd_write, input int unsigned rd, input int unsigned rd_value,
+                                         input bit store, input int unsigned addr, input int unsigned data, input int unsigned mask);
+import "DPI-C" function int cosim_interrupt(input int unsigned epc, input int unsigned vector, input int unsigned cause);
+
+reg cosim_en_r;
+initial begin
+	cosim_en_r = (cosim_init(RAM_BANKS*2048, ITCM_SIZE, DTCM_SIZE) != 0);
+end
+
+// Value written in rd when the instruction reaches WB
+wire [31:0] cosim_rd_value_s = (DUT.inst_cpu.mem_to_reg_mem_r == 1'b1) ? DUT.inst_cpu.data_mem_o : DUT.inst_cpu.alu_result_mem_r;
+
+always @(posedge clk_i) begin
+	if (cosim_en_r && rst_ni) begin
+		// Instruction retired before an interrupt taken in the same cycle
+		if (DUT.inst_cpu.instret_s) begin
+			if (cosim_retire(DUT.inst_cpu.instr_addr_mem_r, DUT.inst_cpu.reg_write_mem_r, {27'd0, DUT.inst_cpu.rd_addr_mem_r}, cosim_rd_value_s,
+			                 DUT.inst_cpu.mem_write_mem_r, DUT.inst_cpu.alu_result_mem_r, DUT.inst_cpu.data_mem_data_o, {28'd0, DUT.inst_cpu.byte_select_o}) != 0) begin
+				$display("Co-simulation stopped at time  %d ns", $time);
+				$finish;
+			end
+		end
+		if (DUT.inst_cpu.irq_take_s) begin
+			if (cosim_interrupt(DUT.inst_cpu.instr_addr_ex_r, DUT.inst_cpu.trap_vector_s, {28'd0, DUT.inst_cpu.inst_csr_file.irq_code_s}) != 0) begin
+				$display("Co-simulation stopped at time  %d ns", $time);
+				$finish;
+			end
+		end
+	end
+end
+
+
+// Performance report written when the program ends (task write_perf_report)
+`include "perf_report.vh"
+
+
+// Stop the simulation when the trap is asserted and print register file content
+assign trap_o = DUT.inst_cpu.trap_o;
+integer file;
+integer i;
+always @(posedge clk_i) begin
+	if (trap_o) begin
+		$display("Trap asserted at time  %d ns", $time);
+		file = $fopen("register_file_dut.txt", "w");
+		if (file != 0) begin
+			$fdisplay(file, "===== register values");
+			for (i = 0; i < 32; i=i+1) begin
+				$fdisplay(file, "x%0d:\t%0d\t(0x%08x)", i, $signed(DUT.inst_cpu.inst_register_file.registers[i]), DUT.inst_cpu.inst_register_file.registers[i]);
+			end
+			$fdisplay(file, "");
+			$fclose(file);
+		end
+		write_perf_report;
+		$finish;
+	end
+end
+
+endmodule
@@ -3,6 +3,11 @@
 module chip_top_tb ();
 
 localparam CLOCK = 10;
+// Number of 2KB SRAM banks (set by the makefile, must match the linker script)
+parameter RAM_BANKS = 1;
+// Size of the tightly-coupled memories (set by the makefile, must match the linker script)
+parameter ITCM_SIZE = 0;
+parameter DTCM_SIZE = 0;
 reg clk_i_s, rst_i_s;
 
 `ifdef DDR
@@ -23,25 +28,34 @@ wire [1:0]  ddr3_dm_fpga;
 wire        ddr3_odt_fpga;
 `endif
 
-wire spi_cs_ns, spi_mosi_s, spi_miso_s, wp_ns, hold_ns, spi_sck_s;
+wire spi_cs_ns, spi_sck_s;
+wire [3:0] spi_io_s;
 wire uart_loop;
-localparam BOOT_SOURCE = 2'b1;
-chip_top DUT(
+// Boot source (+BOOT_SOURCE argument set by the makefile from the linker script, SRAM by default)
+reg [1:0] boot_source_r;
+initial begin
+	if (!$value$plusargs("BOOT_SOURCE=%d", boot_source_r)) begin
+		boot_source_r = 2'd1;
+	end
+end
+chip_top #(
+	.RAM_BANKS(RAM_BANKS),
+	.ITCM_SIZE(ITCM_SIZE),
+	.DTCM_SIZE(DTCM_SIZE)
+	)
+	DUT(
 	.clk_i(clk_i_s),
     .rst_ni(rst_i_s),
     // Boot source strapping pins
 	// 0:SPI, 1:SRAM, 2:DDR
-	.boot_source_i(BOOT_SOURCE),
+	.boot_source_i(boot_source_r),
 	// UART
     .tx_o(uart_loop),
     .rx_i(uart_loop),
 	// SPI
     .spi_sck_o(spi_sck_s),
 	.spi_cs_no(spi_cs_ns),
-	.spi_mosi_o(spi_mosi_s),
-	.spi_miso_i(spi_miso_s),
-	.wp_no(wp_ns),
-	.hold_no(hold_ns)
+	.spi_io(spi_io_s)
 `ifdef DDR
     ,
 	// DDR
@@ -65,6 +79,24 @@ chip_top DUT(
 );
 
 
+// Quad SPI flash connected to the SPI master (seen by the CPU through the flash window)
+localparam FLASH_SIZE = 65536;
+localparam FLASH_BASE = 32'h20000000;
+// Lanes are pulled up when not driven (WP#/HOLD# inactive)
+pullup(spi_io_s[0]);
+pullup(spi_io_s[1]);
+pullup(spi_io_s[2]);
+pullup(spi_io_s[3]);
+spi_flash_model #(
+	.SIZE(FLASH_SIZE)
+	)
+	inst_spi_flash (
+	.sck_i(spi_sck_s),
+	.cs_ni(spi_cs_ns),
+	.sio(spi_io_s)
+);
+
+
 //Generation of the clock signal
 always begin
 	#(CLOCK/2)
@@ -84,17 +116,73 @@ initial begin
 end
 
 
+// Software image
+// The segments of the ELF file are stored at their load addresses, in the SRAM or in the SPI
+//   flash (through the flash window), a file without ELF header is a raw image of the boot memory
+// When booting from SPI the code segments (read-only, or stored at a load address different
+//   from their address like .itcm/.dtcm) are executed from flash address 0 and are stored in the flash
+localparam SRAM_SIZE = 2048*RAM_BANKS;
+// Consecutive words are stored in different SRAM banks
+reg [31:0] sram_image_r [0:(512*RAM_BANKS)-1];
+reg sram_loaded_r = 1'b0;
+reg [0:1023] ELF_FILE_NAME;
+integer elf_fd, elf_seek, elf_byte, seg_idx, byte_idx;
+reg [31:0] elf_magic, ph_offset, ph_num, ph_size, seg_type, seg_offset, seg_vaddr, seg_addr, seg_size, seg_flags;
+reg seg_flash;
+
+// Little-endian value of n bytes at offset of the file
+task elf_read;
+	input  integer offset;
+	input  integer n;
+	output [31:0] value;
+	integer k;
+	begin
+		elf_seek = $fseek(elf_fd, offset, 0);
+		value = 32'd0;
+		for (k = 0; k < n; k = k + 1) begin
+			value[8*k +: 8] = $fgetc(elf_fd);
+		end
+	end
+endtask
+
+// Store a byte of the image in the memory mapped at addr (flash is set for code executed from flash)
+task image_store;
+	input [31:0] addr;
+	input [7:0]  data;
+	input flash;
+	begin
+		if (flash) begin
+			inst_spi_flash.mem[addr] = data;
+		end else if (addr < SRAM_SIZE) begin
+			sram_image_r[addr[31:2]][8*addr[1:0] +: 8] = data;
+		end else begin
+			inst_spi_flash.mem[addr - FLASH_BASE] = data;
+		end
+	end
+endtask
+
+// Segments can only be loaded in the SRAM and in the flash (there is no DDR model)
+function image_valid;
+	input [31:0] addr;
+	input [31:0] size;
+	input flash;
+	begin
+		if (flash) begin
+			image_valid = (addr + size <= FLASH_SIZE);
+		end else begin
+			image_valid = ((addr + size <= SRAM_SIZE) ||
+			               (addr >= FLASH_BASE && addr - FLASH_BASE + size <= FLASH_SIZE));
+		end
+	end
+endfunction
+
 // Parsing simulation arguments
-reg [0:1023] SRAM_FILE_NAME;
 reg [31:0] SIM_TIMEOUT_NS;
 reg VCD_ENABLE;
 initial begin
-    // Load software into memory
-    if (!$value$plusargs("SRAM_FILE_NAME=%s", SRAM_FILE_NAME)) begin
-        $error("SRAM_FILE_NAME argument is not specified");
+    if (!$value$plusargs("ELF_FILE_NAME=%s", ELF_FILE_NAME)) begin
+        $error("ELF_FILE_NAME argument is not specified");
         $finish;
-    end else begin
-	    $readmemb(SRAM_FILE_NAME, DUT.inst_ram_wrapper.inst_ram.mem);
     end
 
     // Save VCD file
@@ -109,9 +197,78 @@ initial begin
         SIM_TIMEOUT_NS = 1000000;
     end
 
+    // Load software into memory
+    // (after the initialization of the flash model, that is overwritten by the image)
+    #1;
+    elf_fd = $fopen(ELF_FILE_NAME, "rb");
+    if (elf_fd == 0) begin
+        $error("Cannot open %0s", ELF_FILE_NAME);
+        $finish;
+    end
+    for (byte_idx = 0; byte_idx < 512*RAM_BANKS; byte_idx = byte_idx + 1) begin
+        sram_image_r[byte_idx] = 32'd0;
+    end
+    elf_read(0, 4, elf_magic);
+    if (elf_magic == 32'h464c457f) begin
+        // Program headers of ELF32 files
+        elf_read(32'h1c, 4, ph_offset);
+        elf_read(32'h2a, 2, ph_size);
+        elf_read(32'h2c, 2, ph_num);
+        for (seg_idx = 0; seg_idx < ph_num; seg_idx = seg_idx + 1) begin
+            elf_read(ph_offset + seg_idx*ph_size,      4, seg_type);
+            elf_read(ph_offset + seg_idx*ph_size + 4,  4, seg_offset);
+            elf_read(ph_offset + seg_idx*ph_size + 8,  4, seg_vaddr);
+            elf_read(ph_offset + seg_idx*ph_size + 12, 4, seg_addr);
+            elf_read(ph_offset + seg_idx*ph_size + 16, 4, seg_size);
+            elf_read(ph_offset + seg_idx*ph_size + 24, 4, seg_flags);
+            // Code segments are not writable (PF_W) or are copied from their load address
+            seg_flash = (boot_source_r == 2'd0) && (!seg_flags[1] || seg_vaddr != seg_addr);
+            // Loadable segments with content in the file (.bss is cleared by crt0)
+            if (seg_type == 32'd1 && seg_size != 32'd0) begin
+                if (!image_valid(seg_addr, seg_size, seg_flash)) begin
+                    $display("Warning: segment at 0x%08x (%0d bytes) is outside of SRAM and flash, not loaded", seg_addr, seg_size);
+                end else begin
+                    elf_seek = $fseek(elf_fd, seg_offset, 0);
+                    for (byte_idx = 0; byte_idx < seg_size; byte_idx = byte_idx + 1) begin
+                        image_store(seg_addr + byte_idx, $fgetc(elf_fd), seg_flash);
+                    end
+                end
+            end
+        end
+    end else begin
+        // Raw binary image of the boot memory (SRAM or flash)
+        seg_flash = (boot_source_r == 2'd0);
+        elf_seek = $fseek(elf_fd, 0, 0);
+        elf_byte = $fgetc(elf_fd);
+        for (byte_idx = 0; byte_idx < (seg_flash ? FLASH_SIZE : SRAM_SIZE) && elf_byte != -1; byte_idx = byte_idx + 1) begin
+            image_store(byte_idx, elf_byte, seg_flash);
+            elf_byte = $fgetc(elf_fd);
+        end
+    end
+    $fclose(elf_fd);
+    sram_loaded_r = 1'b1;
 end
 
 
+// Copy the software image into the SRAM banks
+genvar bank_idx;
+generate
+	for (bank_idx = 0; bank_idx < RAM_BANKS; bank_idx = bank_idx + 1) begin : gen_sram_load
+		integer row;
+		initial begin
+			wait (sram_loaded_r);
+			for (row = 0; row < 512; row = row + 1) begin
+				DUT.inst_ram_wrapper.gen_bank[bank_idx].inst_ram.mem[row] = {1'b0, sram_image_r[(row*RAM_BANKS)+bank_idx]};
+			end
+		end
+	end
+endgenerate
+
+
+// Performance report written when the program ends (task write_perf_report)
+`include "perf_report.vh"
+
+
 integer file;
 integer i;
 initial begin
@@ -137,6 +294,7 @@ initial begin
             $fdisplay(file, "");
             $fclose(file);
         end
+        write_perf_report;
         $finish;
     end else begin
         $warning("Simulation timed out at time %d ns", $time);
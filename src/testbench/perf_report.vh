@@ -0,0 +1,38 @@
+// Performance report written when the program ends (perf_report.json)
+// Included in the testbench modules chip_top_tb and chip_top_sim, the design instance is DUT
+// The benchmarks of src/bench stop the counters around the measured kernel and leave in
+//   mscratch the number of bytes it has moved (src/bench/common/bench.h)
+real cpi_r, bytes_per_cycle_r;
+integer perf_file;
+task write_perf_report;
+	begin
+		cpi_r = 0.0;
+		bytes_per_cycle_r = 0.0;
+		if (DUT.inst_cpu.inst_csr_file.minstret_r != 64'd0) begin
+			cpi_r = DUT.inst_cpu.inst_csr_file.mcycle_r;
+			cpi_r = cpi_r / DUT.inst_cpu.inst_csr_file.minstret_r;
+		end
+		if (DUT.inst_cpu.inst_csr_file.mcycle_r != 64'd0) begin
+			bytes_per_cycle_r = DUT.inst_cpu.inst_csr_file.mscratch_r;
+			bytes_per_cycle_r = bytes_per_cycle_r / DUT.inst_cpu.inst_csr_file.mcycle_r;
+		end
+		perf_file = $fopen("perf_report.json", "w");
+		if (perf_file != 0) begin
+			$fdisplay(perf_file, "{");
+			$fdisplay(perf_file, "  \"cycles\": %0d,", DUT.inst_cpu.inst_csr_file.mcycle_r);
+			$fdisplay(perf_file, "  \"instret\": %0d,", DUT.inst_cpu.inst_csr_file.minstret_r);
+			$fdisplay(perf_file, "  \"cpi\": %0.4f,", cpi_r);
+			$fdisplay(perf_file, "  \"bytes\": %0d,", DUT.inst_cpu.inst_csr_file.mscratch_r);
+			$fdisplay(perf_file, "  \"bytes_per_cycle\": %0.4f,", bytes_per_cycle_r);
+			$fdisplay(perf_file, "  \"instr_wait\": %0d,", DUT.inst_cpu.inst_csr_file.mhpmcounter_r[0]);
+			$fdisplay(perf_file, "  \"data_wait\": %0d,", DUT.inst_cpu.inst_csr_file.mhpmcounter_r[1]);
+			$fdisplay(perf_file, "  \"load_use\": %0d,", DUT.inst_cpu.inst_csr_file.mhpmcounter_r[2]);
+			$fdisplay(perf_file, "  \"branch_flush\": %0d,", DUT.inst_cpu.inst_csr_file.mhpmcounter_r[3]);
+			$fdisplay(perf_file, "  \"copy_stall\": %0d,", DUT.inst_cpu.inst_csr_file.mhpmcounter_r[4]);
+			$fdisplay(perf_file, "  \"muldiv_stall\": %0d,", DUT.inst_cpu.inst_csr_file.mhpmcounter_r[5]);
+			$fdisplay(perf_file, "  \"return_value\": %0d", $signed(DUT.inst_cpu.inst_register_file.registers[10]));
+			$fdisplay(perf_file, "}");
+			$fclose(perf_file);
+		end
+	end
+endtask
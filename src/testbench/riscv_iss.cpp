@@ -0,0 +1,463 @@
+// Reference instruction set simulator of the co-simulation (see riscv_iss.h)
+#include "riscv_iss.h"
+
+#include <cstdio>
+
+// CSR addresses
+static const uint32_t MSTATUS       = 0x300;
+static const uint32_t MIE           = 0x304;
+static const uint32_t MTVEC         = 0x305;
+static const uint32_t MCOUNTINHIBIT = 0x320;
+static const uint32_t MHPMEVENT3    = 0x323;
+static const uint32_t MSCRATCH      = 0x340;
+static const uint32_t MEPC          = 0x341;
+static const uint32_t MCAUSE        = 0x342;
+static const uint32_t MIP           = 0x344;
+// Event counters of csr_file (hpmcounter3 to hpmcounter8)
+static const uint32_t N_HPM = 6;
+// mstatus fields implemented by the CPU
+static const uint32_t MSTATUS_MIE  = 1u << 3;
+static const uint32_t MSTATUS_MPIE = 1u << 7;
+static const uint32_t MSTATUS_MPP  = 3u << 11;
+
+static uint32_t bits(uint32_t value, unsigned int hi, unsigned int lo) {
+    return (value >> lo) & ((hi - lo == 31) ? 0xffffffffu : ((1u << (hi - lo + 1)) - 1));
+}
+
+static int32_t sign_extend(uint32_t value, unsigned int width) {
+    const uint32_t sign = 1u << (width - 1);
+    return static_cast<int32_t>((value ^ sign) - sign);
+}
+
+/* ---------------------------------------------------
+* Expansion of the compressed instructions (RV32C)
+* --------------------------------------------------*/
+static uint32_t enc_r(uint32_t funct7, uint32_t rs2, uint32_t rs1, uint32_t funct3, uint32_t rd, uint32_t opcode) {
+    return (funct7 << 25) | (rs2 << 20) | (rs1 << 15) | (funct3 << 12) | (rd << 7) | opcode;
+}
+
+static uint32_t enc_i(int32_t imm, uint32_t rs1, uint32_t funct3, uint32_t rd, uint32_t opcode) {
+    return (bits(static_cast<uint32_t>(imm), 11, 0) << 20) | (rs1 << 15) | (funct3 << 12) | (rd << 7) | opcode;
+}
+
+static uint32_t enc_s(int32_t imm, uint32_t rs2, uint32_t rs1, uint32_t funct3, uint32_t opcode) {
+    const uint32_t u = static_cast<uint32_t>(imm);
+    return (bits(u, 11, 5) << 25) | (rs2 << 20) | (rs1 << 15) | (funct3 << 12) | (bits(u, 4, 0) << 7) | opcode;
+}
+
+static uint32_t enc_b(int32_t imm, uint32_t rs2, uint32_t rs1, uint32_t funct3) {
+    const uint32_t u = static_cast<uint32_t>(imm);
+    return (bits(u, 12, 12) << 31) | (bits(u, 10, 5) << 25) | (rs2 << 20) | (rs1 << 15) | (funct3 << 12) |
+           (bits(u, 4, 1) << 8) | (bits(u, 11, 11) << 7) | 0x63;
+}
+
+static uint32_t enc_j(int32_t imm, uint32_t rd) {
+    const uint32_t u = static_cast<uint32_t>(imm);
+    return (bits(u, 20, 20) << 31) | (bits(u, 10, 1) << 21) | (bits(u, 11, 11) << 20) | (bits(u, 19, 12) << 12) |
+           (rd << 7) | 0x6f;
+}
+
+// 32-bit equivalent of a compressed instruction (0 if the instruction is illegal)
+static uint32_t expand(uint32_t c) {
+    const uint32_t rd     = bits(c, 11, 7);
+    const uint32_t rs2    = bits(c, 6, 2);
+    const uint32_t rd_p   = bits(c, 4, 2) + 8;
+    const uint32_t rs1_p  = bits(c, 9, 7) + 8;
+    const int32_t  imm6   = sign_extend((bits(c, 12, 12) << 5) | bits(c, 6, 2), 6);
+    const int32_t  j_imm  = sign_extend((bits(c, 12, 12) << 11) | (bits(c, 11, 11) << 4) | (bits(c, 10, 9) << 8) |
+                                        (bits(c, 8, 8) << 10) | (bits(c, 7, 7) << 6) | (bits(c, 6, 6) << 7) |
+                                        (bits(c, 5, 3) << 1) | (bits(c, 2, 2) << 5), 12);
+    const int32_t  b_imm  = sign_extend((bits(c, 12, 12) << 8) | (bits(c, 11, 10) << 3) | (bits(c, 6, 5) << 6) |
+                                        (bits(c, 4, 3) << 1) | (bits(c, 2, 2) << 5), 9);
+    const int32_t  lw_imm = static_cast<int32_t>((bits(c, 12, 10) << 3) | (bits(c, 6, 6) << 2) | (bits(c, 5, 5) << 6));
+
+    switch ((bits(c, 15, 13) << 2) | bits(c, 1, 0)) {
+        // Quadrant 0
+        case 0x00: {
+            // c.addi4spn
+            const uint32_t imm = (bits(c, 12, 11) << 4) | (bits(c, 10, 7) << 6) | (bits(c, 6, 6) << 2) | (bits(c, 5, 5) << 3);
+            return (imm == 0) ? 0 : enc_i(static_cast<int32_t>(imm), 2, 0, rd_p, 0x13);
+        }
+        case 0x08: return enc_i(lw_imm, rs1_p, 2, rd_p, 0x03);          // c.lw
+        case 0x18: return enc_s(lw_imm, rd_p, rs1_p, 2, 0x23);          // c.sw
+
+        // Quadrant 1
+        case 0x01: return enc_i(imm6, rd, 0, rd, 0x13);                 // c.addi, c.nop
+        case 0x05: return enc_j(j_imm, 1);                              // c.jal
+        case 0x09: return enc_i(imm6, 0, 0, rd, 0x13);                  // c.li
+        case 0x0d:
+            if (rd == 2) {
+                // c.addi16sp
+                const int32_t imm = sign_extend((bits(c, 12, 12) << 9) | (bits(c, 6, 6) << 4) | (bits(c, 5, 5) << 6) |
+                                                (bits(c, 4, 3) << 7) | (bits(c, 2, 2) << 5), 10);
+                return (imm == 0) ? 0 : enc_i(imm, 2, 0, 2, 0x13);
+            }
+            // c.lui
+            return (imm6 == 0) ? 0 : ((static_cast<uint32_t>(imm6) << 12) | (rd << 7) | 0x37);
+        case 0x11:
+            switch (bits(c, 11, 10)) {
+                case 0: return enc_r(0x00, bits(c, 6, 2), rs1_p, 5, rs1_p, 0x13);  // c.srli
+                case 1: return enc_r(0x20, bits(c, 6, 2), rs1_p, 5, rs1_p, 0x13);  // c.srai
+                case 2: return enc_i(imm6, rs1_p, 7, rs1_p, 0x13);                 // c.andi
+                default:
+                    if (bits(c, 12, 12) != 0) {
+                        return 0;
+                    }
+                    switch (bits(c, 6, 5)) {
+                        case 0:  return enc_r(0x20, rd_p, rs1_p, 0, rs1_p, 0x33);   // c.sub
+                        case 1:  return enc_r(0x00, rd_p, rs1_p, 4, rs1_p, 0x33);   // c.xor
+                        case 2:  return enc_r(0x00, rd_p, rs1_p, 6, rs1_p, 0x33);   // c.or
+                        default: return enc_r(0x00, rd_p, rs1_p, 7, rs1_p, 0x33);   // c.and
+                    }
+            }
+        case 0x15: return enc_j(j_imm, 0);                              // c.j
+        case 0x19: return enc_b(b_imm, 0, rs1_p, 0);                    // c.beqz
+        case 0x1d: return enc_b(b_imm, 0, rs1_p, 1);                    // c.bnez
+
+        // Quadrant 2
+        case 0x02: return enc_r(0x00, bits(c, 6, 2), rd, 1, rd, 0x13);  // c.slli
+        case 0x0a: {
+            // c.lwsp
+            const uint32_t imm = (bits(c, 12, 12) << 5) | (bits(c, 6, 4) << 2) | (bits(c, 3, 2) << 6);
+            return (rd == 0) ? 0 : enc_i(static_cast<int32_t>(imm), 2, 2, rd, 0x03);
+        }
+        case 0x12:
+            if (bits(c, 12, 12) == 0) {
+                if (rs2 == 0) {
+                    return (rd == 0) ? 0 : enc_i(0, rd, 0, 0, 0x67);    // c.jr
+                }
+                return enc_r(0x00, rs2, 0, 0, rd, 0x33);                // c.mv
+            }
+            if (rs2 == 0) {
+                return (rd == 0) ? 0x00100073 : enc_i(0, rd, 0, 1, 0x67);  // c.ebreak, c.jalr
+            }
+            return enc_r(0x00, rs2, rd, 0, rd, 0x33);                   // c.add
+        case 0x1a: {
+            // c.swsp
+            const uint32_t imm = (bits(c, 12, 9) << 2) | (bits(c, 8, 7) << 6);
+            return enc_s(static_cast<int32_t>(imm), rs2, 2, 2, 0x23);
+        }
+
+        default:
+            return 0;
+    }
+}
+
+/* ---------------------------------------------------
+* Memory
+* --------------------------------------------------*/
+void RiscvIss::add_memory(uint32_t base, uint32_t size) {
+    if (size != 0) {
+        memories_.push_back(Memory{base, std::vector<uint8_t>(size, 0)});
+    }
+}
+
+// Bytes of the model at addr (nullptr if the access is not fully inside a memory)
+uint8_t *RiscvIss::find(uint32_t addr, uint32_t size) {
+    for (Memory &memory : memories_) {
+        const uint64_t offset = static_cast<uint64_t>(addr) - memory.base;
+        if (addr >= memory.base && offset + size <= memory.bytes.size()) {
+            return &memory.bytes[offset];
+        }
+    }
+    return nullptr;
+}
+
+bool RiscvIss::write_word(uint32_t addr, uint32_t data) {
+    uint8_t *bytes = find(addr, 4);
+    if (bytes == nullptr) {
+        return false;
+    }
+    for (unsigned int i = 0; i < 4; i++) {
+        bytes[i] = static_cast<uint8_t>(data >> (8 * i));
+    }
+    return true;
+}
+
+/* ---------------------------------------------------
+* CSRs
+* --------------------------------------------------*/
+// Counters (mcycle, minstret, mhpmcounter*, their high halves and user mode shadows) and mip
+//   depend on the timing of the CPU and of the interrupt sources, they are read from the CPU
+static bool csr_from_dut(uint32_t csr) {
+    const uint32_t counter = csr & ~0x9fu;
+    return counter == 0xb00 || counter == 0xc00 || csr == MIP;
+}
+
+// Registers that are not implemented by csr_file read as 0
+uint32_t RiscvIss::csr_read(uint32_t csr) const {
+    if (csr >= MHPMEVENT3 && csr < MHPMEVENT3 + N_HPM) {
+        // Events are fixed, the selector reads the event number
+        return csr - MHPMEVENT3 + 1;
+    }
+    switch (csr) {
+        case MSTATUS:       return mstatus_ | MSTATUS_MPP;
+        case MIE:           return mie_;
+        case MTVEC:         return mtvec_;
+        case MCOUNTINHIBIT: return mcountinhibit_;
+        case MSCRATCH:      return mscratch_;
+        case MEPC:          return mepc_;
+        case MCAUSE:        return mcause_;
+        default:            return 0;
+    }
+}
+
+// Only the fields implemented by csr_file are stored
+void RiscvIss::csr_write(uint32_t csr, uint32_t value) {
+    switch (csr) {
+        case MSTATUS:       mstatus_       = (value & (MSTATUS_MIE | MSTATUS_MPIE)) | MSTATUS_MPP; break;
+        case MIE:           mie_           = value & 0x888; break;
+        case MTVEC:         mtvec_         = (value & ~3u) | (value & ~(value >> 1) & 1); break;
+        // Bit 1 (time) is not implemented
+        case MCOUNTINHIBIT: mcountinhibit_ = value & 0x1fd; break;
+        case MSCRATCH:      mscratch_      = value; break;
+        case MEPC:          mepc_          = value & ~1u; break;
+        case MCAUSE:        mcause_        = value & 0x8000000f; break;
+        default: break;
+    }
+}
+
+void RiscvIss::interrupt(uint32_t vector, uint32_t cause) {
+    mepc_    = pc_;
+    mcause_  = 0x80000000 | cause;
+    mstatus_ = ((mstatus_ & MSTATUS_MIE) ? MSTATUS_MPIE : 0) | MSTATUS_MPP;
+    pc_      = vector;
+}
+
+/* ---------------------------------------------------
+* Execution
+* --------------------------------------------------*/
+IssCommit RiscvIss::step(uint32_t dut_rd_value) {
+    IssCommit commit = {};
+    commit.pc = pc_;
+
+    const uint8_t *half = find(pc_, 2);
+    if (half == nullptr) {
+        commit.illegal = true;
+        return commit;
+    }
+    uint32_t instr = half[0] | (half[1] << 8);
+    uint32_t length = 2;
+    if ((instr & 3) == 3) {
+        const uint8_t *word = find(pc_, 4);
+        if (word == nullptr) {
+            commit.illegal = true;
+            return commit;
+        }
+        instr |= (word[2] << 16) | (word[3] << 24);
+        length = 4;
+    }
+    commit.instr = instr;
+
+    const uint32_t expanded = (length == 2) ? expand(instr) : instr;
+    if (expanded == 0) {
+        commit.illegal = true;
+        return commit;
+    }
+    execute(expanded, length, dut_rd_value, commit);
+    x_[0] = 0;
+    return commit;
+}
+
+void RiscvIss::execute(uint32_t instr, uint32_t length, uint32_t dut_rd_value, IssCommit &commit) {
+    const uint32_t opcode = bits(instr, 6, 0);
+    const uint32_t rd     = bits(instr, 11, 7);
+    const uint32_t funct3 = bits(instr, 14, 12);
+    const uint32_t funct7 = bits(instr, 31, 25);
+    const uint32_t a      = x_[bits(instr, 19, 15)];
+    const uint32_t b      = x_[bits(instr, 24, 20)];
+    const int32_t  imm_i  = sign_extend(bits(instr, 31, 20), 12);
+    const int32_t  imm_s  = sign_extend((bits(instr, 31, 25) << 5) | bits(instr, 11, 7), 12);
+    const int32_t  imm_b  = sign_extend((bits(instr, 31, 31) << 12) | (bits(instr, 7, 7) << 11) |
+                                        (bits(instr, 30, 25) << 5) | (bits(instr, 11, 8) << 1), 13);
+    const int32_t  imm_j  = sign_extend((bits(instr, 31, 31) << 20) | (bits(instr, 19, 12) << 12) |
+                                        (bits(instr, 20, 20) << 11) | (bits(instr, 30, 21) << 1), 21);
+
+    uint32_t next_pc = pc_ + length;
+    bool write = false;
+    uint32_t result = 0;
+
+    switch (opcode) {
+        // lui, auipc
+        case 0x37: write = true; result = instr & 0xfffff000; break;
+        case 0x17: write = true; result = pc_ + (instr & 0xfffff000); break;
+
+        // jal, jalr
+        case 0x6f:
+            write = true;
+            result = next_pc;
+            next_pc = pc_ + imm_j;
+            break;
+        case 0x67:
+            write = true;
+            result = next_pc;
+            next_pc = (a + imm_i) & ~1u;
+            break;
+
+        // beq, bne, blt, bge, bltu, bgeu
+        case 0x63: {
+            bool taken;
+            switch (funct3) {
+                case 0:  taken = (a == b); break;
+                case 1:  taken = (a != b); break;
+                case 4:  taken = (static_cast<int32_t>(a) <  static_cast<int32_t>(b)); break;
+                case 5:  taken = (static_cast<int32_t>(a) >= static_cast<int32_t>(b)); break;
+                case 6:  taken = (a <  b); break;
+                case 7:  taken = (a >= b); break;
+                default: commit.illegal = true; return;
+            }
+            if (taken) {
+                next_pc = pc_ + imm_b;
+            }
+            break;
+        }
+
+        // lb, lh, lw, lbu, lhu
+        case 0x03: {
+            const uint32_t addr = a + imm_i;
+            const uint32_t size = 1u << (funct3 & 3);
+            if ((funct3 & 3) == 3 || funct3 > 5) {
+                commit.illegal = true;
+                return;
+            }
+            commit.load = true;
+            commit.mem_addr = addr;
+            write = true;
+            const uint8_t *bytes = find(addr, size);
+            if (bytes == nullptr) {
+                // Peripheral registers are not modelled, the value read by the CPU is used
+                result = dut_rd_value;
+                commit.from_dut = true;
+                break;
+            }
+            uint32_t value = 0;
+            for (uint32_t i = 0; i < size; i++) {
+                value |= bytes[i] << (8 * i);
+            }
+            result = (funct3 & 4) ? value : static_cast<uint32_t>(sign_extend(value, 8 * size));
+            break;
+        }
+
+        // sb, sh, sw
+        case 0x23: {
+            const uint32_t addr = a + imm_s;
+            const uint32_t size = 1u << funct3;
+            if (funct3 > 2) {
+                commit.illegal = true;
+                return;
+            }
+            commit.store = true;
+            commit.mem_addr = addr;
+            commit.store_mask = ((1u << size) - 1) << (addr & 3);
+            commit.store_data = b << (8 * (addr & 3));
+            uint8_t *bytes = find(addr, size);
+            if (bytes != nullptr) {
+                for (uint32_t i = 0; i < size; i++) {
+                    bytes[i] = static_cast<uint8_t>(b >> (8 * i));
+                }
+            }
+            break;
+        }
+
+        // Immediate and register operations
+        case 0x13:
+        case 0x33: {
+            const bool reg = (opcode == 0x33);
+            const uint32_t op2 = reg ? b : static_cast<uint32_t>(imm_i);
+            write = true;
+            if (reg && funct7 == 0x01) {
+                // RV32M (division by zero and overflow results are defined by the ISA)
+                const int64_t sa = static_cast<int32_t>(a);
+                const int64_t sb = static_cast<int32_t>(b);
+                const int32_t ia = static_cast<int32_t>(a);
+                const int32_t ib = static_cast<int32_t>(b);
+                switch (funct3) {
+                    case 0: result = a * b; break;
+                    case 1: result = static_cast<uint32_t>((sa * sb) >> 32); break;
+                    case 2: result = static_cast<uint32_t>((sa * static_cast<int64_t>(b)) >> 32); break;
+                    case 3: result = static_cast<uint32_t>((static_cast<uint64_t>(a) * b) >> 32); break;
+                    case 4: result = (b == 0) ? 0xffffffffu : (ia == INT32_MIN && ib == -1) ? a : static_cast<uint32_t>(ia / ib); break;
+                    case 5: result = (b == 0) ? 0xffffffffu : a / b; break;
+                    case 6: result = (b == 0) ? a : (ia == INT32_MIN && ib == -1) ? 0 : static_cast<uint32_t>(ia % ib); break;
+                    default: result = (b == 0) ? a : a % b; break;
+                }
+                break;
+            }
+            const uint32_t shamt = op2 & 31;
+            switch (funct3) {
+                case 0: result = (reg && funct7 == 0x20) ? a - op2 : a + op2; break;
+                case 1: result = a << shamt; break;
+                case 2: result = (static_cast<int32_t>(a) < static_cast<int32_t>(op2)) ? 1 : 0; break;
+                case 3: result = (a < op2) ? 1 : 0; break;
+                case 4: result = a ^ op2; break;
+                case 5: result = (bits(instr, 30, 30) != 0) ? static_cast<uint32_t>(static_cast<int32_t>(a) >> shamt) : a >> shamt; break;
+                case 6: result = a | op2; break;
+                default: result = a & op2; break;
+            }
+            break;
+        }
+
+        // fence, fence.i (memories are coherent in the model)
+        case 0x0f:
+            break;
+
+        // System instructions and CSR accesses
+        case 0x73:
+            if (funct3 == 0) {
+                if (funct7 == 0x18) {
+                    // mret
+                    next_pc = mepc_;
+                    mstatus_ = ((mstatus_ & MSTATUS_MPIE) ? MSTATUS_MIE : 0) | MSTATUS_MPIE | MSTATUS_MPP;
+                }
+                // ecall and ebreak end the program, wfi has no effect on the architectural state
+                break;
+            } else {
+                const uint32_t csr = bits(instr, 31, 20);
+                const uint32_t src = (funct3 & 4) ? bits(instr, 19, 15) : a;
+                // Counters and pending interrupts cannot be predicted, the CPU value is used when rd is written,
+                //   the other registers are compared with the state of the model
+                commit.from_dut = (rd != 0) && csr_from_dut(csr);
+                const uint32_t old = commit.from_dut ? dut_rd_value : csr_read(csr);
+                write = true;
+                result = old;
+                switch (funct3 & 3) {
+                    case 1:  csr_write(csr, src); break;
+                    case 2:  if (bits(instr, 19, 15) != 0) csr_write(csr, old | src); break;
+                    case 3:  if (bits(instr, 19, 15) != 0) csr_write(csr, old & ~src); break;
+                    default: commit.illegal = true; return;
+                }
+            }
+            break;
+
+        default:
+            commit.illegal = true;
+            return;
+    }
+
+    if (write && rd != 0) {
+        x_[rd] = result;
+        commit.rd_write = true;
+        commit.rd = rd;
+        commit.rd_value = result;
+    }
+    pc_ = next_pc;
+}
+
+std::string iss_commit_string(const IssCommit &commit) {
+    char text[160];
+    int length = snprintf(text, sizeof(text), "pc 0x%08x", commit.pc);
+    // Instruction bits are only known by the model
+    if (commit.instr != 0) {
+        length += snprintf(text + length, sizeof(text) - length, " instr 0x%0*x", (commit.instr & 3) == 3 ? 8 : 4, commit.instr);
+    }
+    if (commit.illegal) {
+        length += snprintf(text + length, sizeof(text) - length, " (illegal)");
+    }
+    if (commit.rd_write) {
+        length += snprintf(text + length, sizeof(text) - length, " x%u <- 0x%08x", commit.rd, commit.rd_value);
+    }
+    if (commit.store) {
+        snprintf(text + length, sizeof(text) - length, " mem[0x%08x] <- 0x%08x (mask 0x%x)", commit.mem_addr, commit.store_data, commit.store_mask);
+    }
+    return text;
+}
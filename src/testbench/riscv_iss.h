@@ -0,0 +1,74 @@
+// Reference instruction set simulator (RV32IMC, Zicsr, machine mode) used for the
+//   lock-step co-simulation of the Verilator flow (chip_top_sim.cpp)
+// The model executes one instruction for each instruction retired by the CPU and reports
+//   what the instruction has done, so that the harness can compare it with the CPU
+#ifndef RISCV_ISS_H
+#define RISCV_ISS_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Effects of one instruction
+struct IssCommit {
+    uint32_t pc;
+    // Instruction bits (16-bit instructions are not expanded)
+    uint32_t instr;
+    bool     illegal;
+    // Register write (never reported for x0)
+    bool     rd_write;
+    uint32_t rd;
+    uint32_t rd_value;
+    // Data memory access, store data and byte mask use the lanes of the data memory bus
+    bool     load;
+    bool     store;
+    uint32_t mem_addr;
+    uint32_t store_data;
+    uint32_t store_mask;
+    // Value taken from the CPU (load from a peripheral or CSR read)
+    bool     from_dut;
+};
+
+class RiscvIss {
+public:
+    // Memory owned by the model (SRAM, TCMs), accesses outside of these ranges go to peripherals
+    void add_memory(uint32_t base, uint32_t size);
+    bool write_word(uint32_t addr, uint32_t data);
+
+    // Execute the instruction at pc, dut_rd_value is the value written by the CPU in rd and
+    //   is used for the results the model cannot compute (peripheral loads, counters)
+    IssCommit step(uint32_t dut_rd_value);
+    // Interrupt taken before the instruction at pc, the handler starts at vector
+    void interrupt(uint32_t vector, uint32_t cause);
+
+    uint32_t pc() const { return pc_; }
+    uint32_t reg(unsigned int idx) const { return x_[idx & 31]; }
+
+private:
+    struct Memory {
+        uint32_t base;
+        std::vector<uint8_t> bytes;
+    };
+
+    uint8_t *find(uint32_t addr, uint32_t size);
+    uint32_t csr_read(uint32_t csr) const;
+    void csr_write(uint32_t csr, uint32_t value);
+    void execute(uint32_t instr, uint32_t length, uint32_t dut_rd_value, IssCommit &commit);
+
+    std::vector<Memory> memories_;
+    uint32_t x_[32] = {};
+    uint32_t pc_ = 0;
+    // Machine mode CSRs kept by the model (counters and mip are read from the CPU)
+    uint32_t mstatus_ = 0;
+    uint32_t mie_ = 0;
+    uint32_t mtvec_ = 0;
+    uint32_t mcountinhibit_ = 0;
+    uint32_t mscratch_ = 0;
+    uint32_t mepc_ = 0;
+    uint32_t mcause_ = 0;
+};
+
+// Text of the commit for the mismatch reports
+std::string iss_commit_string(const IssCommit &commit);
+
+#endif
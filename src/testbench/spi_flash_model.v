@@ -0,0 +1,109 @@
+`timescale  1ns/1ns
+
+// Behavioral model of a quad SPI flash (SPI mode 0 and 3)
+// Supported commands: Read (0x03), Fast Read (0x0B), Dual Output Fast Read (0x3B),
+//  Quad Output Fast Read (0x6B) and Quad I/O Fast Read (0xEB, mode byte and 2 dummy bytes on 4 lanes)
+// IO0:DI/IO0, IO1:DO/IO1, IO2:WP#/IO2, IO3:HOLD#/IO3
+module spi_flash_model #(
+	// Size of the memory (bytes, power of 2), addresses wrap around
+	parameter SIZE=65536
+	)(
+	input sck_i,
+	input cs_ni,
+	inout [3:0] sio
+);
+
+reg [7:0] mem [0:SIZE-1];
+
+// Memory content from file (one hexadecimal byte per line)
+// A pattern is used when no file is specified
+reg [0:1023] FLASH_FILE_NAME;
+integer i;
+initial begin
+	if ($value$plusargs("FLASH_FILE_NAME=%s", FLASH_FILE_NAME)) begin
+		$readmemh(FLASH_FILE_NAME, mem);
+	end else begin
+		for (i = 0; i < SIZE; i = i+1) begin
+			mem[i] = i[7:0] ^ i[15:8];
+		end
+	end
+end
+
+// Command, address and number of rising edges of the transaction
+reg [7:0] cmd_r;
+reg [23:0] addr_r;
+integer edge_cnt;
+// Data lanes driven by the flash
+reg [3:0] sio_o_r, sio_oe_r;
+
+// Lanes and first rising edge of the output data depending on the command
+reg [2:0] lanes_s;
+integer data_start_s;
+always @(*) begin
+	case (cmd_r)
+		8'h03   : begin lanes_s = 3'd1; data_start_s = 32; end
+		8'h0B   : begin lanes_s = 3'd1; data_start_s = 40; end
+		8'h3B   : begin lanes_s = 3'd2; data_start_s = 40; end
+		8'h6B   : begin lanes_s = 3'd4; data_start_s = 40; end
+		// Address (6 edges), mode byte (2 edges) and 2 dummy bytes (4 edges) on 4 lanes
+		8'hEB   : begin lanes_s = 3'd4; data_start_s = 20; end
+		default : begin lanes_s = 3'd1; data_start_s = 32'h7fffffff; end
+	endcase
+end
+
+// Command and address are sampled on the rising edge
+// Each register is written by a single block, the transaction state is cleared while chip select is high
+always @(posedge sck_i or posedge cs_ni) begin
+	if (cs_ni == 1'b1) begin
+		edge_cnt = 0;
+		cmd_r    = 8'd0;
+		addr_r   = 24'd0;
+	end else begin
+		if (edge_cnt < 8) begin
+			cmd_r = {cmd_r[6:0], sio[0]};
+		end else if (cmd_r == 8'hEB && edge_cnt < 14) begin
+			addr_r = {addr_r[19:0], sio[3:0]};
+		end else if (cmd_r != 8'hEB && edge_cnt < 32) begin
+			addr_r = {addr_r[22:0], sio[0]};
+		end
+		edge_cnt = edge_cnt+1;
+		if (edge_cnt == 8 && cmd_r != 8'h03 && cmd_r != 8'h0B && cmd_r != 8'h3B && cmd_r != 8'h6B && cmd_r != 8'hEB) begin
+			$display("SPI flash model: unsupported command 0x%02x at time %0d ns", cmd_r, $time);
+		end
+	end
+end
+
+// Data is shifted out on the falling edge, most significant bits first
+integer data_bit;
+reg [7:0] data_byte;
+always @(negedge sck_i or posedge cs_ni) begin
+	if (cs_ni == 1'b1) begin
+		// End of a transaction, lanes are released
+		sio_oe_r <= 4'd0;
+	end else if (edge_cnt >= data_start_s) begin
+		data_bit  = (edge_cnt-data_start_s)*lanes_s;
+		// Bits still to be sent are aligned to the msb
+		data_byte = mem[(addr_r + data_bit/8) & (SIZE-1)] << (data_bit%8);
+		case (lanes_s)
+			3'd4 : begin
+				sio_o_r  <= data_byte[7:4];
+				sio_oe_r <= 4'b1111;
+			end
+			3'd2 : begin
+				sio_o_r  <= {2'b00, data_byte[7:6]};
+				sio_oe_r <= 4'b0011;
+			end
+			default : begin
+				sio_o_r  <= {2'b00, data_byte[7], 1'b0};
+				sio_oe_r <= 4'b0010;
+			end
+		endcase
+	end
+end
+
+assign sio[0] = (sio_oe_r[0] && !cs_ni) ? sio_o_r[0] : 1'bz;
+assign sio[1] = (sio_oe_r[1] && !cs_ni) ? sio_o_r[1] : 1'bz;
+assign sio[2] = (sio_oe_r[2] && !cs_ni) ? sio_o_r[2] : 1'bz;
+assign sio[3] = (sio_oe_r[3] && !cs_ni) ? sio_o_r[3] : 1'bz;
+
+endmodule
@@ -9,7 +9,7 @@ set_property verilog_define {FPGA} [current_fileset]
 add_files -fileset constrs_1 -norecurse ./sources/Arty-S7-25.xdc
 
 # Add design files
-add_files -norecurse {../src/design/cpu/cpu_interface_ctrl.v ../src/design/uart_ctrl/uart_ctrl.v ../src/design/cpu/byte_operation_unit.v ../src/design/uart_ctrl/axi_uart_ctrl.v ../src/design/axi_blocks/axi_interconnect.v ../src/design/spi_ctrl/axi_spi_mst.v ../src/design/axi_blocks/axi_ram_wrapper.v ../src/design/spi_ctrl/spi_boot_ctrl.v ../src/design/axi_blocks/axi_2_hs.v ../src/design/spi_ctrl/spi_mst.v ../src/design/axi_blocks/hs_2_axi.v ../src/design/cpu/register_file.v ../src/design/cpu/control_unit.v ../src/design/cpu/alu.v ../src/design/cpu/cpu.v ../src/design/fifos/sync_fifo.v ../src/design/ram_macro/sky130_sram_2kbyte_1rw_32x512_8.v ../src/design/cpu/alu_control_unit.v ../src/design/cpu/axi_cpu_interface_ctrl.v ../src/design/chip_top.v}
+add_files -norecurse {../src/design/cpu/cpu_interface_ctrl.v ../src/design/caches/icache.v ../src/design/caches/dcache.v ../src/design/cpu/store_buffer.v ../src/design/uart_ctrl/uart_ctrl.v ../src/design/cpu/byte_operation_unit.v ../src/design/uart_ctrl/axi_uart_ctrl.v ../src/design/dma_ctrl/dma_ctrl.v ../src/design/dma_ctrl/axi_dma_ctrl.v ../src/design/irq_ctrl/irq_ctrl.v ../src/design/irq_ctrl/axi_irq_ctrl.v ../src/design/axi_blocks/axi_interconnect.v ../src/design/axi_blocks/axi_lite_adapter.v ../src/design/axi_blocks/axi_arbiter.v ../src/design/spi_ctrl/axi_spi_mst.v ../src/design/axi_blocks/axi_ram_wrapper.v ../src/design/tcm/tcm.v ../src/design/tcm/axi_tcm.v ../src/design/spi_ctrl/spi_boot_ctrl.v ../src/design/spi_ctrl/spi_xip_arb.v ../src/design/spi_ctrl/axi_spi_flash.v ../src/design/axi_blocks/axi_2_hs.v ../src/design/spi_ctrl/spi_mst.v ../src/design/axi_blocks/hs_2_axi.v ../src/design/cpu/register_file.v ../src/design/cpu/branch_predictor.v ../src/design/cpu/csr_file.v ../src/design/cpu/muldiv.v ../src/design/cpu/decompressor.v ../src/design/cpu/control_unit.v ../src/design/cpu/alu.v ../src/design/cpu/clock_gate.v ../src/design/cpu/cpu.v ../src/design/fifos/sync_fifo.v ../src/design/fifos/byte_fifo.v ../src/design/ram_macro/sky130_sram_2kbyte_1rw_32x512_8.v ../src/design/cpu/alu_control_unit.v ../src/design/cpu/axi_cpu_interface_ctrl.v ../src/design/chip_top.v}
 
 # Add SRAM initialization file
 add_files -norecurse ./sources/software.txt
@@ -17,6 +17,7 @@ set_property file_type {Memory Initialization Files} [get_files  ./sources/softw
 
 # Add simulation files
 set_property SOURCE_SET sources_1 [get_filesets sim_1]
+add_files -fileset sim_1 -norecurse ../src/testbench/spi_flash_model.v
 add_files -fileset sim_1 -norecurse ../src/testbench/chip_top_tb.v
 
 # Update compile order